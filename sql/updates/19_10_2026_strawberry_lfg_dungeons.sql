@@ -0,0 +1,7 @@
+DROP TABLE IF EXISTS `lfg_dungeons`;
+CREATE TABLE `lfg_dungeons` (
+  `id` mediumint(8) unsigned NOT NULL DEFAULT '0' COMMENT 'LFGDungeons.dbc id',
+  `map` smallint(5) unsigned NOT NULL DEFAULT '0',
+  `difficulty` tinyint(3) unsigned NOT NULL DEFAULT '0',
+  PRIMARY KEY (`id`)
+) ENGINE=MyISAM DEFAULT CHARSET=utf8 ROW_FORMAT=FIXED COMMENT='Dungeon Finder System';
@@ -17,15 +17,101 @@
  * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
  */
 
+#include "Policies/MemoryStats.h"
+
+#include <new>
+#include <cstdlib>
+
 //lets use Intel scalable_allocator by default and
 //switch to OS specific allocator only when _STANDARD_MALLOC is defined
 #ifndef USE_STANDARD_MALLOC
+#  include "tbb/scalable_allocator.h"
+#  define STRAWBERRY_MALLOC(sz) scalable_malloc(sz)
+#  define STRAWBERRY_FREE(ptr) scalable_free(ptr)
+#else
+// tcmalloc replaces malloc itself, nothing to redirect here
+#  define STRAWBERRY_MALLOC(sz) malloc(sz)
+#  define STRAWBERRY_FREE(ptr) free(ptr)
+#endif
+
+#ifdef STRAWBERRY_ALLOC_STATS
+
+#include "Utilities/AtomicCounter.h"
+
+#if COMPILER == COMPILER_MICROSOFT
+#  define STRAWBERRY_THREAD_LOCAL __declspec(thread)
+#else
+#  define STRAWBERRY_THREAD_LOCAL __thread
+#endif
+
+#define STRAWBERRY_ATOMIC_ADD(var, value) Strawberry::AtomicAdd64((var), (value))
+#define STRAWBERRY_ATOMIC_READ(var) Strawberry::AtomicRead64(var)
+
+// plain integers and compiler TLS only: operator new runs before ACE and any static constructor
+struct MemoryTagCounters
+{
+    volatile int64 allocations;
+    volatile int64 frees;
+    volatile int64 totalBytes;
+    volatile int64 liveBytes;
+    char padding[64 - 4 * sizeof(int64)];                   // one cache line per tag
+};
+
+static MemoryTagCounters memoryTagCounters[MAX_MEMORY_TAGS];
+static STRAWBERRY_THREAD_LOCAL int currentMemoryTag;
+
+// in front of every block, two words keep the alignment malloc returned
+struct MemoryBlockHeader
+{
+    size_t size;
+    size_t tag;
+};
+
+static void* TaggedMalloc(size_t sz)
+{
+    MemoryBlockHeader* header = static_cast<MemoryBlockHeader*>(STRAWBERRY_MALLOC(sz + sizeof(MemoryBlockHeader)));
+    if (!header)
+        return NULL;
+
+    int tag = currentMemoryTag;
+    header->size = sz;
+    header->tag = size_t(tag);
+
+    MemoryTagCounters& counters = memoryTagCounters[tag];
+    STRAWBERRY_ATOMIC_ADD(counters.allocations, int64(1));
+    STRAWBERRY_ATOMIC_ADD(counters.totalBytes, int64(sz));
+    STRAWBERRY_ATOMIC_ADD(counters.liveBytes, int64(sz));
+
+    return header + 1;
+}
+
+static void TaggedFree(void* ptr)
+{
+    if (!ptr)
+        return;
+
+    MemoryBlockHeader* header = static_cast<MemoryBlockHeader*>(ptr) - 1;
+
+    MemoryTagCounters& counters = memoryTagCounters[header->tag];
+    STRAWBERRY_ATOMIC_ADD(counters.frees, int64(1));
+    STRAWBERRY_ATOMIC_ADD(counters.liveBytes, -int64(header->size));
+
+    STRAWBERRY_FREE(header);
+}
+
+#  define STRAWBERRY_NEW(sz) TaggedMalloc(sz)
+#  define STRAWBERRY_DELETE(ptr) TaggedFree(ptr)
 
-#include "../../dep/tbb/include/tbb/scalable_allocator.h"
+#elif !defined(USE_STANDARD_MALLOC)
+#  define STRAWBERRY_NEW(sz) STRAWBERRY_MALLOC(sz)
+#  define STRAWBERRY_DELETE(ptr) STRAWBERRY_FREE(ptr)
+#endif
+
+#ifdef STRAWBERRY_NEW
 
 void* operator new(size_t sz)
 {
-    void *res = scalable_malloc(sz);
+    void *res = STRAWBERRY_NEW(sz);
 
     if (res == NULL)
         throw std::bad_alloc();
@@ -35,7 +121,7 @@ void* operator new(size_t sz)
 
 void* operator new[](size_t sz)
 {
-    void *res = scalable_malloc(sz);
+    void *res = STRAWBERRY_NEW(sz);
 
     if (res == NULL)
         throw std::bad_alloc();
@@ -45,32 +131,102 @@ void* operator new[](size_t sz)
 
 void operator delete(void* ptr) throw()
 {
-    scalable_free(ptr);
+    STRAWBERRY_DELETE(ptr);
 }
 
 void operator delete[](void* ptr) throw()
 {
-    scalable_free(ptr);
+    STRAWBERRY_DELETE(ptr);
 }
 
 void* operator new(size_t sz, const std::nothrow_t&) throw()
 {
-    return scalable_malloc(sz);
+    return STRAWBERRY_NEW(sz);
 }
 
 void* operator new[](size_t sz, const std::nothrow_t&) throw()
 {
-    return scalable_malloc(sz);
+    return STRAWBERRY_NEW(sz);
 }
 
 void operator delete(void* ptr, const std::nothrow_t&) throw()
 {
-    scalable_free(ptr);
+    STRAWBERRY_DELETE(ptr);
 }
 
 void operator delete[](void* ptr, const std::nothrow_t&) throw()
 {
-    scalable_free(ptr);
+    STRAWBERRY_DELETE(ptr);
+}
+
+#endif
+
+bool MemoryStats::IsEnabled()
+{
+#ifdef STRAWBERRY_ALLOC_STATS
+    return true;
+#else
+    return false;
+#endif
+}
+
+char const* MemoryStats::GetAllocatorName()
+{
+#if !defined(USE_STANDARD_MALLOC)
+    return "TBB scalable_malloc";
+#elif defined(STRAWBERRY_TCMALLOC)
+    return "tcmalloc";
+#else
+    return "system malloc";
+#endif
+}
+
+char const* MemoryStats::GetTagName(MemoryTag tag)
+{
+    switch (tag)
+    {
+        case MEMORY_TAG_OTHER:      return "other";
+        case MEMORY_TAG_MAPS:       return "maps";
+        case MEMORY_TAG_SPELLS:     return "spells";
+        case MEMORY_TAG_PACKETS:    return "packets";
+        case MEMORY_TAG_DATABASE:   return "database";
+    }
+
+    return "unknown";
 }
 
+void MemoryStats::GetTagStats(MemoryTag tag, MemoryTagStats& stats)
+{
+#ifdef STRAWBERRY_ALLOC_STATS
+    // 64 bit reads are not atomic on 32 bit targets
+    MemoryTagCounters& counters = memoryTagCounters[tag];
+    stats.allocations = uint64(STRAWBERRY_ATOMIC_READ(counters.allocations));
+    stats.frees = uint64(STRAWBERRY_ATOMIC_READ(counters.frees));
+    stats.totalBytes = uint64(STRAWBERRY_ATOMIC_READ(counters.totalBytes));
+    stats.liveBytes = STRAWBERRY_ATOMIC_READ(counters.liveBytes);
+#else
+    (void)tag;
+    stats.allocations = 0;
+    stats.frees = 0;
+    stats.totalBytes = 0;
+    stats.liveBytes = 0;
 #endif
+}
+
+MemoryTag MemoryStats::GetCurrentTag()
+{
+#ifdef STRAWBERRY_ALLOC_STATS
+    return MemoryTag(currentMemoryTag);
+#else
+    return MEMORY_TAG_OTHER;
+#endif
+}
+
+void MemoryStats::SetCurrentTag(MemoryTag tag)
+{
+#ifdef STRAWBERRY_ALLOC_STATS
+    currentMemoryTag = tag;
+#else
+    (void)tag;
+#endif
+}
@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2010-2012 Strawberry-Pr0jcts <http://strawberry-pr0jcts.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef STRAWBERRY_MEMORYSTATS_H
+#define STRAWBERRY_MEMORYSTATS_H
+
+#include "Platform/Define.h"
+
+/// Subsystems the allocation counters are split into
+enum MemoryTag
+{
+    MEMORY_TAG_OTHER            = 0,                        // everything outside a MemoryTagScope
+    MEMORY_TAG_MAPS             = 1,                        // Map::Update, objects, grids and notifiers
+    MEMORY_TAG_SPELLS           = 2,                        // spell prepare, cast and update
+    MEMORY_TAG_PACKETS          = 3,                        // packet storage and WorldPacket objects
+    MEMORY_TAG_DATABASE         = 4                         // query results
+};
+
+#define MAX_MEMORY_TAGS 5
+
+struct MemoryTagStats
+{
+    uint64 allocations;
+    uint64 frees;
+    uint64 totalBytes;                                      ///< requested by all allocations so far
+    int64 liveBytes;                                        ///< allocated and not freed yet, may be freed under another tag
+};
+
+/**
+ * Allocation counters of the global operator new/delete, only collected when built with ALLOC_STATS.
+ * Each thread carries a current tag, set by MemoryTagScope. Every block remembers the tag it was
+ * allocated under, so freeing it from any thread or scope gives the bytes back to the right subsystem.
+ * Allocations that bypass operator new (malloc in client libraries) are not seen.
+ */
+class MemoryStats
+{
+    public:
+        static bool IsEnabled();
+        static char const* GetAllocatorName();
+        static char const* GetTagName(MemoryTag tag);
+        static void GetTagStats(MemoryTag tag, MemoryTagStats& stats);
+
+        static MemoryTag GetCurrentTag();
+        static void SetCurrentTag(MemoryTag tag);
+};
+
+/// Charges the allocations of the current thread to a subsystem until the end of the scope, compiles to nothing without ALLOC_STATS
+class MemoryTagScope
+{
+    public:
+#ifdef STRAWBERRY_ALLOC_STATS
+        explicit MemoryTagScope(MemoryTag tag) : m_previous(MemoryStats::GetCurrentTag()) { MemoryStats::SetCurrentTag(tag); }
+        ~MemoryTagScope() { MemoryStats::SetCurrentTag(m_previous); }
+
+    private:
+        MemoryTag m_previous;
+#else
+        explicit MemoryTagScope(MemoryTag /*tag*/) {}
+#endif
+};
+
+#endif
@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2010-2012 Strawberry-Pr0jcts <http://strawberry-pr0jcts.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef STRAWBERRY_ATOMICCOUNTER_H
+#define STRAWBERRY_ATOMICCOUNTER_H
+
+#include "Platform/Define.h"
+
+#if COMPILER == COMPILER_MICROSOFT
+#  include <intrin.h>
+#  pragma intrinsic(_InterlockedCompareExchange64)
+#endif
+
+// Lock free 64 bit operations on every platform, ACE_Atomic_Op falls back to a mutex for 64 bit
+// values where long is 32 bit (Windows, 32 bit builds).
+namespace Strawberry
+{
+#if COMPILER == COMPILER_MICROSOFT
+    inline int64 AtomicCompareExchange64(volatile int64& var, int64 newValue, int64 expected)
+    {
+        return _InterlockedCompareExchange64((volatile __int64*)&var, newValue, expected);
+    }
+
+    // _InterlockedExchangeAdd64 only exists for x64, the compare exchange (cmpxchg8b) is there on x86 too
+    inline int64 AtomicAdd64(volatile int64& var, int64 value)
+    {
+        int64 old;
+        do
+            old = var;                                      // may be torn on x86, then the exchange fails and retries
+        while (AtomicCompareExchange64(var, old + value, old) != old);
+        return old + value;
+    }
+#else
+    inline int64 AtomicCompareExchange64(volatile int64& var, int64 newValue, int64 expected)
+    {
+        return __sync_val_compare_and_swap(&var, expected, newValue);
+    }
+
+    inline int64 AtomicAdd64(volatile int64& var, int64 value)
+    {
+        return __sync_add_and_fetch(&var, value);
+    }
+#endif
+
+    inline int64 AtomicRead64(volatile int64& var)
+    {
+        return AtomicCompareExchange64(var, 0, 0);
+    }
+
+    inline void AtomicWrite64(volatile int64& var, int64 value)
+    {
+        int64 old;
+        do
+            old = var;
+        while (AtomicCompareExchange64(var, value, old) != old);
+    }
+}
+
+/// Unsigned 64 bit counter, every operation is a single atomic instruction or a compare exchange loop
+class AtomicCounter64
+{
+    public:
+        AtomicCounter64() : m_value(0) {}
+
+        uint64 operator++() { return uint64(Strawberry::AtomicAdd64(m_value, 1)); }
+        uint64 operator+=(uint64 value) { return uint64(Strawberry::AtomicAdd64(m_value, int64(value))); }
+        AtomicCounter64& operator=(uint64 value) { Strawberry::AtomicWrite64(m_value, int64(value)); return *this; }
+
+        uint64 value() const { return uint64(Strawberry::AtomicRead64(m_value)); }
+
+        // raises the counter to value if it is below, concurrent raises keep the highest
+        void SetMax(uint64 value)
+        {
+            int64 old;
+            do
+            {
+                old = Strawberry::AtomicRead64(m_value);
+                if (uint64(old) >= value)
+                    return;
+            }
+            while (Strawberry::AtomicCompareExchange64(m_value, int64(value), old) != old);
+        }
+
+    private:
+        AtomicCounter64(AtomicCounter64 const&);
+        AtomicCounter64& operator=(AtomicCounter64 const&);
+
+        mutable volatile int64 m_value;                     // mutable, a read is a compare exchange too
+};
+
+#endif
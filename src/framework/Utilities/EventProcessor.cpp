@@ -19,15 +19,286 @@
 
 #include "EventProcessor.h"
 
+#include <cassert>
+
+// private wheel: 6 levels of 8 slots cover 262 seconds, later events go to the overflow list
+#define EVENT_WHEEL_PRIVATE_LEVELS      6
+#define EVENT_WHEEL_PRIVATE_SLOT_BITS   3
+
+namespace
+{
+    // circular lists over BasicEvent::m_wheelPrev/m_wheelNext, head is the first added element
+
+    void WheelListAppend(BasicEvent*& head, BasicEvent* Event, BasicEvent* BasicEvent::*prev, BasicEvent* BasicEvent::*next)
+    {
+        if (!head)
+        {
+            Event->*prev = Event;
+            Event->*next = Event;
+            head = Event;
+            return;
+        }
+
+        BasicEvent* tail = head->*prev;
+        Event->*prev = tail;
+        Event->*next = head;
+        tail->*next = Event;
+        head->*prev = Event;
+    }
+
+    void WheelListRemove(BasicEvent*& head, BasicEvent* Event, BasicEvent* BasicEvent::*prev, BasicEvent* BasicEvent::*next)
+    {
+        if (Event->*next == Event)
+            head = NULL;
+        else
+        {
+            (Event->*prev)->*next = Event->*next;
+            (Event->*next)->*prev = Event->*prev;
+            if (head == Event)
+                head = Event->*next;
+        }
+
+        Event->*prev = NULL;
+        Event->*next = NULL;
+    }
+
+    uint32 NextOccupied(uint64 mask, uint32 from, uint32 count)
+    {
+        for (; from < count; ++from)
+        {
+            if (!(mask >> from))
+                return count;
+            if (mask & (uint64(1) << from))
+                return from;
+        }
+
+        return count;
+    }
+}
+
+EventWheel::EventWheel(uint32 levels, uint32 slotBits, uint64 startTime)
+    : m_levels(levels), m_slotBits(slotBits), m_slotCount(1 << slotBits),
+    m_time(startTime), m_count(0), m_overflow(NULL), m_overflowTime(0)
+{
+    assert(levels > 0 && slotBits > 0 && slotBits <= 6);
+    assert(levels * slotBits < 64);
+
+    m_slots.resize(m_levels * m_slotCount, NULL);
+    m_occupied.resize(m_levels, 0);
+}
+
+EventWheel::~EventWheel()
+{
+    // owners still queued here (shared wheel) fall back to own wheels
+    for (uint32 slot = 0; slot < m_slots.size(); ++slot)
+        while (m_slots[slot])
+            m_slots[slot]->m_owner->SetSharedWheel(NULL);
+
+    while (m_overflow)
+        m_overflow->m_owner->SetSharedWheel(NULL);
+}
+
+void EventWheel::Schedule(BasicEvent* Event, uint64 w_time)
+{
+    Event->m_wheelTime = w_time;
+    ++m_count;
+    Place(Event);
+}
+
+void EventWheel::Place(BasicEvent* Event)
+{
+    uint64 w_time = Event->m_wheelTime;
+
+    // lowest level whose current block contains the due time, at most m_levels steps
+    for (uint32 level = 0; level < m_levels; ++level)
+    {
+        uint32 shift = level * m_slotBits;
+        uint32 blockShift = shift + m_slotBits;
+        if ((w_time >> blockShift) != (m_time >> blockShift))
+            continue;
+
+        uint32 index = uint32(w_time >> shift) & (m_slotCount - 1);
+        Event->m_wheelSlot = int32(level * m_slotCount + index);
+        m_occupied[level] |= uint64(1) << index;
+
+        // a level 0 slot is a single millisecond, appending keeps equal due times FIFO
+        WheelListAppend(m_slots[level * m_slotCount + index], Event, &BasicEvent::m_wheelPrev, &BasicEvent::m_wheelNext);
+        return;
+    }
+
+    uint32 topShift = m_levels * m_slotBits;
+    uint64 blockTime = (w_time >> topShift) << topShift;
+    if (!m_overflow || blockTime < m_overflowTime)
+        m_overflowTime = blockTime;
+
+    Event->m_wheelSlot = SLOT_OVERFLOW;
+    WheelListAppend(m_overflow, Event, &BasicEvent::m_wheelPrev, &BasicEvent::m_wheelNext);
+}
+
+void EventWheel::Unschedule(BasicEvent* Event)
+{
+    if (Event->m_wheelSlot == SLOT_OVERFLOW)
+        WheelListRemove(m_overflow, Event, &BasicEvent::m_wheelPrev, &BasicEvent::m_wheelNext);
+    else
+    {
+        uint32 slot = uint32(Event->m_wheelSlot);
+        BasicEvent*& head = m_slots[slot];
+        WheelListRemove(head, Event, &BasicEvent::m_wheelPrev, &BasicEvent::m_wheelNext);
+        if (!head)
+            m_occupied[slot / m_slotCount] &= ~(uint64(1) << (slot % m_slotCount));
+    }
+
+    Event->m_wheelSlot = SLOT_NONE;
+    --m_count;
+}
+
+uint64 EventWheel::NextSlotTime() const
+{
+    // current slots are already drained (level 0) or cascaded (upper levels), look for the next one
+    for (uint32 level = 0; level < m_levels; ++level)
+    {
+        uint32 shift = level * m_slotBits;
+        uint32 blockShift = shift + m_slotBits;
+        uint32 index = uint32(m_time >> shift) & (m_slotCount - 1);
+
+        uint32 next = NextOccupied(m_occupied[level], index + 1, m_slotCount);
+        if (next < m_slotCount)
+            return ((m_time >> blockShift) << blockShift) + (uint64(next) << shift);
+    }
+
+    // always later than m_time, the block is rescanned when the wheel reaches it
+    if (m_overflow)
+        return m_overflowTime;
+
+    return ~uint64(0);
+}
+
+void EventWheel::Cascade()
+{
+    // m_time just reached the start of a slot, redistribute everything stored for it at upper levels
+    uint32 topShift = m_levels * m_slotBits;
+    if (m_overflow && m_overflowTime <= m_time && !(m_time & ((uint64(1) << topShift) - 1)))
+    {
+        // one pass over the overflow list per top level block that has events in it
+        uint64 nextTime = ~uint64(0);
+        BasicEvent* itr = m_overflow;
+        BasicEvent* last = m_overflow->m_wheelPrev;
+        for (bool done = false; !done;)
+        {
+            BasicEvent* Event = itr;
+            done = Event == last;
+            itr = Event->m_wheelNext;
+
+            uint64 blockTime = (Event->m_wheelTime >> topShift) << topShift;
+            if (blockTime != m_time)
+            {
+                if (blockTime < nextTime)
+                    nextTime = blockTime;
+                continue;
+            }
+
+            WheelListRemove(m_overflow, Event, &BasicEvent::m_wheelPrev, &BasicEvent::m_wheelNext);
+            Place(Event);
+        }
+
+        m_overflowTime = nextTime;
+    }
+
+    // top-down, so events moved from level N are cascaded again from level N-1 in the same pass
+    for (uint32 level = m_levels - 1; level > 0; --level)
+    {
+        uint32 shift = level * m_slotBits;
+        if (m_time & ((uint64(1) << shift) - 1))
+            continue;
+
+        uint32 index = uint32(m_time >> shift) & (m_slotCount - 1);
+        BasicEvent*& head = m_slots[level * m_slotCount + index];
+        if (!head)
+            continue;
+
+        m_occupied[level] &= ~(uint64(1) << index);
+        while (head)
+        {
+            BasicEvent* Event = head;
+            WheelListRemove(head, Event, &BasicEvent::m_wheelPrev, &BasicEvent::m_wheelNext);
+            Place(Event);
+        }
+    }
+}
+
+void EventWheel::Advance(uint64 newTime)
+{
+    if (newTime < m_time)
+        return;
+
+    for (;;)
+    {
+        // everything in the current level 0 slot is due exactly at m_time
+        uint32 index = uint32(m_time) & (m_slotCount - 1);
+        BasicEvent*& head = m_slots[index];
+
+        while (head)
+        {
+            BasicEvent* Event = head;
+            Unschedule(Event);
+            Event->m_owner->AddReady(Event);
+        }
+
+        uint64 next = NextSlotTime();
+        if (next > newTime)
+            break;
+
+        m_time = next;
+        Cascade();
+    }
+
+    m_time = newTime;
+}
+
 EventProcessor::EventProcessor()
 {
     m_time = 0;
     m_aborting = false;
+    m_wheel = NULL;
+    m_sharedWheel = false;
+    m_ready = NULL;
+    m_events = NULL;
 }
 
 EventProcessor::~EventProcessor()
 {
     KillAllEvents(true);
+
+    if (!m_sharedWheel)
+        delete m_wheel;
+}
+
+EventWheel* EventProcessor::GetWheel()
+{
+    if (!m_wheel)
+        m_wheel = new EventWheel(EVENT_WHEEL_PRIVATE_LEVELS, EVENT_WHEEL_PRIVATE_SLOT_BITS, m_time);
+
+    return m_wheel;
+}
+
+void EventProcessor::AddReady(BasicEvent* Event)
+{
+    Event->m_wheelSlot = EventWheel::SLOT_READY;
+    WheelListAppend(m_ready, Event, &BasicEvent::m_wheelPrev, &BasicEvent::m_wheelNext);
+}
+
+void EventProcessor::Unqueue(BasicEvent* Event)
+{
+    if (Event->m_wheelSlot == EventWheel::SLOT_READY)
+    {
+        WheelListRemove(m_ready, Event, &BasicEvent::m_wheelPrev, &BasicEvent::m_wheelNext);
+        Event->m_wheelSlot = EventWheel::SLOT_NONE;
+    }
+    else if (Event->m_wheelSlot != EventWheel::SLOT_NONE)
+        m_wheel->Unschedule(Event);
+
+    WheelListRemove(m_events, Event, &BasicEvent::m_ownerPrev, &BasicEvent::m_ownerNext);
+    Event->m_owner = NULL;
 }
 
 void EventProcessor::Update(uint32 p_time)
@@ -35,13 +306,16 @@ void EventProcessor::Update(uint32 p_time)
     // update time
     m_time += p_time;
 
-    // main event loop
-    EventList::iterator i;
-    while (((i = m_events.begin()) != m_events.end()) && i->first <= m_time)
+    // a shared wheel is advanced by its holder before the owners are updated
+    if (m_wheel && !m_sharedWheel)
+        m_wheel->Advance(m_time);
+
+    // main event loop, events re-added as already due are appended and run in this pass too
+    while (m_ready)
     {
         // get and remove event from queue
-        BasicEvent* Event = i->second;
-        m_events.erase(i);
+        BasicEvent* Event = m_ready;
+        Unqueue(Event);
 
         if (!Event->to_Abort)
         {
@@ -65,25 +339,24 @@ void EventProcessor::KillAllEvents(bool force)
     m_aborting = true;
 
     // first, abort all existing events
-    for (EventList::iterator i = m_events.begin(); i != m_events.end();)
+    if (BasicEvent* itr = m_events)
     {
-        EventList::iterator i_old = i;
-        ++i;
-
-        i_old->second->to_Abort = true;
-        i_old->second->Abort(m_time);
-        if (force || i_old->second->IsDeletable())
+        BasicEvent* last = m_events->m_ownerPrev;
+        for (bool done = false; !done;)
         {
-            delete i_old->second;
+            BasicEvent* Event = itr;
+            done = Event == last;
+            itr = Event->m_ownerNext;
 
-            if (!force)                                      // need per-element cleanup
-                m_events.erase (i_old);
+            Event->to_Abort = true;
+            Event->Abort(m_time);
+            if (force || Event->IsDeletable())
+            {
+                Unqueue(Event);
+                delete Event;
+            }
         }
     }
-
-    // fast clear event list (in force case)
-    if (force)
-        m_events.clear();
 }
 
 void EventProcessor::AddEvent(BasicEvent* Event, uint64 e_time, bool set_addtime)
@@ -92,10 +365,58 @@ void EventProcessor::AddEvent(BasicEvent* Event, uint64 e_time, bool set_addtime
         Event->m_addTime = m_time;
 
     Event->m_execTime = e_time;
-    m_events.insert(std::pair<uint64, BasicEvent*>(e_time, Event));
+
+    Event->m_owner = this;
+    WheelListAppend(m_events, Event, &BasicEvent::m_ownerPrev, &BasicEvent::m_ownerNext);
+
+    if (e_time <= m_time)
+    {
+        AddReady(Event);
+        return;
+    }
+
+    EventWheel* wheel = GetWheel();
+    wheel->Schedule(Event, wheel->GetTime() + (e_time - m_time));
 }
 
 uint64 EventProcessor::CalculateTime(uint64 t_offset)
 {
     return m_time + t_offset;
 }
+
+void EventProcessor::SetSharedWheel(EventWheel* wheel)
+{
+    if (m_sharedWheel ? m_wheel == wheel : !wheel)
+        return;
+
+    EventWheel* oldWheel = m_wheel;
+    bool oldShared = m_sharedWheel;
+
+    m_sharedWheel = wheel != NULL;
+    m_wheel = wheel;
+
+    // move pending events keeping their remaining delay, ready ones stay where they are
+    if (BasicEvent* itr = m_events)
+    {
+        BasicEvent* last = m_events->m_ownerPrev;
+        for (bool done = false; !done;)
+        {
+            BasicEvent* Event = itr;
+            done = Event == last;
+            itr = Event->m_ownerNext;
+
+            if (Event->m_wheelSlot == EventWheel::SLOT_READY || Event->m_wheelSlot == EventWheel::SLOT_NONE)
+                continue;
+
+            uint64 w_time = Event->m_wheelTime;
+            uint64 delay = w_time > oldWheel->GetTime() ? w_time - oldWheel->GetTime() : 0;
+            oldWheel->Unschedule(Event);
+
+            EventWheel* newWheel = GetWheel();
+            newWheel->Schedule(Event, newWheel->GetTime() + delay);
+        }
+    }
+
+    if (oldWheel && !oldShared)
+        delete oldWheel;
+}
@@ -22,16 +22,20 @@
 
 #include "Platform/Define.h"
 
-#include <map>
+#include <vector>
 
 // Note. All times are in milliseconds here.
 
+class EventProcessor;
+class EventWheel;
+
 class BasicEvent
 {
     public:
 
         BasicEvent()
-            : to_Abort(false)
+            : to_Abort(false), m_wheelPrev(NULL), m_wheelNext(NULL), m_ownerPrev(NULL), m_ownerNext(NULL),
+            m_wheelTime(0), m_wheelSlot(-1), m_owner(NULL)
         {
         }
 
@@ -54,9 +58,77 @@ class BasicEvent
         // these can be used for time offset control
         uint64 m_addTime;                                   // time when the event was added to queue, filled by event handler
         uint64 m_execTime;                                  // planned time of next execution, filled by event handler
+
+    private:
+        friend class EventProcessor;
+        friend class EventWheel;
+
+        // intrusive links, an event is queued without any extra allocation
+        BasicEvent* m_wheelPrev;                            // wheel slot or owner ready list
+        BasicEvent* m_wheelNext;
+        BasicEvent* m_ownerPrev;                            // all queued events of the owner
+        BasicEvent* m_ownerNext;
+        uint64 m_wheelTime;                                 // due time in wheel clock
+        int32 m_wheelSlot;                                  // wheel slot index or one of EventWheel::Slots
+        EventProcessor* m_owner;
 };
 
-typedef std::multimap<uint64, BasicEvent*> EventList;
+/**
+ * Hierarchical timing wheel with 1 ms resolution. Every slot is an unsorted bucket,
+ * a level 0 slot holds the events of exactly one millisecond, upper level slots are
+ * cascaded down when the wheel reaches them. Events beyond the last level wait in an
+ * unsorted overflow list which is scanned once each time the wheel enters a new top
+ * level block. Insert and cancel are O(1), each event is moved at most once per level.
+ *
+ * A wheel can be private to one EventProcessor or shared by many (see Map), expired
+ * events are handed to the ready list of their owner which executes them at its own update.
+ * A shared wheel runs on the clock of its holder: events of an owner that is not updated
+ * meanwhile still become due and all execute at the next update of the owner.
+ */
+class EventWheel
+{
+    public:
+
+        enum Slots
+        {
+            SLOT_NONE     = -1,                             // not queued
+            SLOT_READY    = -2,                             // in owner ready list
+            SLOT_OVERFLOW = -3                              // beyond the last wheel level
+        };
+
+        EventWheel(uint32 levels, uint32 slotBits, uint64 startTime = 0);
+        ~EventWheel();
+
+        uint64 GetTime() const { return m_time; }
+        uint32 GetEventCount() const { return m_count; }
+
+        // move the wheel clock forward, due events are passed to the ready lists of their owners
+        void Advance(uint64 newTime);
+
+    private:
+        friend class EventProcessor;
+
+        EventWheel(EventWheel const&);
+        EventWheel& operator=(EventWheel const&);
+
+        void Schedule(BasicEvent* Event, uint64 w_time);
+        void Unschedule(BasicEvent* Event);
+        void Place(BasicEvent* Event);
+        void Cascade();
+        uint64 NextSlotTime() const;
+
+        uint32 m_levels;
+        uint32 m_slotBits;
+        uint32 m_slotCount;
+
+        uint64 m_time;
+        uint32 m_count;
+
+        std::vector<BasicEvent*> m_slots;                   // m_levels * m_slotCount list heads
+        std::vector<uint64> m_occupied;                     // per level bitmask of non empty slots
+        BasicEvent* m_overflow;
+        uint64 m_overflowTime;                              // earliest top level block start in overflow, may be early after cancels
+};
 
 class EventProcessor
 {
@@ -69,12 +141,30 @@ class EventProcessor
         void KillAllEvents(bool force);
         void AddEvent(BasicEvent* Event, uint64 e_time, bool set_addtime = true);
         uint64 CalculateTime(uint64 t_offset);
+        bool HasEvents() const { return m_events != NULL; }
+
+        // queue events in a wheel shared with other processors, NULL switches back to own wheel
+        void SetSharedWheel(EventWheel* wheel);
 
     protected:
 
         uint64 m_time;
-        EventList m_events;
         bool m_aborting;
+
+    private:
+        friend class EventWheel;
+
+        EventProcessor(EventProcessor const&);
+        EventProcessor& operator=(EventProcessor const&);
+
+        EventWheel* GetWheel();
+        void Unqueue(BasicEvent* Event);
+        void AddReady(BasicEvent* Event);
+
+        EventWheel* m_wheel;                                // created at first AddEvent if not shared
+        bool m_sharedWheel;
+        BasicEvent* m_ready;                                // due events waiting for Update
+        BasicEvent* m_events;                               // all queued events
 };
 
 #endif
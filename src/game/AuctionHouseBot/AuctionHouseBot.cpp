@@ -4,6 +4,11 @@
 #include "../ObjectMgr.h"
 #include "../AuctionHouseMgr.h"
 #include "SystemConfig.h"
+#include "LockedQueue.h"
+#include "Threading.h"
+
+#include <ace/Thread_Mutex.h>
+#include <deque>
 
 // Format is YYYYMMDDRR where RR is the change in the conf file
 // for that day.
@@ -65,6 +70,39 @@ struct RandomArrayEntry
 
 typedef std::vector<RandomArrayEntry> RandomArray;
 
+// One seller cycle for a house, snapshot of the world thread state planned by the planning thread
+struct AuctionBotSellerJob
+{
+    AuctionHouseType houseType;
+    uint32 items;                                           // max auctions to plan
+    uint32 missItems[MAX_AUCTION_QUALITY][MAX_ITEM_CLASS];
+    uint32 priceRatio[MAX_AUCTION_QUALITY];
+    uint32 minTime;                                         // in hours
+    uint32 maxTime;
+    bool buyPriceSeller;
+};
+
+struct AuctionBotPlannedAuction
+{
+    AuctionHouseType houseType;
+    uint32 itemId;
+    uint32 stackCount;
+    uint32 bidPrice;
+    uint32 buyoutPrice;
+    uint32 etime;                                           // in seconds
+};
+
+typedef std::vector<AuctionBotPlannedAuction> AuctionBotPlannedAuctions;
+
+struct AuctionBotSellerPlan
+{
+    AuctionHouseType houseType;
+    AuctionBotPlannedAuctions auctions;
+};
+
+// planning thread idle time between checks for new jobs, in ms
+#define AHBOT_PLANNER_SLEEP 100
+
 struct SellerItemClassInfo
 {
     SellerItemClassInfo() : AmountOfItems(0), MissItems(0), Quantity(0) {}
@@ -176,8 +214,11 @@ class AuctionBotBuyer : public AuctionBotAgent
 
 // This class handle all Selling method
 // (holder of AHB_Seller_Config data for each auction house type)
+// Item selection and pricing run in the planning thread, the world thread only posts the planned auctions.
 class AuctionBotSeller : public AuctionBotAgent
 {
+    friend class AuctionBotPlannerRunnable;
+
     public:
         typedef std::vector<uint32> ItemPool;
 
@@ -194,16 +235,44 @@ class AuctionBotSeller : public AuctionBotAgent
         void SetItemsAmountForQuality(AuctionQuality quality, uint32 val);
         void LoadConfig();
 
+        bool HasPlannedAuctions() const;
+        void ApplyPlannedAuctions();
+        void StopPlanningThread();
+
     private:
         AHB_Seller_Config   m_HouseConfig[MAX_AUCTION_HOUSE_TYPE];
 
+        // not changed after Initialize, read by the planning thread
         ItemPool m_ItemPool[MAX_AUCTION_QUALITY][MAX_ITEM_CLASS];
 
+        // cross thread exchange
+        ACE_Based::LockedQueue<AuctionBotSellerJob, ACE_Thread_Mutex> m_jobs;
+        ACE_Based::LockedQueue<AuctionBotSellerPlan, ACE_Thread_Mutex> m_plans;
+        ACE_Based::Thread* m_plannerThread;
+        volatile bool m_stopPlanner;
+
+        // world thread state
+        std::deque<AuctionBotPlannedAuction> m_applyQueue;
+        bool m_housePlanning[MAX_AUCTION_HOUSE_TYPE];       // job queued, plan not received yet
+        uint32 m_houseQueued[MAX_AUCTION_HOUSE_TYPE];       // planned auctions not posted yet
+
         void        LoadSellerValues(AHB_Seller_Config& config);
         uint32      SetStat(AHB_Seller_Config& config);
-        bool        getRandomArray( AHB_Seller_Config& config, RandomArray& ra, const std::vector<std::vector<uint32> >& addedItem  );
-        void        SetPricesOfItem(ItemPrototype const *itemProto, AHB_Seller_Config& config, uint32& buyp, uint32& bidp, uint32 stackcnt, ItemQualities itemQuality);
+        bool        getRandomArray(AuctionBotSellerJob const& job, RandomArray& ra, const std::vector<std::vector<uint32> >& addedItem) const;
+        void        SetPricesOfItem(AuctionBotSellerJob const& job, uint32& buyp, uint32& bidp, uint32 stackcnt, ItemQualities itemQuality) const;
         void        LoadItemsQuantity(AHB_Seller_Config& config);
+        void        PlanNewAuctions(AuctionBotSellerJob const& job, AuctionBotPlannedAuctions& auctions) const;
+};
+
+/// Thread planning the seller cycles queued by AuctionBotSeller::addNewAuctions
+class AuctionBotPlannerRunnable : public ACE_Based::Runnable
+{
+    public:
+        explicit AuctionBotPlannerRunnable(AuctionBotSeller* seller) : m_seller(seller) {}
+        void run();
+
+    private:
+        AuctionBotSeller* m_seller;
 };
 
 INSTANTIATE_SINGLETON_1( AuctionHouseBot );
@@ -326,6 +395,7 @@ void AuctionBotConfig::GetConfigFromFile()
 
     setConfig(CONFIG_UINT32_AHBOT_ITEMS_PER_CYCLE_BOOST      , "AuctionHouseBot.ItemsPerCycle.Boost"         , 75);
     setConfig(CONFIG_UINT32_AHBOT_ITEMS_PER_CYCLE_NORMAL     , "AuctionHouseBot.ItemsPerCycle.Normal"        , 20);
+    setConfigMinMax(CONFIG_UINT32_AHBOT_SELLER_AUCTIONS_PER_TICK, "AuctionHouseBot.Seller.AuctionsPerTick"   , 10, 1, 1000);
 
     setConfig(CONFIG_UINT32_AHBOT_ITEM_MIN_ITEM_LEVEL        , "AuctionHouseBot.Items.ItemLevel.Min"         , 0);
     setConfig(CONFIG_UINT32_AHBOT_ITEM_MAX_ITEM_LEVEL        , "AuctionHouseBot.Items.ItemLevel.Max"         , 0);
@@ -853,15 +923,31 @@ bool AuctionBotBuyer::Update(AuctionHouseType houseType)
 
 //== AuctionBotSeller functions ============================
 
-AuctionBotSeller::AuctionBotSeller()
+AuctionBotSeller::AuctionBotSeller() : m_plannerThread(NULL), m_stopPlanner(false)
 {
     // Define faction for our main data class.
     for (int i = 0; i < MAX_AUCTION_HOUSE_TYPE; ++i)
+    {
         m_HouseConfig[i].Initialize(AuctionHouseType(i));
+        m_housePlanning[i] = false;
+        m_houseQueued[i] = 0;
+    }
 }
 
 AuctionBotSeller::~AuctionBotSeller()
 {
+    StopPlanningThread();
+}
+
+void AuctionBotSeller::StopPlanningThread()
+{
+    if (!m_plannerThread)
+        return;
+
+    m_stopPlanner = true;
+    m_plannerThread->wait();
+    delete m_plannerThread;
+    m_plannerThread = NULL;
 }
 
 bool AuctionBotSeller::Initialize()
@@ -1207,6 +1293,8 @@ bool AuctionBotSeller::Initialize()
     sLog.outString("AHBot seller configuration data loaded and initilized");
 
     sLog.SetLogFilter(LOG_FILTER_AHBOT_SELLER, !sAuctionBotConfig.getConfig(CONFIG_BOOL_AHBOT_DEBUG_SELLER));
+
+    m_plannerThread = new ACE_Based::Thread(new AuctionBotPlannerRunnable(this));
     return true;
 }
 
@@ -1452,7 +1540,7 @@ uint32 AuctionBotSeller::SetStat(AHB_Seller_Config& config)
 }
 
 // getRandomArray is used to make aviable the possibility to add any of missed item in place of first one to last one.
-bool AuctionBotSeller::getRandomArray( AHB_Seller_Config& config, RandomArray& ra, const std::vector<std::vector<uint32> >& addedItem  )
+bool AuctionBotSeller::getRandomArray(AuctionBotSellerJob const& job, RandomArray& ra, const std::vector<std::vector<uint32> >& addedItem) const
 {
     ra.clear();
     bool Ok=false;
@@ -1461,7 +1549,7 @@ bool AuctionBotSeller::getRandomArray( AHB_Seller_Config& config, RandomArray& r
     {
         for (uint32 i = 0; i < MAX_ITEM_CLASS; ++i)
         {
-            if ((config.GetMissedItemsPerClass(AuctionQuality(j), ItemClass(i)) > addedItem[j][i]) && !m_ItemPool[j][i].empty())
+            if ((job.missItems[j][i] > addedItem[j][i]) && !m_ItemPool[j][i].empty())
             {
                 RandomArrayEntry miss_item;
                 miss_item.color = j;
@@ -1475,10 +1563,10 @@ bool AuctionBotSeller::getRandomArray( AHB_Seller_Config& config, RandomArray& r
 }
 
 // Set items price. All important value are passed by address.
-void AuctionBotSeller::SetPricesOfItem(ItemPrototype const *itemProto, AHB_Seller_Config& config, uint32& buyp, uint32& bidp, uint32 stackcnt, ItemQualities itemQuality)
+void AuctionBotSeller::SetPricesOfItem(AuctionBotSellerJob const& job, uint32& buyp, uint32& bidp, uint32 stackcnt, ItemQualities itemQuality) const
 {
     double temp_buyp = buyp * stackcnt *
-        (itemQuality < MAX_AUCTION_QUALITY ? config.GetPriceRatioPerQuality(AuctionQuality(itemQuality)) : 1) ;
+        (itemQuality < MAX_AUCTION_QUALITY ? job.priceRatio[itemQuality] : 1) ;
 
     double randrange = temp_buyp * 0.4;
     buyp = (urand(temp_buyp-randrange, temp_buyp+randrange)/100)+1;
@@ -1543,37 +1631,48 @@ void AuctionBotSeller::SetItemsAmountForQuality(AuctionQuality quality, uint32 v
         LoadItemsQuantity(m_HouseConfig[i]);
 }
 
-// Add new auction to one of the factions.
+// Queue new auctions for one of the factions to the planning thread.
 // Faction and setting assossiated is defined passed argument ( config )
 void AuctionBotSeller::addNewAuctions(AHB_Seller_Config& config)
 {
-    uint32 items;
+    AuctionBotSellerJob job;
+    job.houseType = config.GetHouseType();
 
     // If there is large amount of items missed we can use boost value to get fast filled AH
     if (config.LastMissedItem > sAuctionBotConfig.GetItemPerCycleBoost())
     {
-        items=sAuctionBotConfig.GetItemPerCycleBoost();
+        job.items = sAuctionBotConfig.GetItemPerCycleBoost();
         BASIC_FILTER_LOG(LOG_FILTER_AHBOT_BUYER, "AHBot: Boost value used to fill AH! (if this happens often adjust both ItemsPerCycle in ahbot.conf)");
     }
-    else items=sAuctionBotConfig.GetItemPerCycleNormal();
+    else
+        job.items = sAuctionBotConfig.GetItemPerCycleNormal();
 
-    uint32 houseid;
-    switch (config.GetHouseType())
+    for (uint32 j = 0; j < MAX_AUCTION_QUALITY; ++j)
     {
-        case AUCTION_HOUSE_ALLIANCE: houseid =  1; break;
-        case AUCTION_HOUSE_HORDE:    houseid =  6; break;
-        default:                     houseid =  7; break;
+        for (uint32 i = 0; i < MAX_ITEM_CLASS; ++i)
+            job.missItems[j][i] = config.GetMissedItemsPerClass(AuctionQuality(j), ItemClass(i));
+
+        job.priceRatio[j] = config.GetPriceRatioPerQuality(AuctionQuality(j));
     }
 
-    AuctionHouseEntry const* ahEntry = sAuctionHouseStore.LookupEntry(houseid);
+    job.minTime = config.GetMinTime();
+    job.maxTime = config.GetMaxTime();
+    job.buyPriceSeller = sAuctionBotConfig.getConfig(CONFIG_BOOL_AHBOT_BUYPRICE_SELLER);
 
-    AuctionHouseObject* auctionHouse = sAuctionMgr.GetAuctionsMap(config.GetHouseType());
+    m_housePlanning[job.houseType] = true;
+    m_jobs.add(job);
+}
+
+// Select items, stack sizes and prices of a seller cycle, called in the planning thread.
+void AuctionBotSeller::PlanNewAuctions(AuctionBotSellerJob const& job, AuctionBotPlannedAuctions& auctions) const
+{
+    uint32 items = job.items;
 
     RandomArray randArray;
     std::vector<std::vector<uint32> > ItemsAdded(MAX_AUCTION_QUALITY,std::vector<uint32> (MAX_ITEM_CLASS));
     // Main loop
     // getRandomArray will give what categories of items should be added (return true if there is at least 1 items missed)
-    while (getRandomArray(config,randArray, ItemsAdded) && (items>0))
+    while (getRandomArray(job, randArray, ItemsAdded) && (items>0))
     {
         --items;
 
@@ -1599,25 +1698,68 @@ void AuctionBotSeller::addNewAuctions(AHB_Seller_Config& config)
 
         uint32 stackCount = urand(1, prototype->GetMaxStackSize());
 
+        AuctionBotPlannedAuction auction;
+        auction.houseType = job.houseType;
+        auction.itemId = itemID;
+        auction.stackCount = stackCount;
+        auction.bidPrice = 0;
+
+        // Not sure if i will keep the next test
+        if (job.buyPriceSeller)
+            auction.buyoutPrice = prototype->BuyPrice * stackCount;
+        else
+            auction.buyoutPrice = prototype->SellPrice * stackCount;
+        // Price of items are set here
+        SetPricesOfItem(job, auction.buyoutPrice, auction.bidPrice, stackCount, ItemQualities(prototype->Quality));
 
-        Item* item = Item::CreateItem(itemID, stackCount);
+        auction.etime = urand(job.minTime, job.maxTime) * HOUR;
+        auctions.push_back(auction);
+    }
+}
+
+bool AuctionBotSeller::HasPlannedAuctions() const
+{
+    for (int i = 0; i < MAX_AUCTION_HOUSE_TYPE; ++i)
+        if (m_housePlanning[i])
+            return true;
+
+    return !m_applyQueue.empty();
+}
+
+// Post planned auctions, at most AuctionHouseBot.Seller.AuctionsPerTick per call
+void AuctionBotSeller::ApplyPlannedAuctions()
+{
+    AuctionBotSellerPlan plan;
+    while (m_plans.next(plan))
+    {
+        m_housePlanning[plan.houseType] = false;
+        m_houseQueued[plan.houseType] += plan.auctions.size();
+        m_applyQueue.insert(m_applyQueue.end(), plan.auctions.begin(), plan.auctions.end());
+    }
+
+    for (uint32 count = sAuctionBotConfig.getConfig(CONFIG_UINT32_AHBOT_SELLER_AUCTIONS_PER_TICK); count && !m_applyQueue.empty(); --count)
+    {
+        AuctionBotPlannedAuction auction = m_applyQueue.front();
+        m_applyQueue.pop_front();
+        --m_houseQueued[auction.houseType];
+
+        Item* item = Item::CreateItem(auction.itemId, auction.stackCount);
         if (!item)
         {
-            sLog.outError("AHBot: Item::CreateItem() returned NULL for item %u (stack: %u)", itemID, stackCount);
-            return;
+            sLog.outError("AHBot: Item::CreateItem() returned NULL for item %u (stack: %u)", auction.itemId, auction.stackCount);
+            continue;
         }
 
-        uint32 buyoutPrice;
-        uint32 bidPrice = 0;
-        // Not sure if i will keep the next test
-        if (sAuctionBotConfig.getConfig(CONFIG_BOOL_AHBOT_BUYPRICE_SELLER))
-            buyoutPrice  = prototype->BuyPrice * item->GetCount();
-        else
-            buyoutPrice  = prototype->SellPrice * item->GetCount();
-        // Price of items are set here
-        SetPricesOfItem(prototype, config, buyoutPrice, bidPrice, stackCount, ItemQualities(prototype->Quality));
+        uint32 houseid;
+        switch (auction.houseType)
+        {
+            case AUCTION_HOUSE_ALLIANCE: houseid =  1; break;
+            case AUCTION_HOUSE_HORDE:    houseid =  6; break;
+            default:                     houseid =  7; break;
+        }
 
-        auctionHouse->AddAuction(ahEntry, item, urand(config.GetMinTime(), config.GetMaxTime()) * HOUR, bidPrice, buyoutPrice);
+        AuctionHouseEntry const* ahEntry = sAuctionHouseStore.LookupEntry(houseid);
+        sAuctionMgr.GetAuctionsMap(auction.houseType)->AddAuction(ahEntry, item, auction.etime, auction.bidPrice, auction.buyoutPrice);
     }
 }
 
@@ -1625,6 +1767,10 @@ bool AuctionBotSeller::Update(AuctionHouseType houseType)
 {
     if (sAuctionBotConfig.getConfigItemAmountRatio(houseType) > 0)
     {
+        // previous cycle still planned or posted, its auctions would be counted as missed again
+        if (m_housePlanning[houseType] || m_houseQueued[houseType])
+            return true;
+
         DEBUG_FILTER_LOG(LOG_FILTER_AHBOT_SELLER, "AHBot: %s selling ...", AuctionBotConfig::GetHouseTypeName(houseType));
         if (SetStat(m_HouseConfig[houseType]))
             addNewAuctions(m_HouseConfig[houseType]);
@@ -1634,6 +1780,23 @@ bool AuctionBotSeller::Update(AuctionHouseType houseType)
         return false;
 }
 
+void AuctionBotPlannerRunnable::run()
+{
+    while (!m_seller->m_stopPlanner)
+    {
+        AuctionBotSellerJob job;
+        while (m_seller->m_jobs.next(job))
+        {
+            AuctionBotSellerPlan plan;
+            plan.houseType = job.houseType;
+            m_seller->PlanNewAuctions(job, plan.auctions);
+            m_seller->m_plans.add(plan);
+        }
+
+        ACE_Based::Thread::Sleep(AHBOT_PLANNER_SLEEP);
+    }
+}
+
 //== AuctionHouseBot functions =============================
 
 AuctionHouseBot::AuctionHouseBot() : m_Buyer(NULL), m_Seller(NULL), m_OperationSelector(0)
@@ -1700,6 +1863,26 @@ void AuctionHouseBot::SetItemsAmountForQuality(AuctionQuality quality, uint32 va
         seller->SetItemsAmountForQuality(quality, val);
 }
 
+bool AuctionHouseBot::HasPlannedAuctions() const
+{
+    if (AuctionBotSeller* seller = dynamic_cast<AuctionBotSeller*>(m_Seller))
+        return seller->HasPlannedAuctions();
+
+    return false;
+}
+
+void AuctionHouseBot::ApplyPlannedAuctions()
+{
+    if (AuctionBotSeller* seller = dynamic_cast<AuctionBotSeller*>(m_Seller))
+        seller->ApplyPlannedAuctions();
+}
+
+void AuctionHouseBot::StopPlanningThread()
+{
+    if (AuctionBotSeller* seller = dynamic_cast<AuctionBotSeller*>(m_Seller))
+        seller->StopPlanningThread();
+}
+
 bool AuctionHouseBot::ReloadAllConfig()
 {
     if (!sAuctionBotConfig.Reload())
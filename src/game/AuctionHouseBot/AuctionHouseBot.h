@@ -27,6 +27,7 @@ enum AuctionBotConfigUInt32Values
     CONFIG_UINT32_AHBOT_MINTIME,
     CONFIG_UINT32_AHBOT_ITEMS_PER_CYCLE_BOOST,
     CONFIG_UINT32_AHBOT_ITEMS_PER_CYCLE_NORMAL,
+    CONFIG_UINT32_AHBOT_SELLER_AUCTIONS_PER_TICK,
     CONFIG_UINT32_AHBOT_ALLIANCE_ITEM_AMOUNT_RATIO,
     CONFIG_UINT32_AHBOT_HORDE_ITEM_AMOUNT_RATIO,
     CONFIG_UINT32_AHBOT_NEUTRAL_ITEM_AMOUNT_RATIO,
@@ -192,6 +193,11 @@ class AuctionHouseBot
         void Rebuild(bool all);
 
         void PrepareStatusInfos(AuctionHouseBotStatusInfo& statusInfo);
+
+        // seller cycles are planned in a background thread, the planned auctions are posted by the world thread
+        bool HasPlannedAuctions() const;
+        void ApplyPlannedAuctions();
+        void StopPlanningThread();
     private:
         void InitilizeAgents();
 
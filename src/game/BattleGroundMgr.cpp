@@ -64,6 +64,10 @@ BattleGroundQueue::BattleGroundQueue()
                 m_WaitTimes[i][j][k] = 0;
         }
     }
+
+    for(uint32 i = 0; i < MAX_BATTLEGROUND_BRACKETS; ++i)
+        for(uint32 j = 0; j < BG_QUEUE_GROUP_TYPES_COUNT; ++j)
+            m_WaitingPlayers[i][j] = 0;
 }
 
 BattleGroundQueue::~BattleGroundQueue()
@@ -143,6 +147,95 @@ bool BattleGroundQueue::SelectionPool::AddGroup(GroupQueueInfo *ginfo, uint32 de
     return false;
 }
 
+/*********************************************************/
+/***               BATTLEGROUND QUEUE LISTS            ***/
+/*********************************************************/
+
+// add group to queue list index of its bracket, rated teams waiting for a match also go to their rating bucket
+void BattleGroundQueue::InsertGroup(GroupQueueInfo* ginfo, uint32 index, bool front)
+{
+    GroupsQueueType& queue = m_QueuedGroups[ginfo->BracketId][index];
+    ginfo->QueueIndex = index;
+    ginfo->QueuePos = front ? queue.insert(queue.begin(), ginfo) : queue.insert(queue.end(), ginfo);
+
+    if (ginfo->IsInvitedToBGInstanceGUID)
+        return;
+
+    m_WaitingPlayers[ginfo->BracketId][index] += ginfo->Players.size();
+
+    // rated teams are always in premade lists, index is the team index then
+    if (ginfo->IsRated && index < BG_QUEUE_NORMAL_ALLIANCE)
+    {
+        GroupsQueueType& bucket = m_RatedGroups[ginfo->BracketId][index][ginfo->ArenaTeamRating / BG_QUEUE_RATING_BUCKET_SIZE];
+        ginfo->RatingPos = bucket.insert(bucket.end(), ginfo);
+        ginfo->InRatingBucket = true;
+    }
+}
+
+// remove group from its queue list and rating bucket, group is not deleted
+void BattleGroundQueue::EraseGroup(GroupQueueInfo* ginfo)
+{
+    m_QueuedGroups[ginfo->BracketId][ginfo->QueueIndex].erase(ginfo->QueuePos);
+
+    if (!ginfo->IsInvitedToBGInstanceGUID)
+        m_WaitingPlayers[ginfo->BracketId][ginfo->QueueIndex] -= ginfo->Players.size();
+
+    EraseRatedGroup(ginfo);
+}
+
+void BattleGroundQueue::EraseRatedGroup(GroupQueueInfo* ginfo)
+{
+    if (!ginfo->InRatingBucket)
+        return;
+
+    RatingBucketMap& buckets = m_RatedGroups[ginfo->BracketId][ginfo->QueueIndex];
+    RatingBucketMap::iterator bItr = buckets.find(ginfo->ArenaTeamRating / BG_QUEUE_RATING_BUCKET_SIZE);
+    bItr->second.erase(ginfo->RatingPos);
+    if (bItr->second.empty())
+        buckets.erase(bItr);
+    ginfo->InRatingBucket = false;
+}
+
+void BattleGroundQueue::MoveGroup(GroupQueueInfo* ginfo, uint32 index, bool front)
+{
+    EraseGroup(ginfo);
+    InsertGroup(ginfo, index, front);
+}
+
+// select the rated team that joined first and is in rating range or waits longer than rating discard time
+GroupQueueInfo* BattleGroundQueue::SelectRatedGroup(BattleGroundBracketId bracket_id, uint32 teamIndex, uint32 minRating, uint32 maxRating, uint32 discardTime, GroupQueueInfo const* exclude)
+{
+    // the oldest waiting team is the only one that can be past the discard time
+    for (GroupsQueueType::const_iterator itr = m_QueuedGroups[bracket_id][teamIndex].begin(); itr != m_QueuedGroups[bracket_id][teamIndex].end(); ++itr)
+    {
+        if ((*itr)->IsInvitedToBGInstanceGUID || (*itr) == exclude)
+            continue;
+
+        if ((*itr)->JoinTime < discardTime)
+            return *itr;
+        break;
+    }
+
+    // otherwise the oldest team in rating range, which is the first in range of one of the covered buckets
+    GroupQueueInfo* selected = NULL;
+    RatingBucketMap& buckets = m_RatedGroups[bracket_id][teamIndex];
+    for (RatingBucketMap::const_iterator bItr = buckets.lower_bound(minRating / BG_QUEUE_RATING_BUCKET_SIZE); bItr != buckets.end() && bItr->first <= maxRating / BG_QUEUE_RATING_BUCKET_SIZE; ++bItr)
+    {
+        for (GroupsQueueType::const_iterator itr = bItr->second.begin(); itr != bItr->second.end(); ++itr)
+        {
+            // only the buckets at the range borders can hold teams out of range
+            if ((*itr) == exclude || (*itr)->ArenaTeamRating < minRating || (*itr)->ArenaTeamRating > maxRating)
+                continue;
+
+            if (!selected || (*itr)->JoinTime < selected->JoinTime)
+                selected = *itr;
+            break;
+        }
+    }
+
+    return selected;
+}
+
 /*********************************************************/
 /***               BATTLEGROUND QUEUES                 ***/
 /*********************************************************/
@@ -164,6 +257,9 @@ GroupQueueInfo * BattleGroundQueue::AddGroup(Player *leader, Group* grp, BattleG
     ginfo->GroupTeam                 = leader->GetTeam();
     ginfo->ArenaTeamRating           = arenaRating;
     ginfo->OpponentsTeamRating       = 0;
+    ginfo->BracketId                 = bracketId;
+    ginfo->QueueIndex                = 0;
+    ginfo->InRatingBucket            = false;
 
     ginfo->Players.clear();
 
@@ -211,7 +307,7 @@ GroupQueueInfo * BattleGroundQueue::AddGroup(Player *leader, Group* grp, BattleG
         }
 
         //add GroupInfo to m_QueuedGroups
-        m_QueuedGroups[bracketId][index].push_back(ginfo);
+        InsertGroup(ginfo, index, false);
 
         //announce to world, this code needs mutex
         if (arenaType == ARENA_TYPE_NONE && !isRated && !isPremade && sWorld.getConfig(CONFIG_UINT32_BATTLEGROUND_QUEUE_ANNOUNCER_JOIN))
@@ -220,17 +316,10 @@ GroupQueueInfo * BattleGroundQueue::AddGroup(Player *leader, Group* grp, BattleG
             {
                 char const* bgName = bg->GetName();
                 uint32 MinPlayers = bg->GetMinPlayersPerTeam();
-                uint32 qHorde = 0;
-                uint32 qAlliance = 0;
+                uint32 qHorde = m_WaitingPlayers[bracketId][BG_QUEUE_NORMAL_HORDE];
+                uint32 qAlliance = m_WaitingPlayers[bracketId][BG_QUEUE_NORMAL_ALLIANCE];
                 uint32 q_min_level = bracketEntry->minLevel;
                 uint32 q_max_level = bracketEntry->maxLevel;
-                GroupsQueueType::const_iterator itr;
-                for(itr = m_QueuedGroups[bracketId][BG_QUEUE_NORMAL_ALLIANCE].begin(); itr != m_QueuedGroups[bracketId][BG_QUEUE_NORMAL_ALLIANCE].end(); ++itr)
-                    if (!(*itr)->IsInvitedToBGInstanceGUID)
-                        qAlliance += (*itr)->Players.size();
-                for(itr = m_QueuedGroups[bracketId][BG_QUEUE_NORMAL_HORDE].begin(); itr != m_QueuedGroups[bracketId][BG_QUEUE_NORMAL_HORDE].end(); ++itr)
-                    if (!(*itr)->IsInvitedToBGInstanceGUID)
-                        qHorde += (*itr)->Players.size();
 
                 // Show queue status to player only (when joining queue)
                 if (sWorld.getConfig(CONFIG_UINT32_BATTLEGROUND_QUEUE_ANNOUNCER_JOIN)==1)
@@ -307,7 +396,6 @@ void BattleGroundQueue::RemovePlayer(ObjectGuid guid, bool decreaseInvitedCount)
     //Player *plr = sObjectMgr.GetPlayer(guid);
     //ACE_Guard<ACE_Recursive_Thread_Mutex> guard(m_Lock);
 
-    int32 bracket_id = -1;                                     // signed for proper for-loop finish
     QueuedPlayersMap::iterator itr;
 
     //remove player from map, if he's there
@@ -319,38 +407,8 @@ void BattleGroundQueue::RemovePlayer(ObjectGuid guid, bool decreaseInvitedCount)
     }
 
     GroupQueueInfo* group = itr->second.GroupInfo;
-    GroupsQueueType::iterator group_itr, group_itr_tmp;
-    // mostly people with the highest levels are in battlegrounds, thats why
-    // we count from MAX_BATTLEGROUND_QUEUES - 1 to 0
-    // variable index removes useless searching in other team's queue
-    uint32 index = BattleGround::GetTeamIndexByTeamId(group->GroupTeam);
 
-    for (int32 bracket_id_tmp = MAX_BATTLEGROUND_BRACKETS - 1; bracket_id_tmp >= 0 && bracket_id == -1; --bracket_id_tmp)
-    {
-        //we must check premade and normal team's queue - because when players from premade are joining bg,
-        //they leave groupinfo so we can't use its players size to find out index
-        for (uint32 j = index; j < BG_QUEUE_GROUP_TYPES_COUNT; j += BG_QUEUE_NORMAL_ALLIANCE)
-        {
-            for(group_itr_tmp = m_QueuedGroups[bracket_id_tmp][j].begin(); group_itr_tmp != m_QueuedGroups[bracket_id_tmp][j].end(); ++group_itr_tmp)
-            {
-                if ((*group_itr_tmp) == group)
-                {
-                    bracket_id = bracket_id_tmp;
-                    group_itr = group_itr_tmp;
-                    //we must store index to be able to erase iterator
-                    index = j;
-                    break;
-                }
-            }
-        }
-    }
-    //player can't be in queue without group, but just in case
-    if (bracket_id == -1)
-    {
-        sLog.outError("BattleGroundQueue: ERROR Cannot find groupinfo for %s", guid.GetString().c_str());
-        return;
-    }
-    DEBUG_LOG("BattleGroundQueue: Removing %s, from bracket_id %u", guid.GetString().c_str(), (uint32)bracket_id);
+    DEBUG_LOG("BattleGroundQueue: Removing %s, from bracket_id %u", guid.GetString().c_str(), (uint32)group->BracketId);
 
     // ALL variables are correctly set
     // We can ignore leveling up in queue - it should not cause crash
@@ -360,7 +418,11 @@ void BattleGroundQueue::RemovePlayer(ObjectGuid guid, bool decreaseInvitedCount)
     // remove player queue info from group queue info
     GroupQueueInfoPlayers::iterator pitr = group->Players.find(guid);
     if (pitr != group->Players.end())
+    {
         group->Players.erase(pitr);
+        if (!group->IsInvitedToBGInstanceGUID)
+            --m_WaitingPlayers[group->BracketId][group->QueueIndex];
+    }
 
     // if invited to bg, and should decrease invited count, then do it
     if (decreaseInvitedCount && group->IsInvitedToBGInstanceGUID)
@@ -396,7 +458,7 @@ void BattleGroundQueue::RemovePlayer(ObjectGuid guid, bool decreaseInvitedCount)
     // remove group queue info if needed
     if (group->Players.empty())
     {
-        m_QueuedGroups[bracket_id][index].erase(group_itr);
+        EraseGroup(group);
         delete group;
     }
     // if group wasn't empty, so it wasn't deleted, and player have left a rated
@@ -451,6 +513,10 @@ bool BattleGroundQueue::InviteGroupToBG(GroupQueueInfo * ginfo, BattleGround * b
     if (!ginfo->IsInvitedToBGInstanceGUID)
     {
         // not yet invited
+        // invited groups are no longer candidates for other matches
+        m_WaitingPlayers[ginfo->BracketId][ginfo->QueueIndex] -= ginfo->Players.size();
+        EraseRatedGroup(ginfo);
+
         // set invitation
         ginfo->IsInvitedToBGInstanceGUID = bg->GetInstanceID();
         BattleGroundTypeId bgTypeId = bg->GetTypeID();
@@ -632,12 +698,11 @@ bool BattleGroundQueue::CheckPremadeMatch(BattleGroundBracketId bracket_id, uint
     {
         if (!m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE + i].empty())
         {
-            GroupsQueueType::iterator itr = m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE + i].begin();
-            if (!(*itr)->IsInvitedToBGInstanceGUID && ((*itr)->JoinTime < time_before || (*itr)->Players.size() < MinPlayersPerTeam))
+            GroupQueueInfo* ginfo = m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE + i].front();
+            if (!ginfo->IsInvitedToBGInstanceGUID && (ginfo->JoinTime < time_before || ginfo->Players.size() < MinPlayersPerTeam))
             {
                 //we must insert group to normal queue and erase pointer from premade queue
-                m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_ALLIANCE + i].push_front((*itr));
-                m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE + i].erase(itr);
+                MoveGroup(ginfo, BG_QUEUE_NORMAL_ALLIANCE + i, true);
             }
         }
     }
@@ -652,6 +717,9 @@ bool BattleGroundQueue::CheckNormalMatch(BattleGround* bg_template, BattleGround
     for(uint32 i = 0; i < BG_TEAMS_COUNT; i++)
     {
         itr_team[i] = m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_ALLIANCE + i].begin();
+        // a side without enough waiting players can't reach minPlayers, don't walk its whole list
+        if (!sBattleGroundMgr.isTesting() && m_WaitingPlayers[bracket_id][BG_QUEUE_NORMAL_ALLIANCE + i] < minPlayers)
+            continue;
         for(; itr_team[i] != m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_ALLIANCE + i].end(); ++(itr_team[i]))
         {
             if (!(*(itr_team[i]))->IsInvitedToBGInstanceGUID)
@@ -706,14 +774,8 @@ bool BattleGroundQueue::CheckSkirmishForSameFaction(BattleGroundBracketId bracke
     m_SelectionPools[otherTeamIdx].Init();
     //store last ginfo pointer
     GroupQueueInfo* ginfo = m_SelectionPools[teamIdx].SelectedGroups.back();
-    //set itr_team to group that was added to selection pool latest
-    GroupsQueueType::iterator itr_team = m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_ALLIANCE + teamIdx].begin();
-    for(; itr_team != m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_ALLIANCE + teamIdx].end(); ++itr_team)
-        if (ginfo == *itr_team)
-            break;
-    if (itr_team == m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_ALLIANCE + teamIdx].end())
-        return false;
-    GroupsQueueType::iterator itr_team2 = itr_team;
+    //start right after the group that was added to selection pool latest
+    GroupsQueueType::iterator itr_team2 = ginfo->QueuePos;
     ++itr_team2;
     //invite players to other selection pool
     for(; itr_team2 != m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_ALLIANCE + teamIdx].end(); ++itr_team2)
@@ -730,19 +792,8 @@ bool BattleGroundQueue::CheckSkirmishForSameFaction(BattleGroundBracketId bracke
     {
         //set correct team
         (*itr)->GroupTeam = otherTeamId;
-        //add team to other queue
-        m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_ALLIANCE + otherTeamIdx].push_front(*itr);
-        //remove team from old queue
-        GroupsQueueType::iterator itr2 = itr_team;
-        ++itr2;
-        for(; itr2 != m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_ALLIANCE + teamIdx].end(); ++itr2)
-        {
-            if (*itr2 == *itr)
-            {
-                m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_ALLIANCE + teamIdx].erase(itr2);
-                break;
-            }
-        }
+        //move team to other queue
+        MoveGroup(*itr, BG_QUEUE_NORMAL_ALLIANCE + otherTeamIdx, true);
     }
     return true;
 }
@@ -755,11 +806,11 @@ should be called from BattleGround::RemovePlayer function in some cases
 void BattleGroundQueue::Update(BattleGroundTypeId bgTypeId, BattleGroundBracketId bracket_id, ArenaType arenaType, bool isRated, uint32 arenaRating)
 {
     //ACE_Guard<ACE_Recursive_Thread_Mutex> guard(m_Lock);
-    //if no players in queue - do nothing
-    if( m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE].empty() &&
-        m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_HORDE].empty() &&
-        m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_ALLIANCE].empty() &&
-        m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_HORDE].empty() )
+    //if no players wait for invitation - do nothing
+    if( !m_WaitingPlayers[bracket_id][BG_QUEUE_PREMADE_ALLIANCE] &&
+        !m_WaitingPlayers[bracket_id][BG_QUEUE_PREMADE_HORDE] &&
+        !m_WaitingPlayers[bracket_id][BG_QUEUE_NORMAL_ALLIANCE] &&
+        !m_WaitingPlayers[bracket_id][BG_QUEUE_NORMAL_HORDE] )
         return;
 
     //battleground with free slot for player should be always in the beggining of the queue
@@ -936,66 +987,20 @@ void BattleGroundQueue::Update(BattleGroundTypeId bgTypeId, BattleGroundBracketI
         uint32 discardTime = WorldTimer::getMSTime() - sBattleGroundMgr.GetRatingDiscardTimer();
 
         // we need to find 2 teams which will play next game
+        // each side only looks at the rating buckets covering the allowed range, not at the whole queue
+        GroupQueueInfo* selected[BG_TEAMS_COUNT];
+        for(uint32 i = BG_TEAM_ALLIANCE; i < BG_TEAMS_COUNT; i++)
+            selected[i] = SelectRatedGroup(bracket_id, i, arenaMinRating, arenaMaxRating, discardTime, NULL);
 
-        GroupsQueueType::iterator itr_team[BG_TEAMS_COUNT];
-
-        //optimalization : --- we dont need to use selection_pools - each update we select max 2 groups
-
-        for(uint32 i = BG_QUEUE_PREMADE_ALLIANCE; i < BG_QUEUE_NORMAL_ALLIANCE; i++)
-        {
-            // take the group that joined first
-            itr_team[i] = m_QueuedGroups[bracket_id][i].begin();
-            for(; itr_team[i] != m_QueuedGroups[bracket_id][i].end(); ++(itr_team[i]))
-            {
-                // if group match conditions, then add it to pool
-                if( !(*itr_team[i])->IsInvitedToBGInstanceGUID
-                    && (((*itr_team[i])->ArenaTeamRating >= arenaMinRating && (*itr_team[i])->ArenaTeamRating <= arenaMaxRating)
-                        || (*itr_team[i])->JoinTime < discardTime) )
-                {
-                    m_SelectionPools[i].AddGroup((*itr_team[i]), MaxPlayersPerTeam);
-                    // break for cycle to be able to start selecting another group from same faction queue
-                    break;
-                }
-            }
-        }
         // now we are done if we have 2 groups - ali vs horde!
         // if we don't have, we must try to continue search in same queue
-        // tmp variables are correctly set
-        // this code isn't much userfriendly - but it is supposed to continue search for mathing group in HORDE queue
-        if (m_SelectionPools[BG_TEAM_ALLIANCE].GetPlayerCount() == 0 && m_SelectionPools[BG_TEAM_HORDE].GetPlayerCount())
-        {
-            itr_team[BG_TEAM_ALLIANCE] = itr_team[BG_TEAM_HORDE];
-            ++itr_team[BG_TEAM_ALLIANCE];
-            for(; itr_team[BG_TEAM_ALLIANCE] != m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_HORDE].end(); ++(itr_team[BG_TEAM_ALLIANCE]))
-            {
-                if( !(*itr_team[BG_TEAM_ALLIANCE])->IsInvitedToBGInstanceGUID
-                    && (((*itr_team[BG_TEAM_ALLIANCE])->ArenaTeamRating >= arenaMinRating && (*itr_team[BG_TEAM_ALLIANCE])->ArenaTeamRating <= arenaMaxRating)
-                        || (*itr_team[BG_TEAM_ALLIANCE])->JoinTime < discardTime) )
-                {
-                    m_SelectionPools[BG_TEAM_ALLIANCE].AddGroup((*itr_team[BG_TEAM_ALLIANCE]), MaxPlayersPerTeam);
-                    break;
-                }
-            }
-        }
-        // this code isn't much userfriendly - but it is supposed to continue search for mathing group in ALLIANCE queue
-        if (m_SelectionPools[BG_TEAM_HORDE].GetPlayerCount() == 0 && m_SelectionPools[BG_TEAM_ALLIANCE].GetPlayerCount())
-        {
-            itr_team[BG_TEAM_HORDE] = itr_team[BG_TEAM_ALLIANCE];
-            ++itr_team[BG_TEAM_HORDE];
-            for(; itr_team[BG_TEAM_HORDE] != m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE].end(); ++(itr_team[BG_TEAM_HORDE]))
-            {
-                if( !(*itr_team[BG_TEAM_HORDE])->IsInvitedToBGInstanceGUID
-                    && (((*itr_team[BG_TEAM_HORDE])->ArenaTeamRating >= arenaMinRating && (*itr_team[BG_TEAM_HORDE])->ArenaTeamRating <= arenaMaxRating)
-                        || (*itr_team[BG_TEAM_HORDE])->JoinTime < discardTime) )
-                {
-                    m_SelectionPools[BG_TEAM_HORDE].AddGroup((*itr_team[BG_TEAM_HORDE]), MaxPlayersPerTeam);
-                    break;
-                }
-            }
-        }
+        if (!selected[BG_TEAM_ALLIANCE] && selected[BG_TEAM_HORDE])
+            selected[BG_TEAM_ALLIANCE] = SelectRatedGroup(bracket_id, BG_TEAM_HORDE, arenaMinRating, arenaMaxRating, discardTime, selected[BG_TEAM_HORDE]);
+        if (!selected[BG_TEAM_HORDE] && selected[BG_TEAM_ALLIANCE])
+            selected[BG_TEAM_HORDE] = SelectRatedGroup(bracket_id, BG_TEAM_ALLIANCE, arenaMinRating, arenaMaxRating, discardTime, selected[BG_TEAM_ALLIANCE]);
 
         //if we have 2 teams, then start new arena and invite players!
-        if (m_SelectionPools[BG_TEAM_ALLIANCE].GetPlayerCount() && m_SelectionPools[BG_TEAM_HORDE].GetPlayerCount())
+        if (selected[BG_TEAM_ALLIANCE] && selected[BG_TEAM_HORDE])
         {
             BattleGround* arena = sBattleGroundMgr.CreateNewBattleGround(bgTypeId, bracketEntry, arenaType, true);
             if (!arena)
@@ -1004,28 +1009,18 @@ void BattleGroundQueue::Update(BattleGroundTypeId bgTypeId, BattleGroundBracketI
                 return;
             }
 
-            (*(itr_team[BG_TEAM_ALLIANCE]))->OpponentsTeamRating = (*(itr_team[BG_TEAM_HORDE]))->ArenaTeamRating;
-            DEBUG_LOG("setting oposite teamrating for team %u to %u", (*(itr_team[BG_TEAM_ALLIANCE]))->ArenaTeamId, (*(itr_team[BG_TEAM_ALLIANCE]))->OpponentsTeamRating);
-            (*(itr_team[BG_TEAM_HORDE]))->OpponentsTeamRating = (*(itr_team[BG_TEAM_ALLIANCE]))->ArenaTeamRating;
-            DEBUG_LOG("setting oposite teamrating for team %u to %u", (*(itr_team[BG_TEAM_HORDE]))->ArenaTeamId, (*(itr_team[BG_TEAM_HORDE]))->OpponentsTeamRating);
+            selected[BG_TEAM_ALLIANCE]->OpponentsTeamRating = selected[BG_TEAM_HORDE]->ArenaTeamRating;
+            DEBUG_LOG("setting oposite teamrating for team %u to %u", selected[BG_TEAM_ALLIANCE]->ArenaTeamId, selected[BG_TEAM_ALLIANCE]->OpponentsTeamRating);
+            selected[BG_TEAM_HORDE]->OpponentsTeamRating = selected[BG_TEAM_ALLIANCE]->ArenaTeamRating;
+            DEBUG_LOG("setting oposite teamrating for team %u to %u", selected[BG_TEAM_HORDE]->ArenaTeamId, selected[BG_TEAM_HORDE]->OpponentsTeamRating);
             // now we must move team if we changed its faction to another faction queue, because then we will spam log by errors in Queue::RemovePlayer
-            if ((*(itr_team[BG_TEAM_ALLIANCE]))->GroupTeam != ALLIANCE)
-            {
-                // add to alliance queue
-                m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE].push_front(*(itr_team[BG_TEAM_ALLIANCE]));
-                // erase from horde queue
-                m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_HORDE].erase(itr_team[BG_TEAM_ALLIANCE]);
-                itr_team[BG_TEAM_ALLIANCE] = m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE].begin();
-            }
-            if ((*(itr_team[BG_TEAM_HORDE]))->GroupTeam != HORDE)
-            {
-                m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_HORDE].push_front(*(itr_team[BG_TEAM_HORDE]));
-                m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE].erase(itr_team[BG_TEAM_HORDE]);
-                itr_team[BG_TEAM_HORDE] = m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_HORDE].begin();
-            }
+            if (selected[BG_TEAM_ALLIANCE]->QueueIndex != BG_QUEUE_PREMADE_ALLIANCE)
+                MoveGroup(selected[BG_TEAM_ALLIANCE], BG_QUEUE_PREMADE_ALLIANCE, true);
+            if (selected[BG_TEAM_HORDE]->QueueIndex != BG_QUEUE_PREMADE_HORDE)
+                MoveGroup(selected[BG_TEAM_HORDE], BG_QUEUE_PREMADE_HORDE, true);
 
-            InviteGroupToBG(*(itr_team[BG_TEAM_ALLIANCE]), arena, ALLIANCE);
-            InviteGroupToBG(*(itr_team[BG_TEAM_HORDE]), arena, HORDE);
+            InviteGroupToBG(selected[BG_TEAM_ALLIANCE], arena, ALLIANCE);
+            InviteGroupToBG(selected[BG_TEAM_HORDE], arena, HORDE);
 
             DEBUG_LOG("Starting rated arena match!");
 
@@ -1156,20 +1151,23 @@ void BattleGroundMgr::DeleteAllBattleGrounds()
 // used to update running battlegrounds, and delete finished ones
 void BattleGroundMgr::Update(uint32 diff)
 {
-    // update scheduled queues
+    // update scheduled queues, at most BattleGround.QueueUpdatesPerTick per tick, the rest waits for next tick
     if (!m_QueueUpdateScheduler.empty())
     {
         std::vector<uint64> scheduled;
         {
             //create mutex
             //ACE_Guard<ACE_Thread_Mutex> guard(SchedulerLock);
-            //copy vector and clear the other
-            scheduled = std::vector<uint64>(m_QueueUpdateScheduler);
-            m_QueueUpdateScheduler.clear();
+            //move the oldest requests out of the scheduler
+            size_t count = m_QueueUpdateScheduler.size();
+            if (uint32 limit = sWorld.getConfig(CONFIG_UINT32_BATTLEGROUND_QUEUE_UPDATES_PER_TICK))
+                count = std::min(count, size_t(limit));
+            scheduled.assign(m_QueueUpdateScheduler.begin(), m_QueueUpdateScheduler.begin() + count);
+            m_QueueUpdateScheduler.erase(m_QueueUpdateScheduler.begin(), m_QueueUpdateScheduler.begin() + count);
             //release lock
         }
 
-        for (uint8 i = 0; i < scheduled.size(); i++)
+        for (size_t i = 0; i < scheduled.size(); i++)
         {
             uint32 arenaRating = scheduled[i] >> 32;
             ArenaType arenaType = ArenaType(scheduled[i] >> 24 & 255);
@@ -1985,7 +1983,7 @@ void BattleGroundMgr::ScheduleQueueUpdate(uint32 arenaRating, ArenaType arenaTyp
     //we will use only 1 number created of bgTypeId and bracket_id
     uint64 schedule_id = ((uint64)arenaRating << 32) | (arenaType << 24) | (bgQueueTypeId << 16) | (bgTypeId << 8) | bracket_id;
     bool found = false;
-    for (uint8 i = 0; i < m_QueueUpdateScheduler.size(); i++)
+    for (size_t i = 0; i < m_QueueUpdateScheduler.size(); i++)
     {
         if (m_QueueUpdateScheduler[i] == schedule_id)
         {
@@ -39,6 +39,7 @@ typedef UNORDERED_MAP<uint32, BattleGroundEventIdx> GameObjectBattleEventIndexes
 
 #define BATTLEGROUND_ARENA_POINT_DISTRIBUTION_DAY 86400     // seconds in a day
 #define COUNT_OF_PLAYERS_TO_AVERAGE_WAIT_TIME 10
+#define BG_QUEUE_RATING_BUCKET_SIZE 50                      // rating range covered by one rated arena queue bucket
 
 struct GroupQueueInfo;                                      // type predefinition
 struct PlayerQueueInfo                                      // stores information for players in queue
@@ -62,6 +63,13 @@ struct GroupQueueInfo                                       // stores informatio
     uint32  IsInvitedToBGInstanceGUID;                      // was invited to certain BG
     uint32  ArenaTeamRating;                                // if rated match, inited to the rating of the team
     uint32  OpponentsTeamRating;                            // for rated arena matches
+
+    // queue position, maintained by BattleGroundQueue
+    BattleGroundBracketId BracketId;                        // bracket the group is queued in
+    uint8   QueueIndex;                                     // BG_QUEUE_* list holding the group
+    std::list<GroupQueueInfo*>::iterator QueuePos;          // position in that list
+    std::list<GroupQueueInfo*>::iterator RatingPos;         // position in rating bucket, valid if InRatingBucket
+    bool    InRatingBucket;                                 // not yet invited rated team, selectable by rating
 };
 
 enum BattleGroundQueueGroupTypes
@@ -133,6 +141,21 @@ class BattleGroundQueue
         SelectionPool m_SelectionPools[BG_TEAMS_COUNT];
 
         bool InviteGroupToBG(GroupQueueInfo * ginfo, BattleGround * bg, Team side);
+
+        // queue list maintenance, keeps positions, waiting counters and rating buckets in sync
+        void InsertGroup(GroupQueueInfo* ginfo, uint32 index, bool front);
+        void EraseGroup(GroupQueueInfo* ginfo);
+        void MoveGroup(GroupQueueInfo* ginfo, uint32 index, bool front);
+        void EraseRatedGroup(GroupQueueInfo* ginfo);
+        GroupQueueInfo* SelectRatedGroup(BattleGroundBracketId bracket_id, uint32 teamIndex, uint32 minRating, uint32 maxRating, uint32 discardTime, GroupQueueInfo const* exclude);
+
+        // players in not yet invited groups, lets matching skip lists that can't form a team
+        uint32 m_WaitingPlayers[MAX_BATTLEGROUND_BRACKETS][BG_QUEUE_GROUP_TYPES_COUNT];
+
+        // not yet invited rated teams per bracket and side, keyed by rating / BG_QUEUE_RATING_BUCKET_SIZE, each bucket in join order
+        typedef std::map<uint32, GroupsQueueType> RatingBucketMap;
+        RatingBucketMap m_RatedGroups[MAX_BATTLEGROUND_BRACKETS][BG_TEAMS_COUNT];
+
         uint32 m_WaitTimes[BG_TEAMS_COUNT][MAX_BATTLEGROUND_BRACKETS][COUNT_OF_PLAYERS_TO_AVERAGE_WAIT_TIME];
         uint32 m_WaitTimeLastPlayer[BG_TEAMS_COUNT][MAX_BATTLEGROUND_BRACKETS];
         uint32 m_SumOfWaitTimes[BG_TEAMS_COUNT][MAX_BATTLEGROUND_BRACKETS];
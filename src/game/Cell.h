@@ -115,6 +115,8 @@ struct Cell
     template<class T> static void VisitGridObjects(const WorldObject *obj, T &visitor, float radius, bool dont_load = true);
     template<class T> static void VisitWorldObjects(const WorldObject *obj, T &visitor, float radius, bool dont_load = true);
     template<class T> static void VisitAllObjects(const WorldObject *obj, T &visitor, float radius, bool dont_load = true);
+    // unit searchers only, uses the unit index of the map if enabled
+    template<class T> static void VisitAllUnits(const WorldObject *obj, T &visitor, float radius, bool dont_load = true);
 
     template<class T> static void VisitGridObjects(float x, float y, Map *map, T &visitor, float radius, bool dont_load = true);
     template<class T> static void VisitWorldObjects(float x, float y, Map *map, T &visitor, float radius, bool dont_load = true);
@@ -229,6 +229,25 @@ inline void Cell::VisitWorldObjects(float x, float y, Map *map, T &visitor, floa
     cell.Visit(p ,gnotifier, *map, x, y, radius);
 }
 
+template<class T>
+inline void Cell::VisitAllUnits(const WorldObject *center_obj, T &visitor, float radius, bool dont_load)
+{
+    UnitSpatialIndex const& index = center_obj->GetMap()->GetUnitIndex();
+    if (!index.IsEnabled())
+    {
+        VisitAllObjects(center_obj, visitor, radius, dont_load);
+        return;
+    }
+
+    // range checks of the searchers add the bounding radius of the center object too
+    UnitSpatialIndex::UnitVector units;
+    index.FindInRadius(center_obj->GetPositionX(), center_obj->GetPositionY(), center_obj->GetPositionZ(),
+        radius + center_obj->GetObjectBoundingRadius(), visitor.i_phaseMask, false, units);
+
+    for (UnitSpatialIndex::UnitVector::const_iterator itr = units.begin(); itr != units.end(); ++itr)
+        visitor.VisitUnit(*itr);
+}
+
 template<class T>
 inline void Cell::VisitAllObjects(float x, float y, Map *map, T &visitor, float radius, bool dont_load)
 {
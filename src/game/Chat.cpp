@@ -245,6 +245,7 @@ ChatCommand * ChatHandler::getCommandTable()
         { "getitemvalue",   SEC_ADMINISTRATOR,  false, &ChatHandler::HandleDebugGetItemValueCommand,        "", NULL },
         { "getvalue",       SEC_ADMINISTRATOR,  false, &ChatHandler::HandleDebugGetValueCommand,            "", NULL },
         { "moditemvalue",   SEC_ADMINISTRATOR,  false, &ChatHandler::HandleDebugModItemValueCommand,        "", NULL },
+        { "movecodec",      SEC_ADMINISTRATOR,  false, &ChatHandler::HandleDebugMoveCodecCommand,           "", NULL },
         { "modvalue",       SEC_ADMINISTRATOR,  false, &ChatHandler::HandleDebugModValueCommand,            "", NULL },
         { "play",           SEC_MODERATOR,      false, NULL,                                                "", debugPlayCommandTable },
         { "send",           SEC_ADMINISTRATOR,  false, NULL,                                                "", debugSendCommandTable },
@@ -333,6 +334,12 @@ ChatCommand * ChatHandler::getCommandTable()
         { NULL,             0,                  false, NULL,                                           "", NULL }
     };
 
+    static ChatCommand lfgCommandTable[] =
+    {
+        { "stats",          SEC_ADMINISTRATOR,  true,  &ChatHandler::HandleLfgStatsCommand,            "", NULL },
+        { NULL,             0,                  false, NULL,                                           "", NULL }
+    };
+
     static ChatCommand learnCommandTable[] =
     {
         { "all",            SEC_ADMINISTRATOR,  false, &ChatHandler::HandleLearnAllCommand,            "", NULL },
@@ -482,6 +489,23 @@ ChatCommand * ChatHandler::getCommandTable()
         { NULL,             0,                  false, NULL,                                           "", NULL }
     };
 
+    static ChatCommand perfCommandTable[] =
+    {
+        { "grid",           SEC_ADMINISTRATOR,  false, &ChatHandler::HandlePerfGridCommand,            "", NULL },
+        { "gridbench",      SEC_ADMINISTRATOR,  true,  &ChatHandler::HandlePerfGridBenchCommand,       "", NULL },
+        { "maps",           SEC_ADMINISTRATOR,  true,  &ChatHandler::HandlePerfMapsCommand,            "", NULL },
+        { "memory",         SEC_ADMINISTRATOR,  true,  &ChatHandler::HandlePerfMemoryCommand,          "", NULL },
+        { "opcodes",        SEC_ADMINISTRATOR,  true,  &ChatHandler::HandlePerfOpcodesCommand,         "", NULL },
+        { "pool",           SEC_ADMINISTRATOR,  true,  &ChatHandler::HandlePerfPoolCommand,            "", NULL },
+        { "reset",          SEC_ADMINISTRATOR,  true,  &ChatHandler::HandlePerfResetCommand,           "", NULL },
+        { "sessions",       SEC_ADMINISTRATOR,  true,  &ChatHandler::HandlePerfSessionsCommand,        "", NULL },
+        { "sleep",          SEC_ADMINISTRATOR,  true,  &ChatHandler::HandlePerfSleepCommand,           "", NULL },
+        { "splines",        SEC_ADMINISTRATOR,  true,  &ChatHandler::HandlePerfSplinesCommand,         "", NULL },
+        { "stats",          SEC_ADMINISTRATOR,  true,  &ChatHandler::HandlePerfStatsCommand,           "", NULL },
+        { "tick",           SEC_ADMINISTRATOR,  true,  &ChatHandler::HandlePerfTickCommand,            "", NULL },
+        { NULL,             0,                  false, NULL,                                           "", NULL }
+    };
+
     static ChatCommand poolCommandTable[] =
     {
         { "list",           SEC_GAMEMASTER,     false, &ChatHandler::HandlePoolListCommand,            "", NULL },
@@ -748,10 +772,12 @@ ChatCommand * ChatHandler::getCommandTable()
         { "guild",          SEC_GAMEMASTER,     true,  NULL,                                           "", guildCommandTable    },
         { "instance",       SEC_ADMINISTRATOR,  true,  NULL,                                           "", instanceCommandTable },
         { "learn",          SEC_MODERATOR,      false, NULL,                                           "", learnCommandTable    },
+        { "lfg",            SEC_ADMINISTRATOR,  true,  NULL,                                           "", lfgCommandTable      },
         { "list",           SEC_ADMINISTRATOR,  true,  NULL,                                           "", listCommandTable     },
         { "lookup",         SEC_MODERATOR,      true,  NULL,                                           "", lookupCommandTable   },
         { "modify",         SEC_MODERATOR,      false, NULL,                                           "", modifyCommandTable   },
         { "npc",            SEC_MODERATOR,      false, NULL,                                           "", npcCommandTable      },
+        { "perf",           SEC_ADMINISTRATOR,  true,  NULL,                                           "", perfCommandTable     },
         { "pool",           SEC_GAMEMASTER,     true,  NULL,                                           "", poolCommandTable     },
         { "pdump",          SEC_ADMINISTRATOR,  true,  NULL,                                           "", pdumpCommandTable    },
         { "quest",          SEC_ADMINISTRATOR,  false, NULL,                                           "", questCommandTable    },
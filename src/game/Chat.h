@@ -205,6 +205,7 @@ class ChatHandler
         bool HandleDebugGetValueCommand(char* args);
         bool HandleDebugModItemValueCommand(char* args);
         bool HandleDebugModValueCommand(char* args);
+        bool HandleDebugMoveCodecCommand(char* args);
         bool HandleDebugSetAuraStateCommand(char* args);
         bool HandleDebugSetItemValueCommand(char* args);
         bool HandleDebugSetValueCommand(char* args);
@@ -276,6 +277,8 @@ class ChatHandler
         bool HandleInstanceStatsCommand(char* args);
         bool HandleInstanceSaveDataCommand(char* args);
 
+        bool HandleLfgStatsCommand(char* args);
+
         bool HandleLearnCommand(char* args);
         bool HandleLearnAllCommand(char* args);
         bool HandleLearnAllGMCommand(char* args);
@@ -375,6 +378,20 @@ class ChatHandler
         bool HandlePDumpLoadCommand(char* args);
         bool HandlePDumpWriteCommand(char* args);
 
+        bool HandlePerfGridCommand(char* args);
+        bool HandlePerfGridBenchCommand(char* args);
+        bool HandlePerfMapsCommand(char* args);
+        bool HandlePerfMemoryCommand(char* args);
+        bool HandlePerfOpcodesCommand(char* args);
+        bool HandlePerfPoolCommand(char* args);
+        bool HandlePerfResetCommand(char* args);
+        bool HandlePerfSessionsCommand(char* args);
+        bool HandlePerfSleepCommand(char* args);
+        bool HandlePerfSplinesCommand(char* args);
+        uint32 ExtractPerfSortKey(char** args);
+        bool HandlePerfStatsCommand(char* args);
+        bool HandlePerfTickCommand(char* args);
+
         bool HandlePoolListCommand(char* args);
         bool HandlePoolSpawnsCommand(char* args);
         bool HandlePoolInfoCommand(char* args);
@@ -35,6 +35,7 @@
 #include "MapManager.h"
 #include "CreatureAI.h"
 #include "CreatureAISelector.h"
+#include "NullCreatureAI.h"
 #include "Formulas.h"
 #include "WaypointMovementGenerator.h"
 #include "InstanceData.h"
@@ -46,6 +47,7 @@
 #include "GridNotifiersImpl.h"
 #include "CellImpl.h"
 #include "movement/MoveSplineInit.h"
+#include "movement/MoveSpline.h"
 #include "CreatureLinkingMgr.h"
 
 // apply implementation of the singletons
@@ -197,6 +199,8 @@ void Creature::AddToWorld()
 
     Unit::AddToWorld();
 
+    WakeUp();
+
     if (GetVehicleKit())
         GetVehicleKit()->Reset();
 }
@@ -462,6 +466,9 @@ uint32 Creature::ChooseDisplayId(const CreatureInfo *cinfo, const CreatureData *
 
 void Creature::Update(uint32 update_diff, uint32 diff)
 {
+    // AI timers stood still while the creature slept, the first update after waking gives them the slept time
+    uint32 ai_diff = ConsumeWakeUp() ? update_diff : diff;
+
     switch( m_deathState )
     {
         case JUST_ALIVED:
@@ -588,7 +595,7 @@ void Creature::Update(uint32 update_diff, uint32 diff)
                 {
                     // do not allow the AI to be changed during update
                     m_AI_locked = true;
-                    AI()->UpdateAI(diff);   // AI not react good at real update delays (while freeze in non-active part of map)
+                    AI()->UpdateAI(ai_diff);    // AI not react good at real update delays (while freeze in non-active part of map)
                     m_AI_locked = false;
                 }
             }
@@ -780,6 +787,8 @@ bool Creature::AIM_Initialize()
         return false;
     }
 
+    WakeUp();
+
     CreatureAI * oldAI = i_AI;
     i_motionMaster.Initialize();
     i_AI = FactorySelector::selectAI(this);
@@ -788,6 +797,13 @@ bool Creature::AIM_Initialize()
     return true;
 }
 
+void Creature::AIM_InitializeNull()
+{
+    CreatureAI* oldAI = i_AI;
+    i_AI = new NullCreatureAI(this);
+    delete oldAI;
+}
+
 bool Creature::Create(uint32 guidlow, CreatureCreatePos& cPos, CreatureInfo const* cinfo, Team team /*= TEAM_NONE*/, const CreatureData *data /*= NULL*/, GameEventCreatureData const* eventData /*= NULL*/)
 {
     SetMap(cPos.GetMap());
@@ -2246,6 +2262,59 @@ bool Creature::IsInEvadeMode() const
     return !i_motionMaster.empty() && i_motionMaster.GetCurrentMovementGeneratorType() == HOME_MOTION_TYPE;
 }
 
+/// True if Update would only tick timers that are already at rest, so the creature can be parked until woken
+bool Creature::CanSleep() const
+{
+    if (!isAlive() || m_isDeadByDefault || isInCombat() || getVictim() || IsInEvadeMode())
+        return false;
+
+    if (IsPet() || IsTotem() || IsTemporarySummon() || GetVehicleKit() || !GetCharmerGuid().IsEmpty())
+        return false;
+
+    if (!i_AI || !i_AI->CanSleep())
+        return false;
+
+    // pending events, casts and timed or periodic auras all need Unit::Update
+    if (m_Events.HasEvents() || !m_deletedAuras.empty() || !m_deletedHolders.empty())
+        return false;
+
+    for (uint32 i = 0; i < CURRENT_MAX_SPELL; ++i)
+        if (GetCurrentSpell(CurrentSpellTypes(i)))
+            return false;
+
+    for (SpellAuraHolderMap::const_iterator itr = m_spellAuraHolders.begin(); itr != m_spellAuraHolders.end(); ++itr)
+    {
+        SpellAuraHolder const* holder = itr->second;
+        if (!holder->IsPermanent())
+            return false;
+
+        for (uint32 i = 0; i < MAX_EFFECT_INDEX; ++i)
+            if (Aura const* aura = holder->GetAuraByEffectIndex(SpellEffectIndex(i)))
+                if (aura->IsPeriodic())
+                    return false;
+    }
+
+    if (!movespline->Finalized() || (!i_motionMaster.empty() && i_motionMaster.GetCurrentMovementGeneratorType() != IDLE_MOTION_TYPE))
+        return false;
+
+    if (m_attackTimer[BASE_ATTACK] || m_attackTimer[OFF_ATTACK] || m_lastManaUseTimer || m_groupLootId)
+        return false;
+
+    for (uint32 i = 0; i < MAX_REACTIVE; ++i)
+        if (m_reactiveTimer[i])
+            return false;
+
+    // regeneration
+    if (GetHealth() < GetMaxHealth())
+        return false;
+
+    Powers powerType = getPowerType();
+    if ((powerType == POWER_MANA || powerType == POWER_ENERGY) && GetPower(powerType) < GetMaxPower(powerType))
+        return false;
+
+    return true;
+}
+
 bool Creature::HasSpell(uint32 spellID) const
 {
     uint8 i;
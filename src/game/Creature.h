@@ -579,8 +579,11 @@ class Creature : public Unit
         uint32 GetLevelForTarget(Unit const* target) const; // overwrite Unit::GetLevelForTarget for boss level support
 
         bool IsInEvadeMode() const;
+        bool CanSleep() const;
 
         bool AIM_Initialize();
+        // replaces the AI by one that does nothing, for creatures that must stay passive (grid benchmark)
+        void AIM_InitializeNull();
 
         CreatureAI* AI() { return i_AI; }
 
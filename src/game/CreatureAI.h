@@ -247,6 +247,12 @@ class CreatureAI
          */
         virtual bool IsVisible(Unit* pWho) const { return false; }
 
+        /**
+         * Check if UpdateAI has nothing to do while the creature is idle out of combat
+         * Note: only then the creature may be skipped by the map update until it is woken, see Creature::CanSleep
+         */
+        virtual bool CanSleep() const { return false; }
+
         // Called when victim entered water and creature can not enter water
         // TODO: rather unused
         virtual bool canReachByRangeAttack(Unit*) { return false; }
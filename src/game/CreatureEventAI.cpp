@@ -32,6 +32,8 @@
 #include "Chat.h"
 #include "Language.h"
 
+#include <algorithm>
+
 bool CreatureEventAIHolder::UpdateRepeatTimer( Creature* creature, uint32 repeatMin, uint32 repeatMax )
 {
     if (repeatMin == repeatMax)
@@ -48,6 +50,28 @@ bool CreatureEventAIHolder::UpdateRepeatTimer( Creature* creature, uint32 repeat
     return true;
 }
 
+bool CreatureEventAI::IsPeriodicEventType(uint32 eventType)
+{
+    switch (eventType)
+    {
+        case EVENT_T_TIMER:
+        case EVENT_T_TIMER_OOC:
+        case EVENT_T_HP:
+        case EVENT_T_MANA:
+        case EVENT_T_RANGE:
+        case EVENT_T_TARGET_HP:
+        case EVENT_T_TARGET_CASTING:
+        case EVENT_T_FRIENDLY_HP:
+        case EVENT_T_AURA:
+        case EVENT_T_TARGET_AURA:
+        case EVENT_T_MISSING_AURA:
+        case EVENT_T_TARGET_MISSING_AURA:
+            return true;
+        default:
+            return false;
+    }
+}
+
 int CreatureEventAI::Permissible(const Creature *creature)
 {
     if( creature->GetAIName() == "EventAI" )
@@ -117,6 +141,7 @@ CreatureEventAI::CreatureEventAI(Creature *c ) : CreatureAI(c)
         sLog.outError("CreatureEventAI: EventMap for Creature %u is empty but creature is using CreatureEventAI.", m_creature->GetEntry());
 
     m_bEmptyList = m_CreatureEventAIList.empty();
+    BuildEventIndex();
     m_Phase = 0;
     m_CombatMovementEnabled = true;
     m_MeleeEnabled = true;
@@ -128,13 +153,77 @@ CreatureEventAI::CreatureEventAI(Creature *c ) : CreatureAI(c)
     //Handle Spawned Events
     if (!m_bEmptyList)
     {
-        for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
-            if (SpawnedEventConditionsCheck((*i).Event))
-                ProcessEvent(*i);
+        for (uint32 j = EventsBegin(EVENT_T_SPAWNED); j < EventsEnd(EVENT_T_SPAWNED); ++j)
+            if (SpawnedEventConditionsCheck(EventAt(j).Event))
+                ProcessEvent(EventAt(j));
     }
     Reset();
 }
 
+void CreatureEventAI::BuildEventIndex()
+{
+    // counting sort of list positions by event type, keeps list order inside a type
+    memset(m_EventTypeStart, 0, sizeof(m_EventTypeStart));
+    for (CreatureEventAIList::const_iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
+        if ((*i).Event.event_type < EVENT_T_END)
+            ++m_EventTypeStart[(*i).Event.event_type + 1];
+
+    for (uint32 type = 0; type < EVENT_T_END; ++type)
+        m_EventTypeStart[type + 1] += m_EventTypeStart[type];
+
+    m_EventTypeIndex.resize(m_EventTypeStart[EVENT_T_END]);
+    std::vector<uint16> next(m_EventTypeStart, m_EventTypeStart + EVENT_T_END);
+
+    m_UpdateList.clear();
+    m_UpdateListDirty = false;
+
+    for (uint16 pos = 0; pos < m_CreatureEventAIList.size(); ++pos)
+    {
+        CreatureEventAIHolder& holder = m_CreatureEventAIList[pos];
+        if (holder.Event.event_type >= EVENT_T_END)
+            continue;
+
+        m_EventTypeIndex[next[holder.Event.event_type]++] = pos;
+
+        // periodic events stay in the update list for the whole life of the AI
+        if (IsPeriodicEventType(holder.Event.event_type))
+        {
+            holder.InUpdateList = true;
+            m_UpdateList.push_back(pos);
+        }
+    }
+}
+
+void CreatureEventAI::AddToUpdateList(CreatureEventAIHolder& pHolder)
+{
+    if (pHolder.InUpdateList || !pHolder.Time)
+        return;
+
+    // timer of a non periodic event (repeat delay) is counted down by the periodic update
+    pHolder.InUpdateList = true;
+    m_UpdateList.push_back(uint16(&pHolder - &m_CreatureEventAIList[0]));
+    m_UpdateListDirty = true;
+
+    // a sleeping creature is not updated, so the timer would never run out
+    m_creature->WakeUp();
+}
+
+// same percent condition as ProcessEvent uses for EVENT_T_HP, EVENT_T_MANA and EVENT_T_TARGET_HP
+bool CreatureEventAI::IsInPercentRange(CreatureEventAI_Event const& event) const
+{
+    Unit* pUnit = event.event_type == EVENT_T_TARGET_HP ? m_creature->getVictim() : m_creature;
+    if (!pUnit)
+        return false;
+
+    bool mana = event.event_type == EVENT_T_MANA;
+    uint32 maxValue = mana ? pUnit->GetMaxPower(POWER_MANA) : pUnit->GetMaxHealth();
+    if (!maxValue)
+        return false;
+
+    uint32 perc = ((mana ? pUnit->GetPower(POWER_MANA) : pUnit->GetHealth())*100) / maxValue;
+    return perc <= event.percent_range.percentMax && perc >= event.percent_range.percentMin;
+}
+
 bool CreatureEventAI::ProcessEvent(CreatureEventAIHolder& pHolder, Unit* pActionInvoker)
 {
     if (!pHolder.Enabled || pHolder.Time)
@@ -371,6 +460,8 @@ bool CreatureEventAI::ProcessEvent(CreatureEventAIHolder& pHolder, Unit* pAction
             break;
     }
 
+    AddToUpdateList(pHolder);
+
     //Disable non-repeatable events
     if (!(pHolder.Event.event_flags & EFLAG_REPEATABLE))
         pHolder.Enabled = false;
@@ -866,9 +957,9 @@ void CreatureEventAI::JustRespawned()
         return;
 
     //Handle Spawned Events
-    for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
-        if (SpawnedEventConditionsCheck((*i).Event))
-            ProcessEvent(*i);
+    for (uint32 j = EventsBegin(EVENT_T_SPAWNED); j < EventsEnd(EVENT_T_SPAWNED); ++j)
+        if (SpawnedEventConditionsCheck(EventAt(j).Event))
+            ProcessEvent(EventAt(j));
 }
 
 void CreatureEventAI::Reset()
@@ -879,37 +970,22 @@ void CreatureEventAI::Reset()
     if (m_bEmptyList)
         return;
 
-    //Reset all events to enabled
-    for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
+    //Reset all out of combat timers
+    for (uint32 j = EventsBegin(EVENT_T_TIMER_OOC); j < EventsEnd(EVENT_T_TIMER_OOC); ++j)
     {
-        CreatureEventAI_Event const& event = (*i).Event;
-        switch (event.event_type)
-        {
-            //Reset all out of combat timers
-            case EVENT_T_TIMER_OOC:
-            {
-                if ((*i).UpdateRepeatTimer(m_creature,event.timer.initialMin,event.timer.initialMax))
-                    (*i).Enabled = true;
-                break;
-            }
-            //default:
-            //TODO: enable below code line / verify this is correct to enable events previously disabled (ex. aggro yell), instead of enable this in void Aggro()
-            //(*i).Enabled = true;
-            //(*i).Time = 0;
-            //break;
-        }
+        CreatureEventAIHolder& holder = EventAt(j);
+        if (holder.UpdateRepeatTimer(m_creature,holder.Event.timer.initialMin,holder.Event.timer.initialMax))
+            holder.Enabled = true;
     }
+    //TODO: verify if all other events should be enabled here (ex. aggro yell) with Time = 0, instead of enable this in void Aggro()
 }
 
 void CreatureEventAI::JustReachedHome()
 {
     if (!m_bEmptyList)
     {
-        for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
-        {
-            if ((*i).Event.event_type == EVENT_T_REACHED_HOME)
-                ProcessEvent(*i);
-        }
+        for (uint32 j = EventsBegin(EVENT_T_REACHED_HOME); j < EventsEnd(EVENT_T_REACHED_HOME); ++j)
+            ProcessEvent(EventAt(j));
     }
 
     Reset();
@@ -931,11 +1007,8 @@ void CreatureEventAI::EnterEvadeMode()
         return;
 
     //Handle Evade events
-    for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
-    {
-        if ((*i).Event.event_type == EVENT_T_EVADE)
-            ProcessEvent(*i);
-    }
+    for (uint32 j = EventsBegin(EVENT_T_EVADE); j < EventsEnd(EVENT_T_EVADE); ++j)
+        ProcessEvent(EventAt(j));
 }
 
 void CreatureEventAI::JustDied(Unit* killer)
@@ -953,11 +1026,8 @@ void CreatureEventAI::JustDied(Unit* killer)
         return;
 
     //Handle Evade events
-    for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
-    {
-        if ((*i).Event.event_type == EVENT_T_DEATH)
-            ProcessEvent(*i, killer);
-    }
+    for (uint32 j = EventsBegin(EVENT_T_DEATH); j < EventsEnd(EVENT_T_DEATH); ++j)
+        ProcessEvent(EventAt(j), killer);
 
     // reset phase after any death state events
     m_Phase = 0;
@@ -968,11 +1038,8 @@ void CreatureEventAI::KilledUnit(Unit* victim)
     if (m_bEmptyList || victim->GetTypeId() != TYPEID_PLAYER)
         return;
 
-    for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
-    {
-        if ((*i).Event.event_type == EVENT_T_KILL)
-            ProcessEvent(*i, victim);
-    }
+    for (uint32 j = EventsBegin(EVENT_T_KILL); j < EventsEnd(EVENT_T_KILL); ++j)
+        ProcessEvent(EventAt(j), victim);
 }
 
 void CreatureEventAI::JustSummoned(Creature* pUnit)
@@ -980,11 +1047,8 @@ void CreatureEventAI::JustSummoned(Creature* pUnit)
     if (m_bEmptyList || !pUnit)
         return;
 
-    for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
-    {
-        if ((*i).Event.event_type == EVENT_T_SUMMONED_UNIT)
-            ProcessEvent(*i, pUnit);
-    }
+    for (uint32 j = EventsBegin(EVENT_T_SUMMONED_UNIT); j < EventsEnd(EVENT_T_SUMMONED_UNIT); ++j)
+        ProcessEvent(EventAt(j), pUnit);
 }
 
 void CreatureEventAI::SummonedCreatureJustDied(Creature* pUnit)
@@ -992,11 +1056,8 @@ void CreatureEventAI::SummonedCreatureJustDied(Creature* pUnit)
     if (m_bEmptyList || !pUnit)
         return;
 
-    for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
-    {
-        if ((*i).Event.event_type == EVENT_T_SUMMONED_JUST_DIED)
-            ProcessEvent(*i, pUnit);
-    }
+    for (uint32 j = EventsBegin(EVENT_T_SUMMONED_JUST_DIED); j < EventsEnd(EVENT_T_SUMMONED_JUST_DIED); ++j)
+        ProcessEvent(EventAt(j), pUnit);
 }
 
 void CreatureEventAI::SummonedCreatureDespawn(Creature* pUnit)
@@ -1004,11 +1065,8 @@ void CreatureEventAI::SummonedCreatureDespawn(Creature* pUnit)
     if (m_bEmptyList || !pUnit)
         return;
 
-    for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
-    {
-        if ((*i).Event.event_type == EVENT_T_SUMMONED_JUST_DESPAWN)
-            ProcessEvent(*i, pUnit);
-    }
+    for (uint32 j = EventsBegin(EVENT_T_SUMMONED_JUST_DESPAWN); j < EventsEnd(EVENT_T_SUMMONED_JUST_DESPAWN); ++j)
+        ProcessEvent(EventAt(j), pUnit);
 }
 
 void CreatureEventAI::EnterCombat(Unit *enemy)
@@ -1074,21 +1132,20 @@ void CreatureEventAI::MoveInLineOfSight(Unit *who)
     //Check for OOC LOS Event
     if (!m_bEmptyList && !m_creature->getVictim())
     {
-        for (CreatureEventAIList::iterator itr = m_CreatureEventAIList.begin(); itr != m_CreatureEventAIList.end(); ++itr)
+        for (uint32 j = EventsBegin(EVENT_T_OOC_LOS); j < EventsEnd(EVENT_T_OOC_LOS); ++j)
         {
-            if ((*itr).Event.event_type == EVENT_T_OOC_LOS)
-            {
-                //can trigger if closer than fMaxAllowedRange
-                float fMaxAllowedRange = (float)(*itr).Event.ooc_los.maxRange;
+            CreatureEventAIHolder& holder = EventAt(j);
 
-                //if range is ok and we are actually in LOS
-                if (m_creature->IsWithinDistInMap(who, fMaxAllowedRange) && m_creature->IsWithinLOSInMap(who))
-                {
-                    //if friendly event&&who is not hostile OR hostile event&&who is hostile
-                    if (((*itr).Event.ooc_los.noHostile && !m_creature->IsHostileTo(who)) ||
-                        ((!(*itr).Event.ooc_los.noHostile) && m_creature->IsHostileTo(who)))
-                        ProcessEvent(*itr, who);
-                }
+            //can trigger if closer than fMaxAllowedRange
+            float fMaxAllowedRange = (float)holder.Event.ooc_los.maxRange;
+
+            //if range is ok and we are actually in LOS
+            if (m_creature->IsWithinDistInMap(who, fMaxAllowedRange) && m_creature->IsWithinLOSInMap(who))
+            {
+                //if friendly event&&who is not hostile OR hostile event&&who is hostile
+                if ((holder.Event.ooc_los.noHostile && !m_creature->IsHostileTo(who)) ||
+                    ((!holder.Event.ooc_los.noHostile) && m_creature->IsHostileTo(who)))
+                    ProcessEvent(holder, who);
             }
         }
     }
@@ -1125,12 +1182,14 @@ void CreatureEventAI::SpellHit(Unit* pUnit, const SpellEntry* pSpell)
     if (m_bEmptyList)
         return;
 
-    for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
-        if ((*i).Event.event_type == EVENT_T_SPELLHIT)
-            //If spell id matches (or no spell id) & if spell school matches (or no spell school)
-            if (!(*i).Event.spell_hit.spellId || pSpell->Id == (*i).Event.spell_hit.spellId)
-                if (pSpell->SchoolMask & (*i).Event.spell_hit.schoolMask)
-                    ProcessEvent(*i, pUnit);
+    for (uint32 j = EventsBegin(EVENT_T_SPELLHIT); j < EventsEnd(EVENT_T_SPELLHIT); ++j)
+    {
+        CreatureEventAIHolder& holder = EventAt(j);
+        //If spell id matches (or no spell id) & if spell school matches (or no spell school)
+        if (!holder.Event.spell_hit.spellId || pSpell->Id == holder.Event.spell_hit.spellId)
+            if (pSpell->SchoolMask & holder.Event.spell_hit.schoolMask)
+                ProcessEvent(holder, pUnit);
+    }
 }
 
 void CreatureEventAI::UpdateAI(const uint32 diff)
@@ -1145,34 +1204,48 @@ void CreatureEventAI::UpdateAI(const uint32 diff)
         {
             m_EventDiff += diff;
 
-            //Check for time based events
-            for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
+            if (m_UpdateListDirty)
+            {
+                std::sort(m_UpdateList.begin(), m_UpdateList.end());
+                m_UpdateListDirty = false;
+            }
+
+            //Check for time based events, only periodic events and events with running timer are in the update list
+            //positions added while processing are handled from the next update
+            uint32 count = m_UpdateList.size();
+            for (uint32 k = 0; k < count; ++k)
             {
+                CreatureEventAIHolder& holder = m_CreatureEventAIList[m_UpdateList[k]];
+
                 //Decrement Timers
-                if ((*i).Time)
+                if (holder.Time)
                 {
-                    if ((*i).Time > m_EventDiff)
+                    if (holder.Time > m_EventDiff)
                     {
                         //Do not decrement timers if event cannot trigger in this phase
-                        if (!((*i).Event.event_inverse_phase_mask & (1 << m_Phase)))
-                            (*i).Time -= m_EventDiff;
+                        if (!(holder.Event.event_inverse_phase_mask & (1 << m_Phase)))
+                            holder.Time -= m_EventDiff;
 
                         //Skip processing of events that have time remaining
                         continue;
                     }
-                    else (*i).Time = 0;
+                    else holder.Time = 0;
                 }
 
                 //Events that are updated every EVENT_UPDATE_TIME
-                switch ((*i).Event.event_type)
+                switch (holder.Event.event_type)
                 {
                     case EVENT_T_TIMER_OOC:
-                        ProcessEvent(*i);
+                        ProcessEvent(holder);
                         break;
-                    case EVENT_T_TIMER:
-                    case EVENT_T_MANA:
                     case EVENT_T_HP:
+                    case EVENT_T_MANA:
                     case EVENT_T_TARGET_HP:
+                        //threshold checked here first, most of the time the value is out of range
+                        if (Combat && holder.Enabled && IsInPercentRange(holder.Event))
+                            ProcessEvent(holder);
+                        break;
+                    case EVENT_T_TIMER:
                     case EVENT_T_TARGET_CASTING:
                     case EVENT_T_FRIENDLY_HP:
                     case EVENT_T_AURA:
@@ -1180,19 +1253,31 @@ void CreatureEventAI::UpdateAI(const uint32 diff)
                     case EVENT_T_MISSING_AURA:
                     case EVENT_T_TARGET_MISSING_AURA:
                         if (Combat)
-                            ProcessEvent(*i);
+                            ProcessEvent(holder);
                         break;
                     case EVENT_T_RANGE:
                         if (Combat)
                         {
                             if (m_creature->getVictim() && m_creature->IsInMap(m_creature->getVictim()))
-                                if (m_creature->IsInRange(m_creature->getVictim(), (float)(*i).Event.range.minDist, (float)(*i).Event.range.maxDist))
-                                    ProcessEvent(*i);
+                                if (m_creature->IsInRange(m_creature->getVictim(), (float)holder.Event.range.minDist, (float)holder.Event.range.maxDist))
+                                    ProcessEvent(holder);
                         }
                         break;
                 }
             }
 
+            //Drop non periodic events whose timer expired
+            uint32 kept = 0;
+            for (uint32 k = 0; k < m_UpdateList.size(); ++k)
+            {
+                CreatureEventAIHolder& holder = m_CreatureEventAIList[m_UpdateList[k]];
+                if (holder.Time || IsPeriodicEventType(holder.Event.event_type))
+                    m_UpdateList[kept++] = m_UpdateList[k];
+                else
+                    holder.InUpdateList = false;
+            }
+            m_UpdateList.resize(kept);
+
             m_EventDiff = 0;
             m_EventUpdateTime = EVENT_UPDATE_TIME;
         }
@@ -1214,6 +1299,19 @@ bool CreatureEventAI::IsVisible(Unit *pl) const
         && pl->isVisibleForOrDetect(m_creature,m_creature,true);
 }
 
+bool CreatureEventAI::CanSleep() const
+{
+    //Out of combat only OOC timers and running timers need the update
+    for (uint32 k = 0; k < m_UpdateList.size(); ++k)
+    {
+        CreatureEventAIHolder const& holder = m_CreatureEventAIList[m_UpdateList[k]];
+        if (holder.Time || holder.Event.event_type == EVENT_T_TIMER_OOC)
+            return false;
+    }
+
+    return true;
+}
+
 inline uint32 CreatureEventAI::GetRandActionParam(uint32 rnd, uint32 param1, uint32 param2, uint32 param3)
 {
     switch (rnd % 3)
@@ -1400,19 +1498,17 @@ void CreatureEventAI::ReceiveEmote(Player* pPlayer, uint32 text_emote)
     if (m_bEmptyList)
         return;
 
-    for (CreatureEventAIList::iterator itr = m_CreatureEventAIList.begin(); itr != m_CreatureEventAIList.end(); ++itr)
+    for (uint32 j = EventsBegin(EVENT_T_RECEIVE_EMOTE); j < EventsEnd(EVENT_T_RECEIVE_EMOTE); ++j)
     {
-        if ((*itr).Event.event_type == EVENT_T_RECEIVE_EMOTE)
-        {
-            if ((*itr).Event.receive_emote.emoteId != text_emote)
-                return;
+        CreatureEventAIHolder& holder = EventAt(j);
+        if (holder.Event.receive_emote.emoteId != text_emote)
+            return;
 
-            PlayerCondition pcon((*itr).Event.receive_emote.condition,(*itr).Event.receive_emote.conditionValue1,(*itr).Event.receive_emote.conditionValue2);
-            if (pcon.Meets(pPlayer))
-            {
-                DEBUG_FILTER_LOG(LOG_FILTER_AI_AND_MOVEGENSS, "CreatureEventAI: ReceiveEmote CreatureEventAI: Condition ok, processing");
-                ProcessEvent(*itr, pPlayer);
-            }
+        PlayerCondition pcon(holder.Event.receive_emote.condition,holder.Event.receive_emote.conditionValue1,holder.Event.receive_emote.conditionValue2);
+        if (pcon.Meets(pPlayer))
+        {
+            DEBUG_FILTER_LOG(LOG_FILTER_AI_AND_MOVEGENSS, "CreatureEventAI: ReceiveEmote CreatureEventAI: Condition ok, processing");
+            ProcessEvent(holder, pPlayer);
         }
     }
 }
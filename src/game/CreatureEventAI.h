@@ -564,11 +564,12 @@ typedef UNORDERED_MAP<uint32, CreatureEventAI_Summon> CreatureEventAI_Summon_Map
 
 struct CreatureEventAIHolder
 {
-    CreatureEventAIHolder(CreatureEventAI_Event p) : Event(p), Time(0), Enabled(true){}
+    CreatureEventAIHolder(CreatureEventAI_Event p) : Event(p), Time(0), Enabled(true), InUpdateList(false) {}
 
     CreatureEventAI_Event Event;
     uint32 Time;
     bool Enabled;
+    bool InUpdateList;                                      // visited by the periodic update of CreatureEventAI
 
     // helper
     bool UpdateRepeatTimer(Creature* creature, uint32 repeatMin, uint32 repeatMax);
@@ -599,6 +600,7 @@ class CreatureEventAI : public CreatureAI
         void DamageTaken(Unit* done_by, uint32& damage);
         void UpdateAI(const uint32 diff);
         bool IsVisible(Unit *) const;
+        bool CanSleep() const;
         void ReceiveEmote(Player* pPlayer, uint32 text_emote);
         void SummonedCreatureJustDied(Creature* unit);
         void SummonedCreatureDespawn(Creature* unit);
@@ -620,7 +622,19 @@ class CreatureEventAI : public CreatureAI
         void DoFindFriendlyMissingBuff(std::list<Creature*>& _list, float range, uint32 spellid);
         void DoFindFriendlyCC(std::list<Creature*>& _list, float range);
 
+        // event types checked by the periodic update while their timer is not running
+        static bool IsPeriodicEventType(uint32 eventType);
+
     protected:
+        // events of one type in list order: for (uint32 j = EventsBegin(type); j < EventsEnd(type); ++j) EventAt(j)
+        uint32 EventsBegin(EventAI_Type type) const { return m_EventTypeStart[type]; }
+        uint32 EventsEnd(EventAI_Type type) const { return m_EventTypeStart[type + 1]; }
+        CreatureEventAIHolder& EventAt(uint32 j) { return m_CreatureEventAIList[m_EventTypeIndex[j]]; }
+
+        void BuildEventIndex();
+        void AddToUpdateList(CreatureEventAIHolder& pHolder);
+        bool IsInPercentRange(CreatureEventAI_Event const& event) const;
+
         uint32 m_EventUpdateTime;                           //Time between event updates
         uint32 m_EventDiff;                                 //Time between the last event call
         bool   m_bEmptyList;
@@ -629,6 +643,12 @@ class CreatureEventAI : public CreatureAI
         typedef std::vector<CreatureEventAIHolder> CreatureEventAIList;
         CreatureEventAIList m_CreatureEventAIList;          //Holder for events (stores enabled, time, and eventid)
 
+        // the list never changes after construction, so it is indexed once
+        std::vector<uint16> m_EventTypeIndex;               // list positions grouped by event type
+        uint16 m_EventTypeStart[EVENT_T_END + 1];           // first m_EventTypeIndex position of each type
+        std::vector<uint16> m_UpdateList;                   // list positions of periodic events and events with running timer
+        bool m_UpdateListDirty;                             // m_UpdateList got new positions, needs sorting
+
         uint8  m_Phase;                                     // Current phase, max 32 phases
         bool   m_CombatMovementEnabled;                     // If we allow targeted movment gen (movement twoards top threat)
         bool   m_MeleeEnabled;                              // If we allow melee auto attack
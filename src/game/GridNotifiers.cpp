@@ -130,6 +130,48 @@ void MessageDelivererExcept::Visit(CameraMapType &m)
     }
 }
 
+void MovementMessageDeliverer::Visit(CameraMapType &m)
+{
+    for(CameraMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
+    {
+        Player* owner = iter->getSource()->GetOwner();
+
+        if (!owner->InSamePhase(&i_mover) || owner->GetObjectGuid() == i_skippedGuid)
+            continue;
+
+        if (!i_toFar)
+        {
+            WorldObject const* body = iter->getSource()->GetBody();
+            float dx = body->GetPositionX() - i_mover.GetPositionX();
+            float dy = body->GetPositionY() - i_mover.GetPositionY();
+            if (dx * dx + dy * dy > i_nearDistSq)
+                continue;
+        }
+
+        if (WorldSession* session = owner->GetSession())
+            session->SendPacket(i_message);
+    }
+}
+
+void SplineMessageDeliverer::Visit(CameraMapType &m)
+{
+    for(CameraMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
+    {
+        WorldSession* session = iter->getSource()->GetOwner()->GetSession();
+        if (!session)
+            continue;
+
+        WorldObject const* body = iter->getSource()->GetBody();
+        for (MessageList::const_iterator msgItr = i_messages.begin(); msgItr != i_messages.end(); ++msgItr)
+        {
+            if (!body->InSamePhase(msgItr->first))
+                continue;
+
+            session->SendPacket(msgItr->second);
+            ++i_deliveries;
+        }
+    }
+}
 
 void
 ObjectMessageDeliverer::Visit(CameraMapType &m)
@@ -82,6 +82,35 @@ namespace Strawberry
         template<class SKIP> void Visit(GridRefManager<SKIP> &) {}
     };
 
+    // movement packets, receivers beyond the near distance only get them when i_toFar is set
+    struct MovementMessageDeliverer
+    {
+        WorldObject const& i_mover;
+        WorldPacket*  i_message;
+        ObjectGuid    i_skippedGuid;
+        float         i_nearDistSq;
+        bool          i_toFar;
+
+        MovementMessageDeliverer(WorldObject const& mover, WorldPacket* msg, ObjectGuid skippedGuid, float nearDist, bool toFar)
+            : i_mover(mover), i_message(msg), i_skippedGuid(skippedGuid), i_nearDistSq(nearDist * nearDist), i_toFar(toFar) {}
+
+        void Visit(CameraMapType &m);
+        template<class SKIP> void Visit(GridRefManager<SKIP> &) {}
+    };
+
+    // splines launched in the same tick by units with the same observers, phase checked per packet
+    struct SplineMessageDeliverer
+    {
+        typedef std::vector<std::pair<uint32 /*phaseMask*/, WorldPacket*> > MessageList;
+
+        MessageList const& i_messages;
+        uint32 i_deliveries;
+
+        explicit SplineMessageDeliverer(MessageList const& messages) : i_messages(messages), i_deliveries(0) {}
+        void Visit(CameraMapType &m);
+        template<class SKIP> void Visit(GridRefManager<SKIP> &) {}
+    };
+
     struct ObjectMessageDeliverer
     {
         uint32 i_phaseMask;
@@ -119,7 +148,11 @@ namespace Strawberry
     struct ObjectUpdater
     {
         uint32 i_timeDiff;
-        explicit ObjectUpdater(const uint32 &diff) : i_timeDiff(diff) {}
+        bool i_allowSleep;                                  // park creatures that become idle, see Creature::CanSleep
+        uint32 i_activeCreatures;
+        uint32 i_sleepingCreatures;
+        explicit ObjectUpdater(const uint32 &diff, bool allowSleep = false)
+            : i_timeDiff(diff), i_allowSleep(allowSleep), i_activeCreatures(0), i_sleepingCreatures(0) {}
         template<class T> void Visit(GridRefManager<T> &m);
         void Visit(PlayerMapType &) {}
         void Visit(CorpseMapType &) {}
@@ -348,6 +381,7 @@ namespace Strawberry
 
         void Visit(CreatureMapType &m);
         void Visit(PlayerMapType &m);
+        void VisitUnit(Unit* u);                            // Cell::VisitAllUnits
 
         template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED> &) {}
     };
@@ -365,6 +399,7 @@ namespace Strawberry
 
         void Visit(CreatureMapType &m);
         void Visit(PlayerMapType &m);
+        void VisitUnit(Unit* u);                            // Cell::VisitAllUnits
 
         template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED> &) {}
     };
@@ -382,6 +417,7 @@ namespace Strawberry
 
         void Visit(PlayerMapType &m);
         void Visit(CreatureMapType &m);
+        void VisitUnit(Unit* u);                            // Cell::VisitAllUnits
 
         template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED> &) {}
     };
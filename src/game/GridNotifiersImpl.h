@@ -43,13 +43,34 @@ inline void Strawberry::ObjectUpdater::Visit(CreatureMapType &m)
 {
     for(CreatureMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
     {
-        WorldObject::UpdateHelper helper(iter->getSource());
+        Creature* creature = iter->getSource();
+
+        // the update tracker keeps running, so timers catch up with the whole slept time at wake up
+        if (creature->IsSleeping())
+        {
+            if (i_allowSleep && !creature->m_Events.HasEvents())
+            {
+                ++i_sleepingCreatures;
+                continue;
+            }
+
+            creature->WakeUp();
+        }
+
+        WorldObject::UpdateHelper helper(creature);
         helper.Update(i_timeDiff);
+        ++i_activeCreatures;
+
+        if (i_allowSleep && creature->IsInWorld() && creature->CanSleep())
+            creature->SetSleeping();
     }
 }
 
 inline void PlayerCreatureRelocationWorker(Player* pl, Creature* c)
 {
+    if (c->IsSleeping() && c->IsWithinDistInMap(pl, c->GetAttackDistance(pl)))
+        c->WakeUp();
+
     // Creature AI reaction
     if (!c->hasUnitState(UNIT_STAT_LOST_CONTROL))
     {
@@ -440,6 +461,13 @@ void Strawberry::UnitSearcher<Check>::Visit(PlayerMapType &m)
     }
 }
 
+template<class Check>
+void Strawberry::UnitSearcher<Check>::VisitUnit(Unit* u)
+{
+    if (!i_object && u->InSamePhase(i_phaseMask) && i_check(u))
+        i_object = u;
+}
+
 template<class Check>
 void Strawberry::UnitLastSearcher<Check>::Visit(CreatureMapType &m)
 {
@@ -466,6 +494,13 @@ void Strawberry::UnitLastSearcher<Check>::Visit(PlayerMapType &m)
     }
 }
 
+template<class Check>
+void Strawberry::UnitLastSearcher<Check>::VisitUnit(Unit* u)
+{
+    if (u->InSamePhase(i_phaseMask) && i_check(u))
+        i_object = u;
+}
+
 template<class Check>
 void Strawberry::UnitListSearcher<Check>::Visit(PlayerMapType &m)
 {
@@ -484,6 +519,13 @@ void Strawberry::UnitListSearcher<Check>::Visit(CreatureMapType &m)
                 i_objects.push_back(itr->getSource());
 }
 
+template<class Check>
+void Strawberry::UnitListSearcher<Check>::VisitUnit(Unit* u)
+{
+    if (u->InSamePhase(i_phaseMask) && i_check(u))
+        i_objects.push_back(u);
+}
+
 // Creature searchers
 
 template<class Check>
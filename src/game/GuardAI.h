@@ -43,6 +43,7 @@ class GuardAI : public CreatureAI
         void EnterEvadeMode();
         void JustDied(Unit *);
         bool IsVisible(Unit *) const;
+        bool CanSleep() const { return true; }
 
         void UpdateAI(const uint32);
         static int Permissible(const Creature *);
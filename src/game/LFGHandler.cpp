@@ -23,16 +23,21 @@
 #include "WorldPacket.h"
 #include "ObjectMgr.h"
 #include "World.h"
+#include "LFGMgr.h"
+
+// The CMSG_LFG_* handlers below are not registered in InitOpcodeTable() yet: the 15595 values of
+// CMSG_LFG_JOIN/LEAVE/SET_ROLES/PROPOSAL_RESPONSE and of the SMSG_LFG_* replies are still unknown.
 
 void WorldSession::HandleLfgJoinOpcode( WorldPacket & recv_data )
 {
     DEBUG_LOG("CMSG_LFG_JOIN");
 
+    uint32 roles;
     uint8 dungeonsCount, counter2;
     std::string comment;
-    std::vector<uint32> dungeons;
+    LfgDungeonList dungeons;
 
-    recv_data >> Unused<uint32>();                          // lfg roles
+    recv_data >> roles;                                     // lfg roles
     recv_data >> Unused<uint8>();                           // lua: GetLFGInfoLocal
     recv_data >> Unused<uint8>();                           // lua: GetLFGInfoLocal
 
@@ -41,7 +46,10 @@ void WorldSession::HandleLfgJoinOpcode( WorldPacket & recv_data )
     dungeons.resize(dungeonsCount);
 
     for (uint8 i = 0; i < dungeonsCount; ++i)
+    {
         recv_data >> dungeons[i];                           // dungeons id/type
+        dungeons[i] &= 0x00FFFFFF;
+    }
 
     recv_data >> counter2;                                  // const count = 3, lua: GetLFGInfoLocal
 
@@ -50,15 +58,36 @@ void WorldSession::HandleLfgJoinOpcode( WorldPacket & recv_data )
 
     recv_data >> comment;                                   // lfg comment
 
-    //SendLfgJoinResult(ERR_LFG_OK);
-    //SendLfgUpdate(false, LFG_UPDATE_JOIN, dungeons[0]);
+    sLFGMgr.Join(GetPlayer(), uint8(roles), dungeons);
 }
 
 void WorldSession::HandleLfgLeaveOpcode( WorldPacket & /*recv_data*/ )
 {
     DEBUG_LOG("CMSG_LFG_LEAVE");
 
-    //SendLfgUpdate(false, LFG_UPDATE_LEAVE, 0);
+    sLFGMgr.Leave(GetPlayer());
+}
+
+void WorldSession::HandleLfgSetRolesOpcode( WorldPacket & recv_data )
+{
+    DEBUG_LOG("CMSG_LFG_SET_ROLES");
+
+    uint8 roles;
+    recv_data >> roles;
+
+    sLFGMgr.SetRoles(GetPlayer(), roles);
+}
+
+void WorldSession::HandleLfgProposalResultOpcode( WorldPacket & recv_data )
+{
+    DEBUG_LOG("CMSG_LFG_PROPOSAL_RESPONSE");
+
+    uint32 proposalId;
+    uint8 accept;
+    recv_data >> proposalId;
+    recv_data >> accept;
+
+    sLFGMgr.ProposalResponse(GetPlayer(), proposalId, accept != 0);
 }
 
 void WorldSession::HandleSearchLfgJoinOpcode( WorldPacket & recv_data )
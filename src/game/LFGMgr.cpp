@@ -0,0 +1,1110 @@
+/*
+ * Copyright (C) 2010-2012 Strawberry-Pr0jcts <http://strawberry-pr0jcts.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "LFGMgr.h"
+#include "Policies/SingletonImp.h"
+#include "Database/DatabaseEnv.h"
+#include "ProgressBar.h"
+#include "Log.h"
+#include "World.h"
+#include "WorldSession.h"
+#include "WorldPacket.h"
+#include "ObjectMgr.h"
+#include "Player.h"
+#include "Group.h"
+#include "DBCStores.h"
+
+INSTANTIATE_SINGLETON_1(LFGMgr);
+
+// role flag served by each queue bucket
+static uint8 const LfgSlotRole[MAX_LFG_SLOTS] = { LFG_ROLE_TANK, LFG_ROLE_HEALER, LFG_ROLE_DAMAGE };
+
+// dungeon party composition: 1 tank, 1 healer, 3 damage dealers
+static uint8 const LfgSlotsNeeded[MAX_LFG_SLOTS] = { 1, 1, 3 };
+
+// premade groups examined per dungeon and pass, keeps a pass bounded if many groups can't be completed
+#define LFG_MAX_GROUP_TRIES     10
+
+// amount of recent matches the average wait time is computed over
+#define LFG_WAIT_TIME_SAMPLES   64
+
+static int32 LfgRoleToSlot(uint8 role)
+{
+    for (int32 i = 0; i < MAX_LFG_SLOTS; ++i)
+        if (role == LfgSlotRole[i])
+            return i;
+    return -1;
+}
+
+// ------------------------------------------------------------------------
+// LfgQueue - matching thread only
+// ------------------------------------------------------------------------
+
+LfgQueue::~LfgQueue()
+{
+    for (UnitMap::iterator itr = m_units.begin(); itr != m_units.end(); ++itr)
+        delete itr->second.unit;
+}
+
+LfgQueue::UnitList::iterator LfgQueue::InsertByJoinTime(UnitList& list, LfgQueueUnit* unit)
+{
+    // new units go to the tail in O(1), re-queued units after failed proposals get their old place back
+    UnitList::iterator itr = list.end();
+    while (itr != list.begin())
+    {
+        UnitList::iterator prev = itr;
+        --prev;
+        if ((*prev)->joinTime <= unit->joinTime)
+            break;
+        itr = prev;
+    }
+    return list.insert(itr, unit);
+}
+
+void LfgQueue::AddUnit(LfgQueueUnit* unit)
+{
+    if (m_units.find(unit->unitId) != m_units.end())
+    {
+        delete unit;
+        return;
+    }
+
+    UnitEntry& entry = m_units[unit->unitId];
+    entry.unit = unit;
+
+    for (LfgDungeonList::const_iterator itr = unit->dungeons.begin(); itr != unit->dungeons.end(); ++itr)
+    {
+        DungeonQueue& queue = m_queues[*itr];
+
+        UnitPosition pos;
+        pos.dungeonId = *itr;
+
+        if (unit->IsGroup())
+        {
+            pos.slot = -1;
+            pos.itr = InsertByJoinTime(queue.groups, unit);
+            entry.positions.push_back(pos);
+        }
+        else
+        {
+            for (int32 slot = 0; slot < MAX_LFG_SLOTS; ++slot)
+            {
+                if (!(unit->members[0].roles & LfgSlotRole[slot]))
+                    continue;
+
+                pos.slot = slot;
+                pos.itr = InsertByJoinTime(queue.solo[slot], unit);
+                entry.positions.push_back(pos);
+            }
+        }
+
+        m_dirty.insert(*itr);
+    }
+}
+
+void LfgQueue::RemoveUnit(uint32 unitId)
+{
+    UnitMap::iterator uItr = m_units.find(unitId);
+    if (uItr == m_units.end())
+        return;
+
+    for (std::vector<UnitPosition>::const_iterator itr = uItr->second.positions.begin(); itr != uItr->second.positions.end(); ++itr)
+    {
+        DungeonQueueMap::iterator qItr = m_queues.find(itr->dungeonId);
+        if (qItr == m_queues.end())
+            continue;
+
+        DungeonQueue& queue = qItr->second;
+        if (itr->slot < 0)
+            queue.groups.erase(itr->itr);
+        else
+            queue.solo[itr->slot].erase(itr->itr);
+
+        // m_dirty may still reference the dungeon, FindMatches skips missing queues
+        if (queue.groups.empty() && queue.solo[LFG_SLOT_TANK].empty() &&
+            queue.solo[LFG_SLOT_HEALER].empty() && queue.solo[LFG_SLOT_DAMAGE].empty())
+            m_queues.erase(qItr);
+    }
+
+    delete uItr->second.unit;
+    m_units.erase(uItr);
+}
+
+bool LfgQueue::FillFromSolo(DungeonQueue& queue, uint8 const* need, std::vector<LfgQueueUnit*>& picked, LfgQueueMemberList& members)
+{
+    // serve the scarcest bucket first so flex players are not spent on a role others can fill
+    int32 order[MAX_LFG_SLOTS] = { LFG_SLOT_TANK, LFG_SLOT_HEALER, LFG_SLOT_DAMAGE };
+    uint32 spare[MAX_LFG_SLOTS];
+    for (int32 i = 0; i < MAX_LFG_SLOTS; ++i)
+    {
+        uint32 size = 0;
+        for (UnitList::const_iterator itr = queue.solo[i].begin(); itr != queue.solo[i].end() && size <= uint32(need[i] + MAX_LFG_GROUP_SIZE); ++itr)
+            ++size;
+        spare[i] = size > need[i] ? size - need[i] : 0;
+    }
+
+    for (int32 i = 1; i < MAX_LFG_SLOTS; ++i)
+        for (int32 j = i; j > 0 && spare[order[j]] < spare[order[j - 1]]; --j)
+            std::swap(order[j], order[j - 1]);
+
+    for (int32 i = 0; i < MAX_LFG_SLOTS; ++i)
+    {
+        int32 slot = order[i];
+        uint8 left = need[slot];
+
+        // skipped entries can only be the few units already picked for this party
+        for (UnitList::const_iterator itr = queue.solo[slot].begin(); itr != queue.solo[slot].end() && left; ++itr)
+        {
+            if (std::find(picked.begin(), picked.end(), *itr) != picked.end())
+                continue;
+
+            picked.push_back(*itr);
+            members.push_back(LfgQueueMember((*itr)->members[0].guid, LfgSlotRole[slot]));
+            --left;
+        }
+
+        if (left)
+            return false;
+    }
+
+    return true;
+}
+
+bool LfgQueue::TryMatch(uint32 dungeonId, DungeonQueue& queue, LfgMatch& match)
+{
+    std::vector<LfgQueueUnit*> picked;
+    LfgQueueMemberList members;
+    uint8 need[MAX_LFG_SLOTS];
+
+    bool found = false;
+
+    // premade groups first, completed with solo players
+    uint32 tries = 0;
+    for (UnitList::const_iterator gItr = queue.groups.begin(); gItr != queue.groups.end() && tries < LFG_MAX_GROUP_TRIES; ++gItr, ++tries)
+    {
+        memcpy(need, LfgSlotsNeeded, sizeof(need));
+
+        bool fits = true;
+        for (LfgQueueMemberList::const_iterator mItr = (*gItr)->members.begin(); mItr != (*gItr)->members.end(); ++mItr)
+        {
+            int32 slot = LfgRoleToSlot(mItr->roles);
+            if (slot < 0 || !need[slot])
+            {
+                fits = false;
+                break;
+            }
+            --need[slot];
+        }
+
+        if (!fits)
+            continue;
+
+        picked.clear();
+        picked.push_back(*gItr);
+        members = (*gItr)->members;
+
+        if (FillFromSolo(queue, need, picked, members))
+        {
+            found = true;
+            break;
+        }
+    }
+
+    if (!found)
+    {
+        memcpy(need, LfgSlotsNeeded, sizeof(need));
+        picked.clear();
+        members.clear();
+        found = FillFromSolo(queue, need, picked, members);
+    }
+
+    if (!found)
+        return false;
+
+    uint32 now = WorldTimer::getMSTime();
+    uint32 oldest = now;
+
+    match.dungeonId = dungeonId;
+    match.unitIds.clear();
+    for (std::vector<LfgQueueUnit*>::const_iterator itr = picked.begin(); itr != picked.end(); ++itr)
+    {
+        match.unitIds.push_back((*itr)->unitId);
+        if (WorldTimer::getMSTimeDiff((*itr)->joinTime, now) > WorldTimer::getMSTimeDiff(oldest, now))
+            oldest = (*itr)->joinTime;
+    }
+    match.members = members;
+    match.waitTime = WorldTimer::getMSTimeDiff(oldest, now);
+    return true;
+}
+
+void LfgQueue::FindMatches(std::vector<LfgMatch>& matches, uint32 maxMatches)
+{
+    std::set<uint32>::iterator itr = m_dirty.begin();
+    while (itr != m_dirty.end() && matches.size() < maxMatches)
+    {
+        DungeonQueueMap::iterator qItr = m_queues.find(*itr);
+        if (qItr == m_queues.end())
+        {
+            m_dirty.erase(itr++);
+            continue;
+        }
+
+        LfgMatch match;
+        if (!TryMatch(*itr, qItr->second, match))
+        {
+            // nothing to do here until a new unit joins this dungeon
+            m_dirty.erase(itr++);
+            continue;
+        }
+
+        // matched units leave every dungeon queue they waited in, the same dungeon is tried again
+        for (std::vector<uint32>::const_iterator uItr = match.unitIds.begin(); uItr != match.unitIds.end(); ++uItr)
+            RemoveUnit(*uItr);
+
+        ++m_matches;
+        if (m_matchedCount == LFG_WAIT_TIME_SAMPLES)
+        {
+            m_matchedWaitTime -= m_matchedWaitTime / LFG_WAIT_TIME_SAMPLES;
+            --m_matchedCount;
+        }
+        m_matchedWaitTime += match.waitTime;
+        ++m_matchedCount;
+
+        matches.push_back(match);
+    }
+}
+
+void LfgQueue::GetStatistic(LfgQueueStatistic& stats) const
+{
+    uint32 now = WorldTimer::getMSTime();
+
+    stats.units = m_units.size();
+    stats.dungeons = m_queues.size();
+    stats.matches = m_matches;
+    stats.avgWaitTime = m_matchedCount ? m_matchedWaitTime / m_matchedCount : 0;
+    stats.maxWaitTime = 0;
+
+    for (int32 i = 0; i < MAX_LFG_SLOTS; ++i)
+        stats.players[i] = 0;
+
+    for (UnitMap::const_iterator itr = m_units.begin(); itr != m_units.end(); ++itr)
+    {
+        LfgQueueUnit const* unit = itr->second.unit;
+
+        for (LfgQueueMemberList::const_iterator mItr = unit->members.begin(); mItr != unit->members.end(); ++mItr)
+            for (int32 i = 0; i < MAX_LFG_SLOTS; ++i)
+                if (mItr->roles & LfgSlotRole[i])
+                    ++stats.players[i];
+
+        uint32 wait = WorldTimer::getMSTimeDiff(unit->joinTime, now);
+        if (wait > stats.maxWaitTime)
+            stats.maxWaitTime = wait;
+    }
+}
+
+// ------------------------------------------------------------------------
+// LfgQueueRunnable
+// ------------------------------------------------------------------------
+
+void LfgQueueRunnable::run()
+{
+    LfgQueue queue;
+    LFGMgr& mgr = sLFGMgr;
+
+    uint32 maxMatches = sWorld.getConfig(CONFIG_UINT32_LFG_MAX_MATCHES_PER_UPDATE);
+
+    while (!mgr.m_stopQueueThread)
+    {
+        uint32 startTime = WorldTimer::getMSTime();
+
+        LfgQueueCommand command;
+        while (mgr.m_commands.next(command))
+        {
+            switch (command.type)
+            {
+                case LfgQueueCommand::LFG_QUEUE_ADD:
+                    queue.AddUnit(command.unit);
+                    break;
+                case LfgQueueCommand::LFG_QUEUE_REMOVE:
+                    queue.RemoveUnit(command.unitId);
+                    break;
+            }
+        }
+
+        std::vector<LfgMatch> matches;
+        queue.FindMatches(matches, maxMatches);
+        for (std::vector<LfgMatch>::const_iterator itr = matches.begin(); itr != matches.end(); ++itr)
+            mgr.m_matches.add(*itr);
+
+        LfgQueueStatistic stats;
+        queue.GetStatistic(stats);
+        stats.lastUpdateTime = WorldTimer::getMSTimeDiff(startTime, WorldTimer::getMSTime());
+
+        {
+            ACE_GUARD(ACE_Thread_Mutex, guard, mgr.m_statLock);
+            mgr.m_stats = stats;
+        }
+
+        ACE_Based::Thread::Sleep(m_interval);
+    }
+}
+
+// ------------------------------------------------------------------------
+// LFGMgr - world thread
+// ------------------------------------------------------------------------
+
+LFGMgr::LFGMgr() : m_nextUnitId(1), m_nextProposalId(1), m_queueThread(NULL), m_stopQueueThread(false)
+{
+    m_timeoutTimer.SetInterval(IN_MILLISECONDS);
+}
+
+LFGMgr::~LFGMgr()
+{
+    StopQueueThread();
+
+    // units never picked up by the matching thread
+    LfgQueueCommand command;
+    while (m_commands.next(command))
+        delete command.unit;
+}
+
+void LFGMgr::LoadDungeons()
+{
+    m_dungeons.clear();
+
+    QueryResult* result = WorldDatabase.Query("SELECT id, map, difficulty FROM lfg_dungeons");
+    if (!result)
+    {
+        BarGoLink bar(1);
+        bar.step();
+
+        sLog.outString();
+        sLog.outString(">> Loaded 0 LFG dungeons. DB table `lfg_dungeons` is empty.");
+        return;
+    }
+
+    BarGoLink bar(result->GetRowCount());
+
+    do
+    {
+        Field* fields = result->Fetch();
+        bar.step();
+
+        LfgDungeonEntry entry;
+        entry.id         = fields[0].GetUInt32();
+        entry.map        = fields[1].GetUInt32();
+        uint32 difficulty = fields[2].GetUInt32();
+
+        MapEntry const* mapEntry = sMapStore.LookupEntry(entry.map);
+        if (!mapEntry || !mapEntry->IsDungeon())
+        {
+            sLog.outErrorDb("Table `lfg_dungeons` has dungeon %u with non-existing or non-instanceable map %u, skipped.", entry.id, entry.map);
+            continue;
+        }
+
+        if (difficulty >= MAX_DIFFICULTY)
+        {
+            sLog.outErrorDb("Table `lfg_dungeons` has dungeon %u with wrong difficulty %u, skipped.", entry.id, difficulty);
+            continue;
+        }
+
+        if (!sObjectMgr.GetMapEntranceTrigger(entry.map))
+            sLog.outErrorDb("Table `lfg_dungeons` has dungeon %u for map %u without entrance areatrigger, formed groups will not be teleported.", entry.id, entry.map);
+
+        entry.difficulty = Difficulty(difficulty);
+        m_dungeons[entry.id] = entry;
+    }
+    while (result->NextRow());
+
+    delete result;
+
+    sLog.outString();
+    sLog.outString(">> Loaded %u LFG dungeons", uint32(m_dungeons.size()));
+}
+
+void LFGMgr::Initialize()
+{
+    if (!sWorld.getConfig(CONFIG_BOOL_LFG_ENABLED))
+    {
+        sLog.outString("Dungeon finder is disabled by config.");
+        return;
+    }
+
+    m_stopQueueThread = false;
+    m_queueThread = new ACE_Based::Thread(new LfgQueueRunnable(sWorld.getConfig(CONFIG_UINT32_LFG_QUEUE_UPDATE_INTERVAL)));
+}
+
+void LFGMgr::StopQueueThread()
+{
+    if (!m_queueThread)
+        return;
+
+    m_stopQueueThread = true;
+    m_queueThread->wait();
+    delete m_queueThread;
+    m_queueThread = NULL;
+}
+
+LfgDungeonEntry const* LFGMgr::GetDungeon(uint32 dungeonId) const
+{
+    DungeonMap::const_iterator itr = m_dungeons.find(dungeonId);
+    return itr != m_dungeons.end() ? &itr->second : NULL;
+}
+
+LfgState LFGMgr::GetState(ObjectGuid guid) const
+{
+    PlayerUnitMap::const_iterator itr = m_playerUnits.find(guid);
+    if (itr == m_playerUnits.end())
+        return LFG_STATE_NONE;
+
+    UnitMap::const_iterator uItr = m_units.find(itr->second);
+    return uItr != m_units.end() ? uItr->second.state : LFG_STATE_NONE;
+}
+
+void LFGMgr::GetStatistic(LfgQueueStatistic& stats, uint32& roleChecks, uint32& proposals) const
+{
+    {
+        ACE_GUARD(ACE_Thread_Mutex, guard, m_statLock);
+        stats = m_stats;
+    }
+
+    roleChecks = m_roleChecks.size();
+    proposals = m_proposals.size();
+}
+
+void LFGMgr::QueueUnit(LfgQueueUnit const& unit)
+{
+    LfgUnitState& state = m_units[unit.unitId];
+    state.unit = unit;
+    state.state = LFG_STATE_QUEUED;
+
+    for (LfgQueueMemberList::const_iterator itr = unit.members.begin(); itr != unit.members.end(); ++itr)
+        m_playerUnits[itr->guid] = unit.unitId;
+
+    LfgQueueCommand command;
+    command.type = LfgQueueCommand::LFG_QUEUE_ADD;
+    command.unitId = unit.unitId;
+    command.unit = new LfgQueueUnit(unit);
+    m_commands.add(command);
+}
+
+void LFGMgr::DequeueUnit(uint32 unitId, bool notify)
+{
+    UnitMap::iterator itr = m_units.find(unitId);
+    if (itr == m_units.end())
+        return;
+
+    // after a match the matching thread has already dropped the unit, the command is a no-op then
+    LfgQueueCommand command;
+    command.type = LfgQueueCommand::LFG_QUEUE_REMOVE;
+    command.unitId = unitId;
+    m_commands.add(command);
+
+    LfgQueueUnit const& unit = itr->second.unit;
+    for (LfgQueueMemberList::const_iterator mItr = unit.members.begin(); mItr != unit.members.end(); ++mItr)
+    {
+        m_playerUnits.erase(mItr->guid);
+
+        if (notify)
+            if (Player* player = sObjectMgr.GetPlayer(mItr->guid))
+                player->GetSession()->SendLfgUpdate(unit.IsGroup(), LFG_UPDATE_LEAVE, 0);
+    }
+
+    m_units.erase(itr);
+}
+
+void LFGMgr::Join(Player* player, uint8 roles, LfgDungeonList const& dungeons)
+{
+    WorldSession* session = player->GetSession();
+
+    if (!m_queueThread)
+    {
+        session->SendLfgJoinResult(ERR_LFG_NO_LFG_OBJECT);
+        return;
+    }
+
+    if (dungeons.empty() || !CanQueueForDungeons(player, dungeons))
+    {
+        session->SendLfgJoinResult(ERR_LFG_INVALID_SLOT);
+        return;
+    }
+
+    if (player->InBattleGroundQueue() || player->InBattleGround())
+    {
+        session->SendLfgJoinResult(ERR_LFG_CANT_USE_DUNGEONS);
+        return;
+    }
+
+    // joining again replaces the previous request
+    if (GetState(player->GetObjectGuid()) != LFG_STATE_NONE)
+        Leave(player);
+
+    Group* group = player->GetGroup();
+    if (!group)
+    {
+        if (!(roles & LFG_ROLE_MASK_ANY))
+        {
+            session->SendLfgJoinResult(ERR_LFG_ROLE_CHECK_FAILED);
+            return;
+        }
+
+        LfgQueueUnit unit;
+        unit.unitId = m_nextUnitId++;
+        unit.members.push_back(LfgQueueMember(player->GetObjectGuid(), roles & LFG_ROLE_MASK_ANY));
+        unit.dungeons = dungeons;
+        unit.joinTime = WorldTimer::getMSTime();
+
+        QueueUnit(unit);
+
+        session->SendLfgJoinResult(ERR_LFG_OK);
+        session->SendLfgUpdate(false, LFG_UPDATE_JOIN, dungeons[0]);
+        return;
+    }
+
+    if (!group->IsLeader(player->GetObjectGuid()))
+    {
+        session->SendLfgJoinResult(ERR_LFG_NO_SLOTS_PARTY);
+        return;
+    }
+
+    if (group->isRaidGroup() || group->GetMembersCount() > MAX_LFG_GROUP_SIZE)
+    {
+        session->SendLfgJoinResult(ERR_LFG_TOO_MANY_MEMBERS);
+        return;
+    }
+
+    if (m_roleChecks.find(group->GetObjectGuid()) != m_roleChecks.end())
+        return;
+
+    LfgRoleCheck check;
+    check.leaderGuid = player->GetObjectGuid();
+    check.dungeons = dungeons;
+    check.expireTime = time(NULL) + sWorld.getConfig(CONFIG_UINT32_LFG_ROLECHECK_TIMEOUT);
+
+    for (GroupReference* itr = group->GetFirstMember(); itr != NULL; itr = itr->next())
+    {
+        Player* member = itr->getSource();
+        if (!member || !member->IsInWorld())
+        {
+            session->SendLfgJoinResult(ERR_LFG_MEMBERS_NOT_PRESENT);
+            return;
+        }
+
+        if (member != player && GetState(member->GetObjectGuid()) != LFG_STATE_NONE)
+        {
+            session->SendLfgJoinResult(ERR_LFG_NO_SLOTS_PARTY);
+            return;
+        }
+
+        if (member != player && !CanQueueForDungeons(member, dungeons))
+        {
+            session->SendLfgJoinResult(ERR_LFG_MISMATCHED_SLOTS);
+            return;
+        }
+
+        check.roles[member->GetObjectGuid()] = LFG_ROLE_NONE;
+    }
+
+    check.roles[player->GetObjectGuid()] = roles & LFG_ROLE_MASK_ANY;
+
+    LfgRoleCheck& stored = m_roleChecks[group->GetObjectGuid()];
+    stored = check;
+
+    session->SendLfgJoinResult(ERR_LFG_OK);
+    SendRoleCheckUpdate(stored, LFG_ROLECHECK_INITIALITING, true);
+
+    if (!(roles & LFG_ROLE_MASK_ANY))
+    {
+        FailRoleCheck(group->GetObjectGuid(), stored, LFG_ROLECHECK_NO_ROLE);
+        m_roleChecks.erase(group->GetObjectGuid());
+    }
+    else if (group->GetMembersCount() == 1)
+    {
+        FinishRoleCheck(group->GetObjectGuid(), stored);
+        m_roleChecks.erase(group->GetObjectGuid());
+    }
+}
+
+/// Dungeon ids come from the client, only dungeons a formed group can be teleported to are accepted
+bool LFGMgr::CanQueueForDungeons(Player* player, LfgDungeonList const& dungeons) const
+{
+    for (LfgDungeonList::const_iterator itr = dungeons.begin(); itr != dungeons.end(); ++itr)
+    {
+        LfgDungeonEntry const* dungeon = GetDungeon(*itr);
+        if (!dungeon)
+            return false;
+
+        if (!sObjectMgr.GetMapEntranceTrigger(dungeon->map))
+            return false;
+
+        MapEntry const* mapEntry = sMapStore.LookupEntry(dungeon->map);
+        if (!mapEntry || mapEntry->Expansion() > player->GetSession()->Expansion())
+            return false;
+    }
+
+    return true;
+}
+
+void LFGMgr::Leave(Player* player)
+{
+    if (Group* group = player->GetGroup())
+    {
+        RoleCheckMap::iterator itr = m_roleChecks.find(group->GetObjectGuid());
+        if (itr != m_roleChecks.end())
+        {
+            FailRoleCheck(itr->first, itr->second, LFG_ROLECHECK_ABORTED);
+            m_roleChecks.erase(itr);
+            return;
+        }
+    }
+
+    PlayerUnitMap::const_iterator pItr = m_playerUnits.find(player->GetObjectGuid());
+    if (pItr == m_playerUnits.end())
+        return;
+
+    uint32 unitId = pItr->second;
+    UnitMap::const_iterator uItr = m_units.find(unitId);
+    if (uItr == m_units.end())
+        return;
+
+    if (uItr->second.state != LFG_STATE_PROPOSAL)
+    {
+        DequeueUnit(unitId, true);
+        return;
+    }
+
+    // leaving while a proposal is pending counts as declining it
+    for (ProposalMap::iterator itr = m_proposals.begin(); itr != m_proposals.end(); ++itr)
+    {
+        if (std::find(itr->second.unitIds.begin(), itr->second.unitIds.end(), unitId) != itr->second.unitIds.end())
+        {
+            ProposalResponse(player, itr->first, false);
+            return;
+        }
+    }
+}
+
+void LFGMgr::OnPlayerLogout(Player* player)
+{
+    Leave(player);
+}
+
+void LFGMgr::SetRoles(Player* player, uint8 roles)
+{
+    Group* group = player->GetGroup();
+    if (!group)
+        return;
+
+    RoleCheckMap::iterator itr = m_roleChecks.find(group->GetObjectGuid());
+    if (itr == m_roleChecks.end())
+        return;
+
+    LfgRoleCheck& check = itr->second;
+    std::map<ObjectGuid, uint8>::iterator rItr = check.roles.find(player->GetObjectGuid());
+    if (rItr == check.roles.end())
+        return;
+
+    rItr->second = roles & LFG_ROLE_MASK_ANY;
+
+    if (!rItr->second)
+    {
+        FailRoleCheck(itr->first, check, LFG_ROLECHECK_NO_ROLE);
+        m_roleChecks.erase(itr);
+        return;
+    }
+
+    for (rItr = check.roles.begin(); rItr != check.roles.end(); ++rItr)
+    {
+        if (!rItr->second)
+        {
+            SendRoleCheckUpdate(check, LFG_ROLECHECK_INITIALITING, false);
+            return;
+        }
+    }
+
+    FinishRoleCheck(itr->first, check);
+    m_roleChecks.erase(itr);
+}
+
+// members of a premade group get exactly one role each, capped by the party composition
+static bool AssignRoles(std::vector<std::pair<ObjectGuid, uint8> > const& offered, size_t index, uint8* left, LfgQueueMemberList& assigned)
+{
+    if (index == offered.size())
+        return true;
+
+    for (int32 slot = 0; slot < MAX_LFG_SLOTS; ++slot)
+    {
+        if (!left[slot] || !(offered[index].second & LfgSlotRole[slot]))
+            continue;
+
+        --left[slot];
+        assigned.push_back(LfgQueueMember(offered[index].first, LfgSlotRole[slot]));
+
+        if (AssignRoles(offered, index + 1, left, assigned))
+            return true;
+
+        assigned.pop_back();
+        ++left[slot];
+    }
+
+    return false;
+}
+
+bool LFGMgr::AssignGroupRoles(std::map<ObjectGuid, uint8> const& offered, LfgQueueMemberList& assigned)
+{
+    std::vector<std::pair<ObjectGuid, uint8> > list(offered.begin(), offered.end());
+
+    uint8 left[MAX_LFG_SLOTS];
+    memcpy(left, LfgSlotsNeeded, sizeof(left));
+
+    assigned.clear();
+    return AssignRoles(list, 0, left, assigned);
+}
+
+void LFGMgr::FinishRoleCheck(ObjectGuid groupGuid, LfgRoleCheck& check)
+{
+    LfgQueueUnit unit;
+    if (!AssignGroupRoles(check.roles, unit.members))
+    {
+        FailRoleCheck(groupGuid, check, LFG_ROLECHECK_WRONG_ROLES);
+        return;
+    }
+
+    unit.unitId = m_nextUnitId++;
+    unit.groupGuid = groupGuid;
+    unit.dungeons = check.dungeons;
+    unit.joinTime = WorldTimer::getMSTime();
+
+    QueueUnit(unit);
+
+    SendRoleCheckUpdate(check, LFG_ROLECHECK_FINISHED, false);
+
+    for (LfgQueueMemberList::const_iterator itr = unit.members.begin(); itr != unit.members.end(); ++itr)
+        if (Player* member = sObjectMgr.GetPlayer(itr->guid))
+            member->GetSession()->SendLfgUpdate(true, LFG_UPDATE_JOIN, check.dungeons[0]);
+}
+
+void LFGMgr::FailRoleCheck(ObjectGuid /*groupGuid*/, LfgRoleCheck const& check, LfgRoleCheckState state)
+{
+    SendRoleCheckUpdate(check, state, false);
+
+    if (Player* leader = sObjectMgr.GetPlayer(check.leaderGuid))
+        leader->GetSession()->SendLfgJoinResult(ERR_LFG_ROLE_CHECK_FAILED);
+
+    for (std::map<ObjectGuid, uint8>::const_iterator itr = check.roles.begin(); itr != check.roles.end(); ++itr)
+        if (Player* member = sObjectMgr.GetPlayer(itr->first))
+            member->GetSession()->SendLfgUpdate(true, LFG_UPDATE_LEAVE, 0);
+}
+
+void LFGMgr::HandleMatch(LfgMatch const& match)
+{
+    // every unit must still wait for the dungeon and every member be online
+    bool valid = true;
+    for (std::vector<uint32>::const_iterator itr = match.unitIds.begin(); itr != match.unitIds.end(); ++itr)
+    {
+        UnitMap::const_iterator uItr = m_units.find(*itr);
+        if (uItr == m_units.end() || uItr->second.state != LFG_STATE_QUEUED)
+        {
+            valid = false;
+            continue;
+        }
+
+        for (LfgQueueMemberList::const_iterator mItr = uItr->second.unit.members.begin(); mItr != uItr->second.unit.members.end(); ++mItr)
+            if (!sObjectMgr.GetPlayer(mItr->guid))
+                valid = false;
+    }
+
+    if (!valid)
+    {
+        // the matching thread dropped these units, give the remaining ones their place back
+        for (std::vector<uint32>::const_iterator itr = match.unitIds.begin(); itr != match.unitIds.end(); ++itr)
+        {
+            UnitMap::const_iterator uItr = m_units.find(*itr);
+            if (uItr == m_units.end() || uItr->second.state != LFG_STATE_QUEUED)
+                continue;
+
+            bool online = true;
+            for (LfgQueueMemberList::const_iterator mItr = uItr->second.unit.members.begin(); mItr != uItr->second.unit.members.end(); ++mItr)
+                if (!sObjectMgr.GetPlayer(mItr->guid))
+                    online = false;
+
+            if (online)
+            {
+                LfgQueueUnit unit = uItr->second.unit;
+                QueueUnit(unit);
+            }
+            else
+                DequeueUnit(*itr, true);
+        }
+        return;
+    }
+
+    uint32 proposalId = m_nextProposalId++;
+
+    LfgProposal& proposal = m_proposals[proposalId];
+    proposal.dungeonId = match.dungeonId;
+    proposal.unitIds = match.unitIds;
+    proposal.members = match.members;
+    proposal.expireTime = time(NULL) + sWorld.getConfig(CONFIG_UINT32_LFG_PROPOSAL_TIMEOUT);
+
+    for (std::vector<uint32>::const_iterator itr = match.unitIds.begin(); itr != match.unitIds.end(); ++itr)
+        m_units[*itr].state = LFG_STATE_PROPOSAL;
+
+    SendProposalUpdate(proposalId, proposal, LFG_PROPOSAL_INITIATING);
+}
+
+void LFGMgr::ProposalResponse(Player* player, uint32 proposalId, bool accept)
+{
+    ProposalMap::iterator itr = m_proposals.find(proposalId);
+    if (itr == m_proposals.end())
+        return;
+
+    LfgProposal& proposal = itr->second;
+
+    bool isMember = false;
+    for (LfgQueueMemberList::const_iterator mItr = proposal.members.begin(); mItr != proposal.members.end(); ++mItr)
+        if (mItr->guid == player->GetObjectGuid())
+            isMember = true;
+
+    if (!isMember)
+        return;
+
+    proposal.answers[player->GetObjectGuid()] = accept;
+
+    if (!accept)
+    {
+        FailProposal(proposalId, proposal);
+        m_proposals.erase(itr);
+        return;
+    }
+
+    if (proposal.answers.size() < proposal.members.size())
+    {
+        SendProposalUpdate(proposalId, proposal, LFG_PROPOSAL_INITIATING);
+        return;
+    }
+
+    FinishProposal(proposalId, proposal);
+    m_proposals.erase(itr);
+}
+
+void LFGMgr::FailProposal(uint32 proposalId, LfgProposal& proposal)
+{
+    SendProposalUpdate(proposalId, proposal, LFG_PROPOSAL_FAILED);
+
+    // units with a member that declined or did not answer leave the queue, the others keep their place
+    for (std::vector<uint32>::const_iterator itr = proposal.unitIds.begin(); itr != proposal.unitIds.end(); ++itr)
+    {
+        UnitMap::iterator uItr = m_units.find(*itr);
+        if (uItr == m_units.end())
+            continue;
+
+        bool accepted = true;
+        for (LfgQueueMemberList::const_iterator mItr = uItr->second.unit.members.begin(); mItr != uItr->second.unit.members.end(); ++mItr)
+        {
+            std::map<ObjectGuid, bool>::const_iterator aItr = proposal.answers.find(mItr->guid);
+            if (aItr == proposal.answers.end() || !aItr->second || !sObjectMgr.GetPlayer(mItr->guid))
+                accepted = false;
+        }
+
+        if (accepted)
+        {
+            LfgQueueUnit unit = uItr->second.unit;
+            QueueUnit(unit);
+        }
+        else
+            DequeueUnit(*itr, true);
+    }
+}
+
+void LFGMgr::FinishProposal(uint32 proposalId, LfgProposal& proposal)
+{
+    // a premade group keeps its group and gets the solo players added
+    Group* group = NULL;
+    for (std::vector<uint32>::const_iterator itr = proposal.unitIds.begin(); itr != proposal.unitIds.end(); ++itr)
+    {
+        UnitMap::const_iterator uItr = m_units.find(*itr);
+        if (uItr != m_units.end() && uItr->second.unit.IsGroup())
+            group = sObjectMgr.GetGroupById(uItr->second.unit.groupGuid.GetCounter());
+    }
+
+    if (!group)
+    {
+        Player* leader = NULL;
+        for (LfgQueueMemberList::const_iterator itr = proposal.members.begin(); itr != proposal.members.end() && !leader; ++itr)
+            leader = sObjectMgr.GetPlayer(itr->guid);
+
+        if (!leader)
+        {
+            FailProposal(proposalId, proposal);
+            return;
+        }
+
+        if (leader->GetGroup())
+            leader->RemoveFromGroup();
+
+        group = new Group;
+        if (!group->Create(leader->GetObjectGuid(), leader->GetName()))
+        {
+            delete group;
+            FailProposal(proposalId, proposal);
+            return;
+        }
+        sObjectMgr.AddGroup(group);
+    }
+
+    SendProposalUpdate(proposalId, proposal, LFG_PROPOSAL_SUCCESS);
+
+    for (LfgQueueMemberList::const_iterator itr = proposal.members.begin(); itr != proposal.members.end(); ++itr)
+    {
+        Player* member = sObjectMgr.GetPlayer(itr->guid);
+        if (!member || member->GetGroup() == group)
+            continue;
+
+        if (member->GetGroup())
+            member->RemoveFromGroup();
+
+        group->AddMember(member->GetObjectGuid(), member->GetName());
+    }
+
+    if (LfgDungeonEntry const* dungeon = GetDungeon(proposal.dungeonId))
+    {
+        if (dungeon->difficulty != group->GetDungeonDifficulty())
+            group->SetDungeonDifficulty(dungeon->difficulty);
+
+        if (AreaTrigger const* at = sObjectMgr.GetMapEntranceTrigger(dungeon->map))
+        {
+            for (LfgQueueMemberList::const_iterator itr = proposal.members.begin(); itr != proposal.members.end(); ++itr)
+                if (Player* member = sObjectMgr.GetPlayer(itr->guid))
+                    member->TeleportTo(at->target_mapId, at->target_X, at->target_Y, at->target_Z, at->target_Orientation);
+        }
+    }
+
+    // the matching thread does not know these units anymore, only local state is left
+    for (std::vector<uint32>::const_iterator itr = proposal.unitIds.begin(); itr != proposal.unitIds.end(); ++itr)
+    {
+        UnitMap::iterator uItr = m_units.find(*itr);
+        if (uItr == m_units.end())
+            continue;
+
+        for (LfgQueueMemberList::const_iterator mItr = uItr->second.unit.members.begin(); mItr != uItr->second.unit.members.end(); ++mItr)
+            m_playerUnits.erase(mItr->guid);
+
+        m_units.erase(uItr);
+    }
+}
+
+void LFGMgr::Update(uint32 diff)
+{
+    LfgMatch match;
+    while (m_matches.next(match))
+        HandleMatch(match);
+
+    m_timeoutTimer.Update(diff);
+    if (!m_timeoutTimer.Passed())
+        return;
+
+    m_timeoutTimer.Reset();
+
+    time_t now = time(NULL);
+
+    for (RoleCheckMap::iterator itr = m_roleChecks.begin(); itr != m_roleChecks.end();)
+    {
+        if (itr->second.expireTime < now)
+        {
+            FailRoleCheck(itr->first, itr->second, LFG_ROLECHECK_MISSING_ROLE);
+            m_roleChecks.erase(itr++);
+        }
+        else
+            ++itr;
+    }
+
+    for (ProposalMap::iterator itr = m_proposals.begin(); itr != m_proposals.end();)
+    {
+        if (itr->second.expireTime < now)
+        {
+            FailProposal(itr->first, itr->second);
+            m_proposals.erase(itr++);
+        }
+        else
+            ++itr;
+    }
+}
+
+void LFGMgr::SendRoleCheckUpdate(LfgRoleCheck const& check, LfgRoleCheckState state, bool beginning)
+{
+    WorldPacket data(SMSG_LFG_ROLE_CHECK_UPDATE, 4 + 1 + 1 + check.dungeons.size() * 4 + 1 + check.roles.size() * (8 + 1 + 4 + 1));
+    data << uint32(state);
+    data << uint8(beginning);
+    data << uint8(check.dungeons.size());
+    for (LfgDungeonList::const_iterator itr = check.dungeons.begin(); itr != check.dungeons.end(); ++itr)
+        data << uint32(*itr);
+
+    data << uint8(check.roles.size());
+    for (std::map<ObjectGuid, uint8>::const_iterator itr = check.roles.begin(); itr != check.roles.end(); ++itr)
+    {
+        Player* member = sObjectMgr.GetPlayer(itr->first);
+        uint8 roles = itr->second;
+        if (itr->first == check.leaderGuid)
+            roles |= LFG_ROLE_LEADER;
+
+        data << itr->first;
+        data << uint8(itr->second != LFG_ROLE_NONE);
+        data << uint32(roles);
+        data << uint8(member ? member->getLevel() : 0);
+    }
+
+    for (std::map<ObjectGuid, uint8>::const_iterator itr = check.roles.begin(); itr != check.roles.end(); ++itr)
+        if (Player* member = sObjectMgr.GetPlayer(itr->first))
+            member->GetSession()->SendPacket(&data);
+}
+
+void LFGMgr::SendProposalUpdate(uint32 proposalId, LfgProposal const& proposal, LfgProposalState state)
+{
+    for (LfgQueueMemberList::const_iterator rItr = proposal.members.begin(); rItr != proposal.members.end(); ++rItr)
+    {
+        Player* receiver = sObjectMgr.GetPlayer(rItr->guid);
+        if (!receiver)
+            continue;
+
+        PlayerUnitMap::const_iterator rUnit = m_playerUnits.find(rItr->guid);
+
+        WorldPacket data(SMSG_LFG_PROPOSAL_UPDATE, 4 + 1 + 4 + 4 + 1 + 1 + proposal.members.size() * (4 + 5));
+        data << uint32(proposal.dungeonId);
+        data << uint8(state);
+        data << uint32(proposalId);
+        data << uint32(0);                                  // completed encounters mask
+        data << uint8(0);                                   // silent
+        data << uint8(proposal.members.size());
+
+        for (LfgQueueMemberList::const_iterator itr = proposal.members.begin(); itr != proposal.members.end(); ++itr)
+        {
+            PlayerUnitMap::const_iterator mUnit = m_playerUnits.find(itr->guid);
+            std::map<ObjectGuid, bool>::const_iterator answer = proposal.answers.find(itr->guid);
+
+            data << uint32(itr->roles);
+            data << uint8(itr->guid == rItr->guid);         // self
+            data << uint8(0);                               // already in dungeon
+            data << uint8(rUnit != m_playerUnits.end() && mUnit != m_playerUnits.end() && rUnit->second == mUnit->second);
+            data << uint8(answer != proposal.answers.end());
+            data << uint8(answer != proposal.answers.end() && answer->second);
+        }
+
+        receiver->GetSession()->SendPacket(&data);
+    }
+}
@@ -0,0 +1,343 @@
+/*
+ * Copyright (C) 2010-2012 Strawberry-Pr0jcts <http://strawberry-pr0jcts.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * @file LFGMgr.h
+ * Dungeon finder: role-bucketed queues, matching thread and world-thread proposal handling.
+ *
+ * Queue data lives in LfgQueue and is only touched by the matching thread. The world thread
+ * talks to it through two locked queues: LfgQueueCommand (add/remove a unit) going in and
+ * LfgMatch (a complete party for one dungeon) coming out. Role checks, proposals, group
+ * creation and teleport are all done by LFGMgr::Update() on the world thread.
+ */
+
+#ifndef STRAWBERRY_LFGMGR_H
+#define STRAWBERRY_LFGMGR_H
+
+#include "Common.h"
+#include "ObjectGuid.h"
+#include "SharedDefines.h"
+#include "DBCEnums.h"
+#include "Timer.h"
+#include "Policies/Singleton.h"
+#include "LockedQueue.h"
+#include "Threading.h"
+
+#include <ace/Thread_Mutex.h>
+
+class Player;
+class Group;
+
+enum LfgRoles
+{
+    LFG_ROLE_NONE   = 0x00,
+    LFG_ROLE_LEADER = 0x01,
+    LFG_ROLE_TANK   = 0x02,
+    LFG_ROLE_HEALER = 0x04,
+    LFG_ROLE_DAMAGE = 0x08,
+};
+
+#define LFG_ROLE_MASK_ANY   (LFG_ROLE_TANK | LFG_ROLE_HEALER | LFG_ROLE_DAMAGE)
+
+/// Role buckets of one dungeon queue
+enum LfgRoleSlot
+{
+    LFG_SLOT_TANK   = 0,
+    LFG_SLOT_HEALER = 1,
+    LFG_SLOT_DAMAGE = 2,
+    MAX_LFG_SLOTS   = 3
+};
+
+#define MAX_LFG_GROUP_SIZE  5
+
+enum LfgState
+{
+    LFG_STATE_NONE      = 0,
+    LFG_STATE_ROLECHECK = 1,                                // leader joined, waiting for member roles
+    LFG_STATE_QUEUED    = 2,                                // unit is known by the matching thread
+    LFG_STATE_PROPOSAL  = 3,                                // matched, waiting for answers
+};
+
+enum LfgProposalState
+{
+    LFG_PROPOSAL_INITIATING = 0,
+    LFG_PROPOSAL_FAILED     = 1,
+    LFG_PROPOSAL_SUCCESS    = 2,
+};
+
+enum LfgRoleCheckState
+{
+    LFG_ROLECHECK_DEFAULT      = 0,
+    LFG_ROLECHECK_FINISHED     = 1,
+    LFG_ROLECHECK_INITIALITING = 2,
+    LFG_ROLECHECK_MISSING_ROLE = 3,
+    LFG_ROLECHECK_WRONG_ROLES  = 4,
+    LFG_ROLECHECK_ABORTED      = 5,
+    LFG_ROLECHECK_NO_ROLE      = 6,
+};
+
+typedef std::vector<uint32> LfgDungeonList;
+
+/// Dungeon finder data from `lfg_dungeons`, used for teleport and difficulty of formed groups
+struct LfgDungeonEntry
+{
+    uint32 id;
+    uint32 map;
+    Difficulty difficulty;
+};
+
+/// One member of a queue unit; for premade groups roles holds the single role assigned at role check
+struct LfgQueueMember
+{
+    LfgQueueMember() : roles(LFG_ROLE_NONE) {}
+    LfgQueueMember(ObjectGuid _guid, uint8 _roles) : guid(_guid), roles(_roles) {}
+
+    ObjectGuid guid;
+    uint8 roles;
+};
+
+typedef std::vector<LfgQueueMember> LfgQueueMemberList;
+
+/// Solo player or premade group waiting in the queue as one indivisible entry
+struct LfgQueueUnit
+{
+    LfgQueueUnit() : unitId(0), joinTime(0) {}
+
+    bool IsGroup() const { return !groupGuid.IsEmpty(); }
+
+    uint32 unitId;
+    ObjectGuid groupGuid;
+    LfgQueueMemberList members;
+    LfgDungeonList dungeons;
+    uint32 joinTime;                                        // WorldTimer::getMSTime() at first join, kept at re-queue
+};
+
+/// Work item posted by the world thread to the matching thread
+struct LfgQueueCommand
+{
+    enum Type
+    {
+        LFG_QUEUE_ADD,
+        LFG_QUEUE_REMOVE,
+    };
+
+    LfgQueueCommand() : type(LFG_QUEUE_REMOVE), unitId(0), unit(NULL) {}
+
+    Type type;
+    uint32 unitId;
+    LfgQueueUnit* unit;                                     // LFG_QUEUE_ADD only, owned by the receiver
+};
+
+/// Party found by the matching thread, handed back to the world thread
+struct LfgMatch
+{
+    uint32 dungeonId;
+    std::vector<uint32> unitIds;
+    LfgQueueMemberList members;                             // roles are the single role each member fills
+    uint32 waitTime;                                        // wait of the oldest unit in ms
+};
+
+/// Snapshot of queue metrics filled by the matching thread
+struct LfgQueueStatistic
+{
+    LfgQueueStatistic() : units(0), dungeons(0), matches(0), avgWaitTime(0), maxWaitTime(0), lastUpdateTime(0)
+    {
+        for (int i = 0; i < MAX_LFG_SLOTS; ++i)
+            players[i] = 0;
+    }
+
+    uint32 units;                                           // queued solo players and groups
+    uint32 players[MAX_LFG_SLOTS];                          // queued players able to fill a slot (flex players counted per role)
+    uint32 dungeons;                                        // dungeons with at least one queued unit
+    uint32 matches;                                         // parties formed since start
+    uint32 avgWaitTime;                                     // average wait of the last matched parties, ms
+    uint32 maxWaitTime;                                     // wait of the oldest queued unit, ms
+    uint32 lastUpdateTime;                                  // duration of the last matching pass, ms
+};
+
+/**
+ * Queue storage and matcher, owned by the matching thread.
+ *
+ * Every dungeon has one FIFO bucket per role for solo players (a flex player is linked into
+ * each bucket of the roles it offers) and one FIFO list for premade groups. Only dungeons that
+ * received new units since their last failed pass are examined, and filling a party takes at
+ * most a few bucket heads, so a pass does not depend on the total queue size.
+ */
+class LfgQueue
+{
+    public:
+        LfgQueue() : m_matches(0), m_matchedWaitTime(0), m_matchedCount(0) {}
+        ~LfgQueue();
+
+        void AddUnit(LfgQueueUnit* unit);
+        void RemoveUnit(uint32 unitId);
+
+        /// Form up to maxMatches parties from dungeons touched since the last call
+        void FindMatches(std::vector<LfgMatch>& matches, uint32 maxMatches);
+
+        void GetStatistic(LfgQueueStatistic& stats) const;
+
+    private:
+        typedef std::list<LfgQueueUnit*> UnitList;
+
+        struct DungeonQueue
+        {
+            UnitList solo[MAX_LFG_SLOTS];
+            UnitList groups;
+        };
+
+        struct UnitPosition
+        {
+            uint32 dungeonId;
+            int32 slot;                                     // -1 for the group list
+            UnitList::iterator itr;
+        };
+
+        struct UnitEntry
+        {
+            LfgQueueUnit* unit;
+            std::vector<UnitPosition> positions;
+        };
+
+        typedef UNORDERED_MAP<uint32, UnitEntry> UnitMap;
+        typedef UNORDERED_MAP<uint32, DungeonQueue> DungeonQueueMap;
+
+        UnitList::iterator InsertByJoinTime(UnitList& list, LfgQueueUnit* unit);
+        bool TryMatch(uint32 dungeonId, DungeonQueue& queue, LfgMatch& match);
+        bool FillFromSolo(DungeonQueue& queue, uint8 const* need, std::vector<LfgQueueUnit*>& picked, LfgQueueMemberList& members);
+
+        UnitMap m_units;
+        DungeonQueueMap m_queues;
+        std::set<uint32> m_dirty;
+
+        uint32 m_matches;
+        uint32 m_matchedWaitTime;                           // sum of the recent match wait times
+        uint32 m_matchedCount;                              // number of values in m_matchedWaitTime
+};
+
+/// Thread driving LfgQueue at a fixed cadence
+class LfgQueueRunnable : public ACE_Based::Runnable
+{
+    public:
+        explicit LfgQueueRunnable(uint32 interval) : m_interval(interval) {}
+        void run();
+
+    private:
+        uint32 m_interval;
+};
+
+class LFGMgr
+{
+    friend class LfgQueueRunnable;
+
+    public:
+        LFGMgr();
+        ~LFGMgr();
+
+        void LoadDungeons();
+        void Initialize();
+        void StopQueueThread();
+
+        /// Process matches, proposals and role check timeouts, called from World::Update
+        void Update(uint32 diff);
+
+        // world thread requests from packet handlers
+        void Join(Player* player, uint8 roles, LfgDungeonList const& dungeons);
+        void Leave(Player* player);
+        void SetRoles(Player* player, uint8 roles);
+        void ProposalResponse(Player* player, uint32 proposalId, bool accept);
+
+        /// Remove a player from any queue/proposal state, safe to call for players not queued
+        void OnPlayerLogout(Player* player);
+
+        LfgState GetState(ObjectGuid guid) const;
+        LfgDungeonEntry const* GetDungeon(uint32 dungeonId) const;
+
+        void GetStatistic(LfgQueueStatistic& stats, uint32& roleChecks, uint32& proposals) const;
+
+    private:
+        struct LfgRoleCheck
+        {
+            ObjectGuid leaderGuid;
+            LfgDungeonList dungeons;
+            std::map<ObjectGuid, uint8> roles;              // LFG_ROLE_NONE until answered
+            time_t expireTime;
+        };
+
+        struct LfgProposal
+        {
+            uint32 dungeonId;
+            std::vector<uint32> unitIds;
+            LfgQueueMemberList members;
+            std::map<ObjectGuid, bool> answers;             // only answered members
+            time_t expireTime;
+        };
+
+        /// World thread copy of a queued unit
+        struct LfgUnitState
+        {
+            LfgUnitState() : state(LFG_STATE_NONE) {}
+
+            LfgQueueUnit unit;
+            LfgState state;
+        };
+
+        typedef UNORDERED_MAP<uint32, LfgUnitState> UnitMap;
+        typedef std::map<ObjectGuid, uint32> PlayerUnitMap;
+        typedef std::map<ObjectGuid, LfgRoleCheck> RoleCheckMap;
+        typedef std::map<uint32, LfgProposal> ProposalMap;
+        typedef UNORDERED_MAP<uint32, LfgDungeonEntry> DungeonMap;
+
+        void QueueUnit(LfgQueueUnit const& unit);
+        void DequeueUnit(uint32 unitId, bool notify);
+        void HandleMatch(LfgMatch const& match);
+        void FinishRoleCheck(ObjectGuid groupGuid, LfgRoleCheck& check);
+        void FailRoleCheck(ObjectGuid groupGuid, LfgRoleCheck const& check, LfgRoleCheckState state);
+        void FinishProposal(uint32 proposalId, LfgProposal& proposal);
+        void FailProposal(uint32 proposalId, LfgProposal& proposal);
+        void SendRoleCheckUpdate(LfgRoleCheck const& check, LfgRoleCheckState state, bool beginning);
+        void SendProposalUpdate(uint32 proposalId, LfgProposal const& proposal, LfgProposalState state);
+
+        bool CanQueueForDungeons(Player* player, LfgDungeonList const& dungeons) const;
+
+        static bool AssignGroupRoles(std::map<ObjectGuid, uint8> const& offered, LfgQueueMemberList& assigned);
+
+        // world thread state
+        UnitMap m_units;
+        PlayerUnitMap m_playerUnits;
+        RoleCheckMap m_roleChecks;
+        ProposalMap m_proposals;
+        DungeonMap m_dungeons;
+        uint32 m_nextUnitId;
+        uint32 m_nextProposalId;
+        ShortIntervalTimer m_timeoutTimer;
+
+        // cross thread exchange
+        ACE_Based::LockedQueue<LfgQueueCommand, ACE_Thread_Mutex> m_commands;
+        ACE_Based::LockedQueue<LfgMatch, ACE_Thread_Mutex> m_matches;
+
+        mutable ACE_Thread_Mutex m_statLock;
+        LfgQueueStatistic m_stats;
+
+        ACE_Based::Thread* m_queueThread;
+        volatile bool m_stopQueueThread;
+};
+
+#define sLFGMgr Strawberry::Singleton<LFGMgr>::Instance()
+
+#endif
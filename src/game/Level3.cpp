@@ -51,11 +51,17 @@
 #include "Util.h"
 #include "ItemEnchantmentMgr.h"
 #include "BattleGroundMgr.h"
+#include "LFGMgr.h"
+#include "PerfStatsMgr.h"
+#include "PerfGridBenchmark.h"
+#include "TemporarySummon.h"
+#include "QueryResponseCache.h"
 #include "MapPersistentStateMgr.h"
 #include "InstanceData.h"
 #include "CreatureEventAIMgr.h"
 #include "DBCEnums.h"
 #include "AuctionHouseBot/AuctionHouseBot.h"
+#include "Policies/MemoryStats.h"
 
 static uint32 ahbotQualityIds[MAX_AUCTION_QUALITY] =
 {
@@ -629,6 +635,7 @@ bool ChatHandler::HandleReloadNpcTextCommand(char* /*args*/)
 {
     sLog.outString( "Re-Loading `npc_text` Table!" );
     sObjectMgr.LoadGossipText();
+    sQueryResponseCache.Clear(QUERY_RESPONSE_NPC_TEXT);
     SendGlobalSysMessage("DB table `npc_text` reloaded.");
     return true;
 }
@@ -670,6 +677,7 @@ bool ChatHandler::HandleReloadQuestPOICommand(char* /*args*/)
 {
     sLog.outString( "Re-Loading `quest_poi` and `quest_poi_points` Tables!" );
     sObjectMgr.LoadQuestPOI();
+    sQueryResponseCache.Clear(QUERY_RESPONSE_QUEST_POI);
     SendGlobalSysMessage("DB Table `quest_poi` and `quest_poi_points` reloaded.");
     return true;
 }
@@ -822,6 +830,7 @@ bool ChatHandler::HandleReloadPageTextsCommand(char* /*args*/)
 {
     sLog.outString( "Re-Loading Page Texts..." );
     sObjectMgr.LoadPageTexts();
+    sQueryResponseCache.Clear(QUERY_RESPONSE_PAGE_TEXT);
     SendGlobalSysMessage("DB table `page_texts` reloaded.");
     return true;
 }
@@ -1025,6 +1034,7 @@ bool ChatHandler::HandleReloadLocalesCreatureCommand(char* /*args*/)
 {
     sLog.outString( "Re-Loading Locales Creature ...");
     sObjectMgr.LoadCreatureLocales();
+    sQueryResponseCache.Clear(QUERY_RESPONSE_CREATURE);
     SendGlobalSysMessage("DB table `locales_creature` reloaded.");
     return true;
 }
@@ -1033,6 +1043,7 @@ bool ChatHandler::HandleReloadLocalesGameobjectCommand(char* /*args*/)
 {
     sLog.outString( "Re-Loading Locales Gameobject ... ");
     sObjectMgr.LoadGameObjectLocales();
+    sQueryResponseCache.Clear(QUERY_RESPONSE_GAMEOBJECT);
     SendGlobalSysMessage("DB table `locales_gameobject` reloaded.");
     return true;
 }
@@ -1057,6 +1068,7 @@ bool ChatHandler::HandleReloadLocalesNpcTextCommand(char* /*args*/)
 {
     sLog.outString( "Re-Loading Locales NPC Text ... ");
     sObjectMgr.LoadGossipTextLocales();
+    sQueryResponseCache.Clear(QUERY_RESPONSE_NPC_TEXT);
     SendGlobalSysMessage("DB table `locales_npc_text` reloaded.");
     return true;
 }
@@ -1065,6 +1077,7 @@ bool ChatHandler::HandleReloadLocalesPageTextCommand(char* /*args*/)
 {
     sLog.outString( "Re-Loading Locales Page Text ... ");
     sObjectMgr.LoadPageTextLocales();
+    sQueryResponseCache.Clear(QUERY_RESPONSE_PAGE_TEXT);
     SendGlobalSysMessage("DB table `locales_page_text` reloaded.");
     return true;
 }
@@ -6553,6 +6566,528 @@ bool ChatHandler::HandleInstanceStatsCommand(char* /*args*/)
     PSendSysMessage("instance saves: %d", numSaves);
     PSendSysMessage("players bound: %d", numBoundPlayers);
     PSendSysMessage("groups bound: %d", numBoundGroups);
+
+    uint32 numJobs, numDeleted, numPendingMaps;
+    sMapPersistentStateMgr.GetResetStatistics(numJobs, numDeleted, numPendingMaps);
+    PSendSysMessage("global resets in progress: %u, instances deleted: %u, maps waiting for reset: %u", numJobs, numDeleted, numPendingMaps);
+    return true;
+}
+
+bool ChatHandler::HandleLfgStatsCommand(char* /*args*/)
+{
+    LfgQueueStatistic stats;
+    uint32 roleChecks, proposals;
+    sLFGMgr.GetStatistic(stats, roleChecks, proposals);
+
+    PSendSysMessage("queued units: %u, dungeons: %u", stats.units, stats.dungeons);
+    PSendSysMessage("queued tanks: %u, healers: %u, damage: %u", stats.players[LFG_SLOT_TANK], stats.players[LFG_SLOT_HEALER], stats.players[LFG_SLOT_DAMAGE]);
+    PSendSysMessage("parties formed: %u, average wait: %u ms, longest wait: %u ms", stats.matches, stats.avgWaitTime, stats.maxWaitTime);
+    PSendSysMessage("role checks: %u, proposals: %u", roleChecks, proposals);
+    PSendSysMessage("last matching pass: %u ms", stats.lastUpdateTime);
+    return true;
+}
+
+bool ChatHandler::HandlePerfStatsCommand(char* /*args*/)
+{
+    if (!sPerfStatsMgr.IsEnabled())
+        SendSysMessage("Tick profiling is disabled (PerfStats.Enable), values below are not updated.");
+
+    for (uint32 i = 0; i < MAX_PERF_PROBES; ++i)
+    {
+        PerfHistogram const& hist = sPerfStatsMgr.GetHistogram(PerfProbe(i));
+        PSendSysMessage("%-20s count: " UI64FMTD ", avg: %u us, p50: %u us, p95: %u us, p99: %u us, max: %u us",
+            PerfStatsMgr::GetProbeName(PerfProbe(i)), hist.GetCount(), hist.GetAverage(),
+            hist.GetPercentile(50), hist.GetPercentile(95), hist.GetPercentile(99), hist.GetMax());
+    }
+    return true;
+}
+
+static void PrintPerfGridRow(ChatHandler* handler, char const* name, PerfHistogram const& hist, uint32 objects)
+{
+    handler->PSendSysMessage("%-22s objects: %u, avg: %u us, p50: %u us, p99: %u us, max: %u us",
+        name, objects, hist.GetAverage(), hist.GetPercentile(50), hist.GetPercentile(99), hist.GetMax());
+}
+
+// .perf grid [#iterations]
+// Times the read only grid visitors and unit index queries of a map tick at the player position #iterations times
+// each. Nothing is spawned and nothing is sent to clients, the density is whatever the map holds there, e.g. load
+// bots gathered at the same spot. The whole run blocks the map update of the player. See .perf gridbench for the
+// notifiers that send packets, at a chosen density.
+bool ChatHandler::HandlePerfGridCommand(char* args)
+{
+    uint32 iterations;
+    if (!ExtractOptUInt32(&args, iterations, 100) || !iterations)
+        return false;
+
+    Player* player = m_session->GetPlayer();
+    Map* map = player->GetMap();
+    float radius = map->GetVisibilityDistance();
+
+    PSendSysMessage("Grid benchmark on map %u, %u iterations, radius %.1f:", map->GetId(), iterations, radius);
+
+    PerfHistogram hist;
+    uint32 objects = 0;
+
+    for (uint32 i = 0; i < iterations; ++i)
+    {
+        PerfGridObjectCounter counter;
+        ACE_Time_Value start = ACE_OS::gettimeofday();
+        Cell::VisitAllObjects(player, counter, radius);
+        hist.Add(PerfStatsMgr::GetElapsedTime(start));
+        objects = counter.i_count;
+    }
+    PrintPerfGridRow(this, "Cell::Visit", hist, objects);
+
+    hist.Reset();
+    std::list<Player*> players;
+    for (uint32 i = 0; i < iterations; ++i)
+    {
+        players.clear();
+        Strawberry::AnyPlayerInObjectRangeCheck check(player, radius);
+        Strawberry::PlayerListSearcher<Strawberry::AnyPlayerInObjectRangeCheck> searcher(players, check);
+        ACE_Time_Value start = ACE_OS::gettimeofday();
+        Cell::VisitWorldObjects(player, searcher, radius);
+        hist.Add(PerfStatsMgr::GetElapsedTime(start));
+    }
+    PrintPerfGridRow(this, "PlayerListSearcher", hist, uint32(players.size()));
+
+    hist.Reset();
+    std::list<Creature*> creatures;
+    for (uint32 i = 0; i < iterations; ++i)
+    {
+        creatures.clear();
+        Strawberry::AnyUnitInObjectRangeCheck check(player, radius);
+        Strawberry::CreatureListSearcher<Strawberry::AnyUnitInObjectRangeCheck> searcher(creatures, check);
+        ACE_Time_Value start = ACE_OS::gettimeofday();
+        Cell::VisitGridObjects(player, searcher, radius);
+        hist.Add(PerfStatsMgr::GetElapsedTime(start));
+    }
+    PrintPerfGridRow(this, "CreatureListSearcher", hist, uint32(creatures.size()));
+
+    hist.Reset();
+    std::list<Unit*> units;
+    for (uint32 i = 0; i < iterations; ++i)
+    {
+        units.clear();
+        Strawberry::AnyUnitInObjectRangeCheck check(player, radius);
+        Strawberry::UnitListSearcher<Strawberry::AnyUnitInObjectRangeCheck> searcher(units, check);
+        ACE_Time_Value start = ACE_OS::gettimeofday();
+        Cell::VisitAllObjects(player, searcher, radius);
+        hist.Add(PerfStatsMgr::GetElapsedTime(start));
+    }
+    PrintPerfGridRow(this, "UnitListSearcher", hist, uint32(units.size()));
+
+    // same searcher fed from the unit index, then the raw index queries without any check on the units
+    UnitSpatialIndex const& index = map->GetUnitIndex();
+    if (index.IsEnabled())
+    {
+        hist.Reset();
+        for (uint32 i = 0; i < iterations; ++i)
+        {
+            units.clear();
+            Strawberry::AnyUnitInObjectRangeCheck check(player, radius);
+            Strawberry::UnitListSearcher<Strawberry::AnyUnitInObjectRangeCheck> searcher(units, check);
+            ACE_Time_Value start = ACE_OS::gettimeofday();
+            Cell::VisitAllUnits(player, searcher, radius);
+            hist.Add(PerfStatsMgr::GetElapsedTime(start));
+        }
+        PrintPerfGridRow(this, "UnitIndex searcher", hist, uint32(units.size()));
+
+        UnitSpatialIndex::UnitVector found;
+        hist.Reset();
+        for (uint32 i = 0; i < iterations; ++i)
+        {
+            found.clear();
+            ACE_Time_Value start = ACE_OS::gettimeofday();
+            index.FindInRadius(player->GetPositionX(), player->GetPositionY(), player->GetPositionZ(), radius, player->GetPhaseMask(), true, found);
+            hist.Add(PerfStatsMgr::GetElapsedTime(start));
+        }
+        PrintPerfGridRow(this, "UnitIndex radius", hist, uint32(found.size()));
+
+        hist.Reset();
+        for (uint32 i = 0; i < iterations; ++i)
+        {
+            found.clear();
+            ACE_Time_Value start = ACE_OS::gettimeofday();
+            index.FindInCone(player->GetPositionX(), player->GetPositionY(), player->GetPositionZ(), player->GetOrientation(),
+                M_PI_F / 2, radius, player->GetPhaseMask(), found);
+            hist.Add(PerfStatsMgr::GetElapsedTime(start));
+        }
+        PrintPerfGridRow(this, "UnitIndex cone 90", hist, uint32(found.size()));
+
+        hist.Reset();
+        for (uint32 i = 0; i < iterations; ++i)
+        {
+            found.clear();
+            ACE_Time_Value start = ACE_OS::gettimeofday();
+            index.FindNearest(player->GetPositionX(), player->GetPositionY(), player->GetPositionZ(), radius, player->GetPhaseMask(), 10, found);
+            hist.Add(PerfStatsMgr::GetElapsedTime(start));
+        }
+        PrintPerfGridRow(this, "UnitIndex nearest 10", hist, uint32(found.size()));
+
+        PSendSysMessage("Unit index: %u units in %u cells", index.GetUnitCount(), index.GetCellCount());
+    }
+
+    return true;
+}
+
+// .perf gridbench #creature_entry #creatures #players [#iterations [#radius [#mapid [#x #y]]]]
+// Loads a private copy of #mapid (13, the test map, by default) outside of the MapManager, spawns #creatures of
+// #creature_entry with a NullCreatureAI and #players on socketless sessions on the #radius disc around #x #y, then
+// times the grid walk, VisibleNotifier, MessageDistDeliverer and ObjectUpdater #iterations times each. The map is
+// deleted afterwards. The world thread is blocked for the whole run.
+bool ChatHandler::HandlePerfGridBenchCommand(char* args)
+{
+    uint32 entry, creatureCount, playerCount;
+    if (!ExtractUInt32(&args, entry) || !ExtractUInt32(&args, creatureCount) || !ExtractUInt32(&args, playerCount) || !playerCount)
+        return false;
+
+    uint32 iterations, mapId;
+    float radius, x, y;
+    if (!ExtractOptUInt32(&args, iterations, 100) || !iterations ||
+        !ExtractOptFloat(&args, radius, World::GetMaxVisibleDistanceOnContinents()) || radius <= 0.0f ||
+        !ExtractOptUInt32(&args, mapId, 13) ||
+        !ExtractOptFloat(&args, x, 0.0f) || !ExtractOptFloat(&args, y, 0.0f))
+        return false;
+
+    CreatureInfo const* cinfo = ObjectMgr::GetCreatureTemplate(entry);
+    if (!cinfo)
+    {
+        PSendSysMessage(LANG_COMMAND_INVALIDCREATUREID, entry);
+        SetSentErrorMessage(true);
+        return false;
+    }
+
+    // the benchmark map must not share its persistent state with a map in use
+    MapEntry const* mapEntry = sMapStore.LookupEntry(mapId);
+    if (!mapEntry || mapEntry->Instanceable() || sMapMgr.FindMap(mapId, 0))
+    {
+        PSendSysMessage("Map %u does not exist, is instanceable or is loaded, pick an unused continent.", mapId);
+        SetSentErrorMessage(true);
+        return false;
+    }
+
+    if (!Strawberry::IsValidMapCoord(x, y))
+    {
+        PSendSysMessage(LANG_INVALID_TARGET_COORD, x, y, mapId);
+        SetSentErrorMessage(true);
+        return false;
+    }
+
+    PerfGridBenchmark benchmark(mapId, x, y, radius);
+    creatureCount = benchmark.SpawnCreatures(cinfo, creatureCount);
+    playerCount = benchmark.SpawnPlayers(playerCount);
+    if (!playerCount)
+    {
+        SendSysMessage("Could not create the benchmark players.");
+        SetSentErrorMessage(true);
+        return false;
+    }
+
+    PSendSysMessage("Grid benchmark on private map %u, %u creatures, %u players, %u iterations, radius %.1f:",
+        mapId, creatureCount, playerCount, iterations, radius);
+
+    benchmark.Run(iterations);
+
+    for (uint32 i = 0; i < MAX_PERF_GRID_STEPS; ++i)
+        PrintPerfGridRow(this, PerfGridBenchmark::GetStepName(PerfGridStep(i)), benchmark.GetHistogram(PerfGridStep(i)),
+            benchmark.GetObjectCount(PerfGridStep(i)));
+
+    return true;
+}
+
+// sort key for .perf opcodes/sessions: [time|count|bytes|sent], handler time by default
+uint32 ChatHandler::ExtractPerfSortKey(char** args)
+{
+    if (ExtractLiteralArg(args, "count"))
+        return 1;
+    if (ExtractLiteralArg(args, "bytes"))
+        return 2;
+    if (ExtractLiteralArg(args, "sent"))
+        return 3;
+
+    ExtractLiteralArg(args, "time");
+    return 0;
+}
+
+typedef std::vector<std::pair<uint64, uint32> > PerfRanking;
+
+static void SortPerfRanking(PerfRanking& ranking, uint32 limit)
+{
+    if (ranking.size() > limit)
+    {
+        std::partial_sort(ranking.begin(), ranking.begin() + limit, ranking.end(), std::greater<std::pair<uint64, uint32> >());
+        ranking.resize(limit);
+    }
+    else
+        std::sort(ranking.begin(), ranking.end(), std::greater<std::pair<uint64, uint32> >());
+}
+
+// .perf maps [#count]
+// Loaded maps ranked by the total time of their Map::Update, with the share of each update phase
+bool ChatHandler::HandlePerfMapsCommand(char* args)
+{
+    uint32 limit;
+    if (!ExtractOptUInt32(&args, limit, 10))
+        return false;
+
+    if (!sPerfStatsMgr.IsEnabled())
+        SendSysMessage("Tick profiling is disabled (PerfStats.Enable), values below are not updated.");
+
+    std::vector<Map const*> maps;
+    PerfRanking ranking;
+
+    MapManager::MapMapType const& mapList = sMapMgr.Maps();
+    for (MapManager::MapMapType::const_iterator itr = mapList.begin(); itr != mapList.end(); ++itr)
+    {
+        uint64 total = itr->second->GetPerfStats().GetUpdateHistogram().GetTotal();
+        if (!total)
+            continue;
+
+        ranking.push_back(std::make_pair(total, uint32(maps.size())));
+        maps.push_back(itr->second);
+    }
+
+    SortPerfRanking(ranking, limit);
+
+    for (PerfRanking::const_iterator itr = ranking.begin(); itr != ranking.end(); ++itr)
+    {
+        Map const* map = maps[itr->second];
+        PerfMapStats const& stats = map->GetPerfStats();
+        PerfHistogram const& hist = stats.GetUpdateHistogram();
+
+        PSendSysMessage("map %u instance %u (%s): " UI64FMTD " updates, " UI64FMTD " us total, avg %u, p99 %u, max %u us",
+            map->GetId(), map->GetInstanceId(), map->GetMapName(), hist.GetCount(), hist.GetTotal(),
+            hist.GetAverage(), hist.GetPercentile(99), hist.GetMax());
+
+        std::ostringstream phases;
+        for (uint32 i = 0; i < MAX_PERF_MAP_PHASES; ++i)
+            phases << (i ? ", " : "  ") << PerfStatsMgr::GetProbeName(PerfProbe(PERF_MAP_SESSIONS + i)) << " "
+                << uint32(stats.GetPhaseTotal(i) * 100 / itr->first) << "%";
+
+        SendSysMessage(phases.str().c_str());
+    }
+
+    return true;
+}
+
+bool ChatHandler::HandlePerfOpcodesCommand(char* args)
+{
+    uint32 sortKey = ExtractPerfSortKey(&args);
+
+    uint32 limit;
+    if (!ExtractOptUInt32(&args, limit, 20))
+        return false;
+
+    PerfRanking ranking;
+    for (uint32 i = 0; i < sPerfStatsMgr.GetOpcodeSlotCount(); ++i)
+    {
+        PerfOpcodeStats const& stats = sPerfStatsMgr.GetOpcodeStats(i);
+        uint64 key;
+        switch (sortKey)
+        {
+            case 1:  key = stats.recvPackets.value(); break;
+            case 2:  key = stats.recvBytes.value(); break;
+            case 3:  key = stats.sentBytes.value(); break;
+            default: key = stats.handlerTime.GetTotal(); break;
+        }
+
+        if (key)
+            ranking.push_back(std::make_pair(key, i));
+    }
+
+    SortPerfRanking(ranking, limit);
+
+    for (PerfRanking::const_iterator itr = ranking.begin(); itr != ranking.end(); ++itr)
+    {
+        PerfOpcodeStats const& stats = sPerfStatsMgr.GetOpcodeStats(itr->second);
+        PSendSysMessage("%-40s recv: " UI64FMTD " (" UI64FMTD " bytes), handler: " UI64FMTD " us total, avg %u, p99 %u, max %u us, sent: " UI64FMTD " (" UI64FMTD " bytes)",
+            PerfStatsMgr::GetOpcodeSlotName(itr->second),
+            stats.recvPackets.value(), stats.recvBytes.value(),
+            stats.handlerTime.GetTotal(), stats.handlerTime.GetAverage(), stats.handlerTime.GetPercentile(99), stats.handlerTime.GetMax(),
+            stats.sentPackets.value(), stats.sentBytes.value());
+    }
+
+    if (ranking.empty())
+        SendSysMessage("No opcode traffic recorded.");
+    return true;
+}
+
+bool ChatHandler::HandlePerfSessionsCommand(char* args)
+{
+    if (!sPerfStatsMgr.IsEnabled())
+        SendSysMessage("Tick profiling is disabled (PerfStats.Enable), values below are not updated.");
+
+    uint32 sortKey = ExtractPerfSortKey(&args);
+
+    uint32 limit;
+    if (!ExtractOptUInt32(&args, limit, 10))
+        return false;
+
+    World::SessionMap const& sessions = sWorld.GetAllSessions();
+
+    PerfRanking ranking;
+    for (World::SessionMap::const_iterator itr = sessions.begin(); itr != sessions.end(); ++itr)
+    {
+        if (!itr->second)                                   // kicked session
+            continue;
+
+        PerfSessionCounters const& counters = itr->second->GetPerfCounters();
+        uint64 key;
+        switch (sortKey)
+        {
+            case 1:  key = counters.recvPackets; break;
+            case 2:  key = counters.recvBytes; break;
+            case 3:  key = counters.sentBytes; break;
+            default: key = counters.handlerTime; break;
+        }
+
+        ranking.push_back(std::make_pair(key, itr->first));
+    }
+
+    SortPerfRanking(ranking, limit);
+
+    for (PerfRanking::const_iterator itr = ranking.begin(); itr != ranking.end(); ++itr)
+    {
+        WorldSession* session = sWorld.FindSession(itr->second);
+        PerfSessionCounters const& counters = session->GetPerfCounters();
+        PSendSysMessage("account %u (%s): recv %u (" UI64FMTD " bytes), handler " UI64FMTD " us, slowest %s %u us, sent %u (" UI64FMTD " bytes)",
+            session->GetAccountId(), session->GetPlayerName(),
+            counters.recvPackets, counters.recvBytes, counters.handlerTime,
+            LookupOpcodeName(counters.maxHandlerOpcode), counters.maxHandlerTime,
+            counters.sentPackets, counters.sentBytes);
+    }
+
+    if (ranking.empty())
+        SendSysMessage("No sessions.");
+    return true;
+}
+
+bool ChatHandler::HandlePerfSleepCommand(char* /*args*/)
+{
+    if (!sWorld.getConfig(CONFIG_BOOL_MAP_CREATURE_SLEEP))
+        SendSysMessage("Creature sleep is disabled (MapCreatureSleep = 0).");
+
+    uint32 totalActive = 0;
+    uint32 totalSleeping = 0;
+
+    MapManager::MapMapType const& maps = sMapMgr.Maps();
+    for (MapManager::MapMapType::const_iterator itr = maps.begin(); itr != maps.end(); ++itr)
+    {
+        Map const* map = itr->second;
+        uint32 active = map->GetActiveCreatureCount();
+        uint32 sleeping = map->GetSleepingCreatureCount();
+        if (!active && !sleeping)
+            continue;
+
+        PSendSysMessage("map %u instance %u (%s): %u active, %u sleeping", map->GetId(), map->GetInstanceId(), map->GetMapName(),
+            active, sleeping);
+
+        totalActive += active;
+        totalSleeping += sleeping;
+    }
+
+    uint32 total = totalActive + totalSleeping;
+    PSendSysMessage("Total: %u active, %u sleeping (%u%% of updated creatures skipped)", totalActive, totalSleeping,
+        total ? totalSleeping * 100 / total : 0);
+    return true;
+}
+
+bool ChatHandler::HandlePerfSplinesCommand(char* /*args*/)
+{
+    Map::SplineBroadcastStats total;
+
+    MapManager::MapMapType const& maps = sMapMgr.Maps();
+    for (MapManager::MapMapType::const_iterator itr = maps.begin(); itr != maps.end(); ++itr)
+    {
+        Map const* map = itr->second;
+        Map::SplineBroadcastStats const& stats = map->GetSplineBroadcastStats();
+        if (!stats.launched)
+            continue;
+
+        PSendSysMessage("map %u instance %u (%s): " UI64FMTD " launched, " UI64FMTD " replaced, " UI64FMTD " observer searches, " UI64FMTD " deliveries",
+            map->GetId(), map->GetInstanceId(), map->GetMapName(), stats.launched, stats.replaced, stats.groups, stats.deliveries);
+
+        total.launched += stats.launched;
+        total.replaced += stats.replaced;
+        total.groups += stats.groups;
+        total.deliveries += stats.deliveries;
+    }
+
+    uint64 sent = total.launched - total.replaced;
+    PSendSysMessage("Total: " UI64FMTD " launched, " UI64FMTD " replaced, " UI64FMTD " observer searches for " UI64FMTD " sent splines, " UI64FMTD " deliveries",
+        total.launched, total.replaced, total.groups, sent, total.deliveries);
+    return true;
+}
+
+bool ChatHandler::HandlePerfMemoryCommand(char* /*args*/)
+{
+    PSendSysMessage("Allocator: %s", MemoryStats::GetAllocatorName());
+
+    if (!MemoryStats::IsEnabled())
+    {
+        SendSysMessage("Allocation counters are not compiled in, build with ALLOC_STATS to get them.");
+        return true;
+    }
+
+    for (uint32 i = 0; i < MAX_MEMORY_TAGS; ++i)
+    {
+        MemoryTagStats stats;
+        MemoryStats::GetTagStats(MemoryTag(i), stats);
+
+        PSendSysMessage("%-8s allocations " UI64FMTD ", frees " UI64FMTD ", allocated " UI64FMTD " KB, live " SI64FMTD " KB",
+            MemoryStats::GetTagName(MemoryTag(i)), stats.allocations, stats.frees, stats.totalBytes / 1024, stats.liveBytes / 1024);
+    }
+
+    return true;
+}
+
+bool ChatHandler::HandlePerfPoolCommand(char* /*args*/)
+{
+    for (uint32 i = 0; i < PacketBufferPool::GetClassCount(); ++i)
+    {
+        PacketBufferClassStats stats = PacketBufferPool::GetClassStats(i);
+
+        PSendSysMessage("packet buffers %6u bytes: hits " UI64FMTD " (%u%%), misses " UI64FMTD ", depot refills " UI64FMTD ", spills " UI64FMTD ", parked %u",
+            uint32(PacketBufferPool::GetClassSize(i)), stats.hits, stats.hits + stats.misses ? uint32(stats.hits * 100 / (stats.hits + stats.misses)) : 0,
+            stats.misses, stats.refills, stats.spills, PacketBufferPool::GetDepotCount(i));
+    }
+
+    PSendSysMessage("packet buffers above %u bytes: %ld, from the heap",
+        uint32(PacketBufferPool::GetClassSize(PacketBufferPool::GetClassCount() - 1)), PacketBufferPool::GetOversizeCount());
+    return true;
+}
+
+bool ChatHandler::HandlePerfTickCommand(char* /*args*/)
+{
+    uint64 ticks = sWorld.GetTickCount();
+    PSendSysMessage("Target tick %u ms: " UI64FMTD " ticks, " UI64FMTD " over target", sWorld.getConfig(CONFIG_UINT32_WORLD_TICK_TIME),
+        ticks, sWorld.GetTickOverrunCount());
+
+    for (uint32 i = 0; i < WTASK_COUNT; ++i)
+    {
+        WorldTickTask task = WorldTickTask(i);
+        WorldTickTaskStats const& stats = sWorld.GetTickTaskStats(task);
+        uint32 budget = sWorld.getConfig(eConfigUInt32Values(CONFIG_UINT32_TICK_BUDGET_SESSIONS + i));
+        uint64 avg = stats.runs ? stats.totalTime / stats.runs : 0;
+
+        if (i < WTASK_AHBOT)
+            PSendSysMessage("%s: budget %u ms, " UI64FMTD " runs, avg " UI64FMTD " ms, max %u ms, " UI64FMTD " over budget",
+                World::GetTickTaskName(task), budget, stats.runs, avg, stats.maxTime, stats.overruns);
+        else
+            PSendSysMessage("%s: budget %u ms, " UI64FMTD " runs, avg " UI64FMTD " ms, max %u ms, " UI64FMTD " over budget, "
+                UI64FMTD " ticks put off, " UI64FMTD " forced runs",
+                World::GetTickTaskName(task), budget, stats.runs, avg, stats.maxTime, stats.overruns, stats.deferred, stats.forced);
+    }
+
+    return true;
+}
+
+bool ChatHandler::HandlePerfResetCommand(char* /*args*/)
+{
+    sPerfStatsMgr.Reset();
+    sWorld.ResetTickStats();
+    SendSysMessage("Tick profiling statistics reset.");
     return true;
 }
 
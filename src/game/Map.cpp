@@ -36,11 +36,19 @@
 #include "VMapFactory.h"
 #include "MoveMap.h"
 #include "BattleGroundMgr.h"
+#include "PerfStatsMgr.h"
+#include "Policies/MemoryStats.h"
 
 Map::~Map()
 {
     UnloadAll(true);
 
+    for (MovementBroadcastQueue::iterator itr = m_movementBroadcasts.begin(); itr != m_movementBroadcasts.end(); ++itr)
+        delete itr->data;
+
+    for (SplineBroadcastQueue::iterator itr = m_splineBroadcasts.begin(); itr != m_splineBroadcasts.end(); ++itr)
+        delete itr->data;
+
     if(!m_scriptSchedule.empty())
         sEventScriptMgr.DecreaseScheduledScriptCount(m_scriptSchedule.size());
 
@@ -77,11 +85,14 @@ Map::Map(uint32 id, time_t expiry, uint32 InstanceId, uint8 SpawnMode)
   m_VisibleDistance(DEFAULT_VISIBILITY_DISTANCE), m_persistentState(NULL),
   m_activeNonPlayersIter(m_activeNonPlayers.end()),
   i_gridExpiry(expiry), m_TerrainData(sTerrainMgr.LoadTerrain(id)),
-  i_data(NULL), i_script_id(0)
+  i_data(NULL), i_script_id(0), m_activeCreatureCount(0), m_sleepingCreatureCount(0),
+  m_eventWheel(5, 6)                                        // 5 levels of 64 slots (~12 days)
 {
     m_CreatureGuids.Set(sObjectMgr.GetFirstTemporaryCreatureLowGuid());
     m_GameObjectGuids.Set(sObjectMgr.GetFirstTemporaryGameObjectLowGuid());
 
+    m_unitIndex.SetEnabled(sWorld.getConfig(CONFIG_BOOL_MAP_UNIT_INDEX));
+
     for(unsigned int j=0; j < MAX_NUMBER_OF_GRIDS; ++j)
     {
         for(unsigned int idx=0; idx < MAX_NUMBER_OF_GRIDS; ++idx)
@@ -346,6 +357,8 @@ Map::Add(T *obj)
 
 void Map::MessageBroadcast(Player *player, WorldPacket *msg, bool to_self)
 {
+    FlushQueuedBroadcasts(player);
+
     CellPair p = Strawberry::ComputeCellPair(player->GetPositionX(), player->GetPositionY());
 
     if(p.x_coord >= TOTAL_NUMBER_OF_CELLS_PER_MAP || p.y_coord >= TOTAL_NUMBER_OF_CELLS_PER_MAP )
@@ -367,6 +380,8 @@ void Map::MessageBroadcast(Player *player, WorldPacket *msg, bool to_self)
 
 void Map::MessageBroadcast(WorldObject *obj, WorldPacket *msg)
 {
+    FlushQueuedBroadcasts(obj);
+
     CellPair p = Strawberry::ComputeCellPair(obj->GetPositionX(), obj->GetPositionY());
 
     if(p.x_coord >= TOTAL_NUMBER_OF_CELLS_PER_MAP || p.y_coord >= TOTAL_NUMBER_OF_CELLS_PER_MAP )
@@ -390,6 +405,8 @@ void Map::MessageBroadcast(WorldObject *obj, WorldPacket *msg)
 
 void Map::MessageDistBroadcast(Player *player, WorldPacket *msg, float dist, bool to_self, bool own_team_only)
 {
+    FlushQueuedBroadcasts(player);
+
     CellPair p = Strawberry::ComputeCellPair(player->GetPositionX(), player->GetPositionY());
 
     if(p.x_coord >= TOTAL_NUMBER_OF_CELLS_PER_MAP || p.y_coord >= TOTAL_NUMBER_OF_CELLS_PER_MAP )
@@ -411,6 +428,8 @@ void Map::MessageDistBroadcast(Player *player, WorldPacket *msg, float dist, boo
 
 void Map::MessageDistBroadcast(WorldObject *obj, WorldPacket *msg, float dist)
 {
+    FlushQueuedBroadcasts(obj);
+
     CellPair p = Strawberry::ComputeCellPair(obj->GetPositionX(), obj->GetPositionY());
 
     if(p.x_coord >= TOTAL_NUMBER_OF_CELLS_PER_MAP || p.y_coord >= TOTAL_NUMBER_OF_CELLS_PER_MAP )
@@ -430,6 +449,236 @@ void Map::MessageDistBroadcast(WorldObject *obj, WorldPacket *msg, float dist)
     cell.Visit(p, message, *this, *obj, dist);
 }
 
+void Map::QueueMovementBroadcast(Unit* mover, Player const* skipped, WorldPacket* data, bool heartbeat)
+{
+    ObjectGuid skippedGuid = skipped ? skipped->GetObjectGuid() : ObjectGuid();
+
+    // a spline launched earlier in the tick must reach the observers before this movement
+    FlushSplineBroadcast(mover);
+
+    MovementBroadcastIndex::iterator itr = m_movementBroadcastIndex.find(mover->GetObjectGuid());
+    if (itr != m_movementBroadcastIndex.end())
+    {
+        // a heartbeat carries the whole position, a newer one makes the pending one worthless
+        MovementBroadcast& last = m_movementBroadcasts[itr->second];
+        if (heartbeat && last.heartbeat)
+        {
+            delete last.data;
+            last.data = data;
+            last.skipped = skippedGuid;
+            return;
+        }
+    }
+
+    MovementBroadcast broadcast;
+    broadcast.mover = mover->GetObjectGuid();
+    broadcast.skipped = skippedGuid;
+    broadcast.data = data;
+    broadcast.heartbeat = heartbeat;
+
+    m_movementBroadcastIndex[broadcast.mover] = m_movementBroadcasts.size();
+    m_movementBroadcasts.push_back(broadcast);
+}
+
+void Map::FlushMovementBroadcast(WorldObject const* obj)
+{
+    if (m_movementBroadcastIndex.empty())
+        return;
+
+    MovementBroadcastIndex::iterator itr = m_movementBroadcastIndex.find(obj->GetObjectGuid());
+    if (itr == m_movementBroadcastIndex.end())
+        return;
+
+    // the index points at the last entry of the mover, the earlier ones are before it
+    size_t last = itr->second;
+    m_movementBroadcastIndex.erase(itr);
+
+    float nearDistance = sWorld.getConfig(CONFIG_FLOAT_MOVEMENT_NEAR_DISTANCE);
+    uint32 farInterval = sWorld.getConfig(CONFIG_UINT32_MOVEMENT_FAR_INTERVAL);
+    uint32 now = WorldTimer::getMSTime();
+
+    for (size_t i = 0; i <= last; ++i)
+        if (m_movementBroadcasts[i].data && m_movementBroadcasts[i].mover == obj->GetObjectGuid())
+            SendMovementBroadcast(m_movementBroadcasts[i], nearDistance, farInterval, now);
+}
+
+void Map::SendMovementBroadcast(MovementBroadcast& broadcast, float nearDistance, uint32 farInterval, uint32 now)
+{
+    // the mover can have left the map while the later packets of the tick were handled
+    Unit* mover = GetUnit(broadcast.mover);
+    if (mover && mover->IsInWorld())
+    {
+        // state changes go to everyone, heartbeats reach far observers once per farInterval
+        bool toFar = !broadcast.heartbeat || !farInterval || WorldTimer::getMSTimeDiff(mover->m_farMovementBroadcastTime, now) >= farInterval;
+        if (toFar)
+            mover->m_farMovementBroadcastTime = now;
+
+        Strawberry::MovementMessageDeliverer notifier(*mover, broadcast.data, broadcast.skipped, nearDistance, toFar);
+        Cell::VisitWorldObjects(mover, notifier, GetVisibilityDistance());
+    }
+
+    delete broadcast.data;
+    broadcast.data = NULL;
+}
+
+void Map::SendMovementBroadcasts()
+{
+    if (m_movementBroadcasts.empty())
+        return;
+
+    float nearDistance = sWorld.getConfig(CONFIG_FLOAT_MOVEMENT_NEAR_DISTANCE);
+    uint32 farInterval = sWorld.getConfig(CONFIG_UINT32_MOVEMENT_FAR_INTERVAL);
+    uint32 now = WorldTimer::getMSTime();
+
+    for (MovementBroadcastQueue::iterator itr = m_movementBroadcasts.begin(); itr != m_movementBroadcasts.end(); ++itr)
+        if (itr->data)
+            SendMovementBroadcast(*itr, nearDistance, farInterval, now);
+
+    m_movementBroadcasts.clear();
+    m_movementBroadcastIndex.clear();
+}
+
+void Map::QueueSplineBroadcast(Unit* mover, WorldPacket* data)
+{
+    ++m_splineStats.launched;
+
+    // movement queued earlier in the tick must reach the observers before this spline
+    FlushMovementBroadcast(mover);
+
+    // a newer spline starts from the position computed from the pending one, so the pending one is not needed
+    MovementBroadcastIndex::iterator itr = m_splineBroadcastIndex.find(mover->GetObjectGuid());
+    if (itr != m_splineBroadcastIndex.end())
+    {
+        SplineBroadcast& last = m_splineBroadcasts[itr->second];
+        delete last.data;
+        last.data = data;
+        ++m_splineStats.replaced;
+        return;
+    }
+
+    SplineBroadcast broadcast;
+    broadcast.mover = mover->GetObjectGuid();
+    broadcast.data = data;
+
+    m_splineBroadcastIndex[broadcast.mover] = m_splineBroadcasts.size();
+    m_splineBroadcasts.push_back(broadcast);
+}
+
+void Map::FlushSplineBroadcast(WorldObject const* obj)
+{
+    if (m_splineBroadcastIndex.empty())
+        return;
+
+    MovementBroadcastIndex::iterator itr = m_splineBroadcastIndex.find(obj->GetObjectGuid());
+    if (itr == m_splineBroadcastIndex.end())
+        return;
+
+    SplineBroadcast& broadcast = m_splineBroadcasts[itr->second];
+    m_splineBroadcastIndex.erase(itr);
+
+    // the mover can have left the map since the launch
+    Unit* mover = GetUnit(broadcast.mover);
+    if (mover && mover->IsInWorld())
+    {
+        CellPair p = Strawberry::ComputeCellPair(mover->GetPositionX(), mover->GetPositionY());
+        if (p.x_coord < TOTAL_NUMBER_OF_CELLS_PER_MAP && p.y_coord < TOTAL_NUMBER_OF_CELLS_PER_MAP)
+        {
+            Cell cell(p);
+            cell.SetNoCreate();
+
+            if (loaded(GridPair(cell.data.Part.grid_x, cell.data.Part.grid_y)))
+            {
+                Strawberry::SplineMessageDeliverer::MessageList messages(1, std::make_pair(mover->GetPhaseMask(), broadcast.data));
+                Strawberry::SplineMessageDeliverer post_man(messages);
+                TypeContainerVisitor<Strawberry::SplineMessageDeliverer, WorldTypeMapContainer> message(post_man);
+                cell.Visit(p, message, *this, *mover, GetVisibilityDistance());
+
+                ++m_splineStats.groups;
+                m_splineStats.deliveries += post_man.i_deliveries;
+            }
+        }
+    }
+
+    delete broadcast.data;
+    broadcast.data = NULL;
+}
+
+void Map::SendSplineBroadcasts()
+{
+    if (m_splineBroadcasts.empty())
+        return;
+
+    // the same standing cell and cell area give the same visited cells in Cell::Visit, so the same observers;
+    // the key packs both, 10 bits per cell coordinate
+    typedef std::pair<uint64, size_t> GroupKey;
+    std::vector<GroupKey> keys;
+    std::vector<Unit*> movers(m_splineBroadcasts.size(), (Unit*)NULL);
+    keys.reserve(m_splineBroadcasts.size());
+
+    for (size_t i = 0; i < m_splineBroadcasts.size(); ++i)
+    {
+        if (!m_splineBroadcasts[i].data)
+            continue;
+
+        // the mover can have left the map since the launch
+        Unit* mover = GetUnit(m_splineBroadcasts[i].mover);
+        if (!mover || !mover->IsInWorld())
+            continue;
+
+        CellPair p = Strawberry::ComputeCellPair(mover->GetPositionX(), mover->GetPositionY());
+        if (p.x_coord >= TOTAL_NUMBER_OF_CELLS_PER_MAP || p.y_coord >= TOTAL_NUMBER_OF_CELLS_PER_MAP)
+            continue;
+
+        float radius = std::min(GetVisibilityDistance() + mover->GetObjectBoundingRadius(), 333.0f);
+        CellArea area = Cell::CalculateCellArea(mover->GetPositionX(), mover->GetPositionY(), radius);
+
+        uint64 key = uint64(p.x_coord) | (uint64(p.y_coord) << 10) |
+            (uint64(area.low_bound.x_coord) << 20) | (uint64(area.low_bound.y_coord) << 30) |
+            (uint64(area.high_bound.x_coord) << 40) | (uint64(area.high_bound.y_coord) << 50);
+
+        movers[i] = mover;
+        keys.push_back(GroupKey(key, i));
+    }
+
+    std::sort(keys.begin(), keys.end());
+
+    Strawberry::SplineMessageDeliverer::MessageList messages;
+    for (size_t begin = 0; begin < keys.size();)
+    {
+        size_t end = begin;
+        messages.clear();
+        for (; end < keys.size() && keys[end].first == keys[begin].first; ++end)
+        {
+            size_t idx = keys[end].second;
+            messages.push_back(std::make_pair(movers[idx]->GetPhaseMask(), m_splineBroadcasts[idx].data));
+        }
+
+        // one observer search for the whole group, any mover of it gives the same cells
+        Unit* center = movers[keys[begin].second];
+        CellPair p = Strawberry::ComputeCellPair(center->GetPositionX(), center->GetPositionY());
+        Cell cell(p);
+        cell.SetNoCreate();
+
+        if (loaded(GridPair(cell.data.Part.grid_x, cell.data.Part.grid_y)))
+        {
+            Strawberry::SplineMessageDeliverer post_man(messages);
+            TypeContainerVisitor<Strawberry::SplineMessageDeliverer, WorldTypeMapContainer> message(post_man);
+            cell.Visit(p, message, *this, *center, GetVisibilityDistance());
+
+            ++m_splineStats.groups;
+            m_splineStats.deliveries += post_man.i_deliveries;
+        }
+
+        begin = end;
+    }
+
+    for (SplineBroadcastQueue::iterator itr = m_splineBroadcasts.begin(); itr != m_splineBroadcasts.end(); ++itr)
+        delete itr->data;
+
+    m_splineBroadcasts.clear();
+    m_splineBroadcastIndex.clear();
+}
+
 bool Map::loaded(const GridPair &p) const
 {
     return ( getNGrid(p.x_coord, p.y_coord) && isGridObjectDataLoaded(p.x_coord, p.y_coord) );
@@ -437,7 +686,13 @@ bool Map::loaded(const GridPair &p) const
 
 void Map::Update(const uint32 &t_diff)
 {
+    MemoryTagScope memoryTag(MEMORY_TAG_MAPS);
+
+    /// move due unit events to their owners, executed at unit update
+    m_eventWheel.Advance(m_eventWheel.GetTime() + t_diff);
+
     /// update worldsessions for existing players
+    PerfTimer phaseTimer(PERF_MAP_SESSIONS, &m_perfStats);
     for(m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
     {
         Player* plr = m_mapRefIter->getSource();
@@ -450,7 +705,11 @@ void Map::Update(const uint32 &t_diff)
         }
     }
 
+    /// send the movement received from the sessions in one burst
+    SendMovementBroadcasts();
+
     /// update players at tick
+    phaseTimer.Next(PERF_MAP_PLAYERS);
     for(m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
     {
         Player* plr = m_mapRefIter->getSource();
@@ -462,9 +721,10 @@ void Map::Update(const uint32 &t_diff)
     }
 
     /// update active cells around players and active objects
+    phaseTimer.Next(PERF_MAP_CELLS);
     resetMarkedCells();
 
-    Strawberry::ObjectUpdater updater(t_diff);
+    Strawberry::ObjectUpdater updater(t_diff, sWorld.getConfig(CONFIG_BOOL_MAP_CREATURE_SLEEP));
     // for creature
     TypeContainerVisitor<Strawberry::ObjectUpdater, GridTypeMapContainer  > grid_object_update(updater);
     // for pets
@@ -541,8 +801,14 @@ void Map::Update(const uint32 &t_diff)
         }
     }
 
+    m_activeCreatureCount = updater.i_activeCreatures;
+    m_sleepingCreatureCount = updater.i_sleepingCreatures;
+
     // Send world objects and item update field changes
+    phaseTimer.Next(PERF_MAP_OBJECT_UPDATES);
+    SendSplineBroadcasts();
     SendObjectUpdates();
+    phaseTimer.Next(PERF_MAP_GRID_STATES);
 
     // Don't unload grids if it's battleground, since we may have manually added GOs,creatures, those doesn't load from DB at grid re-load !
     // This isn't really bother us, since as soon as we have instanced BG-s, the whole map unloads as the BG gets ended
@@ -559,11 +825,18 @@ void Map::Update(const uint32 &t_diff)
     }
 
     ///- Process necessary scripts
+    phaseTimer.Next(PERF_MAP_SCRIPTS);
     if (!m_scriptSchedule.empty())
         ScriptsProcess();
 
     if(i_data)
         i_data->Update(t_diff);
+
+    if (sPerfStatsMgr.IsEnabled())
+    {
+        phaseTimer.Stop();
+        m_perfStats.EndUpdate();
+    }
 }
 
 void Map::Remove(Player *player, bool remove)
@@ -3187,7 +3460,7 @@ void Map::SendObjectUpdates()
         obj->BuildUpdateData(update_players);
     }
 
-    WorldPacket packet;                                     // here we allocate a std::vector with a size of 0x10000
+    WorldPacket packet;                                     // storage comes from the packet buffer pools
     for(UpdateDataMapType::iterator iter = update_players.begin(); iter != update_players.end(); ++iter)
     {
         iter->second.BuildPacket(&packet);
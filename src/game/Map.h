@@ -36,8 +36,11 @@
 #include "GameSystem/GridRefManager.h"
 #include "MapRefManager.h"
 #include "Utilities/TypeList.h"
+#include "Utilities/EventProcessor.h"
 #include "ScriptBase/Event/EventScripts.h"
 #include "CreatureLinkingMgr.h"
+#include "UnitSpatialIndex.h"
+#include "PerfStatsMgr.h"
 
 #include <bitset>
 #include <list>
@@ -128,6 +131,13 @@ class Map : public GridRefManager<NGridType>
         void MessageDistBroadcast(Player *, WorldPacket *, float dist, bool to_self, bool own_team_only = false);
         void MessageDistBroadcast(WorldObject *, WorldPacket *, float dist);
 
+        // takes the packet, sent to the mover's observers except skipped at the end of the session phase
+        void QueueMovementBroadcast(Unit* mover, Player const* skipped, WorldPacket* data, bool heartbeat);
+        // sends the queued movement and spline of obj now, called before any other broadcast from obj so it cannot overtake them
+        void FlushQueuedBroadcasts(WorldObject const* obj) { FlushMovementBroadcast(obj); FlushSplineBroadcast(obj); }
+        // takes the SMSG_MONSTER_MOVE packet, sent together with the other splines of the tick having the same observers
+        void QueueSplineBroadcast(Unit* mover, WorldPacket* data);
+
         float GetVisibilityDistance() const { return m_VisibleDistance; }
         //function for setting up visibility distance for maps on per-type/per-Id basis
         virtual void InitVisibilityDistance();
@@ -209,6 +219,26 @@ class Map : public GridRefManager<NGridType>
 
         bool HavePlayers() const { return !m_mapRefManager.isEmpty(); }
         uint32 GetPlayersCountExceptGMs() const;
+
+        // creatures updated and skipped as sleeping in the last tick
+        uint32 GetActiveCreatureCount() const { return m_activeCreatureCount; }
+        uint32 GetSleepingCreatureCount() const { return m_sleepingCreatureCount; }
+
+        // Map::Update phase timings of this map since its creation or the last .perf reset
+        PerfMapStats& GetPerfStats() { return m_perfStats; }
+        PerfMapStats const& GetPerfStats() const { return m_perfStats; }
+
+        // spline launch statistics since map creation
+        struct SplineBroadcastStats
+        {
+            SplineBroadcastStats() : launched(0), replaced(0), groups(0), deliveries(0) {}
+
+            uint64 launched;                                // SMSG_MONSTER_MOVE packets queued
+            uint64 replaced;                                // dropped for a newer spline of the same unit in the same tick
+            uint64 groups;                                  // observer searches, one per group of splines with the same cell area
+            uint64 deliveries;                              // packets handed to sessions
+        };
+        SplineBroadcastStats const& GetSplineBroadcastStats() const { return m_splineStats; }
         bool ActiveObjectsNearGrid(uint32 x,uint32 y) const;
 
         void SendToPlayers(WorldPacket const* data) const;
@@ -265,6 +295,13 @@ class Map : public GridRefManager<NGridType>
 
         // Get Holder for Creature Linking
         CreatureLinkingHolder* GetCreatureLinkingHolder() { return &m_creatureLinkingHolder; }
+        // Timer wheel shared by units of the map (MapSharedEventWheel), advanced with map time even for units not updated
+        // Timer wheel shared by units of the map (MapSharedEventWheel)
+        EventWheel* GetEventWheel() { return &m_eventWheel; }
+
+        // flat index of the units in world for area searches, see Cell::VisitAllUnits
+        UnitSpatialIndex& GetUnitIndex() { return m_unitIndex; }
+        UnitSpatialIndex const& GetUnitIndex() const { return m_unitIndex; }
 
     private:
         void LoadMapAndVMap(int gx, int gy);
@@ -304,6 +341,39 @@ class Map : public GridRefManager<NGridType>
         void SendObjectUpdates();
         std::set<Object *> i_objectsToClientUpdate;
 
+        void SendMovementBroadcasts();
+
+        struct MovementBroadcast
+        {
+            ObjectGuid mover;
+            ObjectGuid skipped;
+            WorldPacket* data;                              // NULL once flushed
+            bool heartbeat;
+        };
+
+        void FlushMovementBroadcast(WorldObject const* obj);
+        void SendMovementBroadcast(MovementBroadcast& broadcast, float nearDistance, uint32 farInterval, uint32 now);
+        typedef std::vector<MovementBroadcast> MovementBroadcastQueue;
+        typedef UNORDERED_MAP<ObjectGuid, size_t> MovementBroadcastIndex;
+
+        MovementBroadcastQueue m_movementBroadcasts;
+        MovementBroadcastIndex m_movementBroadcastIndex;    // mover -> its last entry in m_movementBroadcasts
+
+        void SendSplineBroadcasts();
+
+        struct SplineBroadcast
+        {
+            ObjectGuid mover;
+            WorldPacket* data;                              // NULL once flushed
+        };
+
+        void FlushSplineBroadcast(WorldObject const* obj);
+        typedef std::vector<SplineBroadcast> SplineBroadcastQueue;
+
+        SplineBroadcastQueue m_splineBroadcasts;
+        MovementBroadcastIndex m_splineBroadcastIndex;      // mover -> its entry in m_splineBroadcasts
+        SplineBroadcastStats m_splineStats;
+
     protected:
         MapEntry const* i_mapEntry;
         uint8 i_spawnMode;
@@ -340,6 +410,11 @@ class Map : public GridRefManager<NGridType>
         InstanceData* i_data;
         uint32 i_script_id;
 
+        uint32 m_activeCreatureCount;
+        uint32 m_sleepingCreatureCount;
+
+        PerfMapStats m_perfStats;
+
         // Map local low guid counters
         ObjectGuidGenerator<HIGHGUID_UNIT> m_CreatureGuids;
         ObjectGuidGenerator<HIGHGUID_GAMEOBJECT> m_GameObjectGuids;
@@ -355,6 +430,10 @@ class Map : public GridRefManager<NGridType>
 
         // Holder for information about linked mobs
         CreatureLinkingHolder m_creatureLinkingHolder;
+
+        EventWheel m_eventWheel;
+
+        UnitSpatialIndex m_unitIndex;
 };
 
 class WorldMap : public Map
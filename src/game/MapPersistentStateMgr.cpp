@@ -36,6 +36,7 @@
 #include "Group.h"
 #include "InstanceData.h"
 #include "ProgressBar.h"
+#include "Database/DatabaseImpl.h"
 
 INSTANTIATE_SINGLETON_1( MapPersistentStateManager );
 
@@ -213,6 +214,11 @@ DungeonPersistentState::DungeonPersistentState( uint16 MapId, uint32 InstanceId,
 }
 
 DungeonPersistentState::~DungeonPersistentState()
+{
+    UnbindAll();
+}
+
+void DungeonPersistentState::UnbindAll()
 {
     while(!m_playerList.empty())
     {
@@ -760,10 +766,32 @@ void MapPersistentStateManager::CleanupInstances()
     sLog.outString( ">> Instances cleaned up");
 }
 
+// rows per INSERT into instance remap table
+#define PACK_INSTANCES_INSERT_ROWS 1000
+
+struct PackInstancesTable
+{
+    char const* table;
+    char const* column;
+};
+
+// all tables with instance id associations
+static PackInstancesTable const packInstancesTables[] =
+{
+    { "creature_respawn",   "instance" },
+    { "gameobject_respawn", "instance" },
+    { "corpse",             "instance" },
+    { "character_instance", "instance" },
+    { "instance",           "id"       },
+    { "group_instance",     "instance" },
+};
+
+#define PACK_INSTANCES_TABLES_COUNT int(sizeof(packInstancesTables) / sizeof(packInstancesTables[0]))
+
 void MapPersistentStateManager::PackInstances()
 {
     // this routine renumbers player instance associations in such a way so they start from 1 and go up
-    // TODO: this can be done a LOT more efficiently
+    // done by set-based updates of all tables through a temporary old id -> new id table
 
     // obtain set of all associations
     std::set<uint32> InstanceSet;
@@ -786,29 +814,82 @@ void MapPersistentStateManager::PackInstances()
     BarGoLink bar(InstanceSet.size() + 1);
     bar.step();
 
+    // collect old -> new id pairs into rows of the mapping table, ids already in place are not touched
+    std::vector<std::string> remapRows;
+    std::ostringstream rows;
+    uint32 rowsCount = 0;
+    uint32 remapCount = 0;
+
     uint32 InstanceNumber = 1;
     // we do assume std::set is sorted properly on integer value
     for (std::set<uint32>::iterator i = InstanceSet.begin(); i != InstanceSet.end(); ++i)
     {
         if (*i != InstanceNumber)
         {
-            CharacterDatabase.BeginTransaction();
-            // remap instance id
-            CharacterDatabase.PExecute("UPDATE creature_respawn SET instance = '%u' WHERE instance = '%u'", InstanceNumber, *i);
-            CharacterDatabase.PExecute("UPDATE gameobject_respawn SET instance = '%u' WHERE instance = '%u'", InstanceNumber, *i);
-            CharacterDatabase.PExecute("UPDATE corpse SET instance = '%u' WHERE instance = '%u'", InstanceNumber, *i);
-            CharacterDatabase.PExecute("UPDATE character_instance SET instance = '%u' WHERE instance = '%u'", InstanceNumber, *i);
-            CharacterDatabase.PExecute("UPDATE instance SET id = '%u' WHERE id = '%u'", InstanceNumber, *i);
-            CharacterDatabase.PExecute("UPDATE group_instance SET instance = '%u' WHERE instance = '%u'", InstanceNumber, *i);
-            //execute transaction synchronously
-            CharacterDatabase.CommitTransaction();
+            if (!rowsCount)
+                rows << "INSERT INTO instance_remap (old_id, new_id) VALUES ";
+            rows << (rowsCount ? "," : "") << "(" << *i << "," << InstanceNumber << ")";
+            ++remapCount;
+
+            if (++rowsCount >= PACK_INSTANCES_INSERT_ROWS)
+            {
+                remapRows.push_back(rows.str());
+                rows.str("");
+                rowsCount = 0;
+            }
         }
 
         ++InstanceNumber;
         bar.step();
     }
 
-    sLog.outString( ">> Instance numbers remapped, next instance id is %u", InstanceNumber );
+    if (rowsCount)
+        remapRows.push_back(rows.str());
+
+    if (remapCount)
+    {
+        // new ids can be still used by not yet moved rows, so remapped ids pass through a range above all existing ids first;
+        // rows not cleaned up yet can reference ids above the instance table, the range must be above them too
+        uint32 offset = *InstanceSet.rbegin();
+        for (int i = 0; i < PACK_INSTANCES_TABLES_COUNT; ++i)
+        {
+            result = CharacterDatabase.PQuery("SELECT MAX(%s) FROM %s", packInstancesTables[i].column, packInstancesTables[i].table);
+            if (result)
+            {
+                offset = std::max(offset, result->Fetch()[0].GetUInt32());
+                delete result;
+            }
+        }
+
+        // temporary table exists only in the connection that created it, so all statements run in one direct transaction
+        CharacterDatabase.BeginTransaction();
+        CharacterDatabase.Execute("DROP TEMPORARY TABLE IF EXISTS instance_remap");
+        CharacterDatabase.Execute("CREATE TEMPORARY TABLE instance_remap (old_id INT UNSIGNED NOT NULL, new_id INT UNSIGNED NOT NULL, PRIMARY KEY (old_id), KEY (new_id))");
+        for (std::vector<std::string>::const_iterator itr = remapRows.begin(); itr != remapRows.end(); ++itr)
+            CharacterDatabase.Execute(itr->c_str());
+
+        for (int i = 0; i < PACK_INSTANCES_TABLES_COUNT; ++i)
+        {
+            char const* table = packInstancesTables[i].table;
+            char const* column = packInstancesTables[i].column;
+
+            CharacterDatabase.PExecute("UPDATE %s JOIN instance_remap ON %s.%s = instance_remap.old_id SET %s.%s = instance_remap.new_id + %u",
+                table, table, column, table, column, offset);
+            CharacterDatabase.PExecute("UPDATE %s JOIN instance_remap ON %s.%s = instance_remap.new_id + %u SET %s.%s = instance_remap.new_id",
+                table, table, column, offset, table, column);
+        }
+
+        CharacterDatabase.Execute("DROP TEMPORARY TABLE instance_remap");
+
+        if (!CharacterDatabase.CommitTransactionDirect())
+        {
+            sLog.outError("Instance numbers remapping failed, instance ids are kept as is.");
+            sLog.outString();
+            return;
+        }
+    }
+
+    sLog.outString( ">> Instance numbers remapped (%u changed), next instance id is %u", remapCount, InstanceNumber );
     sLog.outString();
 }
 
@@ -867,17 +948,25 @@ void MapPersistentStateManager::_ResetOrWarnAll(uint32 mapid, Difficulty difficu
         for(PersistentStateMap::iterator itr = m_instanceSaveByInstanceId.begin(); itr != m_instanceSaveByInstanceId.end();)
         {
             if (itr->second->GetMapId() == mapid && itr->second->GetDifficulty() == difficulty)
-                _ResetSave(m_instanceSaveByInstanceId, itr);
+            {
+                // state of loaded map stays valid until the map is reset and unloaded
+                if (Map* map = itr->second->GetMap())
+                {
+                    ((DungeonPersistentState*)itr->second)->UnbindAll();
+                    m_pendingMapResets.push_back(std::make_pair(map->GetId(), map->GetInstanceId()));
+                    ++itr;
+                }
+                else
+                    _ResetSave(m_instanceSaveByInstanceId, itr);
+            }
             else
                 ++itr;
         }
 
-        // delete them from the DB, even if not loaded
-        CharacterDatabase.BeginTransaction();
-        CharacterDatabase.PExecute("DELETE FROM character_instance USING character_instance LEFT JOIN instance ON character_instance.instance = id WHERE map = '%u'", mapid);
-        CharacterDatabase.PExecute("DELETE FROM group_instance USING group_instance LEFT JOIN instance ON group_instance.instance = id WHERE map = '%u'", mapid);
-        CharacterDatabase.PExecute("DELETE FROM instance WHERE map = '%u'", mapid);
-        CharacterDatabase.CommitTransaction();
+        // delete them from the DB in background batches, even if not loaded
+        m_globalResetJobs.push_back(GlobalResetJob(mapid, difficulty, sObjectMgr.GetNextInstanceLowGuid() - 1, WorldTimer::getMSTime()));
+        if (m_globalResetJobs.size() == 1)
+            _QueryGlobalResetBatch();
 
         // calculate the next reset time
         time_t next_reset = DungeonResetScheduler::CalculateNextResetTime(mapDiff, now + timeLeft);
@@ -885,6 +974,10 @@ void MapPersistentStateManager::_ResetOrWarnAll(uint32 mapid, Difficulty difficu
         CharacterDatabase.PExecute("UPDATE instance_reset SET resettime = '"UI64FMTD"' WHERE mapid = '%u' AND difficulty = '%u'", (uint64)next_reset, mapid, difficulty);
     }
 
+    // loaded maps already queued for reset above
+    if (!warn)
+        return;
+
     // note: this isn't fast but it's meant to be executed very rarely
     const MapManager::MapMapType& maps = sMapMgr.Maps();
 
@@ -895,11 +988,127 @@ void MapPersistentStateManager::_ResetOrWarnAll(uint32 mapid, Difficulty difficu
         if(map2->GetId() != mapid)
             break;
 
-        if (warn)
-            ((DungeonMap*)map2)->SendResetWarnings(timeLeft);
-        else
-            ((DungeonMap*)map2)->Reset(INSTANCE_RESET_GLOBAL);
+        ((DungeonMap*)map2)->SendResetWarnings(timeLeft);
+    }
+}
+
+void MapPersistentStateManager::_QueryGlobalResetBatch()
+{
+    GlobalResetJob const& job = m_globalResetJobs.front();
+
+    CharacterDatabase.AsyncPQuery(this, &MapPersistentStateManager::_GlobalResetBatchCallback, job.mapid,
+        "SELECT id FROM instance WHERE map = '%u' AND difficulty = '%u' AND id > '%u' AND id <= '%u' ORDER BY id LIMIT %u",
+        job.mapid, uint32(job.difficulty), job.lastInstanceId, job.maxInstanceId, sWorld.getConfig(CONFIG_UINT32_INSTANCE_RESET_BATCH_SIZE));
+}
+
+void MapPersistentStateManager::_GlobalResetBatchCallback(QueryResult* result, uint32 mapid)
+{
+    // finished directly at shutdown
+    if (m_globalResetJobs.empty() || m_globalResetJobs.front().mapid != mapid)
+    {
+        delete result;
+        return;
     }
+
+    if (!result)
+    {
+        _FinishGlobalResetJob();
+        return;
+    }
+
+    GlobalResetJob& job = m_globalResetJobs.front();
+
+    std::ostringstream ids;
+    uint32 count = 0;
+    do
+    {
+        uint32 instanceId = (*result)[0].GetUInt32();
+        ids << (count ? "," : "") << instanceId;
+        job.lastInstanceId = instanceId;
+        ++count;
+    }
+    while (result->NextRow());
+    delete result;
+
+    std::string idList = ids.str();
+
+    CharacterDatabase.BeginTransaction();
+    CharacterDatabase.Execute(("DELETE FROM character_instance WHERE instance IN (" + idList + ")").c_str());
+    CharacterDatabase.Execute(("DELETE FROM group_instance WHERE instance IN (" + idList + ")").c_str());
+    CharacterDatabase.Execute(("DELETE FROM creature_respawn WHERE instance IN (" + idList + ")").c_str());
+    CharacterDatabase.Execute(("DELETE FROM gameobject_respawn WHERE instance IN (" + idList + ")").c_str());
+    CharacterDatabase.Execute(("DELETE FROM instance WHERE id IN (" + idList + ")").c_str());
+    CharacterDatabase.CommitTransaction();
+
+    job.deleted += count;
+    ++job.batches;
+
+    // short batch is the last one
+    if (count < sWorld.getConfig(CONFIG_UINT32_INSTANCE_RESET_BATCH_SIZE))
+        _FinishGlobalResetJob();
+    else
+        _QueryGlobalResetBatch();
+}
+
+void MapPersistentStateManager::_FinishGlobalResetJob()
+{
+    GlobalResetJob const& job = m_globalResetJobs.front();
+
+    sLog.outDetail("Global reset of map %u difficulty %u: %u instances deleted in %u batches, %u ms",
+        job.mapid, uint32(job.difficulty), job.deleted, job.batches, WorldTimer::getMSTimeDiff(job.startTime, WorldTimer::getMSTime()));
+
+    m_globalResetJobs.pop_front();
+
+    if (!m_globalResetJobs.empty())
+        _QueryGlobalResetBatch();
+}
+
+void MapPersistentStateManager::_UpdatePendingMapResets()
+{
+    uint32 count = sWorld.getConfig(CONFIG_UINT32_INSTANCE_RESET_MAPS_PER_TICK);
+
+    while (!m_pendingMapResets.empty() && count > 0)
+    {
+        std::pair<uint32, uint32> mapPair = m_pendingMapResets.front();
+        m_pendingMapResets.pop_front();
+
+        // can be already unloaded
+        if (Map* map = sMapMgr.FindMap(mapPair.first, mapPair.second))
+        {
+            STRAWBERRY_ASSERT(map->IsDungeon());
+            ((DungeonMap*)map)->Reset(INSTANCE_RESET_GLOBAL);
+            --count;
+        }
+    }
+}
+
+void MapPersistentStateManager::FinishGlobalResets()
+{
+    for (GlobalResetJobList::const_iterator itr = m_globalResetJobs.begin(); itr != m_globalResetJobs.end(); ++itr)
+    {
+        // same range as the remaining batches
+        char const* range = "map = '%u' AND difficulty = '%u' AND id > '%u' AND id <= '%u'";
+        char rangeStr[256];
+        snprintf(rangeStr, sizeof(rangeStr), range, itr->mapid, uint32(itr->difficulty), itr->lastInstanceId, itr->maxInstanceId);
+
+        CharacterDatabase.DirectPExecute("DELETE FROM character_instance USING character_instance JOIN instance ON character_instance.instance = id WHERE %s", rangeStr);
+        CharacterDatabase.DirectPExecute("DELETE FROM group_instance USING group_instance JOIN instance ON group_instance.instance = id WHERE %s", rangeStr);
+        CharacterDatabase.DirectPExecute("DELETE FROM creature_respawn USING creature_respawn JOIN instance ON creature_respawn.instance = id WHERE %s", rangeStr);
+        CharacterDatabase.DirectPExecute("DELETE FROM gameobject_respawn USING gameobject_respawn JOIN instance ON gameobject_respawn.instance = id WHERE %s", rangeStr);
+        CharacterDatabase.DirectPExecute("DELETE FROM instance WHERE %s", rangeStr);
+    }
+
+    m_globalResetJobs.clear();
+}
+
+void MapPersistentStateManager::GetResetStatistics(uint32& numJobs, uint32& numDeleted, uint32& numPendingMaps)
+{
+    numJobs = m_globalResetJobs.size();
+    numDeleted = 0;
+    numPendingMaps = m_pendingMapResets.size();
+
+    for (GlobalResetJobList::const_iterator itr = m_globalResetJobs.begin(); itr != m_globalResetJobs.end(); ++itr)
+        numDeleted += itr->deleted;
 }
 
 void MapPersistentStateManager::GetStatistics(uint32& numStates, uint32& numBoundPlayers, uint32& numBoundGroups)
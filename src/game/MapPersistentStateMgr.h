@@ -26,6 +26,7 @@
 #include "ace/Thread_Mutex.h"
 #include <list>
 #include <map>
+#include <deque>
 #include "Utilities/UnorderedMapSet.h"
 #include "Database/DatabaseEnv.h"
 #include "DBCEnums.h"
@@ -187,6 +188,9 @@ class DungeonPersistentState : public MapPersistentState
 
         SpawnedPoolData& GetSpawnedPoolData() { return m_spawnedPoolData; }
 
+        /* unbind all online players and groups, state itself stays while its map is loaded */
+        void UnbindAll();
+
         InstanceTemplate const* GetTemplate() const;
 
         uint8 GetPlayerCount() const { return m_playerList.size(); }
@@ -329,6 +333,22 @@ class DungeonResetScheduler
         ResetTimeQueue m_resetTimeQueue;
 };
 
+/* global reset of one map difficulty, DB rows of reset instances deleted in background batches */
+struct GlobalResetJob
+{
+    GlobalResetJob(uint32 _mapid, Difficulty _difficulty, uint32 _maxInstanceId, uint32 _startTime)
+        : mapid(_mapid), difficulty(_difficulty), maxInstanceId(_maxInstanceId), lastInstanceId(0),
+        deleted(0), batches(0), startTime(_startTime) {}
+
+    uint32 mapid;
+    Difficulty difficulty;
+    uint32 maxInstanceId;                                   // instances created after reset start are not touched
+    uint32 lastInstanceId;                                  // last instance id deleted, next batch starts after it
+    uint32 deleted;
+    uint32 batches;
+    uint32 startTime;
+};
+
 class MapPersistentStateManager : public Strawberry::Singleton<MapPersistentStateManager, Strawberry::ClassLevelLockable<MapPersistentStateManager, ACE_Thread_Mutex> >
 {
     friend class DungeonResetScheduler;
@@ -364,8 +384,12 @@ class MapPersistentStateManager : public Strawberry::Singleton<MapPersistentStat
         static void DeleteInstanceFromDB(uint32 instanceid);
 
         void GetStatistics(uint32& numStates, uint32& numBoundPlayers, uint32& numBoundGroups);
+        void GetResetStatistics(uint32& numJobs, uint32& numDeleted, uint32& numPendingMaps);
 
-        void Update() { m_Scheduler.Update(); }
+        // delete rows of still running global resets directly, at shutdown
+        void FinishGlobalResets();
+
+        void Update() { m_Scheduler.Update(); _UpdatePendingMapResets(); }
     private:
         typedef UNORDERED_MAP<uint32 /*InstanceId or MapId*/, MapPersistentState*> PersistentStateMap;
 
@@ -375,6 +399,12 @@ class MapPersistentStateManager : public Strawberry::Singleton<MapPersistentStat
         void _CleanupExpiredInstancesAtTime(time_t t);
 
         void _ResetSave(PersistentStateMap& holder, PersistentStateMap::iterator &itr);
+
+        // staged global resets
+        void _QueryGlobalResetBatch();
+        void _GlobalResetBatchCallback(QueryResult* result, uint32 mapid);
+        void _FinishGlobalResetJob();
+        void _UpdatePendingMapResets();
         void _DelHelper(DatabaseType &db, const char *fields, const char *table, const char *queryTail,...);
 
         // used during global instance resets
@@ -385,6 +415,14 @@ class MapPersistentStateManager : public Strawberry::Singleton<MapPersistentStat
         PersistentStateMap m_instanceSaveByMapId;
 
         DungeonResetScheduler m_Scheduler;
+
+        // global resets with DB rows still to delete, batch query of the first one is in flight
+        typedef std::list<GlobalResetJob> GlobalResetJobList;
+        GlobalResetJobList m_globalResetJobs;
+
+        // loaded dungeon maps (map id, instance id) waiting for reset, few per tick to spread their unload
+        typedef std::deque<std::pair<uint32, uint32> > PendingMapResetQueue;
+        PendingMapResetQueue m_pendingMapResets;
 };
 
 template<typename Do>
@@ -72,12 +72,12 @@ void MassMailMgr::AddMassMailTask(MailDraft* mailProto, MailSender sender, char
     CharacterDatabase.AsyncPQuery(&massMailerQueryHandler, &MassMailerQueryHandler::HandleQueryCallback, mailProto, sender, query);
 }
 
-void MassMailMgr::Update(bool sendall /*= false*/)
+void MassMailMgr::Update(bool sendall /*= false*/, uint32 ticks /*= 1*/)
 {
     if (m_massMails.empty())
         return;
 
-    uint32 maxcount = sWorld.getConfig(CONFIG_UINT32_MASS_MAILER_SEND_PER_TICK);
+    uint32 maxcount = sWorld.getConfig(CONFIG_UINT32_MASS_MAILER_SEND_PER_TICK) * ticks;
 
     do
     {
@@ -129,8 +129,7 @@ void MassMailMgr::GetStatistic(uint32& tasks, uint32& mails, uint32& needTime) c
 
     mails = mailsCount;
 
-    // 50 msecs is tick length
-    needTime = 50 * mailsCount / sWorld.getConfig(CONFIG_UINT32_MASS_MAILER_SEND_PER_TICK) / IN_MILLISECONDS;
+    needTime = sWorld.getConfig(CONFIG_UINT32_WORLD_TICK_TIME) * mailsCount / sWorld.getConfig(CONFIG_UINT32_MASS_MAILER_SEND_PER_TICK) / IN_MILLISECONDS;
 }
 
 
@@ -53,6 +53,7 @@ class MassMailMgr
 
     public:                                                 // Accessors
         void GetStatistic(uint32& tasks, uint32& mails, uint32& needTime) const;
+        bool IsEmpty() const { return m_massMails.empty(); }
 
     public:                                                 // modifiers
         typedef UNORDERED_SET<uint32> ReceiversList;
@@ -93,8 +94,10 @@ class MassMailMgr
 
         /**
          * Next step in mass mail activity, send some amount mails from queued tasks
+         *
+         * @param ticks         amount of world ticks the step catches up, each one sends up to MassMailer.SendPerTick mails
          */
-        void Update(bool sendall = false);
+        void Update(bool sendall = false, uint32 ticks = 1);
 
     private:
 
@@ -425,6 +425,8 @@ void MotionMaster::MoveDistract(uint32 timer)
 
 void MotionMaster::Mutate(MovementGenerator *m)
 {
+    m_owner->WakeUp();
+
     if (!empty())
     {
         switch(top()->GetMovementGeneratorType())
@@ -299,388 +299,435 @@ void WorldSession::HandleMovementOpcodes( WorldPacket & recv_data )
     if (plMover)
         plMover->UpdateFallInformationIfNeed(movementInfo, opcode);
 
-    WorldPacket data(SMSG_PLAYER_MOVE, recv_data.size());
-    WriteMovementInfo(data, &movementInfo);
-    mover->SendMessageToSetExcept(&data, _player);
+    WorldPacket* data = new WorldPacket(SMSG_PLAYER_MOVE, recv_data.size());
+    WriteMovementInfo(*data, &movementInfo);
+
+    // sent to the observers at the end of the map's session phase, far ones get fewer heartbeats
+    if (mover->IsInWorld())
+        mover->GetMap()->QueueMovementBroadcast(mover, _player, data, opcode == MSG_MOVE_HEARTBEAT);
+    else
+        delete data;
 }
 
-void WorldSession::ReadMovementInfo(WorldPacket &data, MovementInfo *mi)
+/// Presence bits read so far while decoding a movement packet
+struct MovementReadState
 {
-    bool HaveTransportData = false,
-        HaveTransportTime2 = false,
-        HaveTransportTime3 = false,
-        HaveMovementFlags = true,
-        HaveMovementFlags2 = true,
-        HaveOrientation = true,
-        HaveTimeStamp = true,
-        HavePitch = true,
-        HaveFallData = false,
-        HaveFallDirection = false,
-        HaveSplineElevation = true,
-        HaveUnknownBit = false,
-        HaveSpline = false;
-
-    MovementStatusElements *sequence = GetMovementStatusElementsSequence(data.GetOpcodeEnum());
-    if(sequence == NULL)
-        return;
+    MovementReadState() : haveTransportData(false), haveTransportTime2(false), haveTransportTime3(false),
+        haveMovementFlags(true), haveMovementFlags2(true), haveOrientation(true), haveTimeStamp(true), havePitch(true),
+        haveFallData(false), haveFallDirection(false), haveSplineElevation(true), haveUnknownBit(false), haveSpline(false)
+    {
+        memset(guid, 0, sizeof(guid));
+        memset(tguid, 0, sizeof(tguid));
+    }
 
+    bool haveTransportData;
+    bool haveTransportTime2;
+    bool haveTransportTime3;
+    bool haveMovementFlags;
+    bool haveMovementFlags2;
+    bool haveOrientation;
+    bool haveTimeStamp;
+    bool havePitch;
+    bool haveFallData;
+    bool haveFallDirection;
+    bool haveSplineElevation;
+    bool haveUnknownBit;
+    bool haveSpline;
     uint8 guid[8];
     uint8 tguid[8];
-    *(uint64*)guid = 0;
-    *(uint64*)tguid = 0;
-    for(uint32 i=0; i < MSE_COUNT; i++)
-    {
-        MovementStatusElements element = sequence[i];
+};
 
-        if (element >= MSEGuidByte0 && element <= MSEGuidByte7)
-        {
-            data.ReadByteMask(guid[element - MSEGuidByte0]);
-            continue;
-        }
-
-        if (element >= MSETransportGuidByte0 && element <= MSETransportGuidByte7)
-        {
-            if (HaveTransportData)
-                data.ReadByteMask(tguid[element - MSETransportGuidByte0]);
+/// Presence of the optional parts of an outgoing movement packet, derived from the movement flags
+struct MovementWriteState
+{
+    explicit MovementWriteState(MovementInfo const* mi) :
+        haveTransportData(mi->HasMovementFlag(MOVEFLAG_ONTRANSPORT)),
+        haveTransportTime2((mi->moveFlags2 & MOVEFLAG2_INTERP_MOVEMENT) != 0),
+        haveTransportTime3(false),
+        haveTime(true),
+        havePitch(mi->HasMovementFlag(MovementFlags(MOVEFLAG_SWIMMING | MOVEFLAG_FLYING)) || (mi->moveFlags2 & MOVEFLAG2_ALLOW_PITCHING)),
+        haveFallData(mi->HasMovementFlag2(MOVEFLAG2_INTERP_TURNING)),
+        haveFallDirection(mi->HasMovementFlag(MOVEFLAG_SAFE_FALL)),
+        haveSplineElevation(mi->HasMovementFlag(MOVEFLAG_SPLINE_ELEVATION)),
+        haveSpline(false),
+        guid((uint8 const*)&mi->guid),
+        tguid((uint8 const*)&mi->t_guid)
+    {
+    }
 
-            continue;
-        }
+    bool haveTransportData;
+    bool haveTransportTime2;
+    bool haveTransportTime3;
+    bool haveTime;
+    bool havePitch;
+    bool haveFallData;
+    bool haveFallDirection;
+    bool haveSplineElevation;
+    bool haveSpline;
+    uint8 const* guid;
+    uint8 const* tguid;
+};
+
+// The element is a template argument, so after inlining every switch below folds to the single case
+// of that element and a sequence expands into straight line reads/writes.
+template<MovementStatusElements Element>
+inline void ReadMovementElement(WorldPacket& data, MovementInfo* mi, MovementReadState& state)
+{
+    if (Element >= MSEGuidByte0 && Element <= MSEGuidByte7)
+    {
+        data.ReadByteMask(state.guid[(Element - MSEGuidByte0) & 7]);
+        return;
+    }
 
-        if (element >= MSEGuidByte0_2 && element <= MSEGuidByte7_2)
-        {
-            data.ReadByteSeq(guid[element - MSEGuidByte0_2]);
-            continue;
-        }
+    if (Element >= MSETransportGuidByte0 && Element <= MSETransportGuidByte7)
+    {
+        if (state.haveTransportData)
+            data.ReadByteMask(state.tguid[(Element - MSETransportGuidByte0) & 7]);
+        return;
+    }
 
-        if (element >= MSETransportGuidByte0_2 && element <= MSETransportGuidByte7_2)
-        {
-            if (HaveTransportData)
-                data.ReadByteSeq(tguid[element - MSETransportGuidByte0_2]);
+    if (Element >= MSEGuidByte0_2 && Element <= MSEGuidByte7_2)
+    {
+        data.ReadByteSeq(state.guid[(Element - MSEGuidByte0_2) & 7]);
+        return;
+    }
 
-            continue;
-        }
+    if (Element >= MSETransportGuidByte0_2 && Element <= MSETransportGuidByte7_2)
+    {
+        if (state.haveTransportData)
+            data.ReadByteSeq(state.tguid[(Element - MSETransportGuidByte0_2) & 7]);
+        return;
+    }
 
-        switch (element)
-        {
-            case MSEFlags:
-                if (MSEHaveMovementFlags)
-                    mi->moveFlags = data.ReadBits(30);
-                break;
-            case MSEFlags2:
-                if (MSEHaveMovementFlags2)
-                    mi->moveFlags2 = data.ReadBits(12);
-                break;
-            case MSEHaveUnknownBit:
-                HaveUnknownBit = data.ReadBit();
-                break;
-            case MSETimestamp:
-                if (MSEHaveTimeStamp)
-                    data >> mi->time;
-                break;
-            case MSEHaveTimeStamp:
-                HaveTimeStamp = !data.ReadBit();
-                break;
-            case MSEHaveOrientation:
-                HaveOrientation = !data.ReadBit();
-                break;
-            case MSEHaveMovementFlags:
-                HaveMovementFlags = !data.ReadBit();
-                break;
-            case MSEHaveMovementFlags2:
-                HaveMovementFlags2 = !data.ReadBit();
-                break;
-            case MSEHavePitch:
-                HavePitch = !data.ReadBit();
-                break;
-            case MSEHaveFallData:
-                HaveFallData = data.ReadBit();
-                break;
-            case MSEHaveFallDirection:
-                if (HaveFallData)
-                    HaveFallDirection = data.ReadBit();
-                break;
-            case MSEHaveTransportData:
-                HaveTransportData = data.ReadBit();
-                break;
-            case MSETransportHaveTime2:
-                if (HaveTransportData)
-                    HaveTransportTime2 = data.ReadBit();
-                break;
-            case MSETransportHaveTime3:
-                if (HaveTransportData)
-                    HaveTransportTime3 = data.ReadBit();
-                break;
-            case MSEHaveSpline:
-                HaveSpline = data.ReadBit();
-                break;
-            case MSEHaveSplineElev:
-                HaveSplineElevation = !data.ReadBit();
-                break;
-            case MSEPositionX:
+    switch (Element)
+    {
+        case MSEFlags:
+            if (state.haveMovementFlags)
+                mi->moveFlags = data.ReadBits(30);
+            break;
+        case MSEFlags2:
+            if (state.haveMovementFlags2)
+                mi->moveFlags2 = data.ReadBits(12);
+            break;
+        case MSEHaveUnknownBit:
+            state.haveUnknownBit = data.ReadBit();
+            break;
+        case MSETimestamp:
+            if (state.haveTimeStamp)
+                data >> mi->time;
+            break;
+        case MSEHaveTimeStamp:
+            state.haveTimeStamp = !data.ReadBit();
+            break;
+        case MSEHaveOrientation:
+            state.haveOrientation = !data.ReadBit();
+            break;
+        case MSEHaveMovementFlags:
+            state.haveMovementFlags = !data.ReadBit();
+            break;
+        case MSEHaveMovementFlags2:
+            state.haveMovementFlags2 = !data.ReadBit();
+            break;
+        case MSEHavePitch:
+            state.havePitch = !data.ReadBit();
+            break;
+        case MSEHaveFallData:
+            state.haveFallData = data.ReadBit();
+            break;
+        case MSEHaveFallDirection:
+            if (state.haveFallData)
+                state.haveFallDirection = data.ReadBit();
+            break;
+        case MSEHaveTransportData:
+            state.haveTransportData = data.ReadBit();
+            break;
+        case MSETransportHaveTime2:
+            if (state.haveTransportData)
+                state.haveTransportTime2 = data.ReadBit();
+            break;
+        case MSETransportHaveTime3:
+            if (state.haveTransportData)
+                state.haveTransportTime3 = data.ReadBit();
+            break;
+        case MSEHaveSpline:
+            state.haveSpline = data.ReadBit();
+            break;
+        case MSEHaveSplineElev:
+            state.haveSplineElevation = !data.ReadBit();
+            break;
+        case MSEPositionX:
+            data >> mi->pos.x;
+            break;
+        case MSEPositionY:
+            data >> mi->pos.y;
+            break;
+        case MSEPositionZ:
+            data >> mi->pos.z;
+            break;
+        case MSEPositionO:
+            if (state.haveOrientation)
+                data >> mi->pos.o;
+            break;
+        case MSEPitch:
+            if (state.havePitch)
+                data >> mi->s_pitch;
+            break;
+        case MSEFallTime:
+            if (state.haveFallData)
+                data >> mi->fallTime;
+            break;
+        case MSESplineElev:
+            if (state.haveSplineElevation)
+                data >> mi->splineElevation;
+            break;
+        case MSEFallHorizontalSpeed:
+            if (state.haveFallDirection)
+                data >> mi->jump.xyspeed;
+            break;
+        case MSEFallVerticalSpeed:
+            if (state.haveFallData)
+                data >> mi->jump.velocity;
+            break;
+        case MSEFallCosAngle:
+            if (state.haveFallDirection)
+                data >> mi->jump.cosAngle;
+            break;
+        case MSEFallSinAngle:
+            if (state.haveFallDirection)
+                data >> mi->jump.sinAngle;
+            break;
+        case MSETransportSeat:
+            if (state.haveTransportData)
+                data >> mi->t_seat;
+            break;
+        case MSETransportPositionO:
+            if (state.haveTransportData)
+                data >> mi->t_pos.o;
+            break;
+        case MSETransportPositionX:
+            if (state.haveTransportData)
                 data >> mi->pos.x;
-                break;
-            case MSEPositionY:
+            break;
+        case MSETransportPositionY:
+            if (state.haveTransportData)
                 data >> mi->pos.y;
-                break;
-            case MSEPositionZ:
+            break;
+        case MSETransportPositionZ:
+            if (state.haveTransportData)
                 data >> mi->pos.z;
-                break;
-            case MSEPositionO:
-                if (HaveOrientation)
-                    data >> mi->pos.o;
-                break;
-            case MSEPitch:
-                if (HavePitch)
-                    data >> mi->s_pitch;
-                break;;
-            case MSEFallTime:
-                if (HaveFallData)
-                    sLog.outDebug("mi->fallTime: %u", mi->fallTime);
-                break;
-            case MSESplineElev:
-                if (HaveSplineElevation)
-                    data >> mi->splineElevation;
-                break;
-            case MSEFallHorizontalSpeed:
-                if (HaveFallDirection)
-                    data >> mi->jump.xyspeed;
-                break;
-            case MSEFallVerticalSpeed:
-                if (HaveFallData)
-                    data >> mi->jump.velocity;
-                break;
-            case MSEFallCosAngle:
-                if (HaveFallDirection)
-                    data >> mi->jump.cosAngle;
-                break;
-            case MSEFallSinAngle:
-                if (HaveFallDirection)
-                    data >> mi->jump.sinAngle;
-                break;
-            case MSETransportSeat:
-                if (HaveTransportData)
-                    data >> mi->t_seat;
-                break;
-            case MSETransportPositionO:
-                if (HaveTransportData)
-                    data >> mi->t_pos.o;
-                break;
-            case MSETransportPositionX:
-                if (HaveTransportData)
-                    data >> mi->pos.x;
-                break;
-            case MSETransportPositionY:
-                if (HaveTransportData)
-                    data >> mi->pos.y;
-                break;
-            case MSETransportPositionZ:
-                if (HaveTransportData)
-                    data >> mi->pos.z;
-                break;
-            case MSETransportTime:
-                if (HaveTransportData)
-                    data >> mi->t_time;
-                break;
-            case MSETransportTime2:
-                if (HaveTransportTime2)
-                    data >> mi->t_time2;
-                break;
-            case MSETransportTime3:
-                if (HaveTransportTime3)
-                    data >> mi->fallTime;
-                break;
-            default:
-                WPError(false);
-        }
+            break;
+        case MSETransportTime:
+            if (state.haveTransportData)
+                data >> mi->t_time;
+            break;
+        case MSETransportTime2:
+            if (state.haveTransportTime2)
+                data >> mi->t_time2;
+            break;
+        case MSETransportTime3:
+            if (state.haveTransportTime3)
+                data >> mi->fallTime;
+            break;
+        default:
+            WPError(false);
     }
-
-    mi->guid = *(ObjectGuid*)guid;
-    mi->t_guid = *(ObjectGuid*)tguid;
-
-    if (HaveTransportData && mi->pos.x != mi->t_pos.x)
-        if (GetPlayer()->GetTransport())
-            GetPlayer()->GetTransport()->m_position = mi->pos;
 }
 
-void WorldSession::WriteMovementInfo(WorldPacket &data, MovementInfo *mi)
+template<MovementStatusElements Element>
+inline void WriteMovementElement(WorldPacket& data, MovementInfo const* mi, MovementWriteState const& state)
 {
-    bool HaveTransportData = mi->HasMovementFlag(MOVEFLAG_ONTRANSPORT),
-        HaveTransportTime2 = (mi->moveFlags2 & MOVEFLAG2_INTERP_MOVEMENT) != 0,
-        HaveTransportTime3 = false,
-        HaveTime = true,
-        HavePitch = (mi->HasMovementFlag(MovementFlags(MOVEFLAG_SWIMMING | MOVEFLAG_FLYING))) || (mi->moveFlags2 & MOVEFLAG2_ALLOW_PITCHING),
-        HaveFallData = mi->HasMovementFlag2(MOVEFLAG2_INTERP_TURNING),
-        HaveFallDirection = mi->HasMovementFlag(MOVEFLAG_SAFE_FALL),
-        HaveSplineElevation = mi->HasMovementFlag(MOVEFLAG_SPLINE_ELEVATION),
-        HaveSpline = false;
-
-    MovementStatusElements *sequence = GetMovementStatusElementsSequence(data.GetOpcodeEnum());
-    if(!sequence)
-        return;
-    uint8 *guid = (uint8 *)&mi->guid;
-    uint8 *tguid = (uint8 *)&mi->t_guid;
-    for(uint32 i=0; i < MSE_COUNT; i++)
+    if (Element >= MSEGuidByte0 && Element <= MSEGuidByte7)
     {
-        MovementStatusElements element = sequence[i];
-
-        if (element >= MSEGuidByte0 && element <= MSEGuidByte7)
-        {
-            data.WriteByteMask(guid[element - MSEGuidByte0]);
-            continue;
-        }
+        data.WriteByteMask(state.guid[(Element - MSEGuidByte0) & 7]);
+        return;
+    }
 
-        if (element >= MSETransportGuidByte0 && element <= MSETransportGuidByte7)
-        {
-            if (HaveTransportData)
-                data.WriteByteMask(tguid[element - MSETransportGuidByte0]);
-            continue;
-        }
+    if (Element >= MSETransportGuidByte0 && Element <= MSETransportGuidByte7)
+    {
+        if (state.haveTransportData)
+            data.WriteByteMask(state.tguid[(Element - MSETransportGuidByte0) & 7]);
+        return;
+    }
 
-        if (element >= MSEGuidByte0_2 && element <= MSEGuidByte7_2)
-        {
-            data.WriteByteSeq(guid[element - MSEGuidByte0_2]);
-            continue;
-        }
+    if (Element >= MSEGuidByte0_2 && Element <= MSEGuidByte7_2)
+    {
+        data.WriteByteSeq(state.guid[(Element - MSEGuidByte0_2) & 7]);
+        return;
+    }
 
-        if (element >= MSETransportGuidByte0_2 && element <= MSETransportGuidByte7_2)
-        {
-            if (HaveTransportData)
-                data.WriteByteSeq(tguid[element - MSETransportGuidByte0_2]);
-            continue;
-        }
+    if (Element >= MSETransportGuidByte0_2 && Element <= MSETransportGuidByte7_2)
+    {
+        if (state.haveTransportData)
+            data.WriteByteSeq(state.tguid[(Element - MSETransportGuidByte0_2) & 7]);
+        return;
+    }
 
-        switch (element)
-        {
-            case MSEHaveMovementFlags:
-                data.WriteBit(!mi->GetMovementFlags());
-                break;
-            case MSEHaveMovementFlags2:
-                data.WriteBit(!mi->GetMovementFlags2());
-                break;
-            case MSEFlags:
-                if (mi->GetMovementFlags())
-                    data.WriteBits(mi->moveFlags, 30);
-                break;
-            case MSEFlags2:
-                if (mi->GetMovementFlags2())
-                    data.WriteBits(mi->moveFlags2, 12);
-                break;
-            case MSETimestamp:
-                if (HaveTime)
-                    data << mi->time;
-                break;
-            case MSEHavePitch:
-                data.WriteBit(!HavePitch);
-                break;
-            case MSEHaveTimeStamp:
-                if (HaveFallData)
-                    data.WriteBit(HaveTime);
-                break;
-            case MSEHaveUnknownBit:
-                data.WriteBit(false);
-                break;
-            case MSEHaveFallData:
-                data.WriteBit(HaveFallData);
-                break;
-            case MSEHaveFallDirection:
-                if (HaveFallData)
-                    data.WriteBit(HaveFallDirection);
-                break;
-            case MSEHaveTransportData:
-                data.WriteBit(HaveTransportData);
-                break;
-            case MSETransportHaveTime2:
-                if (HaveTransportData)
-                    data.WriteBit(HaveTransportTime2);
-                break;
-            case MSETransportHaveTime3:
-                if (HaveTransportData)
-                    data.WriteBit(HaveTransportTime3);
-                break;
-            case MSEHaveSpline:
-                data.WriteBit(HaveSpline);
-                break;
-            case MSEHaveSplineElev:
-                data.WriteBit(!HaveSplineElevation);
-                break;
-            case MSEPositionX:
+    switch (Element)
+    {
+        case MSEHaveMovementFlags:
+            data.WriteBit(!mi->GetMovementFlags());
+            break;
+        case MSEHaveMovementFlags2:
+            data.WriteBit(!mi->GetMovementFlags2());
+            break;
+        case MSEFlags:
+            if (mi->GetMovementFlags())
+                data.WriteBits(mi->moveFlags, 30);
+            break;
+        case MSEFlags2:
+            if (mi->GetMovementFlags2())
+                data.WriteBits(mi->moveFlags2, 12);
+            break;
+        case MSETimestamp:
+            if (state.haveTime)
+                data << mi->time;
+            break;
+        case MSEHavePitch:
+            data.WriteBit(!state.havePitch);
+            break;
+        case MSEHaveTimeStamp:
+            data.WriteBit(!state.haveTime);
+            break;
+        case MSEHaveUnknownBit:
+            data.WriteBit(false);
+            break;
+        case MSEHaveFallData:
+            data.WriteBit(state.haveFallData);
+            break;
+        case MSEHaveFallDirection:
+            if (state.haveFallData)
+                data.WriteBit(state.haveFallDirection);
+            break;
+        case MSEHaveTransportData:
+            data.WriteBit(state.haveTransportData);
+            break;
+        case MSETransportHaveTime2:
+            if (state.haveTransportData)
+                data.WriteBit(state.haveTransportTime2);
+            break;
+        case MSETransportHaveTime3:
+            if (state.haveTransportData)
+                data.WriteBit(state.haveTransportTime3);
+            break;
+        case MSEHaveSpline:
+            data.WriteBit(state.haveSpline);
+            break;
+        case MSEHaveSplineElev:
+            data.WriteBit(!state.haveSplineElevation);
+            break;
+        case MSEPositionX:
+            data << mi->pos.x;
+            break;
+        case MSEPositionY:
+            data << mi->pos.y;
+            break;
+        case MSEPositionZ:
+            data << mi->pos.z;
+            break;
+        case MSEPositionO:
+            data << mi->pos.o;
+            break;
+        case MSEPitch:
+            if (state.havePitch)
+                data << mi->s_pitch;
+            break;
+        case MSEHaveOrientation:
+            data.WriteBit(false);
+            break;
+        case MSEFallTime:
+            if (state.haveFallData)
+                data << mi->fallTime;
+            break;
+        case MSESplineElev:
+            if (state.haveSplineElevation)
+                data << mi->splineElevation;
+            break;
+        case MSEFallHorizontalSpeed:
+            if (state.haveFallDirection)
+                data << mi->jump.xyspeed;
+            break;
+        case MSEFallVerticalSpeed:
+            if (state.haveFallData)
+                data << mi->jump.velocity;
+            break;
+        case MSEFallCosAngle:
+            if (state.haveFallDirection)
+                data << mi->jump.cosAngle;
+            break;
+        case MSEFallSinAngle:
+            if (state.haveFallDirection)
+                data << mi->jump.sinAngle;
+            break;
+        case MSETransportSeat:
+            if (state.haveTransportData)
+                data << mi->t_seat;
+            break;
+        case MSETransportPositionO:
+            if (state.haveTransportData)
+                data << mi->t_pos.o;
+            break;
+        case MSETransportPositionX:
+            if (state.haveTransportData)
                 data << mi->pos.x;
-                break;
-            case MSEPositionY:
+            break;
+        case MSETransportPositionY:
+            if (state.haveTransportData)
                 data << mi->pos.y;
-                break;
-            case MSEPositionZ:
+            break;
+        case MSETransportPositionZ:
+            if (state.haveTransportData)
                 data << mi->pos.z;
-                break;
-            case MSEPositionO:
-                data << mi->pos.o;
-                break;
-            case MSEPitch:
-                if (HavePitch)
-                    data << mi->s_pitch;
-                break;
-            case MSEHaveOrientation:
-                data.WriteBit(false);
-                break;
-            case MSEFallTime:
-                if (HaveFallData)
-                    data << mi->fallTime;
-                break;
-            case MSESplineElev:
-                if (HaveSplineElevation)
-                    data << mi->splineElevation;
-                break;
-            case MSEFallHorizontalSpeed:
-                if (HaveFallDirection)
-                    data << mi->jump.xyspeed;
-                break;
-            case MSEFallVerticalSpeed:
-                if (HaveFallData)
-                    data << mi->jump.velocity;
-                break;
-            case MSEFallCosAngle:
-                if (HaveFallDirection)
-                    data << mi->jump.cosAngle;
-                break;
-            case MSEFallSinAngle:
-                if (HaveFallDirection)
-                    data << mi->jump.sinAngle;
-                break;
-            case MSETransportSeat:
-                if (HaveTransportData)
-                    data << mi->t_seat;
-                break;
-            case MSETransportPositionO:
-                if (HaveTransportData)
-                    data << mi->t_pos.o;
-                break;
-            case MSETransportPositionX:
-                if (HaveTransportData)
-                    data << mi->pos.x;
-                break;
-            case MSETransportPositionY:
-                if (HaveTransportData)
-                    data << mi->pos.y;
-                break;
-            case MSETransportPositionZ:
-                if (HaveTransportData)
-                    data << mi->pos.z;
-                break;
-            case MSETransportTime:
-                if (HaveTransportData)
-                    data << mi->t_time;
-                break;
-            case MSETransportTime2:
-                if (HaveTransportTime2)
-                    data << mi->t_time2;
-                break;
-            case MSETransportTime3:
-                if (HaveTransportTime3)
-                    data << mi->fallTime;
-                break;
-            default:
-                WPError(false);
-        }
+            break;
+        case MSETransportTime:
+            if (state.haveTransportData)
+                data << mi->t_time;
+            break;
+        case MSETransportTime2:
+            if (state.haveTransportTime2)
+                data << mi->t_time2;
+            break;
+        case MSETransportTime3:
+            if (state.haveTransportTime3)
+                data << mi->fallTime;
+            break;
+        default:
+            WPError(false);
+    }
+}
+
+#define MOVEMENT_READ_ELEMENT(element) ReadMovementElement<element>(data, mi, state);
+#define MOVEMENT_READ_CASE(opcode, sequence) case opcode: sequence(MOVEMENT_READ_ELEMENT) break;
+#define MOVEMENT_WRITE_ELEMENT(element) WriteMovementElement<element>(data, mi, state);
+#define MOVEMENT_WRITE_CASE(opcode, sequence) case opcode: sequence(MOVEMENT_WRITE_ELEMENT) break;
+
+void WorldSession::ReadMovementInfo(WorldPacket &data, MovementInfo *mi)
+{
+    MovementReadState state;
+
+    switch (data.GetOpcodeEnum())
+    {
+        MOVEMENT_SEQUENCES(MOVEMENT_READ_CASE)
+        default:
+            return;
+    }
+
+    mi->guid = *(ObjectGuid*)state.guid;
+    mi->t_guid = *(ObjectGuid*)state.tguid;
+
+    if (state.haveTransportData && mi->pos.x != mi->t_pos.x)
+        if (GetPlayer()->GetTransport())
+            GetPlayer()->GetTransport()->m_position = mi->pos;
+}
+
+void WorldSession::WriteMovementInfo(WorldPacket &data, MovementInfo *mi)
+{
+    MovementWriteState state(mi);
+
+    switch (data.GetOpcodeEnum())
+    {
+        MOVEMENT_SEQUENCES(MOVEMENT_WRITE_CASE)
+        default:
+            break;
     }
 }
 
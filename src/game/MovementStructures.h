@@ -92,1302 +92,1262 @@ enum MovementStatusElements
     MSE_COUNT
 };
 
-MovementStatusElements PlayerMoveSequence[] =
-{
-    MSEHaveFallData,
-    MSEGuidByte3,
-    MSEGuidByte6,
-    MSEHaveMovementFlags2,
-    MSEHaveUnknownBit,
-    MSEHaveTimeStamp,
-    MSEGuidByte0,
-    MSEGuidByte1,
-    MSEFlags2,
-    MSEGuidByte7,
-    MSEHaveMovementFlags,
-    MSEHaveOrientation,
-    MSEGuidByte2,
-    MSEHaveSplineElev,
-    MSEHaveSpline,
-    MSEGuidByte4,
-    MSEHaveFallDirection,
-    MSEGuidByte5,
-    MSEHaveTransportData,
-    MSEFlags,
-    MSETransportGuidByte3,
-    MSETransportHaveTime3,
-    MSETransportGuidByte6,
-    MSETransportGuidByte1,
-    MSETransportGuidByte7,
-    MSETransportGuidByte0,
-    MSETransportGuidByte4,
-    MSETransportHaveTime2,
-    MSETransportGuidByte5,
-    MSETransportGuidByte2,
-    MSEHavePitch,
-    MSEGuidByte5_2,
-    MSEFallCosAngle,
-    MSEFallHorizontalSpeed,
-    MSEFallSinAngle,
-    MSEFallVerticalSpeed,
-    MSEFallTime,
-    MSESplineElev,
-    MSEGuidByte7_2,
-    MSEPositionY,
-    MSEGuidByte3_2,
-    MSETransportTime3,
-    MSETransportGuidByte6_2,
-    MSETransportSeat,
-    MSETransportGuidByte5_2,
-    MSETransportPositionX,
-    MSETransportGuidByte1_2,
-    MSETransportPositionO,
-    MSETransportGuidByte2_2,
-    MSETransportTime2,
-    MSETransportGuidByte0_2,
-    MSETransportPositionZ,
-    MSETransportGuidByte7_2,
-    MSETransportGuidByte4_2,
-    MSETransportGuidByte3_2,
-    MSETransportPositionY,
-    MSETransportTime,
-    MSEGuidByte4_2,
-    MSEPositionX,
-    MSEGuidByte6_2,
-    MSEPositionZ,
-    MSETimestamp,
-    MSEGuidByte2_2,
-    MSEPitch,
-    MSEGuidByte0_2,
-    MSEPositionO,
-    MSEGuidByte1_2
-};
+/**
+ * Order of the elements in the movement packets, one list per opcode. Each list is an X-macro: the
+ * codec in MovementHandler.cpp passes a macro taking one element and gets the whole sequence unrolled
+ * into straight line code, so there is no table to walk at runtime.
+ */
+#define PLAYER_MOVE_SEQUENCE(E) \
+    E(MSEHaveFallData) \
+    E(MSEGuidByte3) \
+    E(MSEGuidByte6) \
+    E(MSEHaveMovementFlags2) \
+    E(MSEHaveUnknownBit) \
+    E(MSEHaveTimeStamp) \
+    E(MSEGuidByte0) \
+    E(MSEGuidByte1) \
+    E(MSEFlags2) \
+    E(MSEGuidByte7) \
+    E(MSEHaveMovementFlags) \
+    E(MSEHaveOrientation) \
+    E(MSEGuidByte2) \
+    E(MSEHaveSplineElev) \
+    E(MSEHaveSpline) \
+    E(MSEGuidByte4) \
+    E(MSEHaveFallDirection) \
+    E(MSEGuidByte5) \
+    E(MSEHaveTransportData) \
+    E(MSEFlags) \
+    E(MSETransportGuidByte3) \
+    E(MSETransportHaveTime3) \
+    E(MSETransportGuidByte6) \
+    E(MSETransportGuidByte1) \
+    E(MSETransportGuidByte7) \
+    E(MSETransportGuidByte0) \
+    E(MSETransportGuidByte4) \
+    E(MSETransportHaveTime2) \
+    E(MSETransportGuidByte5) \
+    E(MSETransportGuidByte2) \
+    E(MSEHavePitch) \
+    E(MSEGuidByte5_2) \
+    E(MSEFallCosAngle) \
+    E(MSEFallHorizontalSpeed) \
+    E(MSEFallSinAngle) \
+    E(MSEFallVerticalSpeed) \
+    E(MSEFallTime) \
+    E(MSESplineElev) \
+    E(MSEGuidByte7_2) \
+    E(MSEPositionY) \
+    E(MSEGuidByte3_2) \
+    E(MSETransportTime3) \
+    E(MSETransportGuidByte6_2) \
+    E(MSETransportSeat) \
+    E(MSETransportGuidByte5_2) \
+    E(MSETransportPositionX) \
+    E(MSETransportGuidByte1_2) \
+    E(MSETransportPositionO) \
+    E(MSETransportGuidByte2_2) \
+    E(MSETransportTime2) \
+    E(MSETransportGuidByte0_2) \
+    E(MSETransportPositionZ) \
+    E(MSETransportGuidByte7_2) \
+    E(MSETransportGuidByte4_2) \
+    E(MSETransportGuidByte3_2) \
+    E(MSETransportPositionY) \
+    E(MSETransportTime) \
+    E(MSEGuidByte4_2) \
+    E(MSEPositionX) \
+    E(MSEGuidByte6_2) \
+    E(MSEPositionZ) \
+    E(MSETimestamp) \
+    E(MSEGuidByte2_2) \
+    E(MSEPitch) \
+    E(MSEGuidByte0_2) \
+    E(MSEPositionO) \
+    E(MSEGuidByte1_2)
 
-MovementStatusElements MovementFallLandSequence[] = {
-MSEGuidByte5,
-MSEGuidByte6,
-MSEGuidByte4,
-MSEGuidByte1,
-MSEGuidByte2,
-MSEHaveSpline,
-MSEFlags2,
-MSEGuidByte7,
-MSEGuidByte3,
-MSEGuidByte0,
-MSEFlags,
-MSEHaveFallData,
-MSEHaveFallDirection,
-MSEHaveTransportData,
-MSETransportGuidByte6,
-MSETransportGuidByte3,
-MSETransportGuidByte7,
-MSETransportGuidByte4,
-MSETransportGuidByte1,
-MSETransportGuidByte0,
-MSETransportGuidByte2,
-MSETransportGuidByte5,
-MSETransportHaveTime3,
-MSETransportHaveTime2,
-MSEHavePitch,
-MSEHaveSplineElev,
-MSETimestamp,
-MSEPositionX,
-MSEPositionY,
-MSEPositionZ,
-MSEPositionO,
-MSEGuidByte7_2,
-MSEGuidByte2_2,
-MSEGuidByte3_2,
-MSEGuidByte0_2,
-MSEGuidByte1_2,
-MSEGuidByte5_2,
-MSEFallVerticalSpeed,
-MSEFallTime,
-MSEFallHorizontalSpeed,
-MSEFallCosAngle,
-MSEFallSinAngle,
-MSETransportTime,
-MSETransportPositionX,
-MSETransportPositionY,
-MSETransportPositionZ,
-MSETransportPositionO,
-MSETransportSeat,
-MSETransportGuidByte3_2,
-MSETransportGuidByte1_2,
-MSETransportTime3,
-MSETransportGuidByte6_2,
-MSETransportGuidByte0_2,
-MSETransportGuidByte5_2,
-MSETransportTime2,
-MSETransportGuidByte7_2,
-MSETransportGuidByte4_2,
-MSETransportGuidByte2_2,
-MSEPitch,
-MSESplineElev,
-MSEGuidByte6_2,
-MSEGuidByte4_2,
-};
+#define MOVEMENT_FALL_LAND_SEQUENCE(E) \
+    E(MSEGuidByte5) \
+    E(MSEGuidByte6) \
+    E(MSEGuidByte4) \
+    E(MSEGuidByte1) \
+    E(MSEGuidByte2) \
+    E(MSEHaveSpline) \
+    E(MSEFlags2) \
+    E(MSEGuidByte7) \
+    E(MSEGuidByte3) \
+    E(MSEGuidByte0) \
+    E(MSEFlags) \
+    E(MSEHaveFallData) \
+    E(MSEHaveFallDirection) \
+    E(MSEHaveTransportData) \
+    E(MSETransportGuidByte6) \
+    E(MSETransportGuidByte3) \
+    E(MSETransportGuidByte7) \
+    E(MSETransportGuidByte4) \
+    E(MSETransportGuidByte1) \
+    E(MSETransportGuidByte0) \
+    E(MSETransportGuidByte2) \
+    E(MSETransportGuidByte5) \
+    E(MSETransportHaveTime3) \
+    E(MSETransportHaveTime2) \
+    E(MSEHavePitch) \
+    E(MSEHaveSplineElev) \
+    E(MSETimestamp) \
+    E(MSEPositionX) \
+    E(MSEPositionY) \
+    E(MSEPositionZ) \
+    E(MSEPositionO) \
+    E(MSEGuidByte7_2) \
+    E(MSEGuidByte2_2) \
+    E(MSEGuidByte3_2) \
+    E(MSEGuidByte0_2) \
+    E(MSEGuidByte1_2) \
+    E(MSEGuidByte5_2) \
+    E(MSEFallVerticalSpeed) \
+    E(MSEFallTime) \
+    E(MSEFallHorizontalSpeed) \
+    E(MSEFallCosAngle) \
+    E(MSEFallSinAngle) \
+    E(MSETransportTime) \
+    E(MSETransportPositionX) \
+    E(MSETransportPositionY) \
+    E(MSETransportPositionZ) \
+    E(MSETransportPositionO) \
+    E(MSETransportSeat) \
+    E(MSETransportGuidByte3_2) \
+    E(MSETransportGuidByte1_2) \
+    E(MSETransportTime3) \
+    E(MSETransportGuidByte6_2) \
+    E(MSETransportGuidByte0_2) \
+    E(MSETransportGuidByte5_2) \
+    E(MSETransportTime2) \
+    E(MSETransportGuidByte7_2) \
+    E(MSETransportGuidByte4_2) \
+    E(MSETransportGuidByte2_2) \
+    E(MSEPitch) \
+    E(MSESplineElev) \
+    E(MSEGuidByte6_2) \
+    E(MSEGuidByte4_2)
 
-MovementStatusElements MovementHeartBeatSequence[] = {
-    MSEPositionZ,
-    MSEPositionX,
-    MSEPositionY,
-    MSEHavePitch,
-    MSEHaveTimeStamp,
-    MSEHaveFallData,
-    MSEHaveMovementFlags2,
-    MSEHaveTransportData,
-    MSEGuidByte7,
-    MSEGuidByte1,
-    MSEGuidByte0,
-    MSEGuidByte4,
-    MSEGuidByte2,
-    MSEHaveOrientation,
-    MSEGuidByte5,
-    MSEGuidByte3,
-    MSEHaveSplineElev,
-    MSEHaveUnknownBit,
-    MSEHaveSpline,
-    MSEGuidByte6,
-    MSEHaveMovementFlags,
-    MSETransportHaveTime3,
-    MSETransportGuidByte4,
-    MSETransportGuidByte2,
-    MSETransportHaveTime2,
-    MSETransportGuidByte5,
-    MSETransportGuidByte7,
-    MSETransportGuidByte6,
-    MSETransportGuidByte0,
-    MSETransportGuidByte3,
-    MSETransportGuidByte1,
-    MSEHaveFallDirection,
-    MSEFlags,
-    MSEFlags2,
-    MSEGuidByte3_2,
-    MSEGuidByte6_2,
-    MSEGuidByte1_2,
-    MSEGuidByte7_2,
-    MSEGuidByte2_2,
-    MSEGuidByte5_2,
-    MSEGuidByte0_2,
-    MSEGuidByte4_2,
-    MSETransportPositionZ,
-    MSETransportSeat,
-    MSETransportPositionO,
-    MSETransportGuidByte4_2,
-    MSETransportPositionY,
-    MSETransportTime,
-    MSETransportPositionX,
-    MSETransportGuidByte5_2,
-    MSETransportGuidByte1_2,
-    MSETransportGuidByte3_2,
-    MSETransportGuidByte7_2,
-    MSETransportTime3,
-    MSETransportTime2,
-    MSETransportGuidByte2_2,
-    MSETransportGuidByte0_2,
-    MSETransportGuidByte6_2,
-    MSEPositionO,
-    MSEFallVerticalSpeed,
-    MSEFallTime,
-    MSEFallCosAngle,
-    MSEFallSinAngle,
-    MSEFallHorizontalSpeed,
-    MSEPitch,
-    MSESplineElev,
-    MSETimestamp,
-};
+#define MOVEMENT_HEART_BEAT_SEQUENCE(E) \
+    E(MSEPositionZ) \
+    E(MSEPositionX) \
+    E(MSEPositionY) \
+    E(MSEHavePitch) \
+    E(MSEHaveTimeStamp) \
+    E(MSEHaveFallData) \
+    E(MSEHaveMovementFlags2) \
+    E(MSEHaveTransportData) \
+    E(MSEGuidByte7) \
+    E(MSEGuidByte1) \
+    E(MSEGuidByte0) \
+    E(MSEGuidByte4) \
+    E(MSEGuidByte2) \
+    E(MSEHaveOrientation) \
+    E(MSEGuidByte5) \
+    E(MSEGuidByte3) \
+    E(MSEHaveSplineElev) \
+    E(MSEHaveUnknownBit) \
+    E(MSEHaveSpline) \
+    E(MSEGuidByte6) \
+    E(MSEHaveMovementFlags) \
+    E(MSETransportHaveTime3) \
+    E(MSETransportGuidByte4) \
+    E(MSETransportGuidByte2) \
+    E(MSETransportHaveTime2) \
+    E(MSETransportGuidByte5) \
+    E(MSETransportGuidByte7) \
+    E(MSETransportGuidByte6) \
+    E(MSETransportGuidByte0) \
+    E(MSETransportGuidByte3) \
+    E(MSETransportGuidByte1) \
+    E(MSEHaveFallDirection) \
+    E(MSEFlags) \
+    E(MSEFlags2) \
+    E(MSEGuidByte3_2) \
+    E(MSEGuidByte6_2) \
+    E(MSEGuidByte1_2) \
+    E(MSEGuidByte7_2) \
+    E(MSEGuidByte2_2) \
+    E(MSEGuidByte5_2) \
+    E(MSEGuidByte0_2) \
+    E(MSEGuidByte4_2) \
+    E(MSETransportPositionZ) \
+    E(MSETransportSeat) \
+    E(MSETransportPositionO) \
+    E(MSETransportGuidByte4_2) \
+    E(MSETransportPositionY) \
+    E(MSETransportTime) \
+    E(MSETransportPositionX) \
+    E(MSETransportGuidByte5_2) \
+    E(MSETransportGuidByte1_2) \
+    E(MSETransportGuidByte3_2) \
+    E(MSETransportGuidByte7_2) \
+    E(MSETransportTime3) \
+    E(MSETransportTime2) \
+    E(MSETransportGuidByte2_2) \
+    E(MSETransportGuidByte0_2) \
+    E(MSETransportGuidByte6_2) \
+    E(MSEPositionO) \
+    E(MSEFallVerticalSpeed) \
+    E(MSEFallTime) \
+    E(MSEFallCosAngle) \
+    E(MSEFallSinAngle) \
+    E(MSEFallHorizontalSpeed) \
+    E(MSEPitch) \
+    E(MSESplineElev) \
+    E(MSETimestamp)
 
-MovementStatusElements MovementJumpSequence[] = {
-MSEGuidByte5,
-MSEGuidByte1,
-MSEGuidByte6,
-MSEFlags,
-MSEGuidByte2,
-MSEHaveSpline,
-MSEGuidByte3,
-MSEFlags2,
-MSEGuidByte4,
-MSEGuidByte0,
-MSEGuidByte7,
-MSEHaveFallData,
-MSEHaveFallDirection,
-MSEHaveTransportData,
-MSETransportGuidByte6,
-MSETransportGuidByte3,
-MSETransportGuidByte7,
-MSETransportGuidByte4,
-MSETransportGuidByte1,
-MSETransportGuidByte0,
-MSETransportGuidByte2,
-MSETransportGuidByte5,
-MSETransportHaveTime3,
-MSETransportHaveTime2,
-MSEHaveSplineElev,
-MSEHavePitch,
-MSEPositionO,
-MSEPositionX,
-MSEPositionY,
-MSEPositionZ,
-MSETimestamp,
-MSEGuidByte1_2,
-MSEFallVerticalSpeed,
-MSEFallTime,
-MSEFallHorizontalSpeed,
-MSEFallCosAngle,
-MSEFallSinAngle,
-MSETransportTime,
-MSETransportPositionX,
-MSETransportPositionY,
-MSETransportPositionZ,
-MSETransportPositionO,
-MSETransportSeat,
-MSETransportGuidByte3_2,
-MSETransportGuidByte1_2,
-MSETransportTime3,
-MSETransportGuidByte6_2,
-MSETransportGuidByte0_2,
-MSETransportGuidByte5_2,
-MSETransportTime2,
-MSETransportGuidByte7_2,
-MSETransportGuidByte4_2,
-MSETransportGuidByte2_2,
-MSEGuidByte6_2,
-MSEGuidByte4_2,
-MSESplineElev,
-MSEGuidByte0_2,
-MSEPitch,
-MSEGuidByte5_2,
-MSEGuidByte3_2,
-MSEGuidByte7_2,
-MSEGuidByte2_2,
-};
+#define MOVEMENT_JUMP_SEQUENCE(E) \
+    E(MSEGuidByte5) \
+    E(MSEGuidByte1) \
+    E(MSEGuidByte6) \
+    E(MSEFlags) \
+    E(MSEGuidByte2) \
+    E(MSEHaveSpline) \
+    E(MSEGuidByte3) \
+    E(MSEFlags2) \
+    E(MSEGuidByte4) \
+    E(MSEGuidByte0) \
+    E(MSEGuidByte7) \
+    E(MSEHaveFallData) \
+    E(MSEHaveFallDirection) \
+    E(MSEHaveTransportData) \
+    E(MSETransportGuidByte6) \
+    E(MSETransportGuidByte3) \
+    E(MSETransportGuidByte7) \
+    E(MSETransportGuidByte4) \
+    E(MSETransportGuidByte1) \
+    E(MSETransportGuidByte0) \
+    E(MSETransportGuidByte2) \
+    E(MSETransportGuidByte5) \
+    E(MSETransportHaveTime3) \
+    E(MSETransportHaveTime2) \
+    E(MSEHaveSplineElev) \
+    E(MSEHavePitch) \
+    E(MSEPositionO) \
+    E(MSEPositionX) \
+    E(MSEPositionY) \
+    E(MSEPositionZ) \
+    E(MSETimestamp) \
+    E(MSEGuidByte1_2) \
+    E(MSEFallVerticalSpeed) \
+    E(MSEFallTime) \
+    E(MSEFallHorizontalSpeed) \
+    E(MSEFallCosAngle) \
+    E(MSEFallSinAngle) \
+    E(MSETransportTime) \
+    E(MSETransportPositionX) \
+    E(MSETransportPositionY) \
+    E(MSETransportPositionZ) \
+    E(MSETransportPositionO) \
+    E(MSETransportSeat) \
+    E(MSETransportGuidByte3_2) \
+    E(MSETransportGuidByte1_2) \
+    E(MSETransportTime3) \
+    E(MSETransportGuidByte6_2) \
+    E(MSETransportGuidByte0_2) \
+    E(MSETransportGuidByte5_2) \
+    E(MSETransportTime2) \
+    E(MSETransportGuidByte7_2) \
+    E(MSETransportGuidByte4_2) \
+    E(MSETransportGuidByte2_2) \
+    E(MSEGuidByte6_2) \
+    E(MSEGuidByte4_2) \
+    E(MSESplineElev) \
+    E(MSEGuidByte0_2) \
+    E(MSEPitch) \
+    E(MSEGuidByte5_2) \
+    E(MSEGuidByte3_2) \
+    E(MSEGuidByte7_2) \
+    E(MSEGuidByte2_2)
 
-MovementStatusElements MovementSetFacingSequence[] = {
-MSEGuidByte3,
-MSEGuidByte1,
-MSEGuidByte0,
-MSEGuidByte7,
-MSEFlags2,
-MSEHaveSpline,
-MSEGuidByte4,
-MSEFlags,
-MSEGuidByte6,
-MSEGuidByte5,
-MSEGuidByte2,
-MSEHaveFallData,
-MSEHaveFallDirection,
-MSEHaveTransportData,
-MSETransportGuidByte6,
-MSETransportGuidByte3,
-MSETransportGuidByte7,
-MSETransportGuidByte4,
-MSETransportGuidByte1,
-MSETransportGuidByte0,
-MSETransportGuidByte2,
-MSETransportGuidByte5,
-MSETransportHaveTime3,
-MSETransportHaveTime2,
-MSEHavePitch,
-MSEHaveSplineElev,
-MSEPositionX,
-MSEPositionY,
-MSEPositionZ,
-MSEPositionO,
-MSETimestamp,
-MSEFallVerticalSpeed,
-MSEFallTime,
-MSEFallHorizontalSpeed,
-MSEFallCosAngle,
-MSEFallSinAngle,
-MSEGuidByte2_2,
-MSEGuidByte4_2,
-MSETransportTime,
-MSETransportPositionX,
-MSETransportPositionY,
-MSETransportPositionZ,
-MSETransportPositionO,
-MSETransportSeat,
-MSETransportGuidByte3_2,
-MSETransportGuidByte1_2,
-MSETransportTime3,
-MSETransportGuidByte6_2,
-MSETransportGuidByte0_2,
-MSETransportGuidByte5_2,
-MSETransportTime2,
-MSETransportGuidByte7_2,
-MSETransportGuidByte4_2,
-MSETransportGuidByte2_2,
-MSEGuidByte3_2,
-MSEGuidByte7_2,
-MSEPitch,
-MSEGuidByte5_2,
-MSEGuidByte1_2,
-MSEGuidByte6_2,
-MSESplineElev,
-MSEGuidByte0_2,
-};
+#define MOVEMENT_SET_FACING_SEQUENCE(E) \
+    E(MSEGuidByte3) \
+    E(MSEGuidByte1) \
+    E(MSEGuidByte0) \
+    E(MSEGuidByte7) \
+    E(MSEFlags2) \
+    E(MSEHaveSpline) \
+    E(MSEGuidByte4) \
+    E(MSEFlags) \
+    E(MSEGuidByte6) \
+    E(MSEGuidByte5) \
+    E(MSEGuidByte2) \
+    E(MSEHaveFallData) \
+    E(MSEHaveFallDirection) \
+    E(MSEHaveTransportData) \
+    E(MSETransportGuidByte6) \
+    E(MSETransportGuidByte3) \
+    E(MSETransportGuidByte7) \
+    E(MSETransportGuidByte4) \
+    E(MSETransportGuidByte1) \
+    E(MSETransportGuidByte0) \
+    E(MSETransportGuidByte2) \
+    E(MSETransportGuidByte5) \
+    E(MSETransportHaveTime3) \
+    E(MSETransportHaveTime2) \
+    E(MSEHavePitch) \
+    E(MSEHaveSplineElev) \
+    E(MSEPositionX) \
+    E(MSEPositionY) \
+    E(MSEPositionZ) \
+    E(MSEPositionO) \
+    E(MSETimestamp) \
+    E(MSEFallVerticalSpeed) \
+    E(MSEFallTime) \
+    E(MSEFallHorizontalSpeed) \
+    E(MSEFallCosAngle) \
+    E(MSEFallSinAngle) \
+    E(MSEGuidByte2_2) \
+    E(MSEGuidByte4_2) \
+    E(MSETransportTime) \
+    E(MSETransportPositionX) \
+    E(MSETransportPositionY) \
+    E(MSETransportPositionZ) \
+    E(MSETransportPositionO) \
+    E(MSETransportSeat) \
+    E(MSETransportGuidByte3_2) \
+    E(MSETransportGuidByte1_2) \
+    E(MSETransportTime3) \
+    E(MSETransportGuidByte6_2) \
+    E(MSETransportGuidByte0_2) \
+    E(MSETransportGuidByte5_2) \
+    E(MSETransportTime2) \
+    E(MSETransportGuidByte7_2) \
+    E(MSETransportGuidByte4_2) \
+    E(MSETransportGuidByte2_2) \
+    E(MSEGuidByte3_2) \
+    E(MSEGuidByte7_2) \
+    E(MSEPitch) \
+    E(MSEGuidByte5_2) \
+    E(MSEGuidByte1_2) \
+    E(MSEGuidByte6_2) \
+    E(MSESplineElev) \
+    E(MSEGuidByte0_2)
 
-MovementStatusElements MovementSetPitchSequence[] = {
-MSEGuidByte4,
-MSEGuidByte6,
-MSEGuidByte2,
-MSEFlags2,
-MSEGuidByte1,
-MSEGuidByte7,
-MSEGuidByte5,
-MSEGuidByte3,
-MSEHaveSpline,
-MSEGuidByte0,
-MSEFlags,
-MSEHaveFallData,
-MSEHaveFallDirection,
-MSEHaveTransportData,
-MSETransportGuidByte6,
-MSETransportGuidByte3,
-MSETransportGuidByte7,
-MSETransportGuidByte4,
-MSETransportGuidByte1,
-MSETransportGuidByte0,
-MSETransportGuidByte2,
-MSETransportGuidByte5,
-MSETransportHaveTime3,
-MSETransportHaveTime2,
-MSEHaveSplineElev,
-MSEHavePitch,
-MSEPositionO,
-MSETimestamp,
-MSEPositionX,
-MSEPositionY,
-MSEPositionZ,
-MSEGuidByte2_2,
-MSEGuidByte6_2,
-MSEGuidByte5_2,
-MSEFallVerticalSpeed,
-MSEFallTime,
-MSEFallHorizontalSpeed,
-MSEFallCosAngle,
-MSEFallSinAngle,
-MSEGuidByte3_2,
-MSETransportTime,
-MSETransportPositionX,
-MSETransportPositionY,
-MSETransportPositionZ,
-MSETransportPositionO,
-MSETransportSeat,
-MSETransportGuidByte3_2,
-MSETransportGuidByte1_2,
-MSETransportTime3,
-MSETransportGuidByte6_2,
-MSETransportGuidByte0_2,
-MSETransportGuidByte5_2,
-MSETransportTime2,
-MSETransportGuidByte7_2,
-MSETransportGuidByte4_2,
-MSETransportGuidByte2_2,
-MSEGuidByte0_2,
-MSEGuidByte1_2,
-MSESplineElev,
-MSEGuidByte7_2,
-MSEGuidByte4_2,
-MSEPitch,
-};
+#define MOVEMENT_SET_PITCH_SEQUENCE(E) \
+    E(MSEGuidByte4) \
+    E(MSEGuidByte6) \
+    E(MSEGuidByte2) \
+    E(MSEFlags2) \
+    E(MSEGuidByte1) \
+    E(MSEGuidByte7) \
+    E(MSEGuidByte5) \
+    E(MSEGuidByte3) \
+    E(MSEHaveSpline) \
+    E(MSEGuidByte0) \
+    E(MSEFlags) \
+    E(MSEHaveFallData) \
+    E(MSEHaveFallDirection) \
+    E(MSEHaveTransportData) \
+    E(MSETransportGuidByte6) \
+    E(MSETransportGuidByte3) \
+    E(MSETransportGuidByte7) \
+    E(MSETransportGuidByte4) \
+    E(MSETransportGuidByte1) \
+    E(MSETransportGuidByte0) \
+    E(MSETransportGuidByte2) \
+    E(MSETransportGuidByte5) \
+    E(MSETransportHaveTime3) \
+    E(MSETransportHaveTime2) \
+    E(MSEHaveSplineElev) \
+    E(MSEHavePitch) \
+    E(MSEPositionO) \
+    E(MSETimestamp) \
+    E(MSEPositionX) \
+    E(MSEPositionY) \
+    E(MSEPositionZ) \
+    E(MSEGuidByte2_2) \
+    E(MSEGuidByte6_2) \
+    E(MSEGuidByte5_2) \
+    E(MSEFallVerticalSpeed) \
+    E(MSEFallTime) \
+    E(MSEFallHorizontalSpeed) \
+    E(MSEFallCosAngle) \
+    E(MSEFallSinAngle) \
+    E(MSEGuidByte3_2) \
+    E(MSETransportTime) \
+    E(MSETransportPositionX) \
+    E(MSETransportPositionY) \
+    E(MSETransportPositionZ) \
+    E(MSETransportPositionO) \
+    E(MSETransportSeat) \
+    E(MSETransportGuidByte3_2) \
+    E(MSETransportGuidByte1_2) \
+    E(MSETransportTime3) \
+    E(MSETransportGuidByte6_2) \
+    E(MSETransportGuidByte0_2) \
+    E(MSETransportGuidByte5_2) \
+    E(MSETransportTime2) \
+    E(MSETransportGuidByte7_2) \
+    E(MSETransportGuidByte4_2) \
+    E(MSETransportGuidByte2_2) \
+    E(MSEGuidByte0_2) \
+    E(MSEGuidByte1_2) \
+    E(MSESplineElev) \
+    E(MSEGuidByte7_2) \
+    E(MSEGuidByte4_2) \
+    E(MSEPitch)
 
-MovementStatusElements MovementStartBackwardSequence[] = {
-MSEGuidByte4,
-MSEGuidByte1,
-MSEGuidByte5,
-MSEFlags2,
-MSEGuidByte3,
-MSEGuidByte6,
-MSEGuidByte0,
-MSEGuidByte2,
-MSEGuidByte7,
-MSEFlags,
-MSEHaveSpline,
-MSEHaveFallData,
-MSEHaveFallDirection,
-MSEHaveTransportData,
-MSETransportGuidByte6,
-MSETransportGuidByte3,
-MSETransportGuidByte7,
-MSETransportGuidByte4,
-MSETransportGuidByte1,
-MSETransportGuidByte0,
-MSETransportGuidByte2,
-MSETransportGuidByte5,
-MSETransportHaveTime3,
-MSETransportHaveTime2,
-MSEHavePitch,
-MSEHaveSplineElev,
-MSEPositionX,
-MSEPositionY,
-MSEPositionZ,
-MSETimestamp,
-MSEPositionO,
-MSEGuidByte0_2,
-MSEGuidByte5_2,
-MSEFallVerticalSpeed,
-MSEFallTime,
-MSEFallHorizontalSpeed,
-MSEFallCosAngle,
-MSEFallSinAngle,
-MSEGuidByte4_2,
-MSEGuidByte2_2,
-MSETransportTime,
-MSETransportPositionX,
-MSETransportPositionY,
-MSETransportPositionZ,
-MSETransportPositionO,
-MSETransportSeat,
-MSETransportGuidByte3_2,
-MSETransportGuidByte1_2,
-MSETransportTime3,
-MSETransportGuidByte6_2,
-MSETransportGuidByte0_2,
-MSETransportGuidByte5_2,
-MSETransportTime2,
-MSETransportGuidByte7_2,
-MSETransportGuidByte4_2,
-MSETransportGuidByte2_2,
-MSEGuidByte6_2,
-MSEPitch,
-MSEGuidByte3_2,
-MSESplineElev,
-MSEGuidByte1_2,
-MSEGuidByte7_2,
-};
+#define MOVEMENT_START_BACKWARD_SEQUENCE(E) \
+    E(MSEGuidByte4) \
+    E(MSEGuidByte1) \
+    E(MSEGuidByte5) \
+    E(MSEFlags2) \
+    E(MSEGuidByte3) \
+    E(MSEGuidByte6) \
+    E(MSEGuidByte0) \
+    E(MSEGuidByte2) \
+    E(MSEGuidByte7) \
+    E(MSEFlags) \
+    E(MSEHaveSpline) \
+    E(MSEHaveFallData) \
+    E(MSEHaveFallDirection) \
+    E(MSEHaveTransportData) \
+    E(MSETransportGuidByte6) \
+    E(MSETransportGuidByte3) \
+    E(MSETransportGuidByte7) \
+    E(MSETransportGuidByte4) \
+    E(MSETransportGuidByte1) \
+    E(MSETransportGuidByte0) \
+    E(MSETransportGuidByte2) \
+    E(MSETransportGuidByte5) \
+    E(MSETransportHaveTime3) \
+    E(MSETransportHaveTime2) \
+    E(MSEHavePitch) \
+    E(MSEHaveSplineElev) \
+    E(MSEPositionX) \
+    E(MSEPositionY) \
+    E(MSEPositionZ) \
+    E(MSETimestamp) \
+    E(MSEPositionO) \
+    E(MSEGuidByte0_2) \
+    E(MSEGuidByte5_2) \
+    E(MSEFallVerticalSpeed) \
+    E(MSEFallTime) \
+    E(MSEFallHorizontalSpeed) \
+    E(MSEFallCosAngle) \
+    E(MSEFallSinAngle) \
+    E(MSEGuidByte4_2) \
+    E(MSEGuidByte2_2) \
+    E(MSETransportTime) \
+    E(MSETransportPositionX) \
+    E(MSETransportPositionY) \
+    E(MSETransportPositionZ) \
+    E(MSETransportPositionO) \
+    E(MSETransportSeat) \
+    E(MSETransportGuidByte3_2) \
+    E(MSETransportGuidByte1_2) \
+    E(MSETransportTime3) \
+    E(MSETransportGuidByte6_2) \
+    E(MSETransportGuidByte0_2) \
+    E(MSETransportGuidByte5_2) \
+    E(MSETransportTime2) \
+    E(MSETransportGuidByte7_2) \
+    E(MSETransportGuidByte4_2) \
+    E(MSETransportGuidByte2_2) \
+    E(MSEGuidByte6_2) \
+    E(MSEPitch) \
+    E(MSEGuidByte3_2) \
+    E(MSESplineElev) \
+    E(MSEGuidByte1_2) \
+    E(MSEGuidByte7_2)
 
-MovementStatusElements MovementStartForwardSequence[] =
-{
-    MSEPositionY,
-    MSEPositionZ,
-    MSEPositionX,
-    MSEGuidByte5,
-    MSEGuidByte2,
-    MSEGuidByte0,
-    MSEHaveSpline,
-    MSEHaveMovementFlags,
-    MSEGuidByte7,
-    MSEGuidByte3,
-    MSEGuidByte1,
-    MSEHaveOrientation,
-    MSEGuidByte6,
-    MSEHaveUnknownBit,
-    MSEHaveSplineElev,
-    MSEGuidByte4,
-    MSEHaveTransportData,
-    MSEHaveTimeStamp,
-    MSEHavePitch,
-    MSEHaveMovementFlags2,
-    MSEHaveFallData,
-    MSEFlags,
-    MSETransportGuidByte3,
-    MSETransportGuidByte4,
-    MSETransportGuidByte6,
-    MSETransportGuidByte2,
-    MSETransportGuidByte5,
-    MSETransportGuidByte0,
-    MSETransportGuidByte7,
-    MSETransportGuidByte1,
-    MSETransportHaveTime3,
-    MSETransportHaveTime2,
-    MSEHaveFallDirection,
-    MSEFlags2,
-    MSEGuidByte2_2,
-    MSEGuidByte4_2,
-    MSEGuidByte6_2,
-    MSEGuidByte1_2,
-    MSEGuidByte7_2,
-    MSEGuidByte3_2,
-    MSEGuidByte5_2,
-    MSEGuidByte0_2,
-    MSEFallVerticalSpeed,
-    MSEFallCosAngle,
-    MSEFallHorizontalSpeed,
-    MSEFallSinAngle,
-    MSEFallTime,
-    MSETransportGuidByte3_2,
-    MSETransportPositionY,
-    MSETransportPositionZ,
-    MSETransportGuidByte1_2,
-    MSETransportGuidByte4_2,
-    MSETransportGuidByte7_2,
-    MSETransportPositionO,
-    MSETransportGuidByte2_2,
-    MSETransportPositionX,
-    MSETransportGuidByte5_2,
-    MSETransportTime3,
-    MSETransportTime,
-    MSETransportGuidByte6_2,
-    MSETransportGuidByte0_2,
-    MSETransportSeat,
-    MSETransportTime2,
-    MSESplineElev,
-    MSEPitch,
-    MSEPositionO,
-    MSETimestamp,
-};
+#define MOVEMENT_START_FORWARD_SEQUENCE(E) \
+    E(MSEPositionY) \
+    E(MSEPositionZ) \
+    E(MSEPositionX) \
+    E(MSEGuidByte5) \
+    E(MSEGuidByte2) \
+    E(MSEGuidByte0) \
+    E(MSEHaveSpline) \
+    E(MSEHaveMovementFlags) \
+    E(MSEGuidByte7) \
+    E(MSEGuidByte3) \
+    E(MSEGuidByte1) \
+    E(MSEHaveOrientation) \
+    E(MSEGuidByte6) \
+    E(MSEHaveUnknownBit) \
+    E(MSEHaveSplineElev) \
+    E(MSEGuidByte4) \
+    E(MSEHaveTransportData) \
+    E(MSEHaveTimeStamp) \
+    E(MSEHavePitch) \
+    E(MSEHaveMovementFlags2) \
+    E(MSEHaveFallData) \
+    E(MSEFlags) \
+    E(MSETransportGuidByte3) \
+    E(MSETransportGuidByte4) \
+    E(MSETransportGuidByte6) \
+    E(MSETransportGuidByte2) \
+    E(MSETransportGuidByte5) \
+    E(MSETransportGuidByte0) \
+    E(MSETransportGuidByte7) \
+    E(MSETransportGuidByte1) \
+    E(MSETransportHaveTime3) \
+    E(MSETransportHaveTime2) \
+    E(MSEHaveFallDirection) \
+    E(MSEFlags2) \
+    E(MSEGuidByte2_2) \
+    E(MSEGuidByte4_2) \
+    E(MSEGuidByte6_2) \
+    E(MSEGuidByte1_2) \
+    E(MSEGuidByte7_2) \
+    E(MSEGuidByte3_2) \
+    E(MSEGuidByte5_2) \
+    E(MSEGuidByte0_2) \
+    E(MSEFallVerticalSpeed) \
+    E(MSEFallCosAngle) \
+    E(MSEFallHorizontalSpeed) \
+    E(MSEFallSinAngle) \
+    E(MSEFallTime) \
+    E(MSETransportGuidByte3_2) \
+    E(MSETransportPositionY) \
+    E(MSETransportPositionZ) \
+    E(MSETransportGuidByte1_2) \
+    E(MSETransportGuidByte4_2) \
+    E(MSETransportGuidByte7_2) \
+    E(MSETransportPositionO) \
+    E(MSETransportGuidByte2_2) \
+    E(MSETransportPositionX) \
+    E(MSETransportGuidByte5_2) \
+    E(MSETransportTime3) \
+    E(MSETransportTime) \
+    E(MSETransportGuidByte6_2) \
+    E(MSETransportGuidByte0_2) \
+    E(MSETransportSeat) \
+    E(MSETransportTime2) \
+    E(MSESplineElev) \
+    E(MSEPitch) \
+    E(MSEPositionO) \
+    E(MSETimestamp)
 
-MovementStatusElements MovementStartStrafeLeftSequence[] = {
-MSEGuidByte5,
-MSEGuidByte0,
-MSEGuidByte3,
-MSEFlags,
-MSEGuidByte6,
-MSEGuidByte1,
-MSEGuidByte4,
-MSEFlags2,
-MSEHaveSpline,
-MSEGuidByte7,
-MSEGuidByte2,
-MSEHaveTransportData,
-MSETransportGuidByte6,
-MSETransportGuidByte3,
-MSETransportGuidByte7,
-MSETransportGuidByte4,
-MSETransportGuidByte1,
-MSETransportGuidByte0,
-MSETransportGuidByte2,
-MSETransportGuidByte5,
-MSETransportHaveTime3,
-MSETransportHaveTime2,
-MSEHaveSplineElev,
-MSEHaveFallData,
-MSEHaveFallDirection,
-MSEHavePitch,
-MSEPositionO,
-MSETimestamp,
-MSEPositionX,
-MSEPositionY,
-MSEPositionZ,
-MSEGuidByte3_2,
-MSETransportTime,
-MSETransportPositionX,
-MSETransportPositionY,
-MSETransportPositionZ,
-MSETransportPositionO,
-MSETransportSeat,
-MSETransportGuidByte3_2,
-MSETransportGuidByte1_2,
-MSETransportTime3,
-MSETransportGuidByte6_2,
-MSETransportGuidByte0_2,
-MSETransportGuidByte5_2,
-MSETransportTime2,
-MSETransportGuidByte7_2,
-MSETransportGuidByte4_2,
-MSETransportGuidByte2_2,
-MSEGuidByte5_2,
-MSEGuidByte1_2,
-MSEGuidByte4_2,
-MSEGuidByte2_2,
-MSEGuidByte0_2,
-MSESplineElev,
-MSEGuidByte6_2,
-MSEFallVerticalSpeed,
-MSEFallTime,
-MSEFallHorizontalSpeed,
-MSEFallCosAngle,
-MSEFallSinAngle,
-MSEGuidByte7_2,
-MSEPitch,
-};
+#define MOVEMENT_START_STRAFE_LEFT_SEQUENCE(E) \
+    E(MSEGuidByte5) \
+    E(MSEGuidByte0) \
+    E(MSEGuidByte3) \
+    E(MSEFlags) \
+    E(MSEGuidByte6) \
+    E(MSEGuidByte1) \
+    E(MSEGuidByte4) \
+    E(MSEFlags2) \
+    E(MSEHaveSpline) \
+    E(MSEGuidByte7) \
+    E(MSEGuidByte2) \
+    E(MSEHaveTransportData) \
+    E(MSETransportGuidByte6) \
+    E(MSETransportGuidByte3) \
+    E(MSETransportGuidByte7) \
+    E(MSETransportGuidByte4) \
+    E(MSETransportGuidByte1) \
+    E(MSETransportGuidByte0) \
+    E(MSETransportGuidByte2) \
+    E(MSETransportGuidByte5) \
+    E(MSETransportHaveTime3) \
+    E(MSETransportHaveTime2) \
+    E(MSEHaveSplineElev) \
+    E(MSEHaveFallData) \
+    E(MSEHaveFallDirection) \
+    E(MSEHavePitch) \
+    E(MSEPositionO) \
+    E(MSETimestamp) \
+    E(MSEPositionX) \
+    E(MSEPositionY) \
+    E(MSEPositionZ) \
+    E(MSEGuidByte3_2) \
+    E(MSETransportTime) \
+    E(MSETransportPositionX) \
+    E(MSETransportPositionY) \
+    E(MSETransportPositionZ) \
+    E(MSETransportPositionO) \
+    E(MSETransportSeat) \
+    E(MSETransportGuidByte3_2) \
+    E(MSETransportGuidByte1_2) \
+    E(MSETransportTime3) \
+    E(MSETransportGuidByte6_2) \
+    E(MSETransportGuidByte0_2) \
+    E(MSETransportGuidByte5_2) \
+    E(MSETransportTime2) \
+    E(MSETransportGuidByte7_2) \
+    E(MSETransportGuidByte4_2) \
+    E(MSETransportGuidByte2_2) \
+    E(MSEGuidByte5_2) \
+    E(MSEGuidByte1_2) \
+    E(MSEGuidByte4_2) \
+    E(MSEGuidByte2_2) \
+    E(MSEGuidByte0_2) \
+    E(MSESplineElev) \
+    E(MSEGuidByte6_2) \
+    E(MSEFallVerticalSpeed) \
+    E(MSEFallTime) \
+    E(MSEFallHorizontalSpeed) \
+    E(MSEFallCosAngle) \
+    E(MSEFallSinAngle) \
+    E(MSEGuidByte7_2) \
+    E(MSEPitch)
 
-MovementStatusElements MovementStartStrafeRightSequence[] = {
-MSEGuidByte2,
-MSEFlags,
-MSEGuidByte3,
-MSEFlags2,
-MSEGuidByte0,
-MSEGuidByte6,
-MSEHaveSpline,
-MSEGuidByte1,
-MSEGuidByte4,
-MSEGuidByte5,
-MSEGuidByte7,
-MSEHaveSplineElev,
-MSEHavePitch,
-MSEHaveTransportData,
-MSETransportGuidByte6,
-MSETransportGuidByte3,
-MSETransportGuidByte7,
-MSETransportGuidByte4,
-MSETransportGuidByte1,
-MSETransportGuidByte0,
-MSETransportGuidByte2,
-MSETransportGuidByte5,
-MSETransportHaveTime3,
-MSETransportHaveTime2,
-MSEHaveFallData,
-MSEHaveFallDirection,
-MSETimestamp,
-MSEPositionO,
-MSEPositionX,
-MSEPositionY,
-MSEPositionZ,
-MSEGuidByte7_2,
-MSEGuidByte1_2,
-MSESplineElev,
-MSEGuidByte3_2,
-MSEPitch,
-MSETransportTime,
-MSETransportPositionX,
-MSETransportPositionY,
-MSETransportPositionZ,
-MSETransportPositionO,
-MSETransportSeat,
-MSETransportGuidByte3_2,
-MSETransportGuidByte1_2,
-MSETransportTime3,
-MSETransportGuidByte6_2,
-MSETransportGuidByte0_2,
-MSETransportGuidByte5_2,
-MSETransportTime2,
-MSETransportGuidByte7_2,
-MSETransportGuidByte4_2,
-MSETransportGuidByte2_2,
-MSEGuidByte5_2,
-MSEGuidByte2_2,
-MSEGuidByte6_2,
-MSEGuidByte4_2,
-MSEGuidByte0_2,
-MSEFallVerticalSpeed,
-MSEFallTime,
-MSEFallHorizontalSpeed,
-MSEFallCosAngle,
-MSEFallSinAngle,
-};
+#define MOVEMENT_START_STRAFE_RIGHT_SEQUENCE(E) \
+    E(MSEGuidByte2) \
+    E(MSEFlags) \
+    E(MSEGuidByte3) \
+    E(MSEFlags2) \
+    E(MSEGuidByte0) \
+    E(MSEGuidByte6) \
+    E(MSEHaveSpline) \
+    E(MSEGuidByte1) \
+    E(MSEGuidByte4) \
+    E(MSEGuidByte5) \
+    E(MSEGuidByte7) \
+    E(MSEHaveSplineElev) \
+    E(MSEHavePitch) \
+    E(MSEHaveTransportData) \
+    E(MSETransportGuidByte6) \
+    E(MSETransportGuidByte3) \
+    E(MSETransportGuidByte7) \
+    E(MSETransportGuidByte4) \
+    E(MSETransportGuidByte1) \
+    E(MSETransportGuidByte0) \
+    E(MSETransportGuidByte2) \
+    E(MSETransportGuidByte5) \
+    E(MSETransportHaveTime3) \
+    E(MSETransportHaveTime2) \
+    E(MSEHaveFallData) \
+    E(MSEHaveFallDirection) \
+    E(MSETimestamp) \
+    E(MSEPositionO) \
+    E(MSEPositionX) \
+    E(MSEPositionY) \
+    E(MSEPositionZ) \
+    E(MSEGuidByte7_2) \
+    E(MSEGuidByte1_2) \
+    E(MSESplineElev) \
+    E(MSEGuidByte3_2) \
+    E(MSEPitch) \
+    E(MSETransportTime) \
+    E(MSETransportPositionX) \
+    E(MSETransportPositionY) \
+    E(MSETransportPositionZ) \
+    E(MSETransportPositionO) \
+    E(MSETransportSeat) \
+    E(MSETransportGuidByte3_2) \
+    E(MSETransportGuidByte1_2) \
+    E(MSETransportTime3) \
+    E(MSETransportGuidByte6_2) \
+    E(MSETransportGuidByte0_2) \
+    E(MSETransportGuidByte5_2) \
+    E(MSETransportTime2) \
+    E(MSETransportGuidByte7_2) \
+    E(MSETransportGuidByte4_2) \
+    E(MSETransportGuidByte2_2) \
+    E(MSEGuidByte5_2) \
+    E(MSEGuidByte2_2) \
+    E(MSEGuidByte6_2) \
+    E(MSEGuidByte4_2) \
+    E(MSEGuidByte0_2) \
+    E(MSEFallVerticalSpeed) \
+    E(MSEFallTime) \
+    E(MSEFallHorizontalSpeed) \
+    E(MSEFallCosAngle) \
+    E(MSEFallSinAngle)
 
-MovementStatusElements MovementStartTurnLeftSequence[] = {
-MSEFlags,
-MSEGuidByte3,
-MSEGuidByte5,
-MSEGuidByte7,
-MSEFlags2,
-MSEGuidByte6,
-MSEHaveSpline,
-MSEGuidByte0,
-MSEGuidByte2,
-MSEGuidByte1,
-MSEGuidByte4,
-MSEHaveFallData,
-MSEHaveFallDirection,
-MSEHaveSplineElev,
-MSEHavePitch,
-MSEHaveTransportData,
-MSETransportGuidByte6,
-MSETransportGuidByte3,
-MSETransportGuidByte7,
-MSETransportGuidByte4,
-MSETransportGuidByte1,
-MSETransportGuidByte0,
-MSETransportGuidByte2,
-MSETransportGuidByte5,
-MSETransportHaveTime3,
-MSETransportHaveTime2,
-MSEPositionO,
-MSETimestamp,
-MSEPositionX,
-MSEPositionY,
-MSEPositionZ,
-MSEGuidByte2_2,
-MSEGuidByte6_2,
-MSEFallVerticalSpeed,
-MSEFallTime,
-MSEFallHorizontalSpeed,
-MSEFallCosAngle,
-MSEFallSinAngle,
-MSEGuidByte4_2,
-MSESplineElev,
-MSEGuidByte0_2,
-MSEGuidByte7_2,
-MSEPitch,
-MSEGuidByte1_2,
-MSEGuidByte5_2,
-MSEGuidByte3_2,
-MSETransportTime,
-MSETransportPositionX,
-MSETransportPositionY,
-MSETransportPositionZ,
-MSETransportPositionO,
-MSETransportSeat,
-MSETransportGuidByte3_2,
-MSETransportGuidByte1_2,
-MSETransportTime3,
-MSETransportGuidByte6_2,
-MSETransportGuidByte0_2,
-MSETransportGuidByte5_2,
-MSETransportTime2,
-MSETransportGuidByte7_2,
-MSETransportGuidByte4_2,
-MSETransportGuidByte2_2,
-};
+#define MOVEMENT_START_TURN_LEFT_SEQUENCE(E) \
+    E(MSEFlags) \
+    E(MSEGuidByte3) \
+    E(MSEGuidByte5) \
+    E(MSEGuidByte7) \
+    E(MSEFlags2) \
+    E(MSEGuidByte6) \
+    E(MSEHaveSpline) \
+    E(MSEGuidByte0) \
+    E(MSEGuidByte2) \
+    E(MSEGuidByte1) \
+    E(MSEGuidByte4) \
+    E(MSEHaveFallData) \
+    E(MSEHaveFallDirection) \
+    E(MSEHaveSplineElev) \
+    E(MSEHavePitch) \
+    E(MSEHaveTransportData) \
+    E(MSETransportGuidByte6) \
+    E(MSETransportGuidByte3) \
+    E(MSETransportGuidByte7) \
+    E(MSETransportGuidByte4) \
+    E(MSETransportGuidByte1) \
+    E(MSETransportGuidByte0) \
+    E(MSETransportGuidByte2) \
+    E(MSETransportGuidByte5) \
+    E(MSETransportHaveTime3) \
+    E(MSETransportHaveTime2) \
+    E(MSEPositionO) \
+    E(MSETimestamp) \
+    E(MSEPositionX) \
+    E(MSEPositionY) \
+    E(MSEPositionZ) \
+    E(MSEGuidByte2_2) \
+    E(MSEGuidByte6_2) \
+    E(MSEFallVerticalSpeed) \
+    E(MSEFallTime) \
+    E(MSEFallHorizontalSpeed) \
+    E(MSEFallCosAngle) \
+    E(MSEFallSinAngle) \
+    E(MSEGuidByte4_2) \
+    E(MSESplineElev) \
+    E(MSEGuidByte0_2) \
+    E(MSEGuidByte7_2) \
+    E(MSEPitch) \
+    E(MSEGuidByte1_2) \
+    E(MSEGuidByte5_2) \
+    E(MSEGuidByte3_2) \
+    E(MSETransportTime) \
+    E(MSETransportPositionX) \
+    E(MSETransportPositionY) \
+    E(MSETransportPositionZ) \
+    E(MSETransportPositionO) \
+    E(MSETransportSeat) \
+    E(MSETransportGuidByte3_2) \
+    E(MSETransportGuidByte1_2) \
+    E(MSETransportTime3) \
+    E(MSETransportGuidByte6_2) \
+    E(MSETransportGuidByte0_2) \
+    E(MSETransportGuidByte5_2) \
+    E(MSETransportTime2) \
+    E(MSETransportGuidByte7_2) \
+    E(MSETransportGuidByte4_2) \
+    E(MSETransportGuidByte2_2)
 
-MovementStatusElements MovementStartTurnRightSequence[] = {
-MSEGuidByte0,
-MSEFlags,
-MSEGuidByte7,
-MSEHaveSpline,
-MSEGuidByte4,
-MSEGuidByte6,
-MSEGuidByte3,
-MSEGuidByte1,
-MSEFlags2,
-MSEGuidByte2,
-MSEGuidByte5,
-MSEHaveFallData,
-MSEHaveFallDirection,
-MSEHavePitch,
-MSEHaveSplineElev,
-MSEHaveTransportData,
-MSETransportGuidByte6,
-MSETransportGuidByte3,
-MSETransportGuidByte7,
-MSETransportGuidByte4,
-MSETransportGuidByte1,
-MSETransportGuidByte0,
-MSETransportGuidByte2,
-MSETransportGuidByte5,
-MSETransportHaveTime3,
-MSETransportHaveTime2,
-MSEPositionO,
-MSETimestamp,
-MSEPositionX,
-MSEPositionY,
-MSEPositionZ,
-MSEGuidByte1_2,
-MSEGuidByte6_2,
-MSEFallVerticalSpeed,
-MSEFallTime,
-MSEFallHorizontalSpeed,
-MSEFallCosAngle,
-MSEFallSinAngle,
-MSEGuidByte0_2,
-MSEGuidByte5_2,
-MSEGuidByte2_2,
-MSEPitch,
-MSEGuidByte4_2,
-MSEGuidByte3_2,
-MSEGuidByte7_2,
-MSESplineElev,
-MSETransportTime,
-MSETransportPositionX,
-MSETransportPositionY,
-MSETransportPositionZ,
-MSETransportPositionO,
-MSETransportSeat,
-MSETransportGuidByte3_2,
-MSETransportGuidByte1_2,
-MSETransportTime3,
-MSETransportGuidByte6_2,
-MSETransportGuidByte0_2,
-MSETransportGuidByte5_2,
-MSETransportTime2,
-MSETransportGuidByte7_2,
-MSETransportGuidByte4_2,
-MSETransportGuidByte2_2,
-};
+#define MOVEMENT_START_TURN_RIGHT_SEQUENCE(E) \
+    E(MSEGuidByte0) \
+    E(MSEFlags) \
+    E(MSEGuidByte7) \
+    E(MSEHaveSpline) \
+    E(MSEGuidByte4) \
+    E(MSEGuidByte6) \
+    E(MSEGuidByte3) \
+    E(MSEGuidByte1) \
+    E(MSEFlags2) \
+    E(MSEGuidByte2) \
+    E(MSEGuidByte5) \
+    E(MSEHaveFallData) \
+    E(MSEHaveFallDirection) \
+    E(MSEHavePitch) \
+    E(MSEHaveSplineElev) \
+    E(MSEHaveTransportData) \
+    E(MSETransportGuidByte6) \
+    E(MSETransportGuidByte3) \
+    E(MSETransportGuidByte7) \
+    E(MSETransportGuidByte4) \
+    E(MSETransportGuidByte1) \
+    E(MSETransportGuidByte0) \
+    E(MSETransportGuidByte2) \
+    E(MSETransportGuidByte5) \
+    E(MSETransportHaveTime3) \
+    E(MSETransportHaveTime2) \
+    E(MSEPositionO) \
+    E(MSETimestamp) \
+    E(MSEPositionX) \
+    E(MSEPositionY) \
+    E(MSEPositionZ) \
+    E(MSEGuidByte1_2) \
+    E(MSEGuidByte6_2) \
+    E(MSEFallVerticalSpeed) \
+    E(MSEFallTime) \
+    E(MSEFallHorizontalSpeed) \
+    E(MSEFallCosAngle) \
+    E(MSEFallSinAngle) \
+    E(MSEGuidByte0_2) \
+    E(MSEGuidByte5_2) \
+    E(MSEGuidByte2_2) \
+    E(MSEPitch) \
+    E(MSEGuidByte4_2) \
+    E(MSEGuidByte3_2) \
+    E(MSEGuidByte7_2) \
+    E(MSESplineElev) \
+    E(MSETransportTime) \
+    E(MSETransportPositionX) \
+    E(MSETransportPositionY) \
+    E(MSETransportPositionZ) \
+    E(MSETransportPositionO) \
+    E(MSETransportSeat) \
+    E(MSETransportGuidByte3_2) \
+    E(MSETransportGuidByte1_2) \
+    E(MSETransportTime3) \
+    E(MSETransportGuidByte6_2) \
+    E(MSETransportGuidByte0_2) \
+    E(MSETransportGuidByte5_2) \
+    E(MSETransportTime2) \
+    E(MSETransportGuidByte7_2) \
+    E(MSETransportGuidByte4_2) \
+    E(MSETransportGuidByte2_2)
 
-MovementStatusElements MovementStopSequence[] = {
-MSEGuidByte4,
-MSEGuidByte3,
-MSEFlags,
-MSEGuidByte5,
-MSEGuidByte6,
-MSEGuidByte0,
-MSEGuidByte1,
-MSEGuidByte2,
-MSEGuidByte7,
-MSEHaveSpline,
-MSEFlags2,
-MSEHavePitch,
-MSEHaveSplineElev,
-MSEHaveFallData,
-MSEHaveFallDirection,
-MSEHaveTransportData,
-MSETransportGuidByte6,
-MSETransportGuidByte3,
-MSETransportGuidByte7,
-MSETransportGuidByte4,
-MSETransportGuidByte1,
-MSETransportGuidByte0,
-MSETransportGuidByte2,
-MSETransportGuidByte5,
-MSETransportHaveTime3,
-MSETransportHaveTime2,
-MSETimestamp,
-MSEPositionX,
-MSEPositionY,
-MSEPositionZ,
-MSEPositionO,
-MSEGuidByte6_2,
-MSEGuidByte5_2,
-MSEGuidByte1_2,
-MSEGuidByte3_2,
-MSEPitch,
-MSEGuidByte2_2,
-MSESplineElev,
-MSEGuidByte4_2,
-MSEGuidByte0_2,
-MSEGuidByte7_2,
-MSEFallVerticalSpeed,
-MSEFallTime,
-MSEFallHorizontalSpeed,
-MSEFallCosAngle,
-MSEFallSinAngle,
-MSETransportTime,
-MSETransportPositionX,
-MSETransportPositionY,
-MSETransportPositionZ,
-MSETransportPositionO,
-MSETransportSeat,
-MSETransportGuidByte3_2,
-MSETransportGuidByte1_2,
-MSETransportTime3,
-MSETransportGuidByte6_2,
-MSETransportGuidByte0_2,
-MSETransportGuidByte5_2,
-MSETransportTime2,
-MSETransportGuidByte7_2,
-MSETransportGuidByte4_2,
-MSETransportGuidByte2_2,
-};
+#define MOVEMENT_STOP_SEQUENCE(E) \
+    E(MSEGuidByte4) \
+    E(MSEGuidByte3) \
+    E(MSEFlags) \
+    E(MSEGuidByte5) \
+    E(MSEGuidByte6) \
+    E(MSEGuidByte0) \
+    E(MSEGuidByte1) \
+    E(MSEGuidByte2) \
+    E(MSEGuidByte7) \
+    E(MSEHaveSpline) \
+    E(MSEFlags2) \
+    E(MSEHavePitch) \
+    E(MSEHaveSplineElev) \
+    E(MSEHaveFallData) \
+    E(MSEHaveFallDirection) \
+    E(MSEHaveTransportData) \
+    E(MSETransportGuidByte6) \
+    E(MSETransportGuidByte3) \
+    E(MSETransportGuidByte7) \
+    E(MSETransportGuidByte4) \
+    E(MSETransportGuidByte1) \
+    E(MSETransportGuidByte0) \
+    E(MSETransportGuidByte2) \
+    E(MSETransportGuidByte5) \
+    E(MSETransportHaveTime3) \
+    E(MSETransportHaveTime2) \
+    E(MSETimestamp) \
+    E(MSEPositionX) \
+    E(MSEPositionY) \
+    E(MSEPositionZ) \
+    E(MSEPositionO) \
+    E(MSEGuidByte6_2) \
+    E(MSEGuidByte5_2) \
+    E(MSEGuidByte1_2) \
+    E(MSEGuidByte3_2) \
+    E(MSEPitch) \
+    E(MSEGuidByte2_2) \
+    E(MSESplineElev) \
+    E(MSEGuidByte4_2) \
+    E(MSEGuidByte0_2) \
+    E(MSEGuidByte7_2) \
+    E(MSEFallVerticalSpeed) \
+    E(MSEFallTime) \
+    E(MSEFallHorizontalSpeed) \
+    E(MSEFallCosAngle) \
+    E(MSEFallSinAngle) \
+    E(MSETransportTime) \
+    E(MSETransportPositionX) \
+    E(MSETransportPositionY) \
+    E(MSETransportPositionZ) \
+    E(MSETransportPositionO) \
+    E(MSETransportSeat) \
+    E(MSETransportGuidByte3_2) \
+    E(MSETransportGuidByte1_2) \
+    E(MSETransportTime3) \
+    E(MSETransportGuidByte6_2) \
+    E(MSETransportGuidByte0_2) \
+    E(MSETransportGuidByte5_2) \
+    E(MSETransportTime2) \
+    E(MSETransportGuidByte7_2) \
+    E(MSETransportGuidByte4_2) \
+    E(MSETransportGuidByte2_2)
 
-MovementStatusElements MovementStopStrafeSequence[] = {
-MSEGuidByte3,
-MSEFlags,
-MSEHaveSpline,
-MSEGuidByte4,
-MSEGuidByte0,
-MSEFlags2,
-MSEGuidByte5,
-MSEGuidByte6,
-MSEGuidByte7,
-MSEGuidByte1,
-MSEGuidByte2,
-MSEHaveTransportData,
-MSETransportGuidByte6,
-MSETransportGuidByte3,
-MSETransportGuidByte7,
-MSETransportGuidByte4,
-MSETransportGuidByte1,
-MSETransportGuidByte0,
-MSETransportGuidByte2,
-MSETransportGuidByte5,
-MSETransportHaveTime3,
-MSETransportHaveTime2,
-MSEHaveSplineElev,
-MSEHavePitch,
-MSEHaveFallData,
-MSEHaveFallDirection,
-MSEPositionX,
-MSEPositionY,
-MSEPositionZ,
-MSEPositionO,
-MSETimestamp,
-MSEGuidByte2_2,
-MSEGuidByte7_2,
-MSEGuidByte5_2,
-MSETransportTime,
-MSETransportPositionX,
-MSETransportPositionY,
-MSETransportPositionZ,
-MSETransportPositionO,
-MSETransportSeat,
-MSETransportGuidByte3_2,
-MSETransportGuidByte1_2,
-MSETransportTime3,
-MSETransportGuidByte6_2,
-MSETransportGuidByte0_2,
-MSETransportGuidByte5_2,
-MSETransportTime2,
-MSETransportGuidByte7_2,
-MSETransportGuidByte4_2,
-MSETransportGuidByte2_2,
-MSEGuidByte0_2,
-MSESplineElev,
-MSEPitch,
-MSEFallVerticalSpeed,
-MSEFallTime,
-MSEFallHorizontalSpeed,
-MSEFallCosAngle,
-MSEFallSinAngle,
-MSEGuidByte1_2,
-MSEGuidByte3_2,
-MSEGuidByte4_2,
-MSEGuidByte6_2,
-};
+#define MOVEMENT_STOP_STRAFE_SEQUENCE(E) \
+    E(MSEGuidByte3) \
+    E(MSEFlags) \
+    E(MSEHaveSpline) \
+    E(MSEGuidByte4) \
+    E(MSEGuidByte0) \
+    E(MSEFlags2) \
+    E(MSEGuidByte5) \
+    E(MSEGuidByte6) \
+    E(MSEGuidByte7) \
+    E(MSEGuidByte1) \
+    E(MSEGuidByte2) \
+    E(MSEHaveTransportData) \
+    E(MSETransportGuidByte6) \
+    E(MSETransportGuidByte3) \
+    E(MSETransportGuidByte7) \
+    E(MSETransportGuidByte4) \
+    E(MSETransportGuidByte1) \
+    E(MSETransportGuidByte0) \
+    E(MSETransportGuidByte2) \
+    E(MSETransportGuidByte5) \
+    E(MSETransportHaveTime3) \
+    E(MSETransportHaveTime2) \
+    E(MSEHaveSplineElev) \
+    E(MSEHavePitch) \
+    E(MSEHaveFallData) \
+    E(MSEHaveFallDirection) \
+    E(MSEPositionX) \
+    E(MSEPositionY) \
+    E(MSEPositionZ) \
+    E(MSEPositionO) \
+    E(MSETimestamp) \
+    E(MSEGuidByte2_2) \
+    E(MSEGuidByte7_2) \
+    E(MSEGuidByte5_2) \
+    E(MSETransportTime) \
+    E(MSETransportPositionX) \
+    E(MSETransportPositionY) \
+    E(MSETransportPositionZ) \
+    E(MSETransportPositionO) \
+    E(MSETransportSeat) \
+    E(MSETransportGuidByte3_2) \
+    E(MSETransportGuidByte1_2) \
+    E(MSETransportTime3) \
+    E(MSETransportGuidByte6_2) \
+    E(MSETransportGuidByte0_2) \
+    E(MSETransportGuidByte5_2) \
+    E(MSETransportTime2) \
+    E(MSETransportGuidByte7_2) \
+    E(MSETransportGuidByte4_2) \
+    E(MSETransportGuidByte2_2) \
+    E(MSEGuidByte0_2) \
+    E(MSESplineElev) \
+    E(MSEPitch) \
+    E(MSEFallVerticalSpeed) \
+    E(MSEFallTime) \
+    E(MSEFallHorizontalSpeed) \
+    E(MSEFallCosAngle) \
+    E(MSEFallSinAngle) \
+    E(MSEGuidByte1_2) \
+    E(MSEGuidByte3_2) \
+    E(MSEGuidByte4_2) \
+    E(MSEGuidByte6_2)
 
-MovementStatusElements MovementStopTurnSequence[] = {
-    MSEGuidByte3,
-    MSEGuidByte5,
-    MSEGuidByte4,
-    MSEGuidByte2,
-    MSEFlags2,
-    MSEGuidByte0,
-    MSEGuidByte7,
-    MSEGuidByte6,
-    MSEGuidByte1,
-    MSEHaveSpline,
-    MSEFlags,
-    MSEHaveFallData,
-    MSEHaveFallDirection,
-    MSEHaveTransportData,
-    MSETransportGuidByte6,
-    MSETransportGuidByte3,
-    MSETransportGuidByte7,
-    MSETransportGuidByte4,
-    MSETransportGuidByte1,
-    MSETransportGuidByte0,
-    MSETransportGuidByte2,
-    MSETransportGuidByte5,
-    MSETransportHaveTime3,
-    MSETransportHaveTime2,
-    MSEHaveSplineElev,
-    MSEHavePitch,
-    MSEPositionO,
-    MSETimestamp,
-    MSEPositionX,
-    MSEPositionY,
-    MSEPositionZ,
-    MSEGuidByte4_2,
-    MSEGuidByte2_2,
-    MSEGuidByte5_2,
-    MSEFallVerticalSpeed,
-    MSEFallTime,
-    MSEFallHorizontalSpeed,
-    MSEFallCosAngle,
-    MSEFallSinAngle,
-    MSEGuidByte0_2,
-    MSEGuidByte7_2,
-    MSEGuidByte6_2,
-    MSETransportTime,
-    MSETransportPositionX,
-    MSETransportPositionY,
-    MSETransportPositionZ,
-    MSETransportPositionO,
-    MSETransportSeat,
-    MSETransportGuidByte3_2,
-    MSETransportGuidByte1_2,
-    MSETransportTime3,
-    MSETransportGuidByte6_2,
-    MSETransportGuidByte0_2,
-    MSETransportGuidByte5_2,
-    MSETransportTime2,
-    MSETransportGuidByte7_2,
-    MSETransportGuidByte4_2,
-    MSETransportGuidByte2_2,
-    MSESplineElev,
-    MSEGuidByte1_2,
-    MSEGuidByte3_2,
-    MSEPitch,
-};
+#define MOVEMENT_STOP_TURN_SEQUENCE(E) \
+    E(MSEGuidByte3) \
+    E(MSEGuidByte5) \
+    E(MSEGuidByte4) \
+    E(MSEGuidByte2) \
+    E(MSEFlags2) \
+    E(MSEGuidByte0) \
+    E(MSEGuidByte7) \
+    E(MSEGuidByte6) \
+    E(MSEGuidByte1) \
+    E(MSEHaveSpline) \
+    E(MSEFlags) \
+    E(MSEHaveFallData) \
+    E(MSEHaveFallDirection) \
+    E(MSEHaveTransportData) \
+    E(MSETransportGuidByte6) \
+    E(MSETransportGuidByte3) \
+    E(MSETransportGuidByte7) \
+    E(MSETransportGuidByte4) \
+    E(MSETransportGuidByte1) \
+    E(MSETransportGuidByte0) \
+    E(MSETransportGuidByte2) \
+    E(MSETransportGuidByte5) \
+    E(MSETransportHaveTime3) \
+    E(MSETransportHaveTime2) \
+    E(MSEHaveSplineElev) \
+    E(MSEHavePitch) \
+    E(MSEPositionO) \
+    E(MSETimestamp) \
+    E(MSEPositionX) \
+    E(MSEPositionY) \
+    E(MSEPositionZ) \
+    E(MSEGuidByte4_2) \
+    E(MSEGuidByte2_2) \
+    E(MSEGuidByte5_2) \
+    E(MSEFallVerticalSpeed) \
+    E(MSEFallTime) \
+    E(MSEFallHorizontalSpeed) \
+    E(MSEFallCosAngle) \
+    E(MSEFallSinAngle) \
+    E(MSEGuidByte0_2) \
+    E(MSEGuidByte7_2) \
+    E(MSEGuidByte6_2) \
+    E(MSETransportTime) \
+    E(MSETransportPositionX) \
+    E(MSETransportPositionY) \
+    E(MSETransportPositionZ) \
+    E(MSETransportPositionO) \
+    E(MSETransportSeat) \
+    E(MSETransportGuidByte3_2) \
+    E(MSETransportGuidByte1_2) \
+    E(MSETransportTime3) \
+    E(MSETransportGuidByte6_2) \
+    E(MSETransportGuidByte0_2) \
+    E(MSETransportGuidByte5_2) \
+    E(MSETransportTime2) \
+    E(MSETransportGuidByte7_2) \
+    E(MSETransportGuidByte4_2) \
+    E(MSETransportGuidByte2_2) \
+    E(MSESplineElev) \
+    E(MSEGuidByte1_2) \
+    E(MSEGuidByte3_2) \
+    E(MSEPitch)
 
-MovementStatusElements MovementStartAscendSequence[] = {
-    MSEGuidByte2,
-    MSEGuidByte3,
-    MSEGuidByte6,
-    MSEGuidByte4,
-    MSEGuidByte0,
-    MSEHaveSpline,
-    MSEGuidByte1,
-    MSEGuidByte5,
-    MSEFlags,
-    MSEFlags2,
-    MSEGuidByte7,
-    MSEHaveTransportData,
-    MSETransportGuidByte6,
-    MSETransportGuidByte3,
-    MSETransportGuidByte7,
-    MSETransportGuidByte4,
-    MSETransportGuidByte1,
-    MSETransportGuidByte0,
-    MSETransportGuidByte2,
-    MSETransportGuidByte5,
-    MSETransportHaveTime3,
-    MSETransportHaveTime2,
-    MSEHaveFallData,
-    MSEHaveFallDirection,
-    MSEHavePitch,
-    MSEHaveSplineElev,
-    MSEPositionO,
-    MSEPositionX,
-    MSEPositionY,
-    MSEPositionZ,
-    MSETimestamp,
-    MSETransportTime,
-    MSETransportPositionX,
-    MSETransportPositionY,
-    MSETransportPositionZ,
-    MSETransportPositionO,
-    MSETransportSeat,
-    MSETransportGuidByte3_2,
-    MSETransportGuidByte1_2,
-    MSETransportTime3,
-    MSETransportGuidByte6_2,
-    MSETransportGuidByte0_2,
-    MSETransportGuidByte5_2,
-    MSETransportTime2,
-    MSETransportGuidByte7_2,
-    MSETransportGuidByte4_2,
-    MSETransportGuidByte2_2,
-    MSEGuidByte5_2,
-    MSEGuidByte3_2,
-    MSEGuidByte4_2,
-    MSEFallVerticalSpeed,
-    MSEFallTime,
-    MSEFallHorizontalSpeed,
-    MSEFallCosAngle,
-    MSEFallSinAngle,
-    MSEGuidByte0_2,
-    MSEGuidByte2_2,
-    MSEPitch,
-    MSEGuidByte6_2,
-    MSESplineElev,
-    MSEGuidByte7_2,
-    MSEGuidByte1_2,
-};
+#define MOVEMENT_START_ASCEND_SEQUENCE(E) \
+    E(MSEGuidByte2) \
+    E(MSEGuidByte3) \
+    E(MSEGuidByte6) \
+    E(MSEGuidByte4) \
+    E(MSEGuidByte0) \
+    E(MSEHaveSpline) \
+    E(MSEGuidByte1) \
+    E(MSEGuidByte5) \
+    E(MSEFlags) \
+    E(MSEFlags2) \
+    E(MSEGuidByte7) \
+    E(MSEHaveTransportData) \
+    E(MSETransportGuidByte6) \
+    E(MSETransportGuidByte3) \
+    E(MSETransportGuidByte7) \
+    E(MSETransportGuidByte4) \
+    E(MSETransportGuidByte1) \
+    E(MSETransportGuidByte0) \
+    E(MSETransportGuidByte2) \
+    E(MSETransportGuidByte5) \
+    E(MSETransportHaveTime3) \
+    E(MSETransportHaveTime2) \
+    E(MSEHaveFallData) \
+    E(MSEHaveFallDirection) \
+    E(MSEHavePitch) \
+    E(MSEHaveSplineElev) \
+    E(MSEPositionO) \
+    E(MSEPositionX) \
+    E(MSEPositionY) \
+    E(MSEPositionZ) \
+    E(MSETimestamp) \
+    E(MSETransportTime) \
+    E(MSETransportPositionX) \
+    E(MSETransportPositionY) \
+    E(MSETransportPositionZ) \
+    E(MSETransportPositionO) \
+    E(MSETransportSeat) \
+    E(MSETransportGuidByte3_2) \
+    E(MSETransportGuidByte1_2) \
+    E(MSETransportTime3) \
+    E(MSETransportGuidByte6_2) \
+    E(MSETransportGuidByte0_2) \
+    E(MSETransportGuidByte5_2) \
+    E(MSETransportTime2) \
+    E(MSETransportGuidByte7_2) \
+    E(MSETransportGuidByte4_2) \
+    E(MSETransportGuidByte2_2) \
+    E(MSEGuidByte5_2) \
+    E(MSEGuidByte3_2) \
+    E(MSEGuidByte4_2) \
+    E(MSEFallVerticalSpeed) \
+    E(MSEFallTime) \
+    E(MSEFallHorizontalSpeed) \
+    E(MSEFallCosAngle) \
+    E(MSEFallSinAngle) \
+    E(MSEGuidByte0_2) \
+    E(MSEGuidByte2_2) \
+    E(MSEPitch) \
+    E(MSEGuidByte6_2) \
+    E(MSESplineElev) \
+    E(MSEGuidByte7_2) \
+    E(MSEGuidByte1_2)
 
-MovementStatusElements MovementStartDescendSequence[] = {
-    MSEGuidByte7,
-    MSEGuidByte0,
-    MSEGuidByte2,
-    MSEGuidByte1,
-    MSEGuidByte6,
-    MSEGuidByte4,
-    MSEGuidByte5,
-    MSEHaveSpline,
-    MSEGuidByte3,
-    MSEFlags2,
-    MSEFlags,
-    MSEHaveFallData,
-    MSEHaveFallDirection,
-    MSEHavePitch,
-    MSEHaveSplineElev,
-    MSEHaveTransportData,
-    MSETransportGuidByte6,
-    MSETransportGuidByte3,
-    MSETransportGuidByte7,
-    MSETransportGuidByte4,
-    MSETransportGuidByte1,
-    MSETransportGuidByte0,
-    MSETransportGuidByte2,
-    MSETransportGuidByte5,
-    MSETransportHaveTime3,
-    MSETransportHaveTime2,
-    MSETimestamp,
-    MSEPositionX,
-    MSEPositionY,
-    MSEPositionZ,
-    MSEPositionO,
-    MSEGuidByte3_2,
-    MSEGuidByte4_2,
-    MSEGuidByte2_2,
-    MSEFallVerticalSpeed,
-    MSEFallTime,
-    MSEFallHorizontalSpeed,
-    MSEFallCosAngle,
-    MSEFallSinAngle,
-    MSEPitch,
-    MSEGuidByte5_2,
-    MSESplineElev,
-    MSETransportTime,
-    MSETransportPositionX,
-    MSETransportPositionY,
-    MSETransportPositionZ,
-    MSETransportPositionO,
-    MSETransportSeat,
-    MSETransportGuidByte3_2,
-    MSETransportGuidByte1_2,
-    MSETransportTime3,
-    MSETransportGuidByte6_2,
-    MSETransportGuidByte0_2,
-    MSETransportGuidByte5_2,
-    MSETransportTime2,
-    MSETransportGuidByte7_2,
-    MSETransportGuidByte4_2,
-    MSETransportGuidByte2_2,
-    MSEGuidByte1_2,
-    MSEGuidByte0_2,
-    MSEGuidByte7_2,
-    MSEGuidByte6_2,
-};
+#define MOVEMENT_START_DESCEND_SEQUENCE(E) \
+    E(MSEGuidByte7) \
+    E(MSEGuidByte0) \
+    E(MSEGuidByte2) \
+    E(MSEGuidByte1) \
+    E(MSEGuidByte6) \
+    E(MSEGuidByte4) \
+    E(MSEGuidByte5) \
+    E(MSEHaveSpline) \
+    E(MSEGuidByte3) \
+    E(MSEFlags2) \
+    E(MSEFlags) \
+    E(MSEHaveFallData) \
+    E(MSEHaveFallDirection) \
+    E(MSEHavePitch) \
+    E(MSEHaveSplineElev) \
+    E(MSEHaveTransportData) \
+    E(MSETransportGuidByte6) \
+    E(MSETransportGuidByte3) \
+    E(MSETransportGuidByte7) \
+    E(MSETransportGuidByte4) \
+    E(MSETransportGuidByte1) \
+    E(MSETransportGuidByte0) \
+    E(MSETransportGuidByte2) \
+    E(MSETransportGuidByte5) \
+    E(MSETransportHaveTime3) \
+    E(MSETransportHaveTime2) \
+    E(MSETimestamp) \
+    E(MSEPositionX) \
+    E(MSEPositionY) \
+    E(MSEPositionZ) \
+    E(MSEPositionO) \
+    E(MSEGuidByte3_2) \
+    E(MSEGuidByte4_2) \
+    E(MSEGuidByte2_2) \
+    E(MSEFallVerticalSpeed) \
+    E(MSEFallTime) \
+    E(MSEFallHorizontalSpeed) \
+    E(MSEFallCosAngle) \
+    E(MSEFallSinAngle) \
+    E(MSEPitch) \
+    E(MSEGuidByte5_2) \
+    E(MSESplineElev) \
+    E(MSETransportTime) \
+    E(MSETransportPositionX) \
+    E(MSETransportPositionY) \
+    E(MSETransportPositionZ) \
+    E(MSETransportPositionO) \
+    E(MSETransportSeat) \
+    E(MSETransportGuidByte3_2) \
+    E(MSETransportGuidByte1_2) \
+    E(MSETransportTime3) \
+    E(MSETransportGuidByte6_2) \
+    E(MSETransportGuidByte0_2) \
+    E(MSETransportGuidByte5_2) \
+    E(MSETransportTime2) \
+    E(MSETransportGuidByte7_2) \
+    E(MSETransportGuidByte4_2) \
+    E(MSETransportGuidByte2_2) \
+    E(MSEGuidByte1_2) \
+    E(MSEGuidByte0_2) \
+    E(MSEGuidByte7_2) \
+    E(MSEGuidByte6_2)
 
-MovementStatusElements MovementStartSwimSequence[] = {
-    MSEGuidByte1,
-    MSEGuidByte5,
-    MSEFlags,
-    MSEGuidByte2,
-    MSEHaveSpline,
-    MSEGuidByte6,
-    MSEFlags2,
-    MSEGuidByte4,
-    MSEGuidByte7,
-    MSEGuidByte0,
-    MSEGuidByte3,
-    MSEHavePitch,
-    MSEHaveSplineElev,
-    MSEHaveFallData,
-    MSEHaveFallDirection,
-    MSEHaveTransportData,
-    MSETransportGuidByte6,
-    MSETransportGuidByte3,
-    MSETransportGuidByte7,
-    MSETransportGuidByte4,
-    MSETransportGuidByte1,
-    MSETransportGuidByte0,
-    MSETransportGuidByte2,
-    MSETransportGuidByte5,
-    MSETransportHaveTime3,
-    MSETransportHaveTime2,
-    MSEPositionO,
-    MSEPositionX,
-    MSEPositionY,
-    MSEPositionZ,
-    MSETimestamp,
-    MSEPitch,
-    MSEGuidByte4_2,
-    MSESplineElev,
-    MSEFallVerticalSpeed,
-    MSEFallTime,
-    MSEFallHorizontalSpeed,
-    MSEFallCosAngle,
-    MSEFallSinAngle,
-    MSEGuidByte0_2,
-    MSEGuidByte7_2,
-    MSETransportTime,
-    MSETransportPositionX,
-    MSETransportPositionY,
-    MSETransportPositionZ,
-    MSETransportPositionO,
-    MSETransportSeat,
-    MSETransportGuidByte3_2,
-    MSETransportGuidByte1_2,
-    MSETransportTime3,
-    MSETransportGuidByte6_2,
-    MSETransportGuidByte0_2,
-    MSETransportGuidByte5_2,
-    MSETransportTime2,
-    MSETransportGuidByte7_2,
-    MSETransportGuidByte4_2,
-    MSETransportGuidByte2_2,
-    MSEGuidByte6_2,
-    MSEGuidByte5_2,
-    MSEGuidByte2_2,
-    MSEGuidByte1_2,
-    MSEGuidByte3_2,
-};
+#define MOVEMENT_START_SWIM_SEQUENCE(E) \
+    E(MSEGuidByte1) \
+    E(MSEGuidByte5) \
+    E(MSEFlags) \
+    E(MSEGuidByte2) \
+    E(MSEHaveSpline) \
+    E(MSEGuidByte6) \
+    E(MSEFlags2) \
+    E(MSEGuidByte4) \
+    E(MSEGuidByte7) \
+    E(MSEGuidByte0) \
+    E(MSEGuidByte3) \
+    E(MSEHavePitch) \
+    E(MSEHaveSplineElev) \
+    E(MSEHaveFallData) \
+    E(MSEHaveFallDirection) \
+    E(MSEHaveTransportData) \
+    E(MSETransportGuidByte6) \
+    E(MSETransportGuidByte3) \
+    E(MSETransportGuidByte7) \
+    E(MSETransportGuidByte4) \
+    E(MSETransportGuidByte1) \
+    E(MSETransportGuidByte0) \
+    E(MSETransportGuidByte2) \
+    E(MSETransportGuidByte5) \
+    E(MSETransportHaveTime3) \
+    E(MSETransportHaveTime2) \
+    E(MSEPositionO) \
+    E(MSEPositionX) \
+    E(MSEPositionY) \
+    E(MSEPositionZ) \
+    E(MSETimestamp) \
+    E(MSEPitch) \
+    E(MSEGuidByte4_2) \
+    E(MSESplineElev) \
+    E(MSEFallVerticalSpeed) \
+    E(MSEFallTime) \
+    E(MSEFallHorizontalSpeed) \
+    E(MSEFallCosAngle) \
+    E(MSEFallSinAngle) \
+    E(MSEGuidByte0_2) \
+    E(MSEGuidByte7_2) \
+    E(MSETransportTime) \
+    E(MSETransportPositionX) \
+    E(MSETransportPositionY) \
+    E(MSETransportPositionZ) \
+    E(MSETransportPositionO) \
+    E(MSETransportSeat) \
+    E(MSETransportGuidByte3_2) \
+    E(MSETransportGuidByte1_2) \
+    E(MSETransportTime3) \
+    E(MSETransportGuidByte6_2) \
+    E(MSETransportGuidByte0_2) \
+    E(MSETransportGuidByte5_2) \
+    E(MSETransportTime2) \
+    E(MSETransportGuidByte7_2) \
+    E(MSETransportGuidByte4_2) \
+    E(MSETransportGuidByte2_2) \
+    E(MSEGuidByte6_2) \
+    E(MSEGuidByte5_2) \
+    E(MSEGuidByte2_2) \
+    E(MSEGuidByte1_2) \
+    E(MSEGuidByte3_2)
 
-MovementStatusElements MovementStopAscendSequence[] = {
-    MSEHaveSpline,
-    MSEGuidByte5,
-    MSEGuidByte3,
-    MSEGuidByte1,
-    MSEFlags,
-    MSEGuidByte4,
-    MSEGuidByte7,
-    MSEGuidByte2,
-    MSEFlags2,
-    MSEGuidByte6,
-    MSEGuidByte0,
-    MSEHavePitch,
-    MSEHaveSplineElev,
-    MSEHaveFallData,
-    MSEHaveFallDirection,
-    MSEHaveTransportData,
-    MSETransportGuidByte6,
-    MSETransportGuidByte3,
-    MSETransportGuidByte7,
-    MSETransportGuidByte4,
-    MSETransportGuidByte1,
-    MSETransportGuidByte0,
-    MSETransportGuidByte2,
-    MSETransportGuidByte5,
-    MSETransportHaveTime3,
-    MSETransportHaveTime2,
-    MSETimestamp,
-    MSEPositionX,
-    MSEPositionY,
-    MSEPositionZ,
-    MSEPositionO,
-    MSEGuidByte5_2,
-    MSEGuidByte2_2,
-    MSEGuidByte0_2,
-    MSEGuidByte7_2,
-    MSEPitch,
-    MSEGuidByte3_2,
-    MSEGuidByte4_2,
-    MSEGuidByte1_2,
-    MSESplineElev,
-    MSEFallVerticalSpeed,
-    MSEFallTime,
-    MSEFallHorizontalSpeed,
-    MSEFallCosAngle,
-    MSEFallSinAngle,
-    MSEGuidByte6_2,
-    MSETransportTime,
-    MSETransportPositionX,
-    MSETransportPositionY,
-    MSETransportPositionZ,
-    MSETransportPositionO,
-    MSETransportSeat,
-    MSETransportGuidByte3_2,
-    MSETransportGuidByte1_2,
-    MSETransportTime3,
-    MSETransportGuidByte6_2,
-    MSETransportGuidByte0_2,
-    MSETransportGuidByte5_2,
-    MSETransportTime2,
-    MSETransportGuidByte7_2,
-    MSETransportGuidByte4_2,
-    MSETransportGuidByte2_2,
-};
+#define MOVEMENT_STOP_ASCEND_SEQUENCE(E) \
+    E(MSEHaveSpline) \
+    E(MSEGuidByte5) \
+    E(MSEGuidByte3) \
+    E(MSEGuidByte1) \
+    E(MSEFlags) \
+    E(MSEGuidByte4) \
+    E(MSEGuidByte7) \
+    E(MSEGuidByte2) \
+    E(MSEFlags2) \
+    E(MSEGuidByte6) \
+    E(MSEGuidByte0) \
+    E(MSEHavePitch) \
+    E(MSEHaveSplineElev) \
+    E(MSEHaveFallData) \
+    E(MSEHaveFallDirection) \
+    E(MSEHaveTransportData) \
+    E(MSETransportGuidByte6) \
+    E(MSETransportGuidByte3) \
+    E(MSETransportGuidByte7) \
+    E(MSETransportGuidByte4) \
+    E(MSETransportGuidByte1) \
+    E(MSETransportGuidByte0) \
+    E(MSETransportGuidByte2) \
+    E(MSETransportGuidByte5) \
+    E(MSETransportHaveTime3) \
+    E(MSETransportHaveTime2) \
+    E(MSETimestamp) \
+    E(MSEPositionX) \
+    E(MSEPositionY) \
+    E(MSEPositionZ) \
+    E(MSEPositionO) \
+    E(MSEGuidByte5_2) \
+    E(MSEGuidByte2_2) \
+    E(MSEGuidByte0_2) \
+    E(MSEGuidByte7_2) \
+    E(MSEPitch) \
+    E(MSEGuidByte3_2) \
+    E(MSEGuidByte4_2) \
+    E(MSEGuidByte1_2) \
+    E(MSESplineElev) \
+    E(MSEFallVerticalSpeed) \
+    E(MSEFallTime) \
+    E(MSEFallHorizontalSpeed) \
+    E(MSEFallCosAngle) \
+    E(MSEFallSinAngle) \
+    E(MSEGuidByte6_2) \
+    E(MSETransportTime) \
+    E(MSETransportPositionX) \
+    E(MSETransportPositionY) \
+    E(MSETransportPositionZ) \
+    E(MSETransportPositionO) \
+    E(MSETransportSeat) \
+    E(MSETransportGuidByte3_2) \
+    E(MSETransportGuidByte1_2) \
+    E(MSETransportTime3) \
+    E(MSETransportGuidByte6_2) \
+    E(MSETransportGuidByte0_2) \
+    E(MSETransportGuidByte5_2) \
+    E(MSETransportTime2) \
+    E(MSETransportGuidByte7_2) \
+    E(MSETransportGuidByte4_2) \
+    E(MSETransportGuidByte2_2)
 
-MovementStatusElements* GetMovementStatusElementsSequence(Opcodes opcode)
-{
-    switch(opcode)
-    {
-    case SMSG_PLAYER_MOVE:
-        return PlayerMoveSequence;
-    case MSG_MOVE_FALL_LAND:
-        return MovementFallLandSequence;
-    case MSG_MOVE_HEARTBEAT:
-        return MovementHeartBeatSequence;
-    case MSG_MOVE_JUMP:
-        return MovementJumpSequence;
-    case MSG_MOVE_SET_FACING:
-        return MovementSetFacingSequence;
-    case MSG_MOVE_SET_PITCH:
-        return MovementSetPitchSequence;
-    case MSG_MOVE_START_BACKWARD:
-        return MovementStartBackwardSequence;
-    case MSG_START_MOVE_FORWARD:
-        return MovementStartForwardSequence;
-    case MSG_MOVE_START_STRAFE_LEFT:
-        return MovementStartStrafeLeftSequence;
-    case MSG_MOVE_START_STRAFE_RIGHT:
-        return MovementStartStrafeRightSequence;
-    case MSG_MOVE_START_TURN_LEFT:
-        return MovementStartTurnLeftSequence;
-    case MSG_MOVE_START_TURN_RIGHT:
-        return MovementStartTurnRightSequence;
-    case MSG_MOVE_STOP:
-        return MovementStopSequence;
-    case MSG_MOVE_STOP_STRAFE:
-        return MovementStopStrafeSequence;
-    case MSG_MOVE_STOP_TURN:
-        return MovementStopTurnSequence;
-    case MSG_MOVE_START_ASCEND:
-        return MovementStartAscendSequence;
-    case MSG_MOVE_START_DESCEND:
-        return MovementStartDescendSequence;
-    case MSG_MOVE_START_SWIM:
-        return MovementStartSwimSequence;
-    case MSG_MOVE_STOP_ASCEND:
-        return MovementStopAscendSequence;
-    }
-    return NULL;
-}
+/// Opcodes with a known element order, S is called with the opcode and its sequence macro
+#define MOVEMENT_SEQUENCES(S) \
+    S(SMSG_PLAYER_MOVE, PLAYER_MOVE_SEQUENCE) \
+    S(MSG_MOVE_FALL_LAND, MOVEMENT_FALL_LAND_SEQUENCE) \
+    S(MSG_MOVE_HEARTBEAT, MOVEMENT_HEART_BEAT_SEQUENCE) \
+    S(MSG_MOVE_JUMP, MOVEMENT_JUMP_SEQUENCE) \
+    S(MSG_MOVE_SET_FACING, MOVEMENT_SET_FACING_SEQUENCE) \
+    S(MSG_MOVE_SET_PITCH, MOVEMENT_SET_PITCH_SEQUENCE) \
+    S(MSG_MOVE_START_BACKWARD, MOVEMENT_START_BACKWARD_SEQUENCE) \
+    S(MSG_START_MOVE_FORWARD, MOVEMENT_START_FORWARD_SEQUENCE) \
+    S(MSG_MOVE_START_STRAFE_LEFT, MOVEMENT_START_STRAFE_LEFT_SEQUENCE) \
+    S(MSG_MOVE_START_STRAFE_RIGHT, MOVEMENT_START_STRAFE_RIGHT_SEQUENCE) \
+    S(MSG_MOVE_START_TURN_LEFT, MOVEMENT_START_TURN_LEFT_SEQUENCE) \
+    S(MSG_MOVE_START_TURN_RIGHT, MOVEMENT_START_TURN_RIGHT_SEQUENCE) \
+    S(MSG_MOVE_STOP, MOVEMENT_STOP_SEQUENCE) \
+    S(MSG_MOVE_STOP_STRAFE, MOVEMENT_STOP_STRAFE_SEQUENCE) \
+    S(MSG_MOVE_STOP_TURN, MOVEMENT_STOP_TURN_SEQUENCE) \
+    S(MSG_MOVE_START_ASCEND, MOVEMENT_START_ASCEND_SEQUENCE) \
+    S(MSG_MOVE_START_DESCEND, MOVEMENT_START_DESCEND_SEQUENCE) \
+    S(MSG_MOVE_START_SWIM, MOVEMENT_START_SWIM_SEQUENCE) \
+    S(MSG_MOVE_STOP_ASCEND, MOVEMENT_STOP_ASCEND_SEQUENCE)
 
 #endif //_MOVEMENT_STRUCTURES_H
@@ -35,6 +35,7 @@ class NullCreatureAI : public CreatureAI
         void EnterEvadeMode() {}
 
         bool IsVisible(Unit *) const { return false;  }
+        bool CanSleep() const { return true; }
 
         void UpdateAI(const uint32) {}
         static int Permissible(const Creature *) { return PERMIT_BASE_IDLE;  }
@@ -1047,7 +1047,10 @@ void WorldObject::Relocate(float x, float y, float z, float orientation)
     m_position.o = orientation;
 
     if(isType(TYPEMASK_UNIT))
+    {
         ((Unit*)this)->m_movementInfo.ChangePosition(x, y, z, orientation);
+        ((Unit*)this)->UpdateUnitIndex();
+    }
 }
 
 void WorldObject::Relocate(float x, float y, float z)
@@ -1057,7 +1060,10 @@ void WorldObject::Relocate(float x, float y, float z)
     m_position.z = z;
 
     if(isType(TYPEMASK_UNIT))
+    {
         ((Unit*)this)->m_movementInfo.ChangePosition(x, y, z, GetOrientation());
+        ((Unit*)this)->UpdateUnitIndex();
+    }
 }
 
 void WorldObject::SetOrientation(float orientation)
@@ -1591,6 +1597,8 @@ void WorldObject::SendMessageToSetExcept(WorldPacket *data, Player const* skippe
     //if object is in world, map for it already created!
     if (IsInWorld())
     {
+        GetMap()->FlushQueuedBroadcasts(this);
+
         Strawberry::MessageDelivererExcept notifier(this, data, skipped_receiver);
         Cell::VisitWorldObjects(this, notifier, GetMap()->GetVisibilityDistance());
     }
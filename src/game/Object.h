@@ -565,10 +565,10 @@ class WorldObject : public Object
         // low level function for visibility change code, must be define in all main world object subclasses
         virtual bool isVisibleForInState(Player const* u, WorldObject const* viewPoint, bool inVisibleList) const = 0;
 
-        void SetMap(Map * map);
+        virtual void SetMap(Map * map);
         Map * GetMap() const { STRAWBERRY_ASSERT(m_currMap); return m_currMap; }
         //used to check all object's GetMap() calls when object is not in world!
-        void ResetMap() { m_currMap = NULL; }
+        virtual void ResetMap() { m_currMap = NULL; }
 
         //obtain terrain data for map where this object belong...
         TerrainInfo const* GetTerrain() const;
@@ -19,6 +19,7 @@
 
 #include "ObjectMgr.h"
 #include "Database/DatabaseEnv.h"
+#include "Database/DatabaseImpl.h"
 #include "Database/SQLStorageImpl.h"
 #include "Policies/SingletonImp.h"
 
@@ -50,6 +51,11 @@
 
 #include <limits>
 
+//                          0    1              2         3           4            5      6          7                 8             9          10      11       12             13
+#define OLD_MAILS_QUERY "SELECT m.id, m.messageType, m.sender, m.receiver, m.has_items, m.cod, m.checked, m.mailTemplateId, m.stationery, m.subject, m.body, m.money, mi.item_guid, mi.item_template " \
+    "FROM (SELECT id FROM mail WHERE expire_time < '" UI64FMTD "' AND id > '%u' ORDER BY id LIMIT %u) expired " \
+    "JOIN mail m ON m.id = expired.id LEFT JOIN mail_items mi ON mi.mail_id = m.id ORDER BY m.id"
+
 INSTANTIATE_SINGLETON_1(ObjectMgr);
 
 bool normalizePlayerName(std::string& name)
@@ -151,7 +157,12 @@ ObjectMgr::ObjectMgr() :
     m_EquipmentSetIds("Equipment set ids"),
     m_GuildIds("Guild ids"),
     m_MailIds("Mail ids"),
-    m_PetNumbers("Pet numbers")
+    m_PetNumbers("Pet numbers"),
+
+    m_oldMailsInProgress(false),
+    m_oldMailsReturned(0),
+    m_oldMailsDeleted(0),
+    m_oldMailsSkipped(0)
 {
     // Only zero condition left, others will be added while loading DB tables
     mConditions.resize(1);
@@ -4937,112 +4948,269 @@ void ObjectMgr::LoadGossipTextLocales()
     sLog.outString( ">> Loaded %lu NpcText locale strings", (unsigned long)mNpcTextLocaleMap.size() );
 }
 
-//not very fast function but it is called only once a day, or on starting-up
+// Expired mails are processed in chunks of "Mail.ExpireChunkSize" mails ordered by id: one query reads the chunk
+// with its items, and the deletes and returns of the whole chunk are written by a few set-based statements in one
+// transaction. At startup the chunks are read directly, at runtime through the async query queue, so the world
+// thread only sorts the rows of the current chunk and updates mailboxes of online players.
 void ObjectMgr::ReturnOrDeleteOldMails(bool serverUp)
 {
     time_t basetime = time(NULL);
     DEBUG_LOG("Returning mails current time: hour: %d, minute: %d, second: %d ", localtime(&basetime)->tm_hour, localtime(&basetime)->tm_min, localtime(&basetime)->tm_sec);
+
+    if (serverUp)
+    {
+        // previous run still walks the backlog, it already covers everything expired by now
+        if (m_oldMailsInProgress)
+        {
+            sLog.outDetail("Expired mails from previous run still in progress, new run skipped.");
+            return;
+        }
+
+        m_oldMailsInProgress = true;
+        m_oldMailsReturned = 0;
+        m_oldMailsDeleted = 0;
+        m_oldMailsSkipped = 0;
+
+        CharacterDatabase.AsyncPQuery(this, &ObjectMgr::ReturnOrDeleteOldMailsCallback, (uint64)basetime, OLD_MAILS_QUERY,
+            (uint64)basetime, 0, sWorld.getConfig(CONFIG_UINT32_MAIL_EXPIRE_CHUNK_SIZE));
+        return;
+    }
+
     //delete all old mails without item and without body immediately, if starting server
-    if (!serverUp)
-        CharacterDatabase.PExecute("DELETE FROM mail WHERE expire_time < '" UI64FMTD "' AND has_items = '0' AND body = ''", (uint64)basetime);
-    //                                                     0  1           2      3        4         5           6   7       8
-    QueryResult* result = CharacterDatabase.PQuery("SELECT id,messageType,sender,receiver,has_items,expire_time,cod,checked,mailTemplateId FROM mail WHERE expire_time < '" UI64FMTD "'", (uint64)basetime);
+    CharacterDatabase.PExecute("DELETE FROM mail WHERE expire_time < '" UI64FMTD "' AND has_items = '0' AND body = ''", (uint64)basetime);
+
+    m_oldMailsReturned = 0;
+    m_oldMailsDeleted = 0;
+    m_oldMailsSkipped = 0;
+
+    uint32 chunkSize = sWorld.getConfig(CONFIG_UINT32_MAIL_EXPIRE_CHUNK_SIZE);
+    uint32 lastId = 0;
+    uint32 chunks = 0;
+
+    while (QueryResult* result = CharacterDatabase.PQuery(OLD_MAILS_QUERY, (uint64)basetime, lastId, chunkSize))
+    {
+        uint32 mails = ReturnOrDeleteOldMailsChunk(result, basetime, false, lastId);
+        delete result;
+        ++chunks;
+
+        if (mails < chunkSize)
+            break;
+    }
+
+    BarGoLink bar(1);
+    bar.step();
+    sLog.outString();
+    sLog.outString(">> Expired mails: %u returned, %u deleted in %u chunks", m_oldMailsReturned, m_oldMailsDeleted, chunks);
+}
+
+void ObjectMgr::ReturnOrDeleteOldMailsCallback(QueryResult* result, uint64 basetime)
+{
     if (!result)
     {
-        BarGoLink bar(1);
-        bar.step();
-        sLog.outString();
-        sLog.outString(">> Only expired mails (need to be return or delete) or DB table `mail` is empty.");
-        return;                                             // any mails need to be returned or deleted
+        m_oldMailsInProgress = false;
+        sLog.outDetail("Expired mails: %u returned, %u deleted, %u skipped for online receivers.", m_oldMailsReturned, m_oldMailsDeleted, m_oldMailsSkipped);
+        return;
     }
 
-    //std::ostringstream delitems, delmails; //will be here for optimization
-    //bool deletemail = false, deleteitem = false;
-    //delitems << "DELETE FROM item_instance WHERE guid IN ( ";
-    //delmails << "DELETE FROM mail WHERE id IN ( "
+    uint32 chunkSize = sWorld.getConfig(CONFIG_UINT32_MAIL_EXPIRE_CHUNK_SIZE);
+    uint32 lastId = 0;
+    uint32 mails = ReturnOrDeleteOldMailsChunk(result, time_t(basetime), true, lastId);
+    delete result;
 
-    BarGoLink bar(result->GetRowCount());
-    uint32 count = 0;
-    Field *fields;
+    // short chunk is the last one, otherwise continue after it with the same expire time
+    if (mails < chunkSize)
+    {
+        ReturnOrDeleteOldMailsCallback(NULL, basetime);
+        return;
+    }
+
+    CharacterDatabase.AsyncPQuery(this, &ObjectMgr::ReturnOrDeleteOldMailsCallback, basetime, OLD_MAILS_QUERY,
+        basetime, lastId, chunkSize);
+}
+
+uint32 ObjectMgr::ReturnOrDeleteOldMailsChunk(QueryResult* result, time_t basetime, bool serverUp, uint32& lastId)
+{
+    typedef std::vector<Mail*> MailVec;
+    MailVec mails;
 
+    // rows are ordered by mail id, one row per mailed item or a single row with NULL item for mails without items
     do
     {
-        bar.step();
+        Field* fields = result->Fetch();
+        uint32 id = fields[0].GetUInt32();
+
+        if (mails.empty() || mails.back()->messageID != id)
+        {
+            Mail* m = new Mail;
+            m->messageID = id;
+            m->messageType = fields[1].GetUInt8();
+            m->sender = fields[2].GetUInt32();
+            m->receiverGuid = ObjectGuid(HIGHGUID_PLAYER, fields[3].GetUInt32());
+            m->has_items = fields[4].GetBool();
+            m->COD = fields[5].GetUInt32();
+            m->checked = fields[6].GetUInt32();
+            m->mailTemplateId = fields[7].GetInt16();
+            m->stationery = fields[8].GetUInt8();
+            m->subject = fields[9].GetCppString();
+            m->body = fields[10].GetCppString();
+            m->money = fields[11].GetUInt32();
+            m->expire_time = 0;
+            m->deliver_time = 0;
+            mails.push_back(m);
+        }
+
+        if (!fields[12].IsNULL())
+            mails.back()->AddItem(fields[12].GetUInt32(), fields[13].GetUInt32());
+    }
+    while (result->NextRow());
 
-        fields = result->Fetch();
-        Mail *m = new Mail;
-        m->messageID = fields[0].GetUInt32();
-        m->messageType = fields[1].GetUInt8();
-        m->sender = fields[2].GetUInt32();
-        m->receiverGuid = ObjectGuid(HIGHGUID_PLAYER, fields[3].GetUInt32());
-        bool has_items = fields[4].GetBool();
-        m->expire_time = (time_t)fields[5].GetUInt64();
-        m->deliver_time = 0;
-        m->COD = fields[6].GetUInt32();
-        m->checked = fields[7].GetUInt32();
-        m->mailTemplateId = fields[8].GetInt16();
-
-        Player *pl = 0;
-        if (serverUp)
-            pl = GetPlayer(m->receiverGuid);
-        if (pl)
-        {                                                   //this code will run very improbably (the time is between 4 and 5 am, in game is online a player, who has old mail
-            //his in mailbox and he has already listed his mails )
+    lastId = mails.back()->messageID;
+
+    std::ostringstream delMails, delMailItems, delItems;
+    std::ostringstream retMails, retSenders, retItemMails, retItemReceivers, retItems, retItemOwners;
+    bool hasDelMails = false, hasDelMailItems = false, hasDelItems = false;
+    bool hasRetMails = false, hasRetItems = false;
+
+    // online senders of returned mails, updated in memory after the chunk statements are queued
+    MailVec returnedToOnline;
+
+    for (MailVec::iterator itr = mails.begin(); itr != mails.end(); ++itr)
+    {
+        Mail* m = *itr;
+
+        // the receiver has the mail loaded in memory, it stays until the next run
+        if (serverUp && GetPlayer(m->receiverGuid))
+        {
+            ++m_oldMailsSkipped;
             delete m;
+            *itr = NULL;
             continue;
         }
-        //delete or return mail:
-        if (has_items)
+
+        // if it is mail from non-player, or if it's already return mail, it shouldn't be returned, but deleted
+        if (!m->has_items || m->messageType != MAIL_NORMAL || (m->checked & (MAIL_CHECK_MASK_COD_PAYMENT | MAIL_CHECK_MASK_RETURNED)))
         {
-            QueryResult *resultItems = CharacterDatabase.PQuery("SELECT item_guid,item_template FROM mail_items WHERE mail_id='%u'", m->messageID);
-            if(resultItems)
+            delMails << (hasDelMails ? "," : "") << m->messageID;
+            hasDelMails = true;
+
+            if (!m->items.empty())
             {
-                do
+                delMailItems << (hasDelMailItems ? "," : "") << m->messageID;
+                hasDelMailItems = true;
+
+                for (MailItemInfoVec::const_iterator itemItr = m->items.begin(); itemItr != m->items.end(); ++itemItr)
                 {
-                    Field *fields2 = resultItems->Fetch();
+                    delItems << (hasDelItems ? "," : "") << itemItr->item_guid;
+                    hasDelItems = true;
+                }
+            }
+
+            ++m_oldMailsDeleted;
+            delete m;
+            *itr = NULL;
+            continue;
+        }
 
-                    uint32 item_guid_low = fields2[0].GetUInt32();
-                    uint32 item_template = fields2[1].GetUInt32();
+        // mail will be returned, receiver and sender swapped
+        retMails << (hasRetMails ? "," : "") << m->messageID;
+        retSenders << " WHEN " << m->messageID << " THEN " << m->receiverGuid.GetCounter();
+        hasRetMails = true;
 
-                    m->AddItem(item_guid_low, item_template);
-                }
-                while (resultItems->NextRow());
+        if (!m->items.empty())
+        {
+            // update receiver in mail items for its proper delivery, and in instance_item for avoid lost item at sender delete
+            retItemMails << (hasRetItems ? "," : "") << m->messageID;
+            retItemReceivers << " WHEN " << m->messageID << " THEN " << m->sender;
 
-                delete resultItems;
-            }
-            // if it is mail from non-player, or if it's already return mail, it shouldn't be returned, but deleted
-            if (m->messageType != MAIL_NORMAL || (m->checked & (MAIL_CHECK_MASK_COD_PAYMENT | MAIL_CHECK_MASK_RETURNED)))
+            for (MailItemInfoVec::const_iterator itemItr = m->items.begin(); itemItr != m->items.end(); ++itemItr)
             {
-                // mail open and then not returned
-                for(MailItemInfoVec::iterator itr2 = m->items.begin(); itr2 != m->items.end(); ++itr2)
-                    CharacterDatabase.PExecute("DELETE FROM item_instance WHERE guid = '%u'", itr2->item_guid);
-            }
-            else
-            {
-                // mail will be returned:
-                CharacterDatabase.PExecute("UPDATE mail SET sender = '%u', receiver = '%u', expire_time = '" UI64FMTD "', deliver_time = '" UI64FMTD "',cod = '0', checked = '%u' WHERE id = '%u'",
-                    m->receiverGuid.GetCounter(), m->sender, (uint64)(basetime + 30*DAY), (uint64)basetime, MAIL_CHECK_MASK_RETURNED, m->messageID);
-                for (MailItemInfoVec::iterator itr2 = m->items.begin(); itr2 != m->items.end(); ++itr2)
-                {
-                    // update receiver in mail items for its proper delivery, and in instance_item for avoid lost item at sender delete
-                    CharacterDatabase.PExecute("UPDATE mail_items SET receiver = %u WHERE item_guid = '%u'", m->sender, itr2->item_guid);
-                    CharacterDatabase.PExecute("UPDATE item_instance SET owner_guid = %u WHERE guid = '%u'", m->sender, itr2->item_guid);
-                }
-                delete m;
-                continue;
+                retItems << (hasRetItems || itemItr != m->items.begin() ? "," : "") << itemItr->item_guid;
+                retItemOwners << " WHEN " << itemItr->item_guid << " THEN " << m->sender;
             }
+
+            hasRetItems = true;
         }
 
-        // deletemail = true;
-        // delmails << m->messageID << ", ";
-        CharacterDatabase.PExecute("DELETE FROM mail WHERE id = '%u'", m->messageID);
-        delete m;
-        ++count;
-    } while (result->NextRow());
-    delete result;
+        ++m_oldMailsReturned;
 
-    sLog.outString();
-    sLog.outString( ">> Loaded %u mails", count );
+        if (serverUp && GetPlayer(ObjectGuid(HIGHGUID_PLAYER, m->sender)))
+            returnedToOnline.push_back(m);
+        else
+        {
+            delete m;
+            *itr = NULL;
+        }
+    }
+
+    if (hasDelMails || hasRetMails)
+    {
+        // statements are built as whole strings, with items of a big chunk they can exceed PExecute buffer size
+        CharacterDatabase.BeginTransaction();
+
+        if (hasDelItems)
+            CharacterDatabase.Execute(("DELETE FROM item_instance WHERE guid IN (" + delItems.str() + ")").c_str());
+        if (hasDelMailItems)
+            CharacterDatabase.Execute(("DELETE FROM mail_items WHERE mail_id IN (" + delMailItems.str() + ")").c_str());
+        if (hasDelMails)
+            CharacterDatabase.Execute(("DELETE FROM mail WHERE id IN (" + delMails.str() + ")").c_str());
+
+        // receiver assigned first: it takes the old sender also with left to right assignment evaluation
+        if (hasRetMails)
+        {
+            std::ostringstream ss;
+            ss << "UPDATE mail SET receiver = sender, sender = CASE id" << retSenders.str() << " END, expire_time = '" << uint64(basetime + 30*DAY)
+               << "', deliver_time = '" << uint64(basetime) << "', cod = '0', checked = '" << uint32(MAIL_CHECK_MASK_RETURNED) << "' WHERE id IN (" << retMails.str() << ")";
+            CharacterDatabase.Execute(ss.str().c_str());
+        }
+
+        if (hasRetItems)
+        {
+            CharacterDatabase.Execute(("UPDATE mail_items SET receiver = CASE mail_id" + retItemReceivers.str() + " END WHERE mail_id IN (" + retItemMails.str() + ")").c_str());
+            CharacterDatabase.Execute(("UPDATE item_instance SET owner_guid = CASE guid" + retItemOwners.str() + " END WHERE guid IN (" + retItems.str() + ")").c_str());
+        }
+
+        CharacterDatabase.CommitTransaction();
+    }
+
+    // returned mail appears in mailbox of online sender at once, its items are loaded after the chunk statements are executed
+    for (MailVec::const_iterator itr = returnedToOnline.begin(); itr != returnedToOnline.end(); ++itr)
+    {
+        Mail* m = *itr;
+        ObjectGuid senderGuid = ObjectGuid(HIGHGUID_PLAYER, m->sender);
+        Player* pl = GetPlayer(senderGuid);
+
+        m->sender = m->receiverGuid.GetCounter();
+        m->receiverGuid = senderGuid;
+        m->expire_time = basetime + 30*DAY;
+        m->deliver_time = basetime;
+        m->COD = 0;
+        m->checked = MAIL_CHECK_MASK_RETURNED;
+        m->state = MAIL_STATE_UNCHANGED;
+
+        bool hasItems = !m->items.empty();
+        m->items.clear();
+
+        pl->AddMail(m);
+        pl->AddNewMailDeliverTime(basetime);
+
+        if (hasItems)
+            CharacterDatabase.AsyncPQuery(this, &ObjectMgr::LoadReturnedMailItemsCallback, senderGuid,
+                "SELECT data, text, mail_id, item_guid, item_template FROM mail_items JOIN item_instance ON item_guid = guid WHERE mail_id = '%u'", m->messageID);
+    }
+
+    return mails.size();
+}
+
+void ObjectMgr::LoadReturnedMailItemsCallback(QueryResult* result, ObjectGuid receiverGuid)
+{
+    Player* pl = GetPlayer(receiverGuid);
+    if (!pl)
+    {
+        delete result;
+        return;
+    }
+
+    pl->LoadMailedItems(result);
 }
 
 void ObjectMgr::LoadQuestAreaTriggers()
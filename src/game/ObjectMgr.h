@@ -737,6 +737,8 @@ class ObjectMgr
         }
 
         void ReturnOrDeleteOldMails(bool serverUp);
+        void ReturnOrDeleteOldMailsCallback(QueryResult* result, uint64 basetime);
+        void LoadReturnedMailItemsCallback(QueryResult* result, ObjectGuid receiverGuid);
 
         void SetHighestGuids();
 
@@ -752,6 +754,7 @@ class ObjectMgr
         uint32 GenerateItemLowGuid()     { return m_ItemGuids.Generate();     }
         uint32 GenerateCorpseLowGuid()   { return m_CorpseGuids.Generate();   }
         uint32 GenerateInstanceLowGuid() { return m_InstanceGuids.Generate(); }
+        uint32 GetNextInstanceLowGuid() const { return m_InstanceGuids.GetNextAfterMaxUsed(); }
         uint32 GenerateGroupLowGuid()    { return m_GroupGuids.Generate();    }
 
         uint32 GenerateArenaTeamId() { return m_ArenaTeamIds.Generate(); }
@@ -1164,7 +1167,15 @@ class ObjectMgr
 
         int DBCLocaleIndex;
 
+        // expired mails run, at runtime spread over async query results
+        bool m_oldMailsInProgress;
+        uint32 m_oldMailsReturned;
+        uint32 m_oldMailsDeleted;
+        uint32 m_oldMailsSkipped;
+
     private:
+        uint32 ReturnOrDeleteOldMailsChunk(QueryResult* result, time_t basetime, bool serverUp, uint32& lastId);
+
         void LoadCreatureAddons(SQLStorage& creatureaddons, char const* entryName, char const* comment);
         void ConvertCreatureAddonAuras(CreatureDataAddon* addon, char const* table, char const* guidEntryStr);
         void LoadQuestRelationsHelper(QuestRelationsMap& map, char const* table);
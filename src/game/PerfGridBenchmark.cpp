@@ -0,0 +1,183 @@
+/*
+ * Copyright (C) 2010-2012 Strawberry-Pr0jcts <http://strawberry-pr0jcts.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "PerfGridBenchmark.h"
+#include "Map.h"
+#include "Player.h"
+#include "Creature.h"
+#include "WorldSession.h"
+#include "WorldPacket.h"
+#include "World.h"
+#include "ObjectMgr.h"
+#include "GridNotifiers.h"
+#include "GridNotifiersImpl.h"
+#include "CellImpl.h"
+#include "Util.h"
+
+static char const* const perfGridStepNames[MAX_PERF_GRID_STEPS] =
+{
+    "Cell::Visit",
+    "VisibleNotifier",
+    "MessageDistDeliverer",
+    "ObjectUpdater"
+};
+
+PerfGridBenchmark::PerfGridBenchmark(uint32 mapId, float x, float y, float radius)
+    : m_map(new WorldMap(mapId, 0)), m_x(x), m_y(y), m_radius(radius), m_creatureCount(0)
+{
+    for (uint32 i = 0; i < MAX_PERF_GRID_STEPS; ++i)
+        m_objects[i] = 0;
+}
+
+PerfGridBenchmark::~PerfGridBenchmark()
+{
+    // players go first, the map removes and deletes them, their sessions are ours
+    for (std::vector<Player*>::const_iterator itr = m_players.begin(); itr != m_players.end(); ++itr)
+    {
+        WorldSession* session = (*itr)->GetSession();
+        m_map->Remove(*itr, true);
+        session->SetPlayer(NULL);
+        delete session;
+    }
+
+    // creatures are deleted by the map unload
+    delete m_map;
+}
+
+char const* PerfGridBenchmark::GetStepName(PerfGridStep step)
+{
+    return perfGridStepNames[step];
+}
+
+void PerfGridBenchmark::GetRandomPosition(float& x, float& y, float& o) const
+{
+    // uniform on the disc, not packed at the center
+    float dist = m_radius * sqrt(rand_norm_f());
+    float angle = rand_norm_f() * 2 * M_PI_F;
+
+    x = m_x + dist * cos(angle);
+    y = m_y + dist * sin(angle);
+    o = rand_norm_f() * 2 * M_PI_F;
+}
+
+uint32 PerfGridBenchmark::SpawnCreatures(CreatureInfo const* cinfo, uint32 count)
+{
+    uint32 added = 0;
+    for (uint32 i = 0; i < count; ++i)
+    {
+        float x, y, o;
+        GetRandomPosition(x, y, o);
+
+        // flat at z 0, the notifiers do not look at the terrain
+        CreatureCreatePos pos(m_map, x, y, 0.0f, o, PHASEMASK_NORMAL);
+
+        Creature* creature = new Creature;
+        if (!creature->Create(m_map->GenerateLocalLowGuid(cinfo->GetHighGuid()), pos, cinfo))
+        {
+            delete creature;
+            break;
+        }
+
+        creature->AIM_InitializeNull();
+        m_map->Add(creature);
+        ++added;
+    }
+
+    m_creatureCount += added;
+    return added;
+}
+
+uint32 PerfGridBenchmark::SpawnPlayers(uint32 count)
+{
+    uint32 added = 0;
+    for (uint32 i = 0; i < count; ++i)
+    {
+        // no socket: SendPacket drops everything the notifiers build
+        WorldSession* session = new WorldSession(0, NULL, SEC_PLAYER, sWorld.getConfig(CONFIG_UINT32_EXPANSION), 0, LOCALE_enUS);
+
+        Player* player = new Player(session);
+        if (!player->Create(sObjectMgr.GeneratePlayerLowGuid(), "Benchmark", RACE_HUMAN, CLASS_WARRIOR, GENDER_MALE, 0, 0, 0, 0, 0, 0))
+        {
+            delete player;
+            delete session;
+            break;
+        }
+
+        session->SetPlayer(player);
+
+        float x, y, o;
+        GetRandomPosition(x, y, o);
+        player->Relocate(x, y, 0.0f, o);
+
+        m_map->Add(player);
+        m_players.push_back(player);
+        ++added;
+    }
+
+    return added;
+}
+
+void PerfGridBenchmark::Run(uint32 iterations)
+{
+    if (m_players.empty() || !iterations)
+        return;
+
+    for (uint32 i = 0; i < MAX_PERF_GRID_STEPS; ++i)
+        m_histograms[i].Reset();
+
+    uint32 updateDiff = sWorld.getConfig(CONFIG_UINT32_INTERVAL_MAPUPDATE);
+
+    for (uint32 i = 0; i < iterations; ++i)
+    {
+        Player* player = m_players[i % m_players.size()];
+
+        PerfGridObjectCounter counter;
+        ACE_Time_Value start = ACE_OS::gettimeofday();
+        Cell::VisitAllObjects(player, counter, m_radius);
+        m_histograms[PERF_GRID_CELL_VISIT].Add(PerfStatsMgr::GetElapsedTime(start));
+        m_objects[PERF_GRID_CELL_VISIT] = counter.i_count;
+
+        start = ACE_OS::gettimeofday();
+        player->GetCamera().UpdateVisibilityForOwner();
+        m_histograms[PERF_GRID_VISIBLE_NOTIFIER].Add(PerfStatsMgr::GetElapsedTime(start));
+        m_objects[PERF_GRID_VISIBLE_NOTIFIER] = uint32(player->m_clientGUIDs.size());
+
+        // same packet Unit::HandleEmoteCommand sends, built outside of the timing
+        WorldPacket data(SMSG_EMOTE, 4 + 8);
+        data << uint32(EMOTE_ONESHOT_NONE);
+        data << player->GetObjectGuid();
+
+        start = ACE_OS::gettimeofday();
+        m_map->MessageDistBroadcast(player, &data, m_radius, false);
+        m_histograms[PERF_GRID_MESSAGE_DIST].Add(PerfStatsMgr::GetElapsedTime(start));
+
+        Strawberry::ObjectUpdater updater(updateDiff);
+        start = ACE_OS::gettimeofday();
+        Cell::VisitGridObjects(player, updater, m_radius);
+        m_histograms[PERF_GRID_OBJECT_UPDATER].Add(PerfStatsMgr::GetElapsedTime(start));
+        m_objects[PERF_GRID_OBJECT_UPDATER] = updater.i_activeCreatures;
+    }
+
+    // receivers of the last broadcast, counted once outside of the timing
+    std::list<Player*> receivers;
+    Player* last = m_players[(iterations - 1) % m_players.size()];
+    Strawberry::AnyPlayerInObjectRangeCheck check(last, m_radius);
+    Strawberry::PlayerListSearcher<Strawberry::AnyPlayerInObjectRangeCheck> searcher(receivers, check);
+    Cell::VisitWorldObjects(last, searcher, m_radius);
+    m_objects[PERF_GRID_MESSAGE_DIST] = receivers.empty() ? 0 : uint32(receivers.size() - 1);
+}
@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2010-2012 Strawberry-Pr0jcts <http://strawberry-pr0jcts.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * @file PerfGridBenchmark.h
+ * Grid notifier benchmark on a private map filled with synthetic creatures and players.
+ *
+ * The map is created outside of the MapManager, so it is never updated by the map threads and nothing of it is
+ * visible to real clients. Creatures run a NullCreatureAI, players belong to sessions without socket, every packet
+ * the notifiers build is dropped in WorldSession::SendPacket. Densities and iterations are up to the caller.
+ */
+
+#ifndef STRAWBERRY_PERFGRIDBENCHMARK_H
+#define STRAWBERRY_PERFGRIDBENCHMARK_H
+
+#include "Common.h"
+#include "PerfStatsMgr.h"
+#include "GridDefines.h"
+
+class Map;
+class Player;
+struct CreatureInfo;
+
+enum PerfGridStep
+{
+    PERF_GRID_CELL_VISIT        = 0,                        // Cell::VisitAllObjects counting objects only, the baseline
+    PERF_GRID_VISIBLE_NOTIFIER  = 1,                        // Camera::UpdateVisibilityForOwner (VisibleNotifier)
+    PERF_GRID_MESSAGE_DIST      = 2,                        // Map::MessageDistBroadcast (MessageDistDeliverer)
+    PERF_GRID_OBJECT_UPDATER    = 3                         // ObjectUpdater over the grid objects, sleep disabled
+};
+
+#define MAX_PERF_GRID_STEPS       4
+
+/// Counts what a cell visit reaches, so the grid walk is timed without any per object work
+struct PerfGridObjectCounter
+{
+    PerfGridObjectCounter() : i_count(0) {}
+
+    template<class T> void Visit(GridRefManager<T>& m)
+    {
+        for (typename GridRefManager<T>::iterator itr = m.begin(); itr != m.end(); ++itr)
+            ++i_count;
+    }
+
+    uint32 i_count;
+};
+
+class PerfGridBenchmark
+{
+    public:
+        // mapId must be a not instanceable map that is not loaded by the MapManager
+        PerfGridBenchmark(uint32 mapId, float x, float y, float radius);
+        ~PerfGridBenchmark();
+
+        // spawn at random positions on the disc of the benchmark radius, return the number actually added
+        uint32 SpawnCreatures(CreatureInfo const* cinfo, uint32 count);
+        uint32 SpawnPlayers(uint32 count);
+
+        // every iteration runs each step once, centered on the next player of the list
+        void Run(uint32 iterations);
+
+        static char const* GetStepName(PerfGridStep step);
+        PerfHistogram const& GetHistogram(PerfGridStep step) const { return m_histograms[step]; }
+        uint32 GetObjectCount(PerfGridStep step) const { return m_objects[step]; }
+
+        uint32 GetCreatureCount() const { return m_creatureCount; }
+        uint32 GetPlayerCount() const { return uint32(m_players.size()); }
+
+    private:
+        void GetRandomPosition(float& x, float& y, float& o) const;
+
+        Map* m_map;
+        float m_x;
+        float m_y;
+        float m_radius;
+
+        uint32 m_creatureCount;
+        std::vector<Player*> m_players;
+
+        PerfHistogram m_histograms[MAX_PERF_GRID_STEPS];
+        uint32 m_objects[MAX_PERF_GRID_STEPS];              // objects reached by the last iteration of each step
+};
+
+#endif
@@ -0,0 +1,288 @@
+/*
+ * Copyright (C) 2010-2012 Strawberry-Pr0jcts <http://strawberry-pr0jcts.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "PerfStatsMgr.h"
+#include "World.h"
+#include "Opcodes.h"
+#include "Log.h"
+#include "MapManager.h"
+#include "Policies/SingletonImp.h"
+
+INSTANTIATE_SINGLETON_1(PerfStatsMgr);
+
+void PerfHistogram::Add(uint32 usec)
+{
+    uint32 bucket = 0;
+    for (uint32 v = usec; v && bucket < MAX_PERF_HISTOGRAM_BUCKETS - 1; v >>= 1)
+        ++bucket;
+
+    ++m_buckets[bucket];
+    ++m_count;
+    m_total += uint64(usec);
+
+    m_max.SetMax(uint64(usec));
+}
+
+void PerfHistogram::Reset()
+{
+    for (uint32 i = 0; i < MAX_PERF_HISTOGRAM_BUCKETS; ++i)
+        m_buckets[i] = 0;
+
+    m_count = 0;
+    m_total = 0;
+    m_max = 0;
+}
+
+uint32 PerfHistogram::GetAverage() const
+{
+    uint64 count = GetCount();
+    return count ? uint32(GetTotal() / count) : 0;
+}
+
+uint32 PerfHistogram::GetPercentile(uint32 percent) const
+{
+    uint64 count = GetCount();
+    if (!count)
+        return 0;
+
+    uint64 rank = (count * percent + 99) / 100;
+    uint64 seen = 0;
+    for (uint32 i = 0; i < MAX_PERF_HISTOGRAM_BUCKETS - 1; ++i)
+    {
+        seen += m_buckets[i].value();
+        if (seen >= rank)
+            return std::min(uint32(1) << i, GetMax());
+    }
+
+    return GetMax();
+}
+
+void PerfMapStats::Add(PerfProbe probe, uint32 usec)
+{
+    m_phaseTotal[probe - PERF_MAP_SESSIONS] += uint64(usec);
+    m_current += usec;
+}
+
+void PerfMapStats::EndUpdate()
+{
+    m_update.Add(m_current);
+    m_current = 0;
+}
+
+void PerfMapStats::Reset()
+{
+    m_update.Reset();
+    for (uint32 i = 0; i < MAX_PERF_MAP_PHASES; ++i)
+        m_phaseTotal[i] = 0;
+}
+
+PerfStatsMgr::PerfStatsMgr() : m_opcodeSlots(MAX_OPCODE_VALUE + 1), m_enabled(false), m_csvFile(NULL)
+{
+    m_opcodes = new PerfOpcodeStats[m_opcodeSlots];
+}
+
+PerfStatsMgr::~PerfStatsMgr()
+{
+    if (m_csvFile)
+        fclose(m_csvFile);
+
+    delete[] m_opcodes;
+}
+
+void PerfStatsMgr::LoadConfig()
+{
+    m_enabled = sWorld.getConfig(CONFIG_BOOL_PERF_STATS_ENABLE);
+
+    if (m_csvFile)
+    {
+        fclose(m_csvFile);
+        m_csvFile = NULL;
+    }
+
+    uint32 interval = sWorld.getConfig(CONFIG_UINT32_PERF_STATS_CSV_INTERVAL);
+    if (!m_enabled || !interval)
+        return;
+
+    m_csvFile = sLog.openLogFile("PerfStats.CsvFile", NULL, "a");
+    if (!m_csvFile)
+    {
+        sLog.outError("PerfStats.CsvInterval is set but PerfStats.CsvFile can't be opened, periodic dump disabled.");
+        return;
+    }
+
+    fseek(m_csvFile, 0, SEEK_END);
+    if (ftell(m_csvFile) == 0)
+        fprintf(m_csvFile, "time,probe,count,total_us,avg_us,p50_us,p95_us,p99_us,max_us\n");
+
+    m_csvTimer.SetInterval(interval * IN_MILLISECONDS);
+    m_csvTimer.Reset();
+}
+
+void PerfStatsMgr::Update(uint32 diff)
+{
+    if (!m_csvFile)
+        return;
+
+    m_csvTimer.Update(diff);
+    if (!m_csvTimer.Passed())
+        return;
+
+    m_csvTimer.Reset();
+    WriteCsv();
+}
+
+void PerfStatsMgr::Reset()
+{
+    for (uint32 i = 0; i < MAX_PERF_PROBES; ++i)
+        m_probes[i].Reset();
+
+    for (uint32 i = 0; i < m_opcodeSlots; ++i)
+    {
+        PerfOpcodeStats& stats = m_opcodes[i];
+        stats.recvPackets = 0;
+        stats.recvBytes = 0;
+        stats.sentPackets = 0;
+        stats.sentBytes = 0;
+        stats.handlerTime.Reset();
+    }
+
+    MapManager::MapMapType const& maps = sMapMgr.Maps();
+    for (MapManager::MapMapType::const_iterator itr = maps.begin(); itr != maps.end(); ++itr)
+        itr->second->GetPerfStats().Reset();
+}
+
+uint32 PerfStatsMgr::GetOpcodeSlot(uint32 opcode) const
+{
+    // values missing in the opcode table keep a zero enum, tell them apart by the reverse mapping
+    if (opcode < NUM_MSG_TYPES)
+    {
+        Opcodes enumVal = LookupOpcodeEnum(uint16(opcode));
+        if (LookupOpcodeNumber(enumVal) == opcode)
+            return uint32(enumVal);
+    }
+
+    return MAX_OPCODE_VALUE;
+}
+
+char const* PerfStatsMgr::GetOpcodeSlotName(uint32 slot)
+{
+    if (slot >= MAX_OPCODE_VALUE)
+        return "UNKNOWN";
+
+    return LookupOpcodeName(LookupOpcodeNumber(Opcodes(slot)));
+}
+
+void PerfStatsMgr::AddIncomingPacket(uint32 opcode, size_t size)
+{
+    if (!m_enabled)
+        return;
+
+    PerfOpcodeStats& stats = m_opcodes[GetOpcodeSlot(opcode)];
+    ++stats.recvPackets;
+    stats.recvBytes += uint64(size);
+}
+
+void PerfStatsMgr::AddOutgoingPacket(uint32 opcode, size_t size)
+{
+    if (!m_enabled)
+        return;
+
+    PerfOpcodeStats& stats = m_opcodes[GetOpcodeSlot(opcode)];
+    ++stats.sentPackets;
+    stats.sentBytes += uint64(size);
+}
+
+void PerfStatsMgr::AddHandlerSample(uint32 opcode, uint32 usec)
+{
+    m_opcodes[GetOpcodeSlot(opcode)].handlerTime.Add(usec);
+}
+
+uint32 PerfStatsMgr::GetElapsedTime(ACE_Time_Value const& start)
+{
+    ACE_Time_Value elapsed = ACE_OS::gettimeofday() - start;
+    return elapsed > ACE_Time_Value::zero ? uint32(elapsed.sec() * 1000000 + elapsed.usec()) : 0;
+}
+
+void PerfStatsMgr::WriteCsv()
+{
+    uint64 now = uint64(time(NULL));
+
+    // cumulative since start or last reset, consumers diff consecutive rows
+    for (uint32 i = 0; i < MAX_PERF_PROBES; ++i)
+    {
+        PerfHistogram const& hist = m_probes[i];
+        fprintf(m_csvFile, UI64FMTD ",%s," UI64FMTD "," UI64FMTD ",%u,%u,%u,%u,%u\n", now, GetProbeName(PerfProbe(i)),
+            hist.GetCount(), hist.GetTotal(), hist.GetAverage(),
+            hist.GetPercentile(50), hist.GetPercentile(95), hist.GetPercentile(99), hist.GetMax());
+    }
+
+    WriteMapCsv(now);
+
+    fflush(m_csvFile);
+}
+
+void PerfStatsMgr::WriteMapCsv(uint64 now)
+{
+    // one row per loaded map for the whole update, then one per phase with the time spent in it
+    // (count is the number of updates, no percentiles, the name skips the "map." of the probe name);
+    // rows of unloaded instances stop appearing
+    MapManager::MapMapType const& maps = sMapMgr.Maps();
+    for (MapManager::MapMapType::const_iterator itr = maps.begin(); itr != maps.end(); ++itr)
+    {
+        Map* map = itr->second;
+        PerfMapStats const& stats = map->GetPerfStats();
+        PerfHistogram const& hist = stats.GetUpdateHistogram();
+        uint64 count = hist.GetCount();
+        if (!count)
+            continue;
+
+        fprintf(m_csvFile, UI64FMTD ",map.%u.%u," UI64FMTD "," UI64FMTD ",%u,%u,%u,%u,%u\n", now, map->GetId(), map->GetInstanceId(),
+            count, hist.GetTotal(), hist.GetAverage(),
+            hist.GetPercentile(50), hist.GetPercentile(95), hist.GetPercentile(99), hist.GetMax());
+
+        for (uint32 i = 0; i < MAX_PERF_MAP_PHASES; ++i)
+        {
+            uint64 total = stats.GetPhaseTotal(i);
+            fprintf(m_csvFile, UI64FMTD ",map.%u.%u.%s," UI64FMTD "," UI64FMTD ",%u,,,,\n", now, map->GetId(), map->GetInstanceId(),
+                GetProbeName(PerfProbe(PERF_MAP_SESSIONS + i)) + 4, count, total, uint32(total / count));
+        }
+    }
+}
+
+char const* PerfStatsMgr::GetProbeName(PerfProbe probe)
+{
+    switch (probe)
+    {
+        case PERF_WORLD_TICK:           return "world.tick";
+        case PERF_WORLD_SESSIONS:       return "world.sessions";
+        case PERF_WORLD_MAPS:           return "world.maps";
+        case PERF_WORLD_BATTLEGROUNDS:  return "world.battlegrounds";
+        case PERF_WORLD_RESULT_QUEUE:   return "world.resultqueue";
+        case PERF_DB_CHARACTER_QUEUE:   return "db.character";
+        case PERF_DB_WORLD_QUEUE:       return "db.world";
+        case PERF_DB_LOGIN_QUEUE:       return "db.login";
+        case PERF_MAP_SESSIONS:         return "map.sessions";
+        case PERF_MAP_PLAYERS:          return "map.players";
+        case PERF_MAP_CELLS:            return "map.cells";
+        case PERF_MAP_OBJECT_UPDATES:   return "map.objectupdates";
+        case PERF_MAP_GRID_STATES:      return "map.gridstates";
+        case PERF_MAP_SCRIPTS:          return "map.scripts";
+    }
+
+    return "unknown";
+}
@@ -0,0 +1,238 @@
+/*
+ * Copyright (C) 2010-2012 Strawberry-Pr0jcts <http://strawberry-pr0jcts.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * @file PerfStatsMgr.h
+ * Tick profiling: fixed probes around the world and map update phases, and per opcode traffic.
+ *
+ * Every probe and every opcode owns a PerfHistogram of microsecond samples in power of two buckets. Samples
+ * are added with 64 bit atomic operations on each counter, readers (chat command, CSV dump) hold no lock
+ * across counters; a reader may see a sample counted in one field and not yet in another.
+ */
+
+#ifndef STRAWBERRY_PERFSTATSMGR_H
+#define STRAWBERRY_PERFSTATSMGR_H
+
+#include "Common.h"
+#include "Timer.h"
+#include "Policies/Singleton.h"
+#include "Utilities/AtomicCounter.h"
+
+enum PerfProbe
+{
+    PERF_WORLD_TICK             = 0,                        // whole World::Update
+    PERF_WORLD_SESSIONS         = 1,                        // World::UpdateSessions
+    PERF_WORLD_MAPS             = 2,                        // MapManager::Update
+    PERF_WORLD_BATTLEGROUNDS    = 3,                        // BattleGroundMgr::Update
+    PERF_WORLD_RESULT_QUEUE     = 4,                        // World::UpdateResultQueue
+    PERF_DB_CHARACTER_QUEUE     = 5,                        // async callbacks of the character database
+    PERF_DB_WORLD_QUEUE         = 6,                        // async callbacks of the world database
+    PERF_DB_LOGIN_QUEUE         = 7,                        // async callbacks of the login database
+    PERF_MAP_SESSIONS           = 8,                        // Map::Update phases, summed over all maps (per map: PerfMapStats)
+    PERF_MAP_PLAYERS            = 9,
+    PERF_MAP_CELLS              = 10,
+    PERF_MAP_OBJECT_UPDATES     = 11,
+    PERF_MAP_GRID_STATES        = 12,
+    PERF_MAP_SCRIPTS            = 13
+};
+
+#define MAX_PERF_PROBES           14
+#define MAX_PERF_MAP_PHASES       (MAX_PERF_PROBES - PERF_MAP_SESSIONS)
+
+// bucket 0 holds samples below 1 us, bucket N samples in [2^(N-1), 2^N) us, the last one everything above
+#define MAX_PERF_HISTOGRAM_BUCKETS 24
+
+// 64 bit on every platform (long is 32 bit on Windows), byte and us totals pass 2^31 within hours
+typedef AtomicCounter64 PerfCounter;
+
+class PerfHistogram
+{
+    public:
+        PerfHistogram() {}
+
+        void Add(uint32 usec);
+        void Reset();
+
+        uint64 GetCount() const { return m_count.value(); }
+        uint64 GetTotal() const { return m_total.value(); }
+        uint32 GetMax() const { return uint32(m_max.value()); }
+        uint32 GetAverage() const;
+        // upper bound of the bucket holding the given percentile, in us
+        uint32 GetPercentile(uint32 percent) const;
+
+    private:
+        PerfCounter m_buckets[MAX_PERF_HISTOGRAM_BUCKETS];
+        PerfCounter m_count;
+        PerfCounter m_total;
+        PerfCounter m_max;
+};
+
+/// Map::Update of one map: the whole update as a histogram and the time spent in each phase
+class PerfMapStats
+{
+    public:
+        PerfMapStats() : m_current(0) {}
+
+        // probe is one of the PERF_MAP_* phases; only the thread updating the map calls Add and EndUpdate
+        void Add(PerfProbe probe, uint32 usec);
+        void EndUpdate();
+        void Reset();
+
+        PerfHistogram const& GetUpdateHistogram() const { return m_update; }
+        uint64 GetPhaseTotal(uint32 phase) const { return m_phaseTotal[phase].value(); }
+
+    private:
+        PerfHistogram m_update;
+        PerfCounter m_phaseTotal[MAX_PERF_MAP_PHASES];
+        uint32 m_current;                                   // phases of the running update
+};
+
+struct PerfOpcodeStats
+{
+    PerfCounter recvPackets;
+    PerfCounter recvBytes;
+    PerfCounter sentPackets;
+    PerfCounter sentBytes;
+    PerfHistogram handlerTime;
+};
+
+/// Traffic of one WorldSession, updated by the thread owning the session only
+struct PerfSessionCounters
+{
+    PerfSessionCounters() : recvPackets(0), recvBytes(0), sentPackets(0), sentBytes(0),
+        handlerTime(0), maxHandlerTime(0), maxHandlerOpcode(0) {}
+
+    uint32 recvPackets;
+    uint64 recvBytes;
+    uint32 sentPackets;
+    uint64 sentBytes;
+    uint64 handlerTime;                                     // us spent in opcode handlers
+    uint32 maxHandlerTime;                                  // slowest single handler call, us
+    uint32 maxHandlerOpcode;                                // and its opcode
+};
+
+class PerfStatsMgr
+{
+    public:
+        PerfStatsMgr();
+        ~PerfStatsMgr();
+
+        void LoadConfig();
+        void Update(uint32 diff);
+
+        bool IsEnabled() const { return m_enabled; }
+        void AddSample(PerfProbe probe, uint32 usec) { m_probes[probe].Add(usec); }
+        void Reset();
+
+        PerfHistogram const& GetHistogram(PerfProbe probe) const { return m_probes[probe]; }
+        static char const* GetProbeName(PerfProbe probe);
+
+        // opcode accounting, opcode is the wire value; safe from any thread
+        void AddIncomingPacket(uint32 opcode, size_t size);
+        void AddOutgoingPacket(uint32 opcode, size_t size);
+        void AddHandlerSample(uint32 opcode, uint32 usec);
+
+        // one slot per Opcodes enum value plus a last one for values not in the opcode table
+        uint32 GetOpcodeSlotCount() const { return m_opcodeSlots; }
+        PerfOpcodeStats const& GetOpcodeStats(uint32 slot) const { return m_opcodes[slot]; }
+        static char const* GetOpcodeSlotName(uint32 slot);
+
+        static uint32 GetElapsedTime(ACE_Time_Value const& start);
+
+    private:
+        void WriteCsv();
+        void WriteMapCsv(uint64 now);
+        uint32 GetOpcodeSlot(uint32 opcode) const;
+
+        PerfHistogram m_probes[MAX_PERF_PROBES];
+        PerfOpcodeStats* m_opcodes;
+        uint32 m_opcodeSlots;
+        bool m_enabled;
+
+        FILE* m_csvFile;
+        IntervalTimer m_csvTimer;
+};
+
+#define sPerfStatsMgr Strawberry::Singleton<PerfStatsMgr>::Instance()
+
+/**
+ * Measures consecutive phases of one function. Next() closes the running phase and opens the
+ * following one, so a function split in phases pays one clock read per phase boundary. The
+ * running phase is closed by Stop() or the destructor. Does nothing while profiling is disabled.
+ */
+class PerfTimer
+{
+    public:
+        // samples of PERF_MAP_* probes are also added to mapStats when given
+        explicit PerfTimer(PerfProbe probe, PerfMapStats* mapStats = NULL)
+            : m_probe(probe), m_active(sPerfStatsMgr.IsEnabled()), m_mapStats(mapStats)
+        {
+            if (m_active)
+                m_start = ACE_OS::gettimeofday();
+        }
+
+        ~PerfTimer() { Stop(); }
+
+        // reopens a stopped timer for another probe
+        void Start(PerfProbe probe)
+        {
+            Stop();
+            m_probe = probe;
+            m_active = sPerfStatsMgr.IsEnabled();
+            if (m_active)
+                m_start = ACE_OS::gettimeofday();
+        }
+
+        void Next(PerfProbe probe)
+        {
+            if (!m_active)
+                return;
+
+            ACE_Time_Value now = ACE_OS::gettimeofday();
+            Record(now);
+            m_probe = probe;
+            m_start = now;
+        }
+
+        void Stop()
+        {
+            if (!m_active)
+                return;
+
+            Record(ACE_OS::gettimeofday());
+            m_active = false;
+        }
+
+    private:
+        void Record(ACE_Time_Value const& now)
+        {
+            // wall clock may step back, such samples are counted as 0
+            ACE_Time_Value elapsed = now - m_start;
+            uint32 usec = elapsed > ACE_Time_Value::zero ? uint32(elapsed.sec() * 1000000 + elapsed.usec()) : 0;
+            sPerfStatsMgr.AddSample(m_probe, usec);
+            if (m_mapStats)
+                m_mapStats->Add(m_probe, usec);
+        }
+
+        PerfProbe m_probe;
+        bool m_active;
+        PerfMapStats* m_mapStats;
+        ACE_Time_Value m_start;
+};
+
+#endif
@@ -16416,6 +16416,11 @@ void Player::_LoadMailedItems(QueryResult *result)
         Mail* mail = GetMail(mail_id);
         if(!mail)
             continue;
+
+        // already loaded, mail added after login can be also loaded at relogin
+        if (GetMItem(item_guid_low))
+            continue;
+
         mail->AddItem(item_guid_low, item_template);
 
         ItemPrototype const *proto = ObjectMgr::GetItemPrototype(item_template);
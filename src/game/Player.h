@@ -418,14 +418,6 @@ struct EnchantDuration
 typedef std::list<EnchantDuration> EnchantDurationList;
 typedef std::list<Item*> ItemDurationList;
 
-enum LfgRoles
-{
-    LEADER  = 0x01,
-    TANK    = 0x02,
-    HEALER  = 0x04,
-    DAMAGE  = 0x08
-};
-
 enum RaidGroupError
 {
     ERR_RAID_GROUP_NONE                 = 0,
@@ -1574,6 +1566,7 @@ class Player : public Unit
         void RemoveMail(uint32 id);
 
         void AddMail(Mail* mail) { m_mail.push_front(mail);}// for call from WorldSession::SendMailTo
+        void LoadMailedItems(QueryResult* result) { _LoadMailedItems(result); }// for mails added after login
         uint32 GetMailSize() { return m_mail.size(); }
         Mail* GetMail(uint32 id);
 
@@ -33,6 +33,7 @@
 #include "NPCHandler.h"
 #include "Pet.h"
 #include "MapManager.h"
+#include "QueryResponseCache.h"
 
 void WorldSession::SendNameCacheOpcode(Player *p)
 {
@@ -158,11 +159,18 @@ void WorldSession::HandleCreatureStatsOpcode( WorldPacket & recv_data )
     {
         int loc_idx = GetSessionDbLocaleIndex();
 
+        DETAIL_LOG("WORLD: CMSG_CREATURE_STATS '%s' - Entry: %u.", ci->Name, entry);
+
+        if (WorldPacket const* cached = sQueryResponseCache.Find(QUERY_RESPONSE_CREATURE, entry, loc_idx))
+        {
+            SendPacket(cached);
+            return;
+        }
+
         char const* name = ci->Name;
         char const* subName = ci->SubName;
         sObjectMgr.GetCreatureLocaleStrings(entry, loc_idx, &name, &subName);
 
-        DETAIL_LOG("WORLD: CMSG_CREATURE_STATS '%s' - Entry: %u.", ci->Name, entry);
                                                             // guess size
         WorldPacket data( SMSG_CREATURE_STATS, 100 );
         data << uint32(entry);                              // creature entry
@@ -191,7 +199,7 @@ void WorldSession::HandleCreatureStatsOpcode( WorldPacket & recv_data )
             data << uint32(ci->questItems[i]);              // itemId[6], quest drop
         data << uint32(ci->movementId);                     // CreatureMovementInfo.dbc
         data << uint32(ci->Unknown);
-        SendPacket( &data );
+        SendPacket(sQueryResponseCache.Store(QUERY_RESPONSE_CREATURE, entry, loc_idx, data));
         DEBUG_LOG( "WORLD: Sent SMSG_CREATURE_STATS" );
     }
     else
@@ -216,6 +224,16 @@ void WorldSession::HandleGameObjectStatsOpcode( WorldPacket & recv_data )
     const GameObjectInfo *info = ObjectMgr::GetGameObjectInfo(entryID);
     if(info)
     {
+        int loc_idx = GetSessionDbLocaleIndex();
+
+        DETAIL_LOG("WORLD: CMSG_GAME_OBJECT_STATS '%s' - Entry: %u. ", info->name, entryID);
+
+        if (WorldPacket const* cached = sQueryResponseCache.Find(QUERY_RESPONSE_GAMEOBJECT, entryID, loc_idx))
+        {
+            SendPacket(cached);
+            return;
+        }
+
         std::string Name;
         std::string IconName;
         std::string CastBarCaption;
@@ -224,7 +242,6 @@ void WorldSession::HandleGameObjectStatsOpcode( WorldPacket & recv_data )
         IconName = info->IconName;
         CastBarCaption = info->castBarCaption;
 
-        int loc_idx = GetSessionDbLocaleIndex();
         if (loc_idx >= 0)
         {
             GameObjectLocale const *gl = sObjectMgr.GetGameObjectLocale(entryID);
@@ -236,7 +253,6 @@ void WorldSession::HandleGameObjectStatsOpcode( WorldPacket & recv_data )
                     CastBarCaption = gl->CastBarCaption[loc_idx];
             }
         }
-        DETAIL_LOG("WORLD: CMSG_GAME_OBJECT_STATS '%s' - Entry: %u. ", info->name, entryID);
         WorldPacket data (SMSG_GAME_OBJECT_STATS, 150);
         data << uint32(entryID);
         data << uint32(info->type);
@@ -253,7 +269,7 @@ void WorldSession::HandleGameObjectStatsOpcode( WorldPacket & recv_data )
             data << uint32(info->questItems[i]);            // itemId[6], quest drop
 
         data << uint32(info->Unknown);
-        SendPacket( &data );
+        SendPacket(sQueryResponseCache.Store(QUERY_RESPONSE_GAMEOBJECT, entryID, loc_idx, data));
         DEBUG_LOG( "WORLD: Sent SMSG_GAME_OBJECT_STATS" );
     }
     else
@@ -330,6 +346,14 @@ void WorldSession::HandleNpcTextQueryOpcode( WorldPacket & recv_data )
 
     _player->SetTargetGuid(guid);
 
+    int loc_idx = GetSessionDbLocaleIndex();
+
+    if (WorldPacket const* cached = sQueryResponseCache.Find(QUERY_RESPONSE_NPC_TEXT, textID, loc_idx))
+    {
+        SendPacket(cached);
+        return;
+    }
+
     GossipText const* pGossip = sObjectMgr.GetGossipText(textID);
 
     WorldPacket data( SMSG_NPC_CACHE, 100 );          // guess size
@@ -350,6 +374,9 @@ void WorldSession::HandleNpcTextQueryOpcode( WorldPacket & recv_data )
             data << uint32(0);
             data << uint32(0);
         }
+
+        // not cached, any text id can be asked for
+        SendPacket(&data);
     }
     else
     {
@@ -360,8 +387,6 @@ void WorldSession::HandleNpcTextQueryOpcode( WorldPacket & recv_data )
             Text_1[i]=pGossip->Options[i].Text_1;
         }
 
-        int loc_idx = GetSessionDbLocaleIndex();
-
         sObjectMgr.GetNpcTextLocaleStringsAll(textID, loc_idx, &Text_0, &Text_1);
 
         for (int i = 0; i < MAX_GOSSIP_TEXT_OPTIONS; ++i)
@@ -386,9 +411,9 @@ void WorldSession::HandleNpcTextQueryOpcode( WorldPacket & recv_data )
                 data << pGossip->Options[i].Emotes[j]._Emote;
             }
         }
-    }
 
-    SendPacket( &data );
+        SendPacket(sQueryResponseCache.Store(QUERY_RESPONSE_NPC_TEXT, textID, loc_idx, data));
+    }
 
     DEBUG_LOG( "WORLD: Sent SMSG_NPC_CACHE" );
 }
@@ -402,9 +427,19 @@ void WorldSession::HandlePageTextQueryOpcode( WorldPacket & recv_data )
     recv_data >> pageID;
     recv_data.read_skip<uint64>();                          // guid
 
+    int loc_idx = GetSessionDbLocaleIndex();
+
     while (pageID)
     {
         PageText const *pPage = sPageTextStore.LookupEntry<PageText>( pageID );
+
+        WorldPacket const* cached = pPage ? sQueryResponseCache.Find(QUERY_RESPONSE_PAGE_TEXT, pageID, loc_idx) : NULL;
+        if (cached)
+        {
+            SendPacket(cached);
+            pageID = pPage->Next_Page;
+            continue;
+        }
                                                             // guess size
         WorldPacket data(SMSG_PAGE_TEXT_CACHE, 50);
         data << pageID;
@@ -414,12 +449,12 @@ void WorldSession::HandlePageTextQueryOpcode( WorldPacket & recv_data )
             data << "Item page missing.";
             data << uint32(0);
             pageID = 0;
+            SendPacket( &data );
         }
         else
         {
             std::string Text = pPage->Text;
 
-            int loc_idx = GetSessionDbLocaleIndex();
             if (loc_idx >= 0)
             {
                 PageTextLocale const *pl = sObjectMgr.GetPageTextLocale(pageID);
@@ -432,9 +467,9 @@ void WorldSession::HandlePageTextQueryOpcode( WorldPacket & recv_data )
 
             data << Text;
             data << uint32(pPage->Next_Page);
+            SendPacket(sQueryResponseCache.Store(QUERY_RESPONSE_PAGE_TEXT, pageID, loc_idx, data));
             pageID = pPage->Next_Page;
         }
-        SendPacket( &data );
 
         DEBUG_LOG("WORLD: Sent SMSG_PAGE_TEXT_CACHE");
     }
@@ -502,30 +537,41 @@ void WorldSession::HandleQuestPOIQueryOpcode(WorldPacket& recv_data)
 
         if(questOk)
         {
+            // quest block does not depend on locale
+            if (WorldPacket const* cached = sQueryResponseCache.Find(QUERY_RESPONSE_QUEST_POI, questId, -1))
+            {
+                data.append(*cached);
+                continue;
+            }
+
             QuestPOIVector const *POI = sObjectMgr.GetQuestPOIVector(questId);
 
+            // only quests with POI data are cached
+            WorldPacket block;
             if(POI)
             {
-                data << uint32(questId);                    // quest ID
-                data << uint32(POI->size());                // POI count
+                block << uint32(questId);                   // quest ID
+                block << uint32(POI->size());               // POI count
 
                 for(QuestPOIVector::const_iterator itr = POI->begin(); itr != POI->end(); ++itr)
                 {
-                    data << uint32(itr->PoiId);             // POI index
-                    data << int32(itr->ObjectiveIndex);     // objective index
-                    data << uint32(itr->MapId);             // mapid
-                    data << uint32(itr->MapAreaId);         // world map area id
-                    data << uint32(itr->FloorId);           // floor id
-                    data << uint32(itr->Unk3);              // unknown
-                    data << uint32(itr->Unk4);              // unknown
-                    data << uint32(itr->points.size());     // POI points count
+                    block << uint32(itr->PoiId);            // POI index
+                    block << int32(itr->ObjectiveIndex);    // objective index
+                    block << uint32(itr->MapId);            // mapid
+                    block << uint32(itr->MapAreaId);        // world map area id
+                    block << uint32(itr->FloorId);          // floor id
+                    block << uint32(itr->Unk3);             // unknown
+                    block << uint32(itr->Unk4);             // unknown
+                    block << uint32(itr->points.size());    // POI points count
 
                     for(std::vector<QuestPOIPoint>::const_iterator itr2 = itr->points.begin(); itr2 != itr->points.end(); ++itr2)
                     {
-                        data << int32(itr2->x);             // POI point x
-                        data << int32(itr2->y);             // POI point y
+                        block << int32(itr2->x);            // POI point x
+                        block << int32(itr2->y);            // POI point y
                     }
                 }
+
+                data.append(*sQueryResponseCache.Store(QUERY_RESPONSE_QUEST_POI, questId, -1, block));
             }
             else
             {
@@ -0,0 +1,41 @@
+/*
+ * Copyright (C) 2010-2012 Strawberry-Pr0jcts <http://strawberry-pr0jcts.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "QueryResponseCache.h"
+#include "Policies/SingletonImp.h"
+
+INSTANTIATE_SINGLETON_1(QueryResponseCache);
+
+WorldPacket const* QueryResponseCache::Find(QueryResponseType type, uint32 entry, int locIdx) const
+{
+    ResponseMap::const_iterator itr = m_responses[type].find(MakeKey(entry, locIdx));
+    return itr != m_responses[type].end() ? &itr->second : NULL;
+}
+
+WorldPacket const* QueryResponseCache::Store(QueryResponseType type, uint32 entry, int locIdx, WorldPacket const& packet)
+{
+    WorldPacket& stored = m_responses[type][MakeKey(entry, locIdx)];
+    stored = packet;
+    return &stored;
+}
+
+void QueryResponseCache::Clear()
+{
+    for (int i = 0; i < MAX_QUERY_RESPONSE_TYPES; ++i)
+        m_responses[i].clear();
+}
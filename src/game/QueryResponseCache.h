@@ -0,0 +1,64 @@
+/*
+ * Copyright (C) 2010-2012 Strawberry-Pr0jcts <http://strawberry-pr0jcts.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef STRAWBERRY_QUERYRESPONSECACHE_H
+#define STRAWBERRY_QUERYRESPONSECACHE_H
+
+#include "Common.h"
+#include "Policies/Singleton.h"
+#include "WorldPacket.h"
+
+enum QueryResponseType
+{
+    QUERY_RESPONSE_CREATURE     = 0,                        // SMSG_CREATURE_STATS
+    QUERY_RESPONSE_GAMEOBJECT   = 1,                        // SMSG_GAME_OBJECT_STATS
+    QUERY_RESPONSE_NPC_TEXT     = 2,                        // SMSG_NPC_CACHE
+    QUERY_RESPONSE_PAGE_TEXT    = 3,                        // SMSG_PAGE_TEXT_CACHE
+    QUERY_RESPONSE_QUEST_POI    = 4                         // one quest block of SMSG_QUEST_POI_QUERY_RESPONSE
+};
+
+#define MAX_QUERY_RESPONSE_TYPES 5
+
+/**
+ * Serialized replies to the static query opcodes, kept per entry and db locale index.
+ * Replies are built on first request and sent as is afterwards. Only used from the
+ * world thread (query opcodes are PROCESS_THREADUNSAFE), emptied by the .reload
+ * commands of the tables they are built from.
+ */
+class QueryResponseCache
+{
+    public:
+        WorldPacket const* Find(QueryResponseType type, uint32 entry, int locIdx) const;
+        WorldPacket const* Store(QueryResponseType type, uint32 entry, int locIdx, WorldPacket const& packet);
+
+        void Clear(QueryResponseType type) { m_responses[type].clear(); }
+        void Clear();
+
+        size_t GetSize(QueryResponseType type) const { return m_responses[type].size(); }
+
+    private:
+        // db locale index is -1 for default locale
+        static uint64 MakeKey(uint32 entry, int locIdx) { return (uint64(entry) << 8) | uint8(locIdx + 1); }
+
+        typedef UNORDERED_MAP<uint64, WorldPacket> ResponseMap;
+        ResponseMap m_responses[MAX_QUERY_RESPONSE_TYPES];
+};
+
+#define sQueryResponseCache Strawberry::Singleton<QueryResponseCache>::Instance()
+
+#endif
@@ -35,6 +35,7 @@ class ReactorAI : public CreatureAI
         void AttackStart(Unit *);
         void EnterEvadeMode();
         bool IsVisible(Unit *) const;
+        bool CanSleep() const { return true; }
 
         void UpdateAI(const uint32);
         static int Permissible(const Creature *);
@@ -46,6 +46,7 @@
 #include "Util.h"
 #include "Vehicle.h"
 #include "Chat.h"
+#include "Policies/MemoryStats.h"
 
 extern pEffect SpellEffects[TOTAL_SPELL_EFFECTS];
 
@@ -1822,7 +1823,7 @@ void Spell::SetTargetMap(SpellEffectIndex effIndex, uint32 targetMode, UnitList&
             {
                 Strawberry::AnyAoETargetUnitInObjectRangeCheck u_check(m_caster, max_range);
                 Strawberry::UnitListSearcher<Strawberry::AnyAoETargetUnitInObjectRangeCheck> searcher(tempTargetUnitMap, u_check);
-                Cell::VisitAllObjects(m_caster, searcher, max_range);
+                Cell::VisitAllUnits(m_caster, searcher, max_range);
             }
 
             if(tempTargetUnitMap.empty())
@@ -1882,7 +1883,7 @@ void Spell::SetTargetMap(SpellEffectIndex effIndex, uint32 targetMode, UnitList&
             {
                 Strawberry::AnyFriendlyUnitInObjectRangeCheck u_check(m_caster, max_range);
                 Strawberry::UnitListSearcher<Strawberry::AnyFriendlyUnitInObjectRangeCheck> searcher(tempTargetUnitMap, u_check);
-                Cell::VisitAllObjects(m_caster, searcher, max_range);
+                Cell::VisitAllUnits(m_caster, searcher, max_range);
             }
 
             if(tempTargetUnitMap.empty())
@@ -2951,6 +2952,8 @@ void Spell::SetTargetMap(SpellEffectIndex effIndex, uint32 targetMode, UnitList&
 
 void Spell::prepare(SpellCastTargets const* targets, Aura* triggeredByAura)
 {
+    MemoryTagScope memoryTag(MEMORY_TAG_SPELLS);
+
     m_targets = *targets;
 
     m_spellState = SPELL_STATE_PREPARING;
@@ -3087,6 +3090,8 @@ void Spell::cancel()
 
 void Spell::cast(bool skipCheck)
 {
+    MemoryTagScope memoryTag(MEMORY_TAG_SPELLS);
+
     SetExecutedCurrently(true);
 
     if (!m_caster->CheckAndIncreaseCastCounter())
@@ -3554,6 +3559,8 @@ void Spell::SendSpellCooldown()
 
 void Spell::update(uint32 difftime)
 {
+    MemoryTagScope memoryTag(MEMORY_TAG_SPELLS);
+
     // update pointers based at it's GUIDs
     UpdatePointers();
 
@@ -7398,7 +7405,45 @@ SpellCastResult Spell::CanOpenLock(SpellEffectIndex effIndex, uint32 lockId, Ski
 void Spell::FillAreaTargets(UnitList &targetUnitMap, float radius, SpellNotifyPushType pushType, SpellTargets spellTargets, WorldObject* originalCaster /*=NULL*/)
 {
     Strawberry::SpellNotifierCreatureAndPlayer notifier(*this, targetUnitMap, radius, pushType, spellTargets, originalCaster);
-    Cell::VisitAllObjects(notifier.GetCenterX(), notifier.GetCenterY(), m_caster->GetMap(), notifier, radius);
+
+    Map* map = m_caster->GetMap();
+    if (!map->GetUnitIndex().IsEnabled() || !notifier.i_originalCaster || !notifier.i_castingObject)
+    {
+        Cell::VisitAllObjects(notifier.GetCenterX(), notifier.GetCenterY(), map, notifier, radius);
+        return;
+    }
+
+    // the notifier does the exact checks, the index only drops what is out of reach: the radius plus
+    // the bounding radius of the object in the center, the one of the unit is added by the index
+    WorldObject const* center = NULL;
+    float arc = 0.0f;
+    switch (pushType)
+    {
+        case PUSH_IN_FRONT:     arc = 2 * M_PI_F / 3;   center = notifier.i_castingObject; break;
+        case PUSH_IN_FRONT_90:  arc = M_PI_F / 2;       center = notifier.i_castingObject; break;
+        case PUSH_IN_FRONT_30:  arc = M_PI_F / 6;       center = notifier.i_castingObject; break;
+        case PUSH_IN_FRONT_15:  arc = M_PI_F / 12;      center = notifier.i_castingObject; break;
+        case PUSH_IN_BACK:
+        case PUSH_SELF_CENTER:  center = notifier.i_castingObject; break;
+        case PUSH_TARGET_CENTER: center = m_targets.getUnitTarget(); break;
+        default: break;
+    }
+
+    if (pushType == PUSH_TARGET_CENTER && !center)          // nothing passes the exact check without target
+        return;
+
+    float reach = radius + (center ? center->GetObjectBoundingRadius() : 0.0f);
+    uint32 phaseMask = notifier.i_originalCaster->GetPhaseMask();
+
+    UnitSpatialIndex::UnitVector units;
+    if (arc > 0.0f)
+        map->GetUnitIndex().FindInCone(center->GetPositionX(), center->GetPositionY(), center->GetPositionZ(), center->GetOrientation(),
+            arc, reach, phaseMask, units);
+    else
+        map->GetUnitIndex().FindInRadius(notifier.GetCenterX(), notifier.GetCenterY(), 0.0f, reach, phaseMask, false, units);
+
+    for (UnitSpatialIndex::UnitVector::const_iterator itr = units.begin(); itr != units.end(); ++itr)
+        notifier.VisitUnit(*itr);
 }
 
 void Spell::FillRaidOrPartyTargets(UnitList &targetUnitMap, Unit* member, Unit* center, float radius, bool raid, bool withPets, bool withcaster)
@@ -752,97 +752,101 @@ namespace Strawberry
         }
 
         template<class T> inline void Visit(GridRefManager<T>  &m)
+        {
+            for(typename GridRefManager<T>::iterator itr = m.begin(); itr != m.end(); ++itr)
+                VisitUnit(itr->getSource());
+        }
+
+        // also called for the candidates of the map unit index, see Spell::FillAreaTargets
+        void VisitUnit(Unit* unit)
         {
             STRAWBERRY_ASSERT(i_data);
 
             if (!i_originalCaster || !i_castingObject)
                 return;
 
-            for(typename GridRefManager<T>::iterator itr = m.begin(); itr != m.end(); ++itr)
-            {
-                // there are still more spells which can be casted on dead, but
-                // they are no AOE and don't have such a nice SPELL_ATTR flag
-                if ( (i_TargetType != SPELL_TARGETS_ALL && !itr->getSource()->isTargetableForAttack(i_spell.m_spellInfo->AttributesEx3 & SPELL_ATTR_EX3_CAST_ON_DEAD))
-                    // mostly phase check
-                    || !itr->getSource()->IsInMap(i_originalCaster))
-                    continue;
+            // there are still more spells which can be casted on dead, but
+            // they are no AOE and don't have such a nice SPELL_ATTR flag
+            if ( (i_TargetType != SPELL_TARGETS_ALL && !unit->isTargetableForAttack(i_spell.m_spellInfo->AttributesEx3 & SPELL_ATTR_EX3_CAST_ON_DEAD))
+                // mostly phase check
+                || !unit->IsInMap(i_originalCaster))
+                return;
 
-                switch (i_TargetType)
+            switch (i_TargetType)
+            {
+                case SPELL_TARGETS_HOSTILE:
+                    if (!i_originalCaster->IsHostileTo( unit ))
+                        return;
+                    break;
+                case SPELL_TARGETS_NOT_FRIENDLY:
+                    if (i_originalCaster->IsFriendlyTo( unit ))
+                        return;
+                    break;
+                case SPELL_TARGETS_NOT_HOSTILE:
+                    if (i_originalCaster->IsHostileTo( unit ))
+                        return;
+                    break;
+                case SPELL_TARGETS_FRIENDLY:
+                    if (!i_originalCaster->IsFriendlyTo( unit ))
+                        return;
+                    break;
+                case SPELL_TARGETS_AOE_DAMAGE:
                 {
-                    case SPELL_TARGETS_HOSTILE:
-                        if (!i_originalCaster->IsHostileTo( itr->getSource() ))
-                            continue;
-                        break;
-                    case SPELL_TARGETS_NOT_FRIENDLY:
-                        if (i_originalCaster->IsFriendlyTo( itr->getSource() ))
-                            continue;
-                        break;
-                    case SPELL_TARGETS_NOT_HOSTILE:
-                        if (i_originalCaster->IsHostileTo( itr->getSource() ))
-                            continue;
-                        break;
-                    case SPELL_TARGETS_FRIENDLY:
-                        if (!i_originalCaster->IsFriendlyTo( itr->getSource() ))
-                            continue;
-                        break;
-                    case SPELL_TARGETS_AOE_DAMAGE:
+                    if (unit->GetTypeId()==TYPEID_UNIT && ((Creature*)unit)->IsTotem())
+                        return;
+
+                    if (i_playerControlled)
                     {
-                        if (itr->getSource()->GetTypeId()==TYPEID_UNIT && ((Creature*)itr->getSource())->IsTotem())
-                            continue;
-
-                        if (i_playerControlled)
-                        {
-                            if (i_originalCaster->IsFriendlyTo( itr->getSource() ))
-                                continue;
-                        }
-                        else
-                        {
-                            if (!i_originalCaster->IsHostileTo( itr->getSource() ))
-                                continue;
-                        }
+                        if (i_originalCaster->IsFriendlyTo( unit ))
+                            return;
+                    }
+                    else
+                    {
+                        if (!i_originalCaster->IsHostileTo( unit ))
+                            return;
                     }
-                    break;
-                    case SPELL_TARGETS_ALL:
-                        break;
-                    default: continue;
                 }
+                break;
+                case SPELL_TARGETS_ALL:
+                    break;
+                default: return;
+            }
 
-                // we don't need to check InMap here, it's already done some lines above
-                switch(i_push_type)
-                {
-                    case PUSH_IN_FRONT:
-                        if (i_castingObject->isInFront((Unit*)(itr->getSource()), i_radius, 2*M_PI_F/3 ))
-                            i_data->push_back(itr->getSource());
-                        break;
-                    case PUSH_IN_FRONT_90:
-                        if (i_castingObject->isInFront((Unit*)(itr->getSource()), i_radius, M_PI_F/2 ))
-                            i_data->push_back(itr->getSource());
-                        break;
-                    case PUSH_IN_FRONT_30:
-                        if (i_castingObject->isInFront((Unit*)(itr->getSource()), i_radius, M_PI_F/6 ))
-                            i_data->push_back(itr->getSource());
-                        break;
-                    case PUSH_IN_FRONT_15:
-                        if (i_castingObject->isInFront((Unit*)(itr->getSource()), i_radius, M_PI_F/12 ))
-                            i_data->push_back(itr->getSource());
-                        break;
-                    case PUSH_IN_BACK:
-                        if (i_castingObject->isInBack((Unit*)(itr->getSource()), i_radius, 2*M_PI_F/3 ))
-                            i_data->push_back(itr->getSource());
-                        break;
-                    case PUSH_SELF_CENTER:
-                        if (i_castingObject->IsWithinDist((Unit*)(itr->getSource()), i_radius))
-                            i_data->push_back(itr->getSource());
-                        break;
-                    case PUSH_DEST_CENTER:
-                        if (itr->getSource()->IsWithinDist3d(i_spell.m_targets.m_destX, i_spell.m_targets.m_destY, i_spell.m_targets.m_destZ,i_radius))
-                            i_data->push_back(itr->getSource());
-                        break;
-                    case PUSH_TARGET_CENTER:
-                        if (i_spell.m_targets.getUnitTarget() && i_spell.m_targets.getUnitTarget()->IsWithinDist((Unit*)(itr->getSource()), i_radius))
-                            i_data->push_back(itr->getSource());
-                        break;
-                }
+            // we don't need to check InMap here, it's already done some lines above
+            switch(i_push_type)
+            {
+                case PUSH_IN_FRONT:
+                    if (i_castingObject->isInFront(unit, i_radius, 2*M_PI_F/3 ))
+                        i_data->push_back(unit);
+                    break;
+                case PUSH_IN_FRONT_90:
+                    if (i_castingObject->isInFront(unit, i_radius, M_PI_F/2 ))
+                        i_data->push_back(unit);
+                    break;
+                case PUSH_IN_FRONT_30:
+                    if (i_castingObject->isInFront(unit, i_radius, M_PI_F/6 ))
+                        i_data->push_back(unit);
+                    break;
+                case PUSH_IN_FRONT_15:
+                    if (i_castingObject->isInFront(unit, i_radius, M_PI_F/12 ))
+                        i_data->push_back(unit);
+                    break;
+                case PUSH_IN_BACK:
+                    if (i_castingObject->isInBack(unit, i_radius, 2*M_PI_F/3 ))
+                        i_data->push_back(unit);
+                    break;
+                case PUSH_SELF_CENTER:
+                    if (i_castingObject->IsWithinDist(unit, i_radius))
+                        i_data->push_back(unit);
+                    break;
+                case PUSH_DEST_CENTER:
+                    if (unit->IsWithinDist3d(i_spell.m_targets.m_destX, i_spell.m_targets.m_destY, i_spell.m_targets.m_destZ,i_radius))
+                        i_data->push_back(unit);
+                    break;
+                case PUSH_TARGET_CENTER:
+                    if (i_spell.m_targets.getUnitTarget() && i_spell.m_targets.getUnitTarget()->IsWithinDist(unit, i_radius))
+                        i_data->push_back(unit);
+                    break;
             }
         }
 
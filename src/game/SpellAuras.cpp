@@ -661,14 +661,14 @@ void AreaAura::Update(uint32 diff)
                 {
                     Strawberry::AnyFriendlyUnitInObjectRangeCheck u_check(caster, m_radius);
                     Strawberry::UnitListSearcher<Strawberry::AnyFriendlyUnitInObjectRangeCheck> searcher(targets, u_check);
-                    Cell::VisitAllObjects(caster, searcher, m_radius);
+                    Cell::VisitAllUnits(caster, searcher, m_radius);
                     break;
                 }
                 case AREA_AURA_ENEMY:
                 {
                     Strawberry::AnyAoETargetUnitInObjectRangeCheck u_check(caster, m_radius); // No GetCharmer in searcher
                     Strawberry::UnitListSearcher<Strawberry::AnyAoETargetUnitInObjectRangeCheck> searcher(targets, u_check);
-                    Cell::VisitAllObjects(caster, searcher, m_radius);
+                    Cell::VisitAllUnits(caster, searcher, m_radius);
                     break;
                 }
                 case AREA_AURA_OWNER:
@@ -8071,7 +8071,7 @@ void Aura::PeriodicDummyTick()
 
                         Strawberry::AnyUnfriendlyVisibleUnitInObjectRangeCheck u_check(target, target, radius);
                         Strawberry::UnitListSearcher<Strawberry::AnyUnfriendlyVisibleUnitInObjectRangeCheck> checker(targets, u_check);
-                        Cell::VisitAllObjects(target, checker, radius);
+                        Cell::VisitAllUnits(target, checker, radius);
                     }
 
                     if(targets.empty())
@@ -26,6 +26,8 @@
 #include "ObjectAccessor.h"
 #include "UnitEvents.h"
 
+#include <algorithm>
+
 //==============================================================
 //================= ThreatCalcHelper ===========================
 //==============================================================
@@ -65,6 +67,8 @@ HostileReference::HostileReference(Unit* pUnit, ThreatManager *pThreatManager, f
     iUnitGuid = pUnit->GetObjectGuid();
     iOnline = true;
     iAccessible = true;
+    iHeapIndex = 0;
+    iSequence = 0;
 }
 
 //============================================================
@@ -211,21 +215,120 @@ Unit* HostileReference::getSourceUnit()
 
 void ThreatContainer::clearReferences()
 {
-    for(ThreatList::const_iterator i = iThreatList.begin(); i != iThreatList.end(); ++i)
+    for(ThreatHeap::const_iterator i = iThreatHeap.begin(); i != iThreatHeap.end(); ++i)
     {
         (*i)->unlink();
         delete (*i);
     }
+    iThreatHeap.clear();
     iThreatList.clear();
 }
 
+//============================================================
+
+bool ThreatContainer::isBefore(HostileReference const* pLeft, HostileReference const* pRight)
+{
+    if (pLeft->getThreat() != pRight->getThreat())
+        return pLeft->getThreat() > pRight->getThreat();
+
+    return pLeft->iSequence < pRight->iSequence;
+}
+
+void ThreatContainer::swapEntries(uint32 pIndexA, uint32 pIndexB)
+{
+    std::swap(iThreatHeap[pIndexA], iThreatHeap[pIndexB]);
+    iThreatHeap[pIndexA]->iHeapIndex = pIndexA;
+    iThreatHeap[pIndexB]->iHeapIndex = pIndexB;
+}
+
+void ThreatContainer::siftUp(uint32 pIndex)
+{
+    while (pIndex > 0)
+    {
+        uint32 parent = (pIndex - 1) / 2;
+        if (!isBefore(iThreatHeap[pIndex], iThreatHeap[parent]))
+            break;
+
+        swapEntries(pIndex, parent);
+        pIndex = parent;
+    }
+}
+
+void ThreatContainer::siftDown(uint32 pIndex)
+{
+    uint32 size = iThreatHeap.size();
+    for (;;)
+    {
+        uint32 best = pIndex;
+        uint32 left = 2 * pIndex + 1;
+        uint32 right = left + 1;
+
+        if (left < size && isBefore(iThreatHeap[left], iThreatHeap[best]))
+            best = left;
+        if (right < size && isBefore(iThreatHeap[right], iThreatHeap[best]))
+            best = right;
+        if (best == pIndex)
+            break;
+
+        swapEntries(pIndex, best);
+        pIndex = best;
+    }
+}
+
+//============================================================
+
+void ThreatContainer::addReference(HostileReference* pHostileReference)
+{
+    pHostileReference->iSequence = iNextSequence++;
+    pHostileReference->iListPos = iThreatList.insert(iThreatList.end(), pHostileReference);
+    pHostileReference->iHeapIndex = iThreatHeap.size();
+    iThreatHeap.push_back(pHostileReference);
+    siftUp(pHostileReference->iHeapIndex);
+    iDirty = true;
+}
+
+//============================================================
+
+void ThreatContainer::remove(HostileReference* pRef)
+{
+    uint32 index = pRef->iHeapIndex;
+    if (index >= iThreatHeap.size() || iThreatHeap[index] != pRef)
+        return;                                             // not in this container
+
+    iThreatList.erase(pRef->iListPos);
+
+    uint32 last = iThreatHeap.size() - 1;
+    if (index != last)
+        swapEntries(index, last);
+    iThreatHeap.pop_back();
+
+    if (index < iThreatHeap.size())
+    {
+        siftUp(index);
+        siftDown(index);
+    }
+}
+
+//============================================================
+
+void ThreatContainer::threatChanged(HostileReference* pRef)
+{
+    uint32 index = pRef->iHeapIndex;
+    if (index >= iThreatHeap.size() || iThreatHeap[index] != pRef)
+        return;
+
+    siftUp(index);
+    siftDown(pRef->iHeapIndex);
+    iDirty = true;
+}
+
 //============================================================
 // Return the HostileReference of NULL, if not found
 HostileReference* ThreatContainer::getReferenceByTarget(Unit* pVictim)
 {
     HostileReference* result = NULL;
     ObjectGuid guid = pVictim->GetObjectGuid();
-    for(ThreatList::const_iterator i = iThreatList.begin(); i != iThreatList.end(); ++i)
+    for(ThreatHeap::const_iterator i = iThreatHeap.begin(); i != iThreatHeap.end(); ++i)
     {
         if ((*i)->getUnitGuid() == guid)
         {
@@ -266,24 +369,70 @@ void ThreatContainer::modifyThreatPercent(Unit *pVictim, int32 pPercent)
 
 //============================================================
 
-bool HostileReferenceSortPredicate(const HostileReference* lhs, const HostileReference* rhs)
-{
-    // std::list::sort ordering predicate must be: (Pred(x,y)&&Pred(y,x))==false
-    return lhs->getThreat() > rhs->getThreat();             // reverse sorting
-}
-
-//============================================================
-// Check if the list is dirty and sort if necessary
+// Check if the list view is dirty and sort if necessary
 
 void ThreatContainer::update()
 {
     if(iDirty && iThreatList.size() >1)
     {
-        iThreatList.sort(HostileReferenceSortPredicate);
+        iThreatList.sort(ThreatContainer::isBefore);
     }
     iDirty = false;
 }
 
+//============================================================
+// Yields the references of a threat heap in list order without sorting it,
+// selection rarely looks further than the first few entries
+
+namespace
+{
+    struct ThreatHeapOrder
+    {
+        explicit ThreatHeapOrder(ThreatHeap const& pHeap) : iHeap(&pHeap) {}
+
+        // std heap functions keep the greatest element first
+        bool operator()(uint32 pLeft, uint32 pRight) const { return ThreatContainer::isBefore((*iHeap)[pRight], (*iHeap)[pLeft]); }
+
+        ThreatHeap const* iHeap;
+    };
+
+    class ThreatHeapWalker
+    {
+        public:
+            explicit ThreatHeapWalker(ThreatHeap const& pHeap) : iHeap(pHeap), iOrder(pHeap) { restart(); }
+
+            void restart()
+            {
+                iFrontier.clear();
+                if (!iHeap.empty())
+                    iFrontier.push_back(0);
+            }
+
+            HostileReference* next()
+            {
+                if (iFrontier.empty())
+                    return NULL;
+
+                std::pop_heap(iFrontier.begin(), iFrontier.end(), iOrder);
+                uint32 index = iFrontier.back();
+                iFrontier.pop_back();
+
+                for (uint32 child = 2 * index + 1; child <= 2 * index + 2 && child < iHeap.size(); ++child)
+                {
+                    iFrontier.push_back(child);
+                    std::push_heap(iFrontier.begin(), iFrontier.end(), iOrder);
+                }
+
+                return iHeap[index];
+            }
+
+        private:
+            ThreatHeap const& iHeap;
+            ThreatHeapOrder iOrder;
+            std::vector<uint32> iFrontier;
+    };
+}
+
 //============================================================
 // return the next best victim
 // could be the current victim
@@ -295,12 +444,12 @@ HostileReference* ThreatContainer::selectNextVictim(Creature* pAttacker, Hostile
     bool onlySecondChoiceTargetsFound = false;
     bool checkedCurrentVictim = false;
 
-    ThreatList::const_iterator lastRef = iThreatList.end();
-    --lastRef;
+    ThreatHeapWalker walker(iThreatHeap);
+    HostileReference* pNextRef = walker.next();
 
-    for (ThreatList::const_iterator iter = iThreatList.begin(); iter != iThreatList.end() && !found;)
+    while (pNextRef && !found)
     {
-        pCurrentRef  = (*iter);
+        pCurrentRef = pNextRef;
 
         Unit* pTarget = pCurrentRef ->getTarget();
         STRAWBERRY_ASSERT(pTarget);                              // if the ref has status online the target must be there !
@@ -310,13 +459,13 @@ HostileReference* ThreatContainer::selectNextVictim(Creature* pAttacker, Hostile
         //     This prevents dropping valid targets due to 1.1 or 1.3 threat rule vs invalid current target
         if (!onlySecondChoiceTargetsFound && pAttacker->IsSecondChoiceTarget(pTarget, pCurrentRef == pCurrentVictim))
         {
-            if (iter != lastRef)
-                ++iter;
-            else
+            pNextRef = walker.next();
+            if (!pNextRef)
             {
                 // if we reached to this point, everyone in the threatlist is a second choice target. In such a situation the target with the highest threat should be attacked.
                 onlySecondChoiceTargetsFound = true;
-                iter = iThreatList.begin();
+                walker.restart();
+                pNextRef = walker.next();
             }
 
             // current victim is a second choice target, so don't compare threat with it below
@@ -374,7 +523,7 @@ HostileReference* ThreatContainer::selectNextVictim(Creature* pAttacker, Hostile
                 break;
             }
         }
-        ++iter;
+        pNextRef = walker.next();
     }
     if(!found)
         pCurrentRef = NULL;
@@ -556,9 +705,9 @@ void ThreatManager::processThreatEvent(ThreatRefStatusChangeEvent* threatRefStat
     switch(threatRefStatusChangeEvent->getType())
     {
         case UEV_THREAT_REF_THREAT_CHANGE:
-            if((getCurrentVictim() == hostileReference && threatRefStatusChangeEvent->getFValue()<0.0f) ||
-                (getCurrentVictim() != hostileReference && threatRefStatusChangeEvent->getFValue()>0.0f))
-                setDirty(true);                             // the order in the threat list might have changed
+            // keep the heap ordered, only the container holding the reference reacts
+            iThreatContainer.threatChanged(hostileReference);
+            iThreatOfflineContainer.threatChanged(hostileReference);
             break;
         case UEV_THREAT_REF_ONLINE_STATUS:
             if(!hostileReference->isOnline())
@@ -27,14 +27,19 @@
 #include "Timer.h"
 #include "ObjectGuid.h"
 #include <list>
+#include <vector>
 
 //==============================================================
 
 class Unit;
 class Creature;
 class ThreatManager;
+class ThreatContainer;
+class HostileReference;
 struct SpellEntry;
 
+typedef std::list<HostileReference*> ThreatList;
+
 #define THREAT_UPDATE_INTERVAL 1 * IN_MILLISECONDS    // Server should send threat update to client periodically each second
 
 //==============================================================
@@ -120,6 +125,8 @@ class HostileReference : public Reference<Unit, ThreatManager>
         // Tell our refFrom (source) object, that the link is cut (Target destroyed)
         void sourceObjectDestroyLink();
     private:
+        friend class ThreatContainer;
+
         // Inform the source, that the status of that reference was changed
         void fireStatusChanged(ThreatRefStatusChangeEvent& pThreatRefStatusChangeEvent);
 
@@ -130,31 +137,49 @@ class HostileReference : public Reference<Unit, ThreatManager>
         ObjectGuid iUnitGuid;
         bool iOnline;
         bool iAccessible;
+
+        // position in the owning ThreatContainer
+        uint32 iHeapIndex;
+        uint32 iSequence;                                   // insertion order, keeps equal threats in stable order
+        ThreatList::iterator iListPos;
 };
 
 //==============================================================
-class ThreatManager;
-
-typedef std::list<HostileReference*> ThreatList;
 
+typedef std::vector<HostileReference*> ThreatHeap;
 
+// References are kept in an indexed binary max-heap by threat, so threat changes cost
+// O(log n) and the most hated is always at hand. The sorted list is only a view for
+// external iteration, it is re-sorted at target selection (ThreatManager::getHostileTarget)
+// and never while being handed out, so iterating it while changing threat is safe.
 class ThreatContainer
 {
     private:
+        ThreatHeap iThreatHeap;
         ThreatList iThreatList;
         bool iDirty;
+        uint32 iNextSequence;
+
+        void swapEntries(uint32 pIndexA, uint32 pIndexB);
+        void siftUp(uint32 pIndex);
+        void siftDown(uint32 pIndex);
     protected:
         friend class ThreatManager;
 
-        void remove(HostileReference* pRef) { iThreatList.remove(pRef); }
-        void addReference(HostileReference* pHostileReference) { iThreatList.push_back(pHostileReference); }
+        void remove(HostileReference* pRef);
+        void addReference(HostileReference* pHostileReference);
         void clearReferences();
-        // Sort the list if necessary
+        // Restore order of the reference after its threat changed
+        void threatChanged(HostileReference* pRef);
+        // Sort the list view if necessary, done once per target selection
         void update();
     public:
-        ThreatContainer() { iDirty = false; }
+        ThreatContainer() : iDirty(false), iNextSequence(0) {}
         ~ThreatContainer() { clearReferences(); }
 
+        // list order: higher threat first, equal threat in order of adding
+        static bool isBefore(HostileReference const* pLeft, HostileReference const* pRight);
+
         HostileReference* addThreat(Unit* pVictim, float pThreat);
 
         void modifyThreatPercent(Unit *pVictim, int32 percent);
@@ -165,9 +190,9 @@ class ThreatContainer
 
         bool isDirty() const { return iDirty; }
 
-        bool empty() const { return(iThreatList.empty()); }
+        bool empty() const { return(iThreatHeap.empty()); }
 
-        HostileReference* getMostHated() { return iThreatList.empty() ? NULL : iThreatList.front(); }
+        HostileReference* getMostHated() { return iThreatHeap.empty() ? NULL : iThreatHeap.front(); }
 
         HostileReference* getReferenceByTarget(Unit* pVictim);
 
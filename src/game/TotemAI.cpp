@@ -82,7 +82,7 @@ TotemAI::UpdateAI(const uint32 /*diff*/)
 
         Strawberry::NearestAttackableUnitInObjectRangeCheck u_check(m_creature, m_creature, max_range);
         Strawberry::UnitLastSearcher<Strawberry::NearestAttackableUnitInObjectRangeCheck> checker(victim, u_check);
-        Cell::VisitAllObjects(m_creature, checker, max_range);
+        Cell::VisitAllUnits(m_creature, checker, max_range);
     }
 
     // If have target
@@ -128,6 +128,9 @@ Unit::Unit() :
 
     m_Visibility = VISIBILITY_ON;
     m_AINotifyScheduled = false;
+    m_sleeping = false;
+    m_wokenUp = false;
+    m_farMovementBroadcastTime = 0;
 
     m_detectInvisibilityMask = 0;
     m_invisibilityMask = 0;
@@ -186,6 +189,9 @@ Unit::Unit() :
 
 Unit::~Unit()
 {
+    if (m_unitIndexSlot.index)
+        m_unitIndexSlot.index->Remove(this);
+
     // set current spells as deletable
     for (uint32 i = 0; i < CURRENT_MAX_SPELL; ++i)
     {
@@ -3496,6 +3502,8 @@ void Unit::SetCurrentCastedSpell( Spell * pSpell )
 {
     STRAWBERRY_ASSERT(pSpell);                                  // NULL may be never passed here, use InterruptSpell or InterruptNonMeleeSpells
 
+    WakeUp();
+
     CurrentSpellTypes CSpellType = pSpell->GetCurrentContainer();
 
     if (pSpell == m_currentSpells[CSpellType]) return;      // avoid breaking self
@@ -3885,6 +3893,8 @@ float Unit::GetTotalAuraMultiplierByMiscValueForMask(AuraType auratype, uint32 m
 
 bool Unit::AddSpellAuraHolder(SpellAuraHolder *holder)
 {
+    WakeUp();
+
     SpellEntry const* aurSpellInfo = holder->GetSpellProto();
 
     // ghost spell check, allow apply any auras at player loading in ghost mode (will be cleanup after load)
@@ -5561,6 +5571,8 @@ bool Unit::Attack(Unit *victim, bool meleeAttack)
     if(!victim || victim == this)
         return false;
 
+    WakeUp();
+
     // dead units can neither attack nor be attacked
     if(!isAlive() || !victim->IsInWorld() || !victim->isAlive())
         return false;
@@ -7763,6 +7775,8 @@ void Unit::SetInCombatWith(Unit* enemy)
 
 void Unit::SetInCombatState(bool PvP, Unit* enemy)
 {
+    WakeUp();
+
     // only alive units can be in combat
     if (!isAlive())
         return;
@@ -8420,6 +8434,8 @@ void Unit::SetHover(bool on)
 
 void Unit::SetDeathState(DeathState s)
 {
+    WakeUp();
+
     if (s != ALIVE && s!= JUST_ALIVED)
     {
         ExitVehicle();
@@ -8517,7 +8533,10 @@ void Unit::AddThreat(Unit* pVictim, float threat /*= 0.0f*/, bool crit /*= false
 {
     // Only mobs can manage threat lists
     if (CanHaveThreatList())
+    {
+        WakeUp();
         m_ThreatManager.addThreat(pVictim, threat, crit, schoolMask, threatSpell);
+    }
 }
 
 //======================================================================
@@ -9226,6 +9245,8 @@ void Unit::SetLevel(uint32 lvl)
 
 void Unit::SetHealth(uint32 val)
 {
+    WakeUp();
+
     uint32 maxHealth = GetMaxHealth();
     if(maxHealth < val)
         val = maxHealth;
@@ -9284,6 +9305,8 @@ void Unit::SetHealthPercent(float percent)
 
 void Unit::SetPower(Powers power, uint32 val)
 {
+    WakeUp();
+
     uint32 maxPower = GetMaxPower(power);
     if(maxPower < val)
         val = maxPower;
@@ -9426,6 +9449,7 @@ uint32 Unit::GetCreatePowers( Powers power ) const
 void Unit::AddToWorld()
 {
     Object::AddToWorld();
+    GetMap()->GetUnitIndex().Insert(this);
     ScheduleAINotify(0);
 }
 
@@ -9445,6 +9469,9 @@ void Unit::RemoveFromWorld()
         GetViewPoint().Event_RemovedFromWorld();
     }
 
+    if (m_unitIndexSlot.index)
+        m_unitIndexSlot.index->Remove(this);
+
     Object::RemoveFromWorld();
 }
 
@@ -9470,6 +9497,22 @@ void Unit::CleanupsBeforeDelete()
     WorldObject::CleanupsBeforeDelete();
 }
 
+void Unit::SetMap(Map* map)
+{
+    WorldObject::SetMap(map);
+
+    if (sWorld.getConfig(CONFIG_BOOL_MAP_SHARED_EVENT_WHEEL))
+        m_Events.SetSharedWheel(map->GetEventWheel());
+}
+
+void Unit::ResetMap()
+{
+    // pending events keep their delays in the unit own wheel while outside of a map
+    m_Events.SetSharedWheel(NULL);
+
+    WorldObject::ResetMap();
+}
+
 CharmInfo* Unit::InitCharmInfo(Unit *charm)
 {
     if(!m_charmInfo)
@@ -10236,6 +10279,8 @@ void Unit::UpdateModelData()
             SetFloatValue(UNIT_FIELD_COMBATREACH, 1.5f);
         else
             SetFloatValue(UNIT_FIELD_COMBATREACH, GetObjectScale() * modelInfo->combat_reach);
+
+        UpdateUnitIndex();
     }
 }
 
@@ -10310,7 +10355,7 @@ Unit* Unit::SelectRandomUnfriendlyTarget(Unit* except /*= NULL*/, float radius /
 
     Strawberry::AnyUnfriendlyUnitInObjectRangeCheck u_check(this, this, radius);
     Strawberry::UnitListSearcher<Strawberry::AnyUnfriendlyUnitInObjectRangeCheck> searcher(targets, u_check);
-    Cell::VisitAllObjects(this, searcher, radius);
+    Cell::VisitAllUnits(this, searcher, radius);
 
     // remove current target
     if(except)
@@ -10349,7 +10394,7 @@ Unit* Unit::SelectRandomFriendlyTarget(Unit* except /*= NULL*/, float radius /*=
     Strawberry::AnyFriendlyUnitInObjectRangeCheck u_check(this, radius);
     Strawberry::UnitListSearcher<Strawberry::AnyFriendlyUnitInObjectRangeCheck> searcher(targets, u_check);
 
-    Cell::VisitAllObjects(this, searcher, radius);
+    Cell::VisitAllUnits(this, searcher, radius);
     // remove current target
     if(except)
         targets.remove(except);
@@ -10562,6 +10607,7 @@ void Unit::SetPhaseMask(uint32 newPhaseMask, bool update)
     }
 
     WorldObject::SetPhaseMask(newPhaseMask, update);
+    UpdateUnitIndex();
 }
 
 bool Unit::SetPosition(float x, float y, float z, float orientation, bool teleport)
@@ -37,6 +37,7 @@
 #include "Path.h"
 #include "WorldPacket.h"
 #include "Timer.h"
+#include "UnitSpatialIndex.h"
 #include <list>
 #include "ObjectGuid.h"
 
@@ -1115,6 +1116,9 @@ class Unit : public WorldObject
 
         void CleanupsBeforeDelete();                        // used in ~Creature/~Player (or before mass creature delete to remove cross-references to already deleted units)
 
+        void SetMap(Map* map);                              // overwrite WorldObject version, m_Events may use the map event wheel
+        void ResetMap();
+
         float GetObjectBoundingRadius() const               // overwrite WorldObject version
         {
             return m_floatValues[UNIT_FIELD_BOUNDINGRADIUS];
@@ -1979,12 +1983,23 @@ class Unit : public WorldObject
         // Movement info
         MovementInfo m_movementInfo;
         Movement::MoveSpline * movespline;
+        uint32 m_farMovementBroadcastTime;                  // getMSTime() of the last movement packet sent to far observers, see Map::SendMovementBroadcasts
 
         void ScheduleAINotify(uint32 delay);
         bool IsAINotifyScheduled() const { return m_AINotifyScheduled;}
         void _SetAINotifyScheduled(bool on) { m_AINotifyScheduled = on;}       // only for call from RelocationNotifyEvent code
         void OnRelocated();
 
+        // sleeping units are skipped by ObjectUpdater until something wakes them, see Creature::CanSleep
+        bool IsSleeping() const { return m_sleeping; }
+        void SetSleeping() { m_sleeping = true; }
+        void WakeUp() { m_wokenUp = m_wokenUp || m_sleeping; m_sleeping = false; }
+        // true once after a wake up, the next update also covers the slept time
+        bool ConsumeWakeUp() { bool woken = m_wokenUp; m_wokenUp = false; return woken; }
+
+        // refresh position, phase and bounding radius in the unit index of the map
+        void UpdateUnitIndex() { if (m_unitIndexSlot.index) m_unitIndexSlot.index->Update(this); }
+
         bool IsLinkingEventTrigger() { return m_isCreatureLinkingTrigger; }
 
         // Transports
@@ -2085,8 +2100,13 @@ class Unit : public WorldObject
         UnitVisibility m_Visibility;
         Position m_last_notified_position;
         bool m_AINotifyScheduled;
+        bool m_sleeping;
+        bool m_wokenUp;
         ShortTimeTracker m_movesplineTimer;
 
+        friend class UnitSpatialIndex;
+        UnitIndexSlot m_unitIndexSlot;
+
         Diminishing m_Diminishing;
         // Manage all Units threatening us
         ThreatManager m_ThreatManager;
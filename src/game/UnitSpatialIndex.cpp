@@ -0,0 +1,303 @@
+/*
+ * Copyright (C) 2010-2012 Strawberry-Pr0jcts <http://strawberry-pr0jcts.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "UnitSpatialIndex.h"
+#include "Unit.h"
+#include "MapManager.h"
+#include "GridDefines.h"
+
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  define UNIT_INDEX_SSE2
+#  include <emmintrin.h>
+#endif
+
+#define MAX_UNIT_INDEX_CELL_COORD   uint32(MAP_SIZE / UNIT_INDEX_CELL_SIZE)
+
+UnitSpatialIndex::UnitSpatialIndex() : m_unitCount(0), m_maxBound(0.0f), m_enabled(false)
+{
+}
+
+uint32 UnitSpatialIndex::ComputeCellCoord(float c)
+{
+    float coord = (c + MAP_HALFSIZE) / UNIT_INDEX_CELL_SIZE;
+    if (coord <= 0.0f)
+        return 0;
+
+    return std::min(uint32(coord), MAX_UNIT_INDEX_CELL_COORD);
+}
+
+void UnitSpatialIndex::Insert(Unit* unit)
+{
+    if (!m_enabled)
+        return;
+
+    UnitIndexSlot& slot = unit->m_unitIndexSlot;
+    if (slot.index == this)
+    {
+        Update(unit);
+        return;
+    }
+
+    if (slot.index)                                         // left in the index of another map, should not happen
+        slot.index->Remove(unit);
+
+    uint32 cellId = MakeCellId(ComputeCellCoord(unit->GetPositionX()), ComputeCellCoord(unit->GetPositionY()));
+    IndexCell& cell = m_cells[cellId];
+
+    slot.index = this;
+    slot.cell = cellId;
+    slot.pos = uint32(cell.units.size());
+
+    float bound = unit->GetObjectBoundingRadius();
+    cell.x.push_back(unit->GetPositionX());
+    cell.y.push_back(unit->GetPositionY());
+    cell.z.push_back(unit->GetPositionZ());
+    cell.bound.push_back(bound);
+    cell.phaseMask.push_back(unit->GetPhaseMask());
+    cell.units.push_back(unit);
+
+    if (bound > m_maxBound)
+        m_maxBound = bound;
+
+    ++m_unitCount;
+}
+
+void UnitSpatialIndex::Remove(Unit* unit)
+{
+    UnitIndexSlot& slot = unit->m_unitIndexSlot;
+    if (slot.index != this)
+        return;
+
+    IndexCellMap::iterator itr = m_cells.find(slot.cell);
+    STRAWBERRY_ASSERT(itr != m_cells.end());
+
+    IndexCell& cell = itr->second;
+    uint32 last = uint32(cell.units.size()) - 1;
+
+    // fill the hole with the last unit of the cell
+    if (slot.pos != last)
+    {
+        cell.x[slot.pos] = cell.x[last];
+        cell.y[slot.pos] = cell.y[last];
+        cell.z[slot.pos] = cell.z[last];
+        cell.bound[slot.pos] = cell.bound[last];
+        cell.phaseMask[slot.pos] = cell.phaseMask[last];
+        cell.units[slot.pos] = cell.units[last];
+        cell.units[slot.pos]->m_unitIndexSlot.pos = slot.pos;
+    }
+
+    cell.x.pop_back();
+    cell.y.pop_back();
+    cell.z.pop_back();
+    cell.bound.pop_back();
+    cell.phaseMask.pop_back();
+    cell.units.pop_back();
+
+    if (cell.units.empty())
+        m_cells.erase(itr);
+
+    slot.index = NULL;
+    --m_unitCount;
+}
+
+void UnitSpatialIndex::Update(Unit* unit)
+{
+    UnitIndexSlot& slot = unit->m_unitIndexSlot;
+    if (slot.index != this)
+        return;
+
+    uint32 cellId = MakeCellId(ComputeCellCoord(unit->GetPositionX()), ComputeCellCoord(unit->GetPositionY()));
+    if (cellId != slot.cell)
+    {
+        Remove(unit);
+        Insert(unit);
+        return;
+    }
+
+    IndexCell& cell = m_cells[cellId];
+    float bound = unit->GetObjectBoundingRadius();
+    cell.x[slot.pos] = unit->GetPositionX();
+    cell.y[slot.pos] = unit->GetPositionY();
+    cell.z[slot.pos] = unit->GetPositionZ();
+    cell.bound[slot.pos] = bound;
+    cell.phaseMask[slot.pos] = unit->GetPhaseMask();
+
+    if (bound > m_maxBound)
+        m_maxBound = bound;
+}
+
+void UnitSpatialIndex::FilterCell(IndexCell const& cell, float x, float y, float z, float radius, uint32 phaseMask, bool is3D, CandidateVector& result)
+{
+    size_t count = cell.units.size();
+    size_t i = 0;
+
+#ifdef UNIT_INDEX_SSE2
+    __m128 const vx = _mm_set1_ps(x);
+    __m128 const vy = _mm_set1_ps(y);
+    __m128 const vz = _mm_set1_ps(z);
+    __m128 const vradius = _mm_set1_ps(radius);
+    __m128 const vdepth = is3D ? _mm_castsi128_ps(_mm_set1_epi32(-1)) : _mm_setzero_ps();
+    __m128i const vphase = _mm_set1_epi32(int(phaseMask));
+    __m128i const vzero = _mm_setzero_si128();
+
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 dx = _mm_sub_ps(_mm_loadu_ps(&cell.x[i]), vx);
+        __m128 dy = _mm_sub_ps(_mm_loadu_ps(&cell.y[i]), vy);
+        __m128 dz = _mm_sub_ps(_mm_loadu_ps(&cell.z[i]), vz);
+        __m128 dzSq = _mm_and_ps(_mm_mul_ps(dz, dz), vdepth);
+        __m128 distSq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), dzSq);
+
+        __m128 maxDist = _mm_add_ps(vradius, _mm_loadu_ps(&cell.bound[i]));
+        __m128 inRange = _mm_cmplt_ps(distSq, _mm_mul_ps(maxDist, maxDist));
+
+        __m128i phase = _mm_and_si128(_mm_loadu_si128((__m128i const*)&cell.phaseMask[i]), vphase);
+        __m128 otherPhase = _mm_castsi128_ps(_mm_cmpeq_epi32(phase, vzero));
+
+        int mask = _mm_movemask_ps(_mm_andnot_ps(otherPhase, inRange));
+        if (!mask)
+            continue;
+
+        float lanes[4][4];
+        _mm_storeu_ps(lanes[0], dx);
+        _mm_storeu_ps(lanes[1], dy);
+        _mm_storeu_ps(lanes[2], dz);
+        _mm_storeu_ps(lanes[3], distSq);
+
+        for (int lane = 0; lane < 4; ++lane)
+        {
+            if (!(mask & (1 << lane)))
+                continue;
+
+            Candidate candidate;
+            candidate.unit = cell.units[i + lane];
+            candidate.dx = lanes[0][lane];
+            candidate.dy = lanes[1][lane];
+            candidate.dz = lanes[2][lane];
+            candidate.distSq = lanes[3][lane];
+            result.push_back(candidate);
+        }
+    }
+#endif
+
+    for (; i < count; ++i)
+    {
+        if (!(cell.phaseMask[i] & phaseMask))
+            continue;
+
+        float dx = cell.x[i] - x;
+        float dy = cell.y[i] - y;
+        float dz = cell.z[i] - z;
+        float distSq = dx*dx + dy*dy;
+        if (is3D)
+            distSq += dz*dz;
+
+        float maxDist = radius + cell.bound[i];
+        if (distSq >= maxDist * maxDist)
+            continue;
+
+        Candidate candidate;
+        candidate.unit = cell.units[i];
+        candidate.dx = dx;
+        candidate.dy = dy;
+        candidate.dz = dz;
+        candidate.distSq = distSq;
+        result.push_back(candidate);
+    }
+}
+
+void UnitSpatialIndex::Collect(float x, float y, float z, float radius, uint32 phaseMask, bool is3D, CandidateVector& result) const
+{
+    radius += UNIT_INDEX_SLACK;
+
+    float reach = radius + m_maxBound;
+    uint32 lowX = ComputeCellCoord(x - reach);
+    uint32 highX = ComputeCellCoord(x + reach);
+    uint32 lowY = ComputeCellCoord(y - reach);
+    uint32 highY = ComputeCellCoord(y + reach);
+
+    for (uint32 cx = lowX; cx <= highX; ++cx)
+    {
+        for (uint32 cy = lowY; cy <= highY; ++cy)
+        {
+            IndexCellMap::const_iterator itr = m_cells.find(MakeCellId(cx, cy));
+            if (itr != m_cells.end())
+                FilterCell(itr->second, x, y, z, radius, phaseMask, is3D, result);
+        }
+    }
+}
+
+void UnitSpatialIndex::FindInRadius(float x, float y, float z, float radius, uint32 phaseMask, bool is3D, UnitVector& result) const
+{
+    CandidateVector candidates;
+    Collect(x, y, z, radius, phaseMask, is3D, candidates);
+
+    result.reserve(result.size() + candidates.size());
+    for (CandidateVector::const_iterator itr = candidates.begin(); itr != candidates.end(); ++itr)
+        result.push_back(itr->unit);
+}
+
+void UnitSpatialIndex::FindInCone(float x, float y, float z, float orientation, float arc, float radius, uint32 phaseMask, UnitVector& result) const
+{
+    CandidateVector candidates;
+    Collect(x, y, z, radius, phaseMask, true, candidates);
+
+    // same borders as WorldObject::HasInArc, widened a bit for the exact check done by the caller
+    float border = MapManager::NormalizeOrientation(arc) / 2.0f + 0.01f;
+
+    for (CandidateVector::const_iterator itr = candidates.begin(); itr != candidates.end(); ++itr)
+    {
+        if (itr->dx != 0.0f || itr->dy != 0.0f)
+        {
+            float angle = MapManager::NormalizeOrientation(atan2(itr->dy, itr->dx) - orientation);
+            if (angle > M_PI_F)
+                angle -= 2.0f * M_PI_F;
+
+            if (angle < -border || angle > border)
+                continue;
+        }
+
+        result.push_back(itr->unit);
+    }
+}
+
+struct UnitIndexCandidateCloser
+{
+    template<class T>
+    bool operator()(T const& a, T const& b) const { return a.distSq < b.distSq; }
+};
+
+void UnitSpatialIndex::FindNearest(float x, float y, float z, float radius, uint32 phaseMask, uint32 count, UnitVector& result) const
+{
+    CandidateVector candidates;
+    Collect(x, y, z, radius, phaseMask, true, candidates);
+
+    if (count < candidates.size())
+        std::partial_sort(candidates.begin(), candidates.begin() + count, candidates.end(), UnitIndexCandidateCloser());
+    else
+    {
+        std::sort(candidates.begin(), candidates.end(), UnitIndexCandidateCloser());
+        count = uint32(candidates.size());
+    }
+
+    result.reserve(result.size() + count);
+    for (uint32 i = 0; i < count; ++i)
+        result.push_back(candidates[i].unit);
+}
@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2010-2012 Strawberry-Pr0jcts <http://strawberry-pr0jcts.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef STRAWBERRY_UNITSPATIALINDEX_H
+#define STRAWBERRY_UNITSPATIALINDEX_H
+
+#include "Common.h"
+#include "Platform/Define.h"
+
+#include <vector>
+
+class Unit;
+class UnitSpatialIndex;
+
+// edge of one index cell in yards, about the radius of common area spells and aggro checks
+#define UNIT_INDEX_CELL_SIZE    32.0f
+// distance added to every query, covers float rounding against the exact checks done on the found units
+#define UNIT_INDEX_SLACK        0.5f
+
+/**
+ * Position of a unit in the index of its map, kept by the unit itself so that relocation
+ * and removal need no lookup.
+ */
+struct UnitIndexSlot
+{
+    UnitIndexSlot() : index(NULL), cell(0), pos(0) {}
+
+    UnitSpatialIndex* index;                                // NULL while not indexed
+    uint32 cell;
+    uint32 pos;
+};
+
+/**
+ * Flat uniform hash grid of all units in world in one map. Each cell keeps positions, bounding
+ * radius and phase mask of its units in separate arrays, so radius, cone and nearest queries
+ * filter packed floats (4 at once with SSE2) and only units passing the filter are touched.
+ *
+ * Results are candidates: everything within the query distance plus the unit bounding radius
+ * is returned, callers still do their exact checks (LoS, faction, state) on the units.
+ * Only used from the map update thread owning the map.
+ */
+class UnitSpatialIndex
+{
+    public:
+        typedef std::vector<Unit*> UnitVector;
+
+        UnitSpatialIndex();
+
+        void SetEnabled(bool enabled) { m_enabled = enabled; }
+        bool IsEnabled() const { return m_enabled; }
+
+        // called from Unit::AddToWorld / Unit::RemoveFromWorld, and at relocation, phase or model change
+        void Insert(Unit* unit);
+        void Remove(Unit* unit);
+        void Update(Unit* unit);
+
+        /**
+         * Units with the center closer than radius + own bounding radius to (x,y[,z])
+         * @param phaseMask     only units sharing a phase with it, PHASEMASK_ANYWHERE for all
+         */
+        void FindInRadius(float x, float y, float z, float radius, uint32 phaseMask, bool is3D, UnitVector& result) const;
+        /// FindInRadius in 3d limited to the arc (in radians) around orientation, as WorldObject::isInFront
+        void FindInCone(float x, float y, float z, float orientation, float arc, float radius, uint32 phaseMask, UnitVector& result) const;
+        /// Up to count units of FindInRadius in 3d, nearest first by center distance
+        void FindNearest(float x, float y, float z, float radius, uint32 phaseMask, uint32 count, UnitVector& result) const;
+
+        uint32 GetUnitCount() const { return m_unitCount; }
+        uint32 GetCellCount() const { return uint32(m_cells.size()); }
+
+    private:
+        struct IndexCell
+        {
+            std::vector<float> x;
+            std::vector<float> y;
+            std::vector<float> z;
+            std::vector<float> bound;
+            std::vector<uint32> phaseMask;
+            std::vector<Unit*> units;
+        };
+
+        typedef UNORDERED_MAP<uint32, IndexCell> IndexCellMap;
+
+        // positions of the passed units and their squared distance, filled by FilterCell
+        struct Candidate
+        {
+            Unit* unit;
+            float dx, dy, dz;
+            float distSq;
+        };
+        typedef std::vector<Candidate> CandidateVector;
+
+        static uint32 ComputeCellCoord(float c);
+        static uint32 MakeCellId(uint32 cx, uint32 cy) { return (cx << 16) | cy; }
+
+        void Collect(float x, float y, float z, float radius, uint32 phaseMask, bool is3D, CandidateVector& result) const;
+        static void FilterCell(IndexCell const& cell, float x, float y, float z, float radius, uint32 phaseMask, bool is3D, CandidateVector& result);
+
+        IndexCellMap m_cells;
+        uint32 m_unitCount;
+        float m_maxBound;                                   // largest bounding radius ever indexed, widens the cell range of queries
+        bool m_enabled;
+};
+
+#endif
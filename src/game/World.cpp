@@ -70,6 +70,8 @@
 #include "WardenDataStorage.h"
 #include "ScriptMgr.h"
 #include "BattlefieldMgr.h"
+#include "LFGMgr.h"
+#include "PerfStatsMgr.h"
 
 INSTANTIATE_SINGLETON_1( World );
 
@@ -102,6 +104,18 @@ World::World()
     m_NextDailyQuestReset = 0;
     m_NextWeeklyQuestReset = 0;
 
+    m_tickStartTime = 0;
+    m_tickCount = 0;
+    m_tickOverruns = 0;
+    m_weatherDiff = 0;
+
+    for(int i = 0; i < WTASK_COUNT; ++i)
+    {
+        m_taskPending[i] = false;
+        m_taskPendingSince[i] = 0;
+        m_taskPendingTicks[i] = 0;
+    }
+
     m_defaultDbcLocale = LOCALE_enUS;
     m_availableDbcLocaleMask = 0;
 
@@ -544,6 +558,9 @@ void World::LoadConfigSettings(bool reload)
     setConfig(CONFIG_BOOL_ADDON_CHANNEL, "AddonChannel", true);
     setConfig(CONFIG_BOOL_CLEAN_CHARACTER_DB, "CleanCharacterDB", true);
     setConfig(CONFIG_BOOL_GRID_UNLOAD, "GridUnload", true);
+    setConfig(CONFIG_BOOL_MAP_SHARED_EVENT_WHEEL, "MapSharedEventWheel", false);
+    setConfig(CONFIG_BOOL_MAP_CREATURE_SLEEP, "MapCreatureSleep", true);
+    setConfig(CONFIG_BOOL_MAP_UNIT_INDEX, "MapUnitIndex", true);
     setConfig(CONFIG_UINT32_INTERVAL_SAVE, "PlayerSave.Interval", 15 * MINUTE * IN_MILLISECONDS);
     setConfigMinMax(CONFIG_UINT32_MIN_LEVEL_STAT_SAVE, "PlayerSave.Stats.MinLevel", 0, 0, MAX_LEVEL);
     setConfig(CONFIG_BOOL_STATS_SAVE_ONLY_ON_LOGOUT, "PlayerSave.Stats.SaveOnlyOnLogout", true);
@@ -558,6 +575,15 @@ void World::LoadConfigSettings(bool reload)
 
     setConfig(CONFIG_UINT32_INTERVAL_CHANGEWEATHER, "ChangeWeatherInterval", 10 * MINUTE * IN_MILLISECONDS);
 
+    setConfigMin(CONFIG_UINT32_WORLD_TICK_TIME, "WorldTickTime", 50, 1);
+    setConfig(CONFIG_UINT32_TICK_BUDGET_SESSIONS, "TickBudget.Sessions", 20);
+    setConfig(CONFIG_UINT32_TICK_BUDGET_MAPS, "TickBudget.Maps", 25);
+    setConfig(CONFIG_UINT32_TICK_BUDGET_BATTLEGROUNDS, "TickBudget.BattleGrounds", 5);
+    setConfig(CONFIG_UINT32_TICK_BUDGET_AHBOT, "TickBudget.AuctionHouseBot", 10);
+    setConfig(CONFIG_UINT32_TICK_BUDGET_MASS_MAILER, "TickBudget.MassMailer", 5);
+    setConfig(CONFIG_UINT32_TICK_BUDGET_WEATHERS, "TickBudget.Weather", 2);
+    setConfig(CONFIG_UINT32_TICK_MAX_DEFER_TIME, "TickBudget.MaxDeferTime", 5 * IN_MILLISECONDS);
+
     if (configNoReload(reload, CONFIG_UINT32_PORT_WORLD, "WorldServerPort", DEFAULT_WORLDSERVER_PORT))
         setConfig(CONFIG_UINT32_PORT_WORLD, "WorldServerPort", DEFAULT_WORLDSERVER_PORT);
 
@@ -625,6 +651,8 @@ void World::LoadConfigSettings(bool reload)
 
     setConfig(CONFIG_UINT32_INSTANCE_RESET_TIME_HOUR, "Instance.ResetTimeHour", 4);
     setConfig(CONFIG_UINT32_INSTANCE_UNLOAD_DELAY,    "Instance.UnloadDelay", 30 * MINUTE * IN_MILLISECONDS);
+    setConfigMin(CONFIG_UINT32_INSTANCE_RESET_BATCH_SIZE,    "Instance.ResetBatchSize", 500, 1);
+    setConfigMin(CONFIG_UINT32_INSTANCE_RESET_MAPS_PER_TICK, "Instance.ResetMapsPerTick", 5, 1);
 
     setConfigMinMax(CONFIG_UINT32_MAX_PRIMARY_TRADE_SKILL, "MaxPrimaryTradeSkill", 2, 0, 10);
 
@@ -653,6 +681,7 @@ void World::LoadConfigSettings(bool reload)
     setConfig(CONFIG_UINT32_MAIL_DELIVERY_DELAY, "MailDeliveryDelay", HOUR);
 
     setConfigMin(CONFIG_UINT32_MASS_MAILER_SEND_PER_TICK, "MassMailer.SendPerTick", 10, 1);
+    setConfigMin(CONFIG_UINT32_MAIL_EXPIRE_CHUNK_SIZE, "Mail.ExpireChunkSize", 500, 1);
 
     setConfig(CONFIG_UINT32_UPTIME_UPDATE, "UpdateUptimeInterval", 10);
     if (reload)
@@ -758,6 +787,7 @@ void World::LoadConfigSettings(bool reload)
     setConfig(CONFIG_UINT32_BATTLEGROUND_INVITATION_TYPE,              "Battleground.InvitationType", 0);
     setConfig(CONFIG_UINT32_BATTLEGROUND_PREMATURE_FINISH_TIMER,       "BattleGround.PrematureFinishTimer", 5 * MINUTE * IN_MILLISECONDS);
     setConfig(CONFIG_UINT32_BATTLEGROUND_PREMADE_GROUP_WAIT_FOR_MATCH, "BattleGround.PremadeGroupWaitForMatch", 30 * MINUTE * IN_MILLISECONDS);
+    setConfig(CONFIG_UINT32_BATTLEGROUND_QUEUE_UPDATES_PER_TICK,       "BattleGround.QueueUpdatesPerTick", 50);
     setConfig(CONFIG_UINT32_ARENA_MAX_RATING_DIFFERENCE,               "Arena.MaxRatingDifference", 150);
     setConfig(CONFIG_UINT32_ARENA_RATING_DISCARD_TIMER,                "Arena.RatingDiscardTimer", 10 * MINUTE * IN_MILLISECONDS);
     setConfig(CONFIG_BOOL_ARENA_AUTO_DISTRIBUTE_POINTS,                "Arena.AutoDistributePoints", false);
@@ -769,6 +799,12 @@ void World::LoadConfigSettings(bool reload)
     setConfigMin(CONFIG_INT32_ARENA_STARTRATING,                       "Arena.StartRating", -1, -1);
     setConfigMin(CONFIG_INT32_ARENA_STARTPERSONALRATING,               "Arena.StartPersonalRating", -1, -1);
 
+    setConfig(CONFIG_BOOL_LFG_ENABLED,                                 "LFG.Enable", true);
+    setConfigMin(CONFIG_UINT32_LFG_QUEUE_UPDATE_INTERVAL,              "LFG.QueueUpdateInterval", 1000, 50);
+    setConfigMin(CONFIG_UINT32_LFG_MAX_MATCHES_PER_UPDATE,             "LFG.MaxMatchesPerUpdate", 50, 1);
+    setConfigMin(CONFIG_UINT32_LFG_ROLECHECK_TIMEOUT,                  "LFG.RoleCheckTimeout", 2 * MINUTE, 10);
+    setConfigMin(CONFIG_UINT32_LFG_PROPOSAL_TIMEOUT,                   "LFG.ProposalTimeout", 45, 10);
+
     setConfig(CONFIG_BOOL_OFFHAND_CHECK_AT_TALENTS_RESET, "OffhandCheckAtTalentsReset", false);
 
     setConfig(CONFIG_BOOL_KICK_PLAYER_ON_BAD_PACKET, "Network.KickOnBadPacket", false);
@@ -804,6 +840,9 @@ void World::LoadConfigSettings(bool reload)
     m_relocation_ai_notify_delay = sConfig.GetIntDefault("Visibility.AIRelocationNotifyDelay", 1000u);
     m_relocation_lower_limit_sq  = pow(sConfig.GetFloatDefault("Visibility.RelocationLowerLimit",10), 2);
 
+    setConfigPos(CONFIG_FLOAT_MOVEMENT_NEAR_DISTANCE, "Visibility.Movement.NearDistance", 40.0f);
+    setConfig(CONFIG_UINT32_MOVEMENT_FAR_INTERVAL,    "Visibility.Movement.FarInterval", 1000);
+
     m_VisibleUnitGreyDistance = sConfig.GetFloatDefault("Visibility.Distance.Grey.Unit", 1);
     if(m_VisibleUnitGreyDistance >  MAX_VISIBILITY_DISTANCE)
     {
@@ -875,6 +914,10 @@ void World::LoadConfigSettings(bool reload)
 
     setConfig(CONFIG_UINT32_MIN_LEVEL_FOR_RAID, "Raid.MinLevel", 10);
 
+    setConfig(CONFIG_BOOL_PERF_STATS_ENABLE, "PerfStats.Enable", true);
+    setConfig(CONFIG_UINT32_PERF_STATS_CSV_INTERVAL, "PerfStats.CsvInterval", 0);
+    sPerfStatsMgr.LoadConfig();
+
     ///- Read the "Data" directory from the config file
     std::string dataPath = sConfig.GetStringDefault("DataDir", "./");
 
@@ -1290,6 +1333,9 @@ void World::SetInitialWorldSettings()
     sLog.outString( "Loading BattleGround event indexes..." );
     sBattleGroundMgr.LoadBattleEventIndexes();
 
+    sLog.outString( "Loading LFG dungeons..." );
+    sLFGMgr.LoadDungeons();
+
     sLog.outString( "Loading GameTeleports..." );
     sObjectMgr.LoadGameTele();
 
@@ -1391,6 +1437,10 @@ void World::SetInitialWorldSettings()
     sLog.outString( "Starting Battlefield System" );
     sBattlefieldMgr.Initialize();
 
+    ///- Initialize Dungeon Finder
+    sLog.outString( "Starting Dungeon Finder System" );
+    sLFGMgr.Initialize();
+
     //Not sure if this can be moved up in the sequence (with static data loading) as it uses MapManager
     sLog.outString( "Loading Transports..." );
     sMapMgr.LoadTransports();
@@ -1477,6 +1527,9 @@ void World::DetectDBCLang()
 /// Update the World !
 void World::Update(uint32 diff)
 {
+    PerfTimer tickTimer(PERF_WORLD_TICK);
+    m_tickStartTime = WorldTimer::getMSTime();
+
     ///- Update the different timers
     for(int i = 0; i < WUPDATE_COUNT; ++i)
     {
@@ -1489,9 +1542,6 @@ void World::Update(uint32 diff)
     ///- Update the game time and check for shutdown time
     _UpdateGameTime();
 
-    ///-Update mass mailer tasks if any
-    sMassMailMgr.Update();
-
     /// Handle daily quests reset time
     if (m_gameTime > m_NextDailyQuestReset)
         ResetDailyQuests();
@@ -1521,35 +1571,13 @@ void World::Update(uint32 diff)
         sAuctionMgr.Update();
     }
 
-    /// <li> Handle AHBot operations
-    if (m_timers[WUPDATE_AHBOT].Passed())
-    {
-        sAuctionBot.Update();
-        m_timers[WUPDATE_AHBOT].Reset();
-    }
-
     /// <li> Handle session updates
+    uint32 taskStartTime = WorldTimer::getMSTime();
+    PerfTimer phaseTimer(PERF_WORLD_SESSIONS);
     UpdateSessions(diff);
+    phaseTimer.Stop();
+    _FinishTickTask(WTASK_SESSIONS, taskStartTime);
 
-    /// <li> Handle weather updates when the timer has passed
-    if (m_timers[WUPDATE_WEATHERS].Passed())
-    {
-        ///- Send an update signal to Weather objects
-        for (WeatherMap::iterator itr = m_weathers.begin(); itr != m_weathers.end(); )
-        {
-            ///- and remove Weather objects for zones with no player
-                                                            //As interval > WorldTick
-            if(!itr->second->Update(m_timers[WUPDATE_WEATHERS].GetInterval()))
-            {
-                delete itr->second;
-                m_weathers.erase(itr++);
-            }
-            else
-                ++itr;
-        }
-
-        m_timers[WUPDATE_WEATHERS].SetCurrent(0);
-    }
     /// <li> Update uptime table
     if (m_timers[WUPDATE_UPTIME].Passed())
     {
@@ -1562,9 +1590,18 @@ void World::Update(uint32 diff)
 
     /// <li> Handle all other objects
     ///- Update objects (maps, transport, creatures,...)
+    taskStartTime = WorldTimer::getMSTime();
+    phaseTimer.Start(PERF_WORLD_MAPS);
     sMapMgr.Update(diff);
+    _FinishTickTask(WTASK_MAPS, taskStartTime);
+
+    taskStartTime = WorldTimer::getMSTime();
+    phaseTimer.Next(PERF_WORLD_BATTLEGROUNDS);
     sBattleGroundMgr.Update(diff);
+    phaseTimer.Stop();
+    _FinishTickTask(WTASK_BATTLEGROUNDS, taskStartTime);
     sBattlefieldMgr.Update(diff);
+    sLFGMgr.Update(diff);
 
     ///- Delete all characters which have been deleted X days before
     if (m_timers[WUPDATE_DELETECHARS].Passed())
@@ -1600,11 +1637,165 @@ void World::Update(uint32 diff)
     // update the instance reset times
     sMapPersistentStateMgr.Update();
 
+    ///- AHBot, mass mailer and weather updates, put off while the tick is over its target
+    _UpdateDeferredTasks();
+
     // And last, but not least handle the issued cli commands
     ProcessCliCommands();
 
     //cleanup unused GridMap objects as well as VMaps
     sTerrainMgr.Update(diff);
+
+    // periodic dump of the tick profile, if configured
+    sPerfStatsMgr.Update(diff);
+
+    ++m_tickCount;
+    if (WorldTimer::getMSTimeDiff(m_tickStartTime, WorldTimer::getMSTime()) > getConfig(CONFIG_UINT32_WORLD_TICK_TIME))
+        ++m_tickOverruns;
+}
+
+// a deferred mass mailer run sends at most this many ticks worth of mails
+#define MAX_MASS_MAILER_CATCH_UP_TICKS 4
+
+/// Run the low priority parts of the tick that fit in what is left of WorldTickTime
+void World::_UpdateDeferredTasks()
+{
+    ///- Mark due work as pending, it stays pending until a tick has room for it
+    if (m_timers[WUPDATE_AHBOT].Passed() || sAuctionBot.HasPlannedAuctions())
+        _SetTaskPending(WTASK_AHBOT);
+
+    if (!sMassMailMgr.IsEmpty())
+        _SetTaskPending(WTASK_MASS_MAILER);
+
+    if (m_timers[WUPDATE_WEATHERS].Passed())
+    {
+        m_weatherDiff += m_timers[WUPDATE_WEATHERS].GetInterval();
+        m_timers[WUPDATE_WEATHERS].SetCurrent(0);
+        _SetTaskPending(WTASK_WEATHERS);
+    }
+
+    ///- Cheapest first, so a long AHBot run is the first to be put off
+    if (_CanRunDeferredTask(WTASK_WEATHERS))
+    {
+        uint32 startTime = WorldTimer::getMSTime();
+        _UpdateWeathers(m_weatherDiff);
+        m_weatherDiff = 0;
+        _FinishTickTask(WTASK_WEATHERS, startTime);
+    }
+
+    if (_CanRunDeferredTask(WTASK_MASS_MAILER))
+    {
+        uint32 startTime = WorldTimer::getMSTime();
+        sMassMailMgr.Update(false, std::min(m_taskPendingTicks[WTASK_MASS_MAILER], uint32(MAX_MASS_MAILER_CATCH_UP_TICKS)));
+        _FinishTickTask(WTASK_MASS_MAILER, startTime);
+    }
+
+    if (_CanRunDeferredTask(WTASK_AHBOT))
+    {
+        uint32 startTime = WorldTimer::getMSTime();
+        if (m_timers[WUPDATE_AHBOT].Passed())
+        {
+            m_timers[WUPDATE_AHBOT].Reset();
+            sAuctionBot.Update();
+        }
+
+        ///- Post a batch of the auctions planned by the AHBot seller thread
+        sAuctionBot.ApplyPlannedAuctions();
+        _FinishTickTask(WTASK_AHBOT, startTime);
+    }
+}
+
+void World::_UpdateWeathers(uint32 diff)
+{
+    ///- Send an update signal to Weather objects
+    for (WeatherMap::iterator itr = m_weathers.begin(); itr != m_weathers.end(); )
+    {
+        ///- and remove Weather objects for zones with no player
+        if (!itr->second->Update(diff))
+        {
+            delete itr->second;
+            m_weathers.erase(itr++);
+        }
+        else
+            ++itr;
+    }
+}
+
+void World::_SetTaskPending(WorldTickTask task)
+{
+    if (m_taskPending[task])
+        return;
+
+    m_taskPending[task] = true;
+    m_taskPendingSince[task] = WorldTimer::getMSTime();
+    m_taskPendingTicks[task] = 1;
+}
+
+bool World::_CanRunDeferredTask(WorldTickTask task)
+{
+    if (!m_taskPending[task])
+        return false;
+
+    uint32 now = WorldTimer::getMSTime();
+
+    // budget 0 never defers
+    uint32 budget = getConfig(eConfigUInt32Values(CONFIG_UINT32_TICK_BUDGET_SESSIONS + task));
+    if (!budget || WorldTimer::getMSTimeDiff(m_tickStartTime, now) + budget <= getConfig(CONFIG_UINT32_WORLD_TICK_TIME))
+        return true;
+
+    // shed work must not starve under constant overload
+    if (WorldTimer::getMSTimeDiff(m_taskPendingSince[task], now) >= getConfig(CONFIG_UINT32_TICK_MAX_DEFER_TIME))
+    {
+        ++m_tickTaskStats[task].forced;
+        m_taskPendingTicks[task] = 1;                       // no catch up in a tick already over its target
+        return true;
+    }
+
+    ++m_tickTaskStats[task].deferred;
+    ++m_taskPendingTicks[task];
+    return false;
+}
+
+void World::_FinishTickTask(WorldTickTask task, uint32 startTime)
+{
+    uint32 time = WorldTimer::getMSTimeDiff(startTime, WorldTimer::getMSTime());
+
+    WorldTickTaskStats& stats = m_tickTaskStats[task];
+    ++stats.runs;
+    stats.totalTime += time;
+    if (time > stats.maxTime)
+        stats.maxTime = time;
+
+    uint32 budget = getConfig(eConfigUInt32Values(CONFIG_UINT32_TICK_BUDGET_SESSIONS + task));
+    if (budget && time > budget)
+        ++stats.overruns;
+
+    m_taskPending[task] = false;
+}
+
+void World::ResetTickStats()
+{
+    m_tickCount = 0;
+    m_tickOverruns = 0;
+
+    for (int i = 0; i < WTASK_COUNT; ++i)
+        m_tickTaskStats[i] = WorldTickTaskStats();
+}
+
+char const* World::GetTickTaskName(WorldTickTask task)
+{
+    switch (task)
+    {
+        case WTASK_SESSIONS:        return "sessions";
+        case WTASK_MAPS:            return "maps";
+        case WTASK_BATTLEGROUNDS:   return "battlegrounds";
+        case WTASK_AHBOT:           return "ahbot";
+        case WTASK_MASS_MAILER:     return "mass mailer";
+        case WTASK_WEATHERS:        return "weather";
+        default:                    break;
+    }
+
+    return "unknown";
 }
 
 /// Send a packet to all players (except self if mentioned)
@@ -2010,9 +2201,14 @@ void World::InitResultQueue()
 
 void World::UpdateResultQueue()
 {
+    PerfTimer queueTimer(PERF_WORLD_RESULT_QUEUE);
+
     //process async result queues
+    PerfTimer phaseTimer(PERF_DB_CHARACTER_QUEUE);
     CharacterDatabase.ProcessResultQueue();
+    phaseTimer.Next(PERF_DB_WORLD_QUEUE);
     WorldDatabase.ProcessResultQueue();
+    phaseTimer.Next(PERF_DB_LOGIN_QUEUE);
     LoginDatabase.ProcessResultQueue();
 }
 
@@ -82,6 +82,32 @@ enum WorldTimers
     WUPDATE_COUNT       = 7
 };
 
+/// Parts of the world tick with an own time budget (TickBudget.* config options)
+enum WorldTickTask
+{
+    WTASK_SESSIONS      = 0,
+    WTASK_MAPS          = 1,
+    WTASK_BATTLEGROUNDS = 2,
+    // deferrable work, put off to a later tick while the current one is over its target
+    WTASK_AHBOT         = 3,
+    WTASK_MASS_MAILER   = 4,
+    WTASK_WEATHERS      = 5,
+    WTASK_COUNT         = 6
+};
+
+/// Time spent by one part of the world tick, times in ms
+struct WorldTickTaskStats
+{
+    WorldTickTaskStats() : runs(0), overruns(0), deferred(0), forced(0), totalTime(0), maxTime(0) {}
+
+    uint64 runs;
+    uint64 overruns;                                        // runs longer than the budget
+    uint64 deferred;                                        // ticks a pending run was put off
+    uint64 forced;                                          // runs done without room in the tick after TickBudget.MaxDeferTime
+    uint64 totalTime;
+    uint32 maxTime;
+};
+
 /// Configuration elements
 enum eConfigUInt32Values
 {
@@ -89,6 +115,14 @@ enum eConfigUInt32Values
     CONFIG_UINT32_INTERVAL_SAVE,
     CONFIG_UINT32_INTERVAL_GRIDCLEAN,
     CONFIG_UINT32_INTERVAL_MAPUPDATE,
+    CONFIG_UINT32_WORLD_TICK_TIME,
+    CONFIG_UINT32_TICK_BUDGET_SESSIONS,                     // budgets in WorldTickTask order
+    CONFIG_UINT32_TICK_BUDGET_MAPS,
+    CONFIG_UINT32_TICK_BUDGET_BATTLEGROUNDS,
+    CONFIG_UINT32_TICK_BUDGET_AHBOT,
+    CONFIG_UINT32_TICK_BUDGET_MASS_MAILER,
+    CONFIG_UINT32_TICK_BUDGET_WEATHERS,
+    CONFIG_UINT32_TICK_MAX_DEFER_TIME,
     CONFIG_UINT32_INTERVAL_CHANGEWEATHER,
     CONFIG_UINT32_PORT_WORLD,
     CONFIG_UINT32_GAME_TYPE,
@@ -115,6 +149,8 @@ enum eConfigUInt32Values
     CONFIG_UINT32_START_ARENA_POINTS,
     CONFIG_UINT32_INSTANCE_RESET_TIME_HOUR,
     CONFIG_UINT32_INSTANCE_UNLOAD_DELAY,
+    CONFIG_UINT32_INSTANCE_RESET_BATCH_SIZE,
+    CONFIG_UINT32_INSTANCE_RESET_MAPS_PER_TICK,
     CONFIG_UINT32_MAX_SPELL_CASTS_IN_CHAIN,
     CONFIG_UINT32_BIRTHDAY_TIME,
     CONFIG_UINT32_MAX_PRIMARY_TRADE_SKILL,
@@ -133,6 +169,7 @@ enum eConfigUInt32Values
     CONFIG_UINT32_GROUP_VISIBILITY,
     CONFIG_UINT32_MAIL_DELIVERY_DELAY,
     CONFIG_UINT32_MASS_MAILER_SEND_PER_TICK,
+    CONFIG_UINT32_MAIL_EXPIRE_CHUNK_SIZE,
     CONFIG_UINT32_UPTIME_UPDATE,
     CONFIG_UINT32_AUCTION_DEPOSIT_MIN,
     CONFIG_UINT32_SKILL_CHANCE_ORANGE,
@@ -168,11 +205,16 @@ enum eConfigUInt32Values
     CONFIG_UINT32_BATTLEGROUND_PREMATURE_FINISH_TIMER,
     CONFIG_UINT32_BATTLEGROUND_PREMADE_GROUP_WAIT_FOR_MATCH,
     CONFIG_UINT32_BATTLEGROUND_QUEUE_ANNOUNCER_JOIN,
+    CONFIG_UINT32_BATTLEGROUND_QUEUE_UPDATES_PER_TICK,
     CONFIG_UINT32_ARENA_MAX_RATING_DIFFERENCE,
     CONFIG_UINT32_ARENA_RATING_DISCARD_TIMER,
     CONFIG_UINT32_ARENA_AUTO_DISTRIBUTE_INTERVAL_DAYS,
     CONFIG_UINT32_ARENA_SEASON_ID,
     CONFIG_UINT32_ARENA_SEASON_PREVIOUS_ID,
+    CONFIG_UINT32_LFG_QUEUE_UPDATE_INTERVAL,
+    CONFIG_UINT32_LFG_MAX_MATCHES_PER_UPDATE,
+    CONFIG_UINT32_LFG_ROLECHECK_TIMEOUT,
+    CONFIG_UINT32_LFG_PROPOSAL_TIMEOUT,
     CONFIG_UINT32_CLIENTCACHE_VERSION,
     CONFIG_UINT32_GUILD_EVENT_LOG_COUNT,
     CONFIG_UINT32_GUILD_BANK_EVENT_LOG_COUNT,
@@ -189,6 +231,8 @@ enum eConfigUInt32Values
     CONFIG_UINT32_GUID_RESERVE_SIZE_CREATURE,
     CONFIG_UINT32_GUID_RESERVE_SIZE_GAMEOBJECT,
     CONFIG_UINT32_MIN_LEVEL_FOR_RAID,
+    CONFIG_UINT32_PERF_STATS_CSV_INTERVAL,
+    CONFIG_UINT32_MOVEMENT_FAR_INTERVAL,
     CONFIG_UINT32_VALUE_COUNT
 };
 
@@ -275,6 +319,7 @@ enum eConfigFloatValues
     CONFIG_FLOAT_THREAT_RADIUS,
     CONFIG_FLOAT_GHOST_RUN_SPEED_WORLD,
     CONFIG_FLOAT_GHOST_RUN_SPEED_BG,
+    CONFIG_FLOAT_MOVEMENT_NEAR_DISTANCE,
     CONFIG_FLOAT_VALUE_COUNT
 };
 
@@ -328,6 +373,7 @@ enum eConfigBoolValues
     CONFIG_BOOL_ARENA_AUTO_DISTRIBUTE_POINTS,
     CONFIG_BOOL_ARENA_QUEUE_ANNOUNCER_JOIN,
     CONFIG_BOOL_ARENA_QUEUE_ANNOUNCER_EXIT,
+    CONFIG_BOOL_LFG_ENABLED,
     CONFIG_BOOL_KICK_PLAYER_ON_BAD_PACKET,
     CONFIG_BOOL_STATS_SAVE_ONLY_ON_LOGOUT,
     CONFIG_BOOL_CLEAN_CHARACTER_DB,
@@ -335,6 +381,10 @@ enum eConfigBoolValues
     CONFIG_BOOL_PET_UNSUMMON_AT_MOUNT,
     CONFIG_BOOL_MMAP_ENABLED,
     CONFIG_BOOL_WARDEN_KICK,
+    CONFIG_BOOL_MAP_SHARED_EVENT_WHEEL,
+    CONFIG_BOOL_MAP_CREATURE_SLEEP,
+    CONFIG_BOOL_MAP_UNIT_INDEX,
+    CONFIG_BOOL_PERF_STATS_ENABLE,
     CONFIG_BOOL_VALUE_COUNT
 };
 
@@ -441,7 +491,10 @@ class World
         World();
         ~World();
 
+        typedef UNORDERED_MAP<uint32, WorldSession*> SessionMap;
+
         WorldSession* FindSession(uint32 id) const;
+        SessionMap const& GetAllSessions() const { return m_sessions; }
         void AddSession(WorldSession *s);
         bool RemoveSession(uint32 id);
         /// Get the number of current active sessions
@@ -458,6 +511,13 @@ class World
         Weather* AddWeather(uint32 zone_id);
         void RemoveWeather(uint32 zone_id);
 
+        /// Tick pacing statistics, see TickBudget.* config options
+        WorldTickTaskStats const& GetTickTaskStats(WorldTickTask task) const { return m_tickTaskStats[task]; }
+        uint64 GetTickCount() const { return m_tickCount; }
+        uint64 GetTickOverrunCount() const { return m_tickOverruns; }
+        void ResetTickStats();
+        static char const* GetTickTaskName(WorldTickTask task);
+
         /// Get the active session server limit (or security level limitations)
         uint32 GetPlayerAmountLimit() const { return m_playerLimit >= 0 ? m_playerLimit : 0; }
         AccountTypes GetPlayerSecurityLimit() const { return m_playerLimit <= 0 ? AccountTypes(-m_playerLimit) : SEC_PLAYER; }
@@ -595,6 +655,12 @@ class World
         void ResetWeeklyQuests();
         void ResetMonthlyQuests();
 
+        void _UpdateDeferredTasks();
+        void _UpdateWeathers(uint32 diff);
+        void _SetTaskPending(WorldTickTask task);
+        bool _CanRunDeferredTask(WorldTickTask task);
+        void _FinishTickTask(WorldTickTask task, uint32 startTime);
+
     private:
         void setConfig(eConfigUInt32Values index, char const* fieldname, uint32 defvalue);
         void setConfig(eConfigInt32Values index, char const* fieldname, int32 defvalue);
@@ -623,9 +689,18 @@ class World
         uint32 mail_timer;
         uint32 mail_timer_expires;
 
+        // tick pacing
+        uint32 m_tickStartTime;                             // getMSTime() at start of the current tick
+        uint64 m_tickCount;
+        uint64 m_tickOverruns;                              // ticks longer than WorldTickTime
+        WorldTickTaskStats m_tickTaskStats[WTASK_COUNT];
+        bool m_taskPending[WTASK_COUNT];                    // deferrable work waiting for room in a tick
+        uint32 m_taskPendingSince[WTASK_COUNT];
+        uint32 m_taskPendingTicks[WTASK_COUNT];             // ticks of work the next run has to catch up
+        uint32 m_weatherDiff;                               // weather time not applied yet
+
         typedef UNORDERED_MAP<uint32, Weather*> WeatherMap;
         WeatherMap m_weathers;
-        typedef UNORDERED_MAP<uint32, WorldSession*> SessionMap;
         SessionMap m_sessions;
         uint32 m_maxActiveSessionCount;
         uint32 m_maxQueuedSessionCount;
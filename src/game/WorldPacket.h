@@ -48,6 +48,20 @@ class WorldPacket : public ByteBuffer
         {
         }
 
+        // packets created by the network threads are deleted by the world threads, recycle the objects
+        // through the same pools as their storage
+        static void* operator new(size_t size) { return PacketBufferPool::Allocate(size); }
+        static void* operator new(size_t size, std::nothrow_t const&) throw()
+        {
+            try { return PacketBufferPool::Allocate(size); }
+            catch (std::bad_alloc&) { return NULL; }
+        }
+        // sized, so a derived class deleted through its own type goes back to the size class new took it from
+        static void operator delete(void* p, size_t size) { PacketBufferPool::Deallocate(p, size); }
+        // only reached when a constructor throws after the nothrow new, the size is unknown here; every pool
+        // block comes from the global operator new, so it can go straight back to the heap
+        static void operator delete(void* p, std::nothrow_t const&) throw() { ::operator delete(p); }
+
         void Initialize(Opcodes enumVal, size_t newres=200)
         {
             Initialize(LookupOpcodeNumber(enumVal), newres);
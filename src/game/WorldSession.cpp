@@ -35,6 +35,7 @@
 #include "GuildMgr.h"
 #include "World.h"
 #include "BattleGroundMgr.h"
+#include "LFGMgr.h"
 #include "MapManager.h"
 #include "SocialMgr.h"
 #include "Auth/AuthCrypt.h"
@@ -178,6 +179,12 @@ void WorldSession::SendPacket(WorldPacket const* packet)
     if (strcmp(opcodeTable[packet->GetOpcode()].name, "UNKNOWN") == 0)
         sLog.outError("Sent unknown opcode %X to account %u player %s", packet->GetOpcode(), GetAccountId(), GetPlayer() ? GetPlayer()->GetGuidStr().c_str() : "UNKNOWN");
 
+    if (sPerfStatsMgr.IsEnabled())
+    {
+        ++m_perfCounters.sentPackets;
+        m_perfCounters.sentBytes += packet->size();
+    }
+
     if (m_Socket->SendPacket (*packet) == -1)
         m_Socket->CloseSocket ();
 }
@@ -214,8 +221,13 @@ bool WorldSession::Update(PacketFilter& updater)
     WorldPacket* packet;
     while (m_Socket && !m_Socket->IsClosed() && _recvQueue.next(packet, updater))
     {
+        if (sPerfStatsMgr.IsEnabled())
+        {
+            ++m_perfCounters.recvPackets;
+            m_perfCounters.recvBytes += packet->size();
+            sPerfStatsMgr.AddIncomingPacket(packet->GetOpcode(), packet->size());
+        }
 
-        
         OpcodeHandler const& opHandle = opcodeTable[packet->GetOpcode()];
 
         try
@@ -427,6 +439,9 @@ void WorldSession::LogoutPlayer(bool Save)
             }
         }
 
+        ///- Leave dungeon finder queue, role check or pending proposal
+        sLFGMgr.OnPlayerLogout(_player);
+
         ///- Reset the online field in the account table
         // no point resetting online in character table here as Player::SaveToDB() will set it to 1 since player has not been removed from world at this stage
         // No SQL injection as AccountID is uint32
@@ -952,6 +967,11 @@ void WorldSession::ExecuteOpcode( OpcodeHandler const& opHandle, WorldPacket* pa
     if (_player)
         _player->SetCanDelayTeleport(true);
 
+    bool profile = sPerfStatsMgr.IsEnabled();
+    ACE_Time_Value start;
+    if (profile)
+        start = ACE_OS::gettimeofday();
+
     (this->*opHandle.handler)(*packet);
 
     if (_player)
@@ -965,6 +985,20 @@ void WorldSession::ExecuteOpcode( OpcodeHandler const& opHandle, WorldPacket* pa
             _player->TeleportTo(_player->m_teleport_dest, _player->m_teleport_options);
     }
 
+    // delayed teleport is charged to the opcode that caused it
+    if (profile)
+    {
+        uint32 usec = PerfStatsMgr::GetElapsedTime(start);
+        sPerfStatsMgr.AddHandlerSample(packet->GetOpcode(), usec);
+
+        m_perfCounters.handlerTime += usec;
+        if (usec > m_perfCounters.maxHandlerTime)
+        {
+            m_perfCounters.maxHandlerTime = usec;
+            m_perfCounters.maxHandlerOpcode = packet->GetOpcode();
+        }
+    }
+
     if (packet->rpos() < packet->wpos() && sLog.HasLogLevelOrHigher(LOG_LVL_DEBUG))
         LogUnprocessedTail(packet);
 }
@@ -42,6 +42,7 @@
 #include "WorldSession.h"
 #include "WorldSocketMgr.h"
 #include "Log.h"
+#include "PerfStatsMgr.h"
 #include "DBCStores.h"
 
 #if defined( __GNUC__ )
@@ -168,6 +169,8 @@ int WorldSocket::SendPacket(const WorldPacket& pct)
     // Dump outgoing packet.
     sLog.outWorldPacketDump(uint32(get_handle()), pct.GetOpcode(), LookupOpcodeName(pct.GetOpcode()), &pct, false);
 
+    sPerfStatsMgr.AddOutgoingPacket(pct.GetOpcode(), pct.size());
+
     ServerPktHeader header(pct.size()+2, pct.GetOpcode());
     m_Crypt.EncryptSend((uint8*)header.header, header.getHeaderLength());
 
@@ -185,6 +185,7 @@ class ReactorRunnable : protected ACE_Task_Base
             }
 
             WorldDatabase.ThreadEnd();
+            PacketBufferPool::ReleaseThreadCache();
 
             DEBUG_LOG ("Network Thread Exitting");
 
@@ -32,6 +32,7 @@
 #include "ObjectMgr.h"
 #include "ObjectGuid.h"
 #include "SpellMgr.h"
+#include "MovementStructures.h"
 
 bool ChatHandler::HandleDebugSendSpellFailCommand(char* args)
 {
@@ -1041,6 +1042,85 @@ bool ChatHandler::HandleDebugModValueCommand(char* args)
     return HandlerDebugModValueHelper(target, field, typeStr, valStr);
 }
 
+#define MOVEMENT_CODEC_OPCODE(opcode, sequence) opcode,
+
+// Writes a sample MovementInfo with every sequence, reads it back and writes it again.
+// The reader must consume exactly what the writer produced and both writes must be identical.
+bool ChatHandler::HandleDebugMoveCodecCommand(char* /*args*/)
+{
+    // the sequence list still names some 3.3.5a opcodes, only those that resolve back to themselves are reachable
+    static uint32 const opcodes[] = { MOVEMENT_SEQUENCES(MOVEMENT_CODEC_OPCODE) };
+
+    MovementInfo samples[3];
+    for (int i = 0; i < 3; ++i)
+    {
+        samples[i].guid = m_session->GetPlayer()->GetObjectGuid();
+        samples[i].time = 123456 + i;
+        samples[i].ChangePosition(-8913.25f, 554.5f, 93.125f, 1.5f);
+    }
+
+    // swimming with pitch, falling with direction and spline elevation
+    samples[1].moveFlags = MOVEFLAG_FORWARD | MOVEFLAG_SWIMMING | MOVEFLAG_SAFE_FALL | MOVEFLAG_SPLINE_ELEVATION;
+    samples[1].moveFlags2 = MOVEFLAG2_INTERP_TURNING;
+    samples[1].s_pitch = 0.25f;
+    samples[1].fallTime = 750;
+    samples[1].jump.velocity = -7.5f;
+    samples[1].jump.sinAngle = 0.5f;
+    samples[1].jump.cosAngle = 0.75f;
+    samples[1].jump.xyspeed = 7.0f;
+    samples[1].splineElevation = 2.5f;
+
+    // on a transport, skipped while the player is on one because reading it moves the transport
+    samples[2].moveFlags = MOVEFLAG_ONTRANSPORT;
+    samples[2].moveFlags2 = MOVEFLAG2_INTERP_MOVEMENT;
+    samples[2].SetTransportData(ObjectGuid(HIGHGUID_MO_TRANSPORT, uint32(1)), -8913.25f, 554.5f, 93.125f, 1.5f, 654321, 0);
+    samples[2].t_time2 = 654000;
+    int numSamples = m_session->GetPlayer()->GetTransport() ? 2 : 3;
+
+    uint32 checked = 0;
+    uint32 failed = 0;
+    for (size_t i = 0; i < countof(opcodes); ++i)
+    {
+        if (opcodes[i] >= MAX_OPCODE_VALUE || WorldPacket(Opcodes(opcodes[i]), 0).GetOpcodeEnum() != Opcodes(opcodes[i]))
+            continue;
+
+        ++checked;
+        for (int j = 0; j < numSamples; ++j)
+        {
+            WorldPacket first(Opcodes(opcodes[i]));
+            m_session->WriteMovementInfo(first, &samples[j]);
+
+            MovementInfo read;
+            bool ok = true;
+            try
+            {
+                m_session->ReadMovementInfo(first, &read);
+            }
+            catch (ByteBufferException &)
+            {
+                ok = false;
+            }
+
+            WorldPacket second(Opcodes(opcodes[i]));
+            m_session->WriteMovementInfo(second, &read);
+
+            ok = ok && first.rpos() == first.wpos() && read.guid == samples[j].guid &&
+                first.wpos() == second.wpos() && memcmp(first.contents(), second.contents(), first.wpos()) == 0;
+            if (!ok)
+            {
+                PSendSysMessage("%s (sample %i): wrote " SIZEFMTD " bytes, read " SIZEFMTD ", rewrote " SIZEFMTD,
+                    LookupOpcodeName(first.GetOpcode()), j, first.wpos(), first.rpos(), second.wpos());
+                ++failed;
+            }
+        }
+    }
+
+    PSendSysMessage("Movement codecs: %u of " SIZEFMTD " sequences checked, %u mismatches", checked, countof(opcodes), failed);
+    return true;
+}
+
+#undef MOVEMENT_CODEC_OPCODE
+
 bool ChatHandler::HandleDebugSpellCoefsCommand(char* args)
 {
     uint32 spellid = ExtractSpellIdFromLink(&args);
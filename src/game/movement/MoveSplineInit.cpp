@@ -54,6 +54,7 @@ namespace Movement
     int32 MoveSplineInit::Launch()
     {
         MoveSpline& move_spline = *unit.movespline;
+        unit.WakeUp();
 
         Location real_position(unit.GetPositionX(),unit.GetPositionY(),unit.GetPositionZ(),unit.GetOrientation());
         // there is a big chane that current position is unknown if current state is not finalized, need compute it
@@ -88,10 +89,21 @@ namespace Movement
         unit.m_movementInfo.SetMovementFlags((MovementFlags)moveFlags);
         move_spline.Initialize(args);
 
-        WorldPacket data(SMSG_MONSTER_MOVE, 64);
-        data << unit.GetPackGUID();
-        PacketBuilder::WriteMonsterMove(move_spline, data);
-        unit.SendMessageToSet(&data,true);
+        // creature splines go out with the other splines of the map tick, grouped by observers
+        if (unit.GetTypeId() == TYPEID_UNIT && unit.IsInWorld())
+        {
+            WorldPacket* data = new WorldPacket(SMSG_MONSTER_MOVE, 64);
+            *data << unit.GetPackGUID();
+            PacketBuilder::WriteMonsterMove(move_spline, *data);
+            unit.GetMap()->QueueSplineBroadcast(&unit, data);
+        }
+        else
+        {
+            WorldPacket data(SMSG_MONSTER_MOVE, 64);
+            data << unit.GetPackGUID();
+            PacketBuilder::WriteMonsterMove(move_spline, data);
+            unit.SendMessageToSet(&data,true);
+        }
 
         return move_spline.Duration();
     }
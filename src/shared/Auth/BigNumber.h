@@ -80,6 +80,7 @@ class BigNumber
         int GetNumBytes(void);
 
         struct bignum_st *BN() { return _bn; }
+        struct bignum_st const* BN() const { return _bn; }
 
         uint32 AsDword();
         uint8* AsByteArray(int minSize = 0, bool reverse = true);
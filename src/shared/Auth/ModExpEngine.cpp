@@ -0,0 +1,131 @@
+/*
+ * Copyright (C) 2010-2012 Strawberry-Pr0jcts <http://strawberry-pr0jcts.com/>
+ * Copyright (C) 2005-2011 MaNGOS <http://getmangos.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#include "Auth/ModExpEngine.h"
+#include <openssl/bn.h>
+
+ModExpEngine::ModExpEngine(BigNumber const& base, BigNumber const& mod, int maxExpBits, int windowBits)
+    : m_base(base), m_mod(mod), m_windowBits(windowBits), m_windowCount((maxExpBits + windowBits - 1) / windowBits)
+{
+    BN_CTX* bnctx = BN_CTX_new();
+
+    m_mont = BN_MONT_CTX_new();
+    BN_MONT_CTX_set(m_mont, m_mod.BN(), bnctx);
+
+    m_montOne = BN_new();
+    BN_one(m_montOne);
+    BN_to_montgomery(m_montOne, m_montOne, m_mont, bnctx);
+
+    uint32 windowSize = 1 << m_windowBits;
+    m_entryBytes = BN_num_bytes(m_mod.BN());
+    m_table.resize(m_windowCount * windowSize * m_entryBytes, 0);
+
+    // base^(2^(i * windowBits)) in Montgomery form, squared windowBits times per window
+    BIGNUM* windowBase = BN_new();
+    BN_nnmod(windowBase, m_base.BN(), m_mod.BN(), bnctx);
+    BN_to_montgomery(windowBase, windowBase, m_mont, bnctx);
+
+    BIGNUM* power = BN_new();
+    for (int i = 0; i < m_windowCount; ++i)
+    {
+        BN_copy(power, m_montOne);
+        for (uint32 d = 0; d < windowSize; ++d)
+        {
+            if (d)
+                BN_mod_mul_montgomery(power, power, windowBase, m_mont, bnctx);
+
+            // right aligned, the leading bytes stay zero
+            uint8* entry = &m_table[(i * windowSize + d) * m_entryBytes];
+            BN_bn2bin(power, entry + m_entryBytes - BN_num_bytes(power));
+        }
+
+        for (int k = 0; k < m_windowBits; ++k)
+            BN_mod_mul_montgomery(windowBase, windowBase, windowBase, m_mont, bnctx);
+    }
+
+    BN_free(power);
+    BN_free(windowBase);
+    BN_CTX_free(bnctx);
+}
+
+ModExpEngine::~ModExpEngine()
+{
+    BN_free(m_montOne);
+    BN_MONT_CTX_free(m_mont);
+}
+
+BigNumber ModExpEngine::ModExp(BigNumber const& exp) const
+{
+    BIGNUM const* e = exp.BN();
+    int numBits = BN_num_bits(e);
+    if (BN_is_negative(e) || numBits > m_windowCount * m_windowBits)
+        return ModExp(m_base, exp);
+
+    BigNumber ret;
+    BN_CTX* bnctx = BN_CTX_new();
+
+    BN_copy(ret.BN(), m_montOne);
+
+    uint32 windowSize = 1 << m_windowBits;
+    std::vector<uint8> selected(m_entryBytes);
+    BIGNUM* factor = BN_new();
+
+    // all windows, the zero ones included, so the work does not depend on the exponent length or digits
+    for (int i = 0; i < m_windowCount; ++i)
+    {
+        // collect the exponent bits of this window, at most windowBits wide
+        uint32 digit = 0;
+        for (int k = m_windowBits - 1; k >= 0; --k)
+            digit = (digit << 1) | uint32(BN_is_bit_set(e, i * m_windowBits + k) != 0);
+
+        // read the whole row and keep only the entry of this digit, no branch or index depends on it
+        std::fill(selected.begin(), selected.end(), 0);
+        uint8 const* row = &m_table[i * windowSize * m_entryBytes];
+        for (uint32 d = 0; d < windowSize; ++d)
+        {
+            uint32 diff = d ^ digit;
+            uint8 mask = uint8(((diff | (0 - diff)) >> 31) - 1);   // 0xFF when d == digit, else 0
+
+            uint8 const* entry = row + d * m_entryBytes;
+            for (int b = 0; b < m_entryBytes; ++b)
+                selected[b] |= entry[b] & mask;
+        }
+
+        BN_bin2bn(&selected[0], m_entryBytes, factor);
+        BN_mod_mul_montgomery(ret.BN(), ret.BN(), factor, m_mont, bnctx);
+    }
+
+    BN_free(factor);
+    BN_from_montgomery(ret.BN(), ret.BN(), m_mont, bnctx);
+    BN_CTX_free(bnctx);
+
+    return ret;
+}
+
+BigNumber ModExpEngine::ModExp(BigNumber const& base, BigNumber const& exp) const
+{
+    BigNumber ret;
+    BN_CTX* bnctx = BN_CTX_new();
+
+    BN_mod_exp_mont(ret.BN(), base.BN(), exp.BN(), m_mod.BN(), bnctx, m_mont);
+
+    BN_CTX_free(bnctx);
+    return ret;
+}
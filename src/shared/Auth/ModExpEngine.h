@@ -0,0 +1,66 @@
+/*
+ * Copyright (C) 2010-2012 Strawberry-Pr0jcts <http://strawberry-pr0jcts.com/>
+ * Copyright (C) 2005-2011 MaNGOS <http://getmangos.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#ifndef _AUTH_MODEXPENGINE_H
+#define _AUTH_MODEXPENGINE_H
+
+#include "Common.h"
+#include "Auth/BigNumber.h"
+
+struct bignum_st;
+struct bn_mont_ctx_st;
+
+/// Modular exponentiation with a fixed base and modulus
+/// The Montgomery context of the modulus is built once and shared by all callers,
+/// powers of the base are precomputed per exponent window so base^exp needs
+/// one Montgomery multiplication per window and no squarings at all.
+/// Every window is multiplied and every table row is read in full whatever the
+/// exponent is, so the secret exponent does not show in the timing or the memory access.
+/// Read-only after construction, safe to use from several threads.
+class ModExpEngine
+{
+    public:
+        ModExpEngine(BigNumber const& base, BigNumber const& mod, int maxExpBits, int windowBits = 4);
+        ~ModExpEngine();
+
+        /// base^exp % mod, exponents wider than maxExpBits fall back to ModExp(base, exp)
+        BigNumber ModExp(BigNumber const& exp) const;
+        /// any other base^exp % mod, still reusing the Montgomery context of the modulus
+        BigNumber ModExp(BigNumber const& base, BigNumber const& exp) const;
+
+        BigNumber const& GetBase() const { return m_base; }
+        BigNumber const& GetMod() const { return m_mod; }
+
+    private:
+        ModExpEngine(ModExpEngine const&);
+        ModExpEngine& operator=(ModExpEngine const&);
+
+        BigNumber m_base;
+        BigNumber m_mod;
+        int m_windowBits;
+        int m_windowCount;
+
+        struct bn_mont_ctx_st* m_mont;
+        struct bignum_st* m_montOne;                        ///< 1 in Montgomery form
+        int m_entryBytes;                                   ///< big endian width of one table entry, the width of mod
+        /// entry i * 2^windowBits + d = base^(d * 2^(i * windowBits)) in Montgomery form, zero padded to m_entryBytes
+        std::vector<uint8> m_table;
+};
+#endif
@@ -22,6 +22,7 @@
 #include "Common.h"
 #include "Log.h"
 #include "Utilities/ByteConverter.h"
+#include "PacketBufferPool.h"
 
 
 
@@ -98,6 +99,9 @@ class ByteBuffer
     public:
         const static size_t DEFAULT_SIZE = 0x1000;
 
+        // packet contents come from the size classed pools, see PacketBufferPool.h
+        typedef std::vector<uint8, PacketAllocator<uint8> > StorageType;
+
         // constructor
         ByteBuffer(): _rpos(0), _wpos(0), _bitpos(8), _curbitval(0)
         {
@@ -698,7 +702,7 @@ class ByteBuffer
     protected:
         size_t _rpos, _wpos, _bitpos;
         uint8 _curbitval;
-        std::vector<uint8> _storage;
+        StorageType _storage;
 };
 
 template <typename T>
@@ -137,6 +137,22 @@ bool Database::Initialize(const char * infoString, int nConns /*= 1*/)
         m_pQueryConnections.push_back(pConn);
     }
 
+    //query holder parts get connections of their own, so they never hold a pooled connection the world thread waits on
+    if(m_nQueryConnPoolSize >= 2)
+    {
+        for (int i = 0; i < m_nQueryConnPoolSize; ++i)
+        {
+            SqlConnection * pConn = CreateConnection();
+            if(!pConn->Initialize(infoString))
+            {
+                delete pConn;
+                return false;
+            }
+
+            m_pHolderConnections.push_back(pConn);
+        }
+    }
+
     //create and initialize connection for async requests
     m_pAsyncConn = CreateConnection();
     if(!m_pAsyncConn->Initialize(infoString))
@@ -169,6 +185,10 @@ void Database::StopServer()
 
     m_pQueryConnections.clear();
 
+    for (size_t i = 0; i < m_pHolderConnections.size(); ++i)
+        delete m_pHolderConnections[i];
+
+    m_pHolderConnections.clear();
 }
 
 SqlDelayThread * Database::CreateDelayThread()
@@ -184,6 +204,14 @@ void Database::InitDelayThread()
     //New delay thread for delay execute
     m_threadBody = CreateDelayThread();              // will deleted at m_delayThread delete
     m_delayThread = new ACE_Based::Thread(m_threadBody);
+
+    //holder connections only exist when the pool has more than one connection
+    for (size_t i = 0; i < m_pHolderConnections.size(); ++i)
+    {
+        SqlDelayThread * worker = new SqlDelayThread(this, m_pHolderConnections[i], false);
+        m_holderWorkers.push_back(worker);
+        m_holderWorkerThreads.push_back(new ACE_Based::Thread(worker));
+    }
 }
 
 void Database::HaltDelayThread()
@@ -195,6 +223,17 @@ void Database::HaltDelayThread()
     delete m_delayThread;                                   //This also deletes m_threadBody
     m_delayThread = NULL;
     m_threadBody = NULL;
+
+    //halted after the delay thread, which may still hand them holder parts while flushing
+    for (size_t i = 0; i < m_holderWorkerThreads.size(); ++i)
+    {
+        m_holderWorkers[i]->Stop();
+        m_holderWorkerThreads[i]->wait();
+        delete m_holderWorkerThreads[i];
+    }
+
+    m_holderWorkerThreads.clear();
+    m_holderWorkers.clear();
 }
 
 void Database::ThreadStart()
@@ -249,6 +288,12 @@ void Database::Ping()
         SqlConnection::Lock guard(m_pQueryConnections[i]);
         delete guard->Query(sql);
     }
+
+    for (size_t i = 0; i < m_pHolderConnections.size(); ++i)
+    {
+        SqlConnection::Lock guard(m_pHolderConnections[i]);
+        delete guard->Query(sql);
+    }
 }
 
 bool Database::PExecuteLog(const char * format,...)
@@ -437,10 +482,10 @@ bool Database::CommitTransactionDirect()
 
     //directly execute SqlTransaction
     SqlTransaction * pTrans = m_TransStorage->detach();
-    pTrans->Execute(m_pAsyncConn);
+    bool res = pTrans->Execute(m_pAsyncConn);
     delete pTrans;
 
-    return true;
+    return res;
 }
 
 bool Database::RollbackTransaction()
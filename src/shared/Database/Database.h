@@ -288,6 +288,11 @@ class Database
         SqlDelayThread *    m_threadBody;                    ///< Pointer to delay sql executer (owned by m_delayThread)
         ACE_Based::Thread * m_delayThread;                   ///< Pointer to executer thread
 
+        //query holders are split over dedicated connections, one executer per connection, as many as the query pool
+        SqlConnectionContainer m_pHolderConnections;
+        std::vector<SqlDelayThread*> m_holderWorkers;        ///< Holder part executers (owned by m_holderWorkerThreads)
+        std::vector<ACE_Based::Thread*> m_holderWorkerThreads;
+
         bool m_bAllowAsyncTransactions;                      ///< flag which specifies if async transactions are enabled
 
         //PREPARED STATEMENT REGISTRY
@@ -22,6 +22,7 @@
 #include "Util.h"
 #include "Policies/SingletonImp.h"
 #include "Platform/Define.h"
+#include "Policies/MemoryStats.h"
 #include "Threading.h"
 #include "DatabaseEnv.h"
 #include "Timer.h"
@@ -212,6 +213,8 @@ bool MySQLConnection::_Query(const char *sql, MYSQL_RES **pResult, MYSQL_FIELD *
 
 QueryResult* MySQLConnection::Query(const char *sql)
 {
+    MemoryTagScope memoryTag(MEMORY_TAG_DATABASE);
+
     MYSQL_RES *result = NULL;
     MYSQL_FIELD *fields = NULL;
     uint64 rowCount = 0;
@@ -228,6 +231,8 @@ QueryResult* MySQLConnection::Query(const char *sql)
 
 QueryNamedResult* MySQLConnection::QueryNamed(const char *sql)
 {
+    MemoryTagScope memoryTag(MEMORY_TAG_DATABASE);
+
     MYSQL_RES *result = NULL;
     MYSQL_FIELD *fields = NULL;
     uint64 rowCount = 0;
@@ -21,6 +21,7 @@
 #include "Util.h"
 #include "Policies/SingletonImp.h"
 #include "Platform/Define.h"
+#include "Policies/MemoryStats.h"
 #include "Threading.h"
 #include "DatabaseEnv.h"
 #include "Database/SqlOperations.h"
@@ -135,6 +136,8 @@ bool PostgreSQLConnection::_Query(const char *sql, PGresult** pResult, uint64* p
 
 QueryResult* PostgreSQLConnection::Query(const char *sql)
 {
+    MemoryTagScope memoryTag(MEMORY_TAG_DATABASE);
+
     if (!mPGconn)
         return NULL;
 
@@ -153,6 +156,8 @@ QueryResult* PostgreSQLConnection::Query(const char *sql)
 
 QueryNamedResult* PostgreSQLConnection::QueryNamed(const char *sql)
 {
+    MemoryTagScope memoryTag(MEMORY_TAG_DATABASE);
+
     if (!mPGconn)
         return NULL;
 
@@ -21,7 +21,7 @@
 #include "Database/SqlOperations.h"
 #include "DatabaseEnv.h"
 
-SqlDelayThread::SqlDelayThread(Database* db, SqlConnection* conn) : m_dbEngine(db), m_dbConnection(conn), m_running(true)
+SqlDelayThread::SqlDelayThread(Database* db, SqlConnection* conn, bool pingDb) : m_dbEngine(db), m_dbConnection(conn), m_running(true), m_pingDb(pingDb)
 {
 }
 
@@ -50,7 +50,7 @@ void SqlDelayThread::run()
 
         ProcessRequests();
 
-        if((loopCounter++) >= pingEveryLoop)
+        if(m_pingDb && (loopCounter++) >= pingEveryLoop)
         {
             loopCounter = 0;
             m_dbEngine->Ping();
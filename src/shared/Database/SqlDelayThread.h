@@ -38,12 +38,13 @@ class SqlDelayThread : public ACE_Based::Runnable
         Database* m_dbEngine;                               ///< Pointer to used Database engine
         SqlConnection * m_dbConnection;                     ///< Pointer to DB connection
         volatile bool m_running;
+        bool m_pingDb;                                      ///< Keep the database connections alive from this thread
 
         //process all enqueued requests
         void ProcessRequests();
 
     public:
-        SqlDelayThread(Database* db, SqlConnection* conn);
+        SqlDelayThread(Database* db, SqlConnection* conn, bool pingDb = true);
         ~SqlDelayThread();
 
         ///< Put sql statement to delay queue
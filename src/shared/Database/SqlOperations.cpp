@@ -108,14 +108,14 @@ void SqlResultQueue::Update()
     }
 }
 
-bool SqlQueryHolder::Execute(Strawberry::IQueryCallback * callback, SqlDelayThread *thread, SqlResultQueue *queue)
+bool SqlQueryHolder::Execute(Strawberry::IQueryCallback * callback, SqlDelayThread *thread, SqlResultQueue *queue, SqlDelayThreadList const* workers)
 {
     if(!callback || !thread || !queue)
         return false;
 
     /// delay the execution of the queries, sync them with the delay thread
     /// which will in turn resync on execution (via the queue) and call back
-    SqlQueryHolderEx *holderEx = new SqlQueryHolderEx(this, callback, queue);
+    SqlQueryHolderEx *holderEx = new SqlQueryHolderEx(this, callback, queue, workers);
     thread->Delay(holderEx);
     return true;
 }
@@ -213,9 +213,30 @@ bool SqlQueryHolderEx::Execute(SqlConnection *conn)
     if(!m_holder || !m_callback || !m_queue)
         return false;
 
-    LOCK_DB_CONN(conn);
     /// we can do this, we are friends
     std::vector<SqlQueryHolder::SqlResultPair> &queries = m_holder->m_queries;
+
+    /// everything queued on the delay thread before this holder is already executed here,
+    /// so the queries may now run concurrently on the holder connections without reading stale data
+    size_t nParts = m_workers ? m_workers->size() : 0;
+    if(nParts > queries.size())
+        nParts = queries.size();
+
+    if(nParts > 1)
+    {
+        SqlQueryHolderBatch *batch = new SqlQueryHolderBatch(m_callback, m_queue, long(nParts));
+        for(size_t p = 0; p < nParts; ++p)
+        {
+            SqlQueryHolderPart *part = new SqlQueryHolderPart(m_holder, batch);
+            for(size_t i = p; i < queries.size(); i += nParts)
+                if(queries[i].first) part->AddIndex(i);
+
+            (*m_workers)[p]->Delay(part);
+        }
+        return true;
+    }
+
+    LOCK_DB_CONN(conn);
     for(size_t i = 0; i < queries.size(); i++)
     {
         /// execute all queries in the holder and pass the results
@@ -228,3 +249,30 @@ bool SqlQueryHolderEx::Execute(SqlConnection *conn)
 
     return true;
 }
+
+void SqlQueryHolderBatch::PartDone()
+{
+    if(--m_pending > 0)
+        return;
+
+    /// sync with the caller thread
+    m_queue->add(m_callback);
+    delete this;
+}
+
+bool SqlQueryHolderPart::Execute(SqlConnection *conn)
+{
+    if(!m_holder || !m_batch)
+        return false;
+
+    {
+        LOCK_DB_CONN(conn);
+        std::vector<SqlQueryHolder::SqlResultPair> &queries = m_holder->m_queries;
+        /// each part owns its own indexes, the results vector itself is never resized here
+        for(size_t i = 0; i < m_indexes.size(); ++i)
+            m_holder->SetResult(m_indexes[i], conn->Query(queries[m_indexes[i]].first));
+    }
+
+    m_batch->PartDone();
+    return true;
+}
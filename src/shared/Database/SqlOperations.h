@@ -23,6 +23,7 @@
 #include "Common.h"
 
 #include "ace/Thread_Mutex.h"
+#include "ace/Atomic_Op.h"
 #include "LockedQueue.h"
 #include <queue>
 #include "Utilities/Callback.h"
@@ -88,6 +89,10 @@ class QueryResult;                                          /// the result of on
 class SqlResultQueue;                                       /// queue for thread sync
 class SqlQueryHolder;                                       /// groups several async quries
 class SqlQueryHolderEx;                                     /// points to a holder, added to the delay thread
+class SqlQueryHolderBatch;                                  /// completion state of a holder split over the holder connections
+class SqlQueryHolderPart;                                   /// slice of a split holder, added to a holder worker
+
+typedef std::vector<SqlDelayThread*> SqlDelayThreadList;
 
 class SqlResultQueue : public ACE_Based::LockedQueue<Strawberry::IQueryCallback* , ACE_Thread_Mutex>
 {
@@ -112,6 +117,7 @@ class SqlQuery : public SqlOperation
 class SqlQueryHolder
 {
     friend class SqlQueryHolderEx;
+    friend class SqlQueryHolderPart;
     private:
         typedef std::pair<const char*, QueryResult*> SqlResultPair;
         std::vector<SqlResultPair> m_queries;
@@ -123,7 +129,7 @@ class SqlQueryHolder
         void SetSize(size_t size);
         QueryResult* GetResult(size_t index);
         void SetResult(size_t index, QueryResult *result);
-        bool Execute(Strawberry::IQueryCallback * callback, SqlDelayThread *thread, SqlResultQueue *queue);
+        bool Execute(Strawberry::IQueryCallback * callback, SqlDelayThread *thread, SqlResultQueue *queue, SqlDelayThreadList const* workers = NULL);
 };
 
 class SqlQueryHolderEx : public SqlOperation
@@ -132,9 +138,36 @@ class SqlQueryHolderEx : public SqlOperation
         SqlQueryHolder * m_holder;
         Strawberry::IQueryCallback * m_callback;
         SqlResultQueue * m_queue;
+        SqlDelayThreadList const* m_workers;
+    public:
+        SqlQueryHolderEx(SqlQueryHolder *holder, Strawberry::IQueryCallback * callback, SqlResultQueue * queue, SqlDelayThreadList const* workers)
+            : m_holder(holder), m_callback(callback), m_queue(queue), m_workers(workers) {}
+        bool Execute(SqlConnection *conn);
+};
+
+class SqlQueryHolderBatch
+{
+    private:
+        Strawberry::IQueryCallback * m_callback;
+        SqlResultQueue * m_queue;
+        ACE_Atomic_Op<ACE_Thread_Mutex, long> m_pending;
+    public:
+        SqlQueryHolderBatch(Strawberry::IQueryCallback * callback, SqlResultQueue * queue, long parts)
+            : m_callback(callback), m_queue(queue), m_pending(parts) {}
+        /// the last finished part hands the holder back to the caller thread
+        void PartDone();
+};
+
+class SqlQueryHolderPart : public SqlOperation
+{
+    private:
+        SqlQueryHolder * m_holder;
+        SqlQueryHolderBatch * m_batch;
+        std::vector<size_t> m_indexes;
     public:
-        SqlQueryHolderEx(SqlQueryHolder *holder, Strawberry::IQueryCallback * callback, SqlResultQueue * queue)
-            : m_holder(holder), m_callback(callback), m_queue(queue) {}
+        SqlQueryHolderPart(SqlQueryHolder *holder, SqlQueryHolderBatch *batch)
+            : m_holder(holder), m_batch(batch) {}
+        void AddIndex(size_t index) { m_indexes.push_back(index); }
         bool Execute(SqlConnection *conn);
 };
 #endif                                                      //__SQLOPERATIONS_H
@@ -166,8 +166,10 @@ class Log : public Strawberry::Singleton<Log, Strawberry::ClassLevelLockable<Log
         bool IsIncludeTime() const { return m_includeTime; }
 
         static void WaitBeforeContinueIfNeed();
-    private:
+
+        // opens a file named by a config option inside LogsDir, NULL if the option is empty
         FILE* openLogFile(char const* configFileName,char const* configTimeStampFlag, char const* mode);
+    private:
         FILE* openGmlogPerAccount(uint32 account);
 
         FILE* raLogfile;
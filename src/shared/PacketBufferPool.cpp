@@ -0,0 +1,324 @@
+/*
+ * Copyright (C) 2010-2012 Strawberry-Pr0jcts <http://strawberry-pr0jcts.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "PacketBufferPool.h"
+#include "Policies/MemoryStats.h"
+
+#include <ace/TSS_T.h>
+#include <ace/Guard_T.h>
+
+#include <set>
+
+// blocks a thread cache may hold per size class, about 256 KB but at least 8 blocks
+static uint32 GetCacheLimit(uint32 sizeClass)
+{
+    uint32 limit = uint32((256 * 1024) / PacketBufferPool::GetClassSize(sizeClass));
+    return limit < 8 ? 8 : limit;
+}
+
+// the depot keeps at most this many thread cache limits per class, the rest goes back to the heap
+#define PACKET_BUFFER_DEPOT_CACHES  16
+
+struct PacketBufferFreeBlock
+{
+    PacketBufferFreeBlock* next;
+};
+
+/// Intrusive free list, the links live in the free blocks themselves
+struct PacketBufferList
+{
+    PacketBufferList() : head(NULL), count(0) {}
+
+    void Push(void* block)
+    {
+        PacketBufferFreeBlock* free = static_cast<PacketBufferFreeBlock*>(block);
+        free->next = head;
+        head = free;
+        ++count;
+    }
+
+    void* Pop()
+    {
+        PacketBufferFreeBlock* free = head;
+        head = free->next;
+        --count;
+        return free;
+    }
+
+    // moves the first n blocks of this list to the front of the other one
+    void MoveTo(PacketBufferList& other, uint32 n)
+    {
+        if (!n)
+            return;
+
+        PacketBufferFreeBlock* first = head;
+        PacketBufferFreeBlock* last = head;
+        for (uint32 i = 1; i < n; ++i)
+            last = last->next;
+
+        head = last->next;
+        count -= n;
+
+        last->next = other.head;
+        other.head = first;
+        other.count += n;
+    }
+
+    void Release()
+    {
+        while (head)
+            ::operator delete(Pop());
+    }
+
+    PacketBufferFreeBlock* head;
+    uint32 count;
+};
+
+/// Shared overflow of the thread caches, never destroyed so threads may return blocks at any time
+class PacketBufferDepot
+{
+    public:
+        void Put(uint32 sizeClass, PacketBufferList& batch)
+        {
+            PacketBufferList excess;
+            {
+                ACE_GUARD(ACE_Thread_Mutex, guard, m_lock);
+                uint32 room = GetCacheLimit(sizeClass) * PACKET_BUFFER_DEPOT_CACHES;
+                room = m_lists[sizeClass].count < room ? room - m_lists[sizeClass].count : 0;
+                batch.MoveTo(m_lists[sizeClass], batch.count < room ? batch.count : room);
+            }
+
+            // freed outside the lock
+            batch.MoveTo(excess, batch.count);
+            excess.Release();
+        }
+
+        void Take(uint32 sizeClass, PacketBufferList& into, uint32 count)
+        {
+            ACE_GUARD(ACE_Thread_Mutex, guard, m_lock);
+            PacketBufferList& list = m_lists[sizeClass];
+            list.MoveTo(into, list.count < count ? list.count : count);
+        }
+
+        uint32 GetCount(uint32 sizeClass)
+        {
+            ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_lock, 0);
+            return m_lists[sizeClass].count;
+        }
+
+    private:
+        ACE_Thread_Mutex m_lock;
+        PacketBufferList m_lists[MAX_PACKET_BUFFER_CLASSES];
+};
+
+static PacketBufferDepot& GetDepot()
+{
+    static PacketBufferDepot* depot = new PacketBufferDepot;
+    return *depot;
+}
+
+static ACE_Atomic_Op<ACE_Thread_Mutex, long> packetBufferOversize;
+
+class PacketBufferCache;
+
+/// Knows every live thread cache for the stats, keeps the totals of released ones; never destroyed
+class PacketBufferStatsRegistry
+{
+    public:
+        void Add(PacketBufferCache* cache)
+        {
+            ACE_GUARD(ACE_Thread_Mutex, guard, m_lock);
+            m_caches.insert(cache);
+        }
+
+        void Remove(PacketBufferCache* cache);
+        PacketBufferClassStats Sum(uint32 sizeClass);
+
+    private:
+        ACE_Thread_Mutex m_lock;
+        std::set<PacketBufferCache*> m_caches;
+        PacketBufferClassStats m_released[MAX_PACKET_BUFFER_CLASSES];
+};
+
+static PacketBufferStatsRegistry& GetStatsRegistry()
+{
+    static PacketBufferStatsRegistry* registry = new PacketBufferStatsRegistry;
+    return *registry;
+}
+
+/// Per thread free lists and counters, handed to the depot and the registry when the thread exits
+class PacketBufferCache
+{
+    public:
+        PacketBufferCache() { GetStatsRegistry().Add(this); }
+
+        ~PacketBufferCache()
+        {
+            for (uint32 i = 0; i < MAX_PACKET_BUFFER_CLASSES; ++i)
+                if (m_lists[i].count)
+                    GetDepot().Put(i, m_lists[i]);
+
+            GetStatsRegistry().Remove(this);
+        }
+
+        void* Allocate(uint32 sizeClass)
+        {
+            PacketBufferList& list = m_lists[sizeClass];
+            if (!list.count)
+            {
+                GetDepot().Take(sizeClass, list, GetCacheLimit(sizeClass) / 2);
+                if (!list.count)
+                {
+                    ++m_stats[sizeClass].misses;
+                    return ::operator new(PacketBufferPool::GetClassSize(sizeClass));
+                }
+
+                ++m_stats[sizeClass].refills;
+            }
+
+            ++m_stats[sizeClass].hits;
+            return list.Pop();
+        }
+
+        void Put(uint32 sizeClass, void* block)
+        {
+            PacketBufferList& list = m_lists[sizeClass];
+            list.Push(block);
+
+            if (list.count > GetCacheLimit(sizeClass))
+            {
+                PacketBufferList batch;
+                list.MoveTo(batch, list.count / 2);
+                GetDepot().Put(sizeClass, batch);
+                ++m_stats[sizeClass].spills;
+            }
+        }
+
+        // written by the owning thread only, readers accept a slightly stale value
+        PacketBufferClassStats const& GetStats(uint32 sizeClass) const { return m_stats[sizeClass]; }
+
+    private:
+        PacketBufferList m_lists[MAX_PACKET_BUFFER_CLASSES];
+        PacketBufferClassStats m_stats[MAX_PACKET_BUFFER_CLASSES];
+};
+
+static void AddClassStats(PacketBufferClassStats& total, PacketBufferClassStats const& stats)
+{
+    total.hits += stats.hits;
+    total.refills += stats.refills;
+    total.misses += stats.misses;
+    total.spills += stats.spills;
+}
+
+void PacketBufferStatsRegistry::Remove(PacketBufferCache* cache)
+{
+    ACE_GUARD(ACE_Thread_Mutex, guard, m_lock);
+    for (uint32 i = 0; i < MAX_PACKET_BUFFER_CLASSES; ++i)
+        AddClassStats(m_released[i], cache->GetStats(i));
+
+    m_caches.erase(cache);
+}
+
+PacketBufferClassStats PacketBufferStatsRegistry::Sum(uint32 sizeClass)
+{
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_lock, PacketBufferClassStats());
+
+    PacketBufferClassStats total = m_released[sizeClass];
+    for (std::set<PacketBufferCache*>::const_iterator itr = m_caches.begin(); itr != m_caches.end(); ++itr)
+        AddClassStats(total, (*itr)->GetStats(sizeClass));
+
+    return total;
+}
+
+typedef ACE_TSS<PacketBufferCache> PacketBufferCacheTSS;
+
+static bool packetBufferCacheAlive = false;
+static PacketBufferCacheTSS packetBufferCache;
+
+// constructed after and destroyed before the thread cache storage above; outside its lifetime blocks
+// bypass the caches, which is safe because every block has exactly its class size
+static struct PacketBufferCacheGuard
+{
+    PacketBufferCacheGuard() { packetBufferCacheAlive = true; }
+    ~PacketBufferCacheGuard() { packetBufferCacheAlive = false; }
+} packetBufferCacheGuard;
+
+uint32 PacketBufferPool::GetSizeClass(size_t size)
+{
+    uint32 sizeClass = 0;
+    while (sizeClass < MAX_PACKET_BUFFER_CLASSES && size > GetClassSize(sizeClass))
+        ++sizeClass;
+
+    return sizeClass;
+}
+
+void* PacketBufferPool::Allocate(size_t size)
+{
+    MemoryTagScope memoryTag(MEMORY_TAG_PACKETS);
+
+    uint32 sizeClass = GetSizeClass(size);
+    if (sizeClass == MAX_PACKET_BUFFER_CLASSES)
+    {
+        ++packetBufferOversize;
+        return ::operator new(size);
+    }
+
+    if (packetBufferCacheAlive)
+        return packetBufferCache->Allocate(sizeClass);
+
+    return ::operator new(GetClassSize(sizeClass));
+}
+
+void PacketBufferPool::Deallocate(void* block, size_t size)
+{
+    if (!block)
+        return;
+
+    uint32 sizeClass = GetSizeClass(size);
+    if (sizeClass == MAX_PACKET_BUFFER_CLASSES || !packetBufferCacheAlive)
+    {
+        ::operator delete(block);
+        return;
+    }
+
+    packetBufferCache->Put(sizeClass, block);
+}
+
+PacketBufferClassStats PacketBufferPool::GetClassStats(uint32 sizeClass)
+{
+    return GetStatsRegistry().Sum(sizeClass);
+}
+
+uint32 PacketBufferPool::GetDepotCount(uint32 sizeClass)
+{
+    return GetDepot().GetCount(sizeClass);
+}
+
+long PacketBufferPool::GetOversizeCount()
+{
+    return packetBufferOversize.value();
+}
+
+void PacketBufferPool::ReleaseThreadCache()
+{
+    if (!packetBufferCacheAlive)
+        return;
+
+    // a later packet of this thread simply creates a new cache
+    delete packetBufferCache.ts_object(NULL);
+}
@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2010-2012 Strawberry-Pr0jcts <http://strawberry-pr0jcts.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * @file PacketBufferPool.h
+ * Size classed free lists for packet storage (ByteBuffer contents and WorldPacket objects).
+ *
+ * Every thread keeps a small cache per size class and takes blocks from it without locking. A cache that
+ * grows past its limit hands half of its blocks to a shared depot, an empty one refills a batch from there,
+ * so blocks allocated by the network threads and released by the world and map threads flow back without
+ * a lock per packet. Blocks are plain ::operator new memory of exactly the class size; requests above the
+ * largest class go straight to the heap. Hit and miss counters live in the thread caches too and are only
+ * summed when read.
+ */
+
+#ifndef STRAWBERRY_PACKETBUFFERPOOL_H
+#define STRAWBERRY_PACKETBUFFERPOOL_H
+
+#include "Common.h"
+
+#include <ace/Atomic_Op.h>
+#include <ace/Thread_Mutex.h>
+
+#include <cstddef>
+#include <limits>
+#include <new>
+
+// 64, 256, 1K, 4K, 16K, 64K
+#define MAX_PACKET_BUFFER_CLASSES   6
+
+struct PacketBufferClassStats
+{
+    PacketBufferClassStats() : hits(0), refills(0), misses(0), spills(0) {}
+
+    uint64 hits;                                            // served by the thread cache
+    uint64 refills;                                         // batches taken from the depot
+    uint64 misses;                                          // new heap blocks
+    uint64 spills;                                          // batches handed to the depot
+};
+
+class PacketBufferPool
+{
+    public:
+        static void* Allocate(size_t size);
+        static void Deallocate(void* block, size_t size);
+
+        static uint32 GetClassCount() { return MAX_PACKET_BUFFER_CLASSES; }
+        static size_t GetClassSize(uint32 sizeClass) { return size_t(64) << (2 * sizeClass); }
+        /// summed over the caches of running threads and those already released, blocks served
+        /// while the thread cache storage is not constructed yet (static init) are not counted
+        static PacketBufferClassStats GetClassStats(uint32 sizeClass);
+        /// blocks parked in the depot, thread caches not included
+        static uint32 GetDepotCount(uint32 sizeClass);
+        /// requests above the largest class
+        static long GetOversizeCount();
+
+        /// hands the blocks cached by the calling thread to the depot, call before a thread exits;
+        /// ACE only destroys thread storage itself for threads it started
+        static void ReleaseThreadCache();
+
+    private:
+        static uint32 GetSizeClass(size_t size);
+};
+
+/// STL allocator on top of PacketBufferPool, used for the ByteBuffer storage
+template<class T>
+class PacketAllocator
+{
+    public:
+        typedef T value_type;
+        typedef T* pointer;
+        typedef T const* const_pointer;
+        typedef T& reference;
+        typedef T const& const_reference;
+        typedef size_t size_type;
+        typedef ptrdiff_t difference_type;
+
+        template<class U> struct rebind { typedef PacketAllocator<U> other; };
+
+        PacketAllocator() {}
+        PacketAllocator(PacketAllocator const&) {}
+        template<class U> PacketAllocator(PacketAllocator<U> const&) {}
+
+        pointer address(reference x) const { return &x; }
+        const_pointer address(const_reference x) const { return &x; }
+
+        pointer allocate(size_type n, void const* = 0) { return static_cast<pointer>(PacketBufferPool::Allocate(n * sizeof(T))); }
+        void deallocate(pointer p, size_type n) { PacketBufferPool::Deallocate(p, n * sizeof(T)); }
+
+        size_type max_size() const { return std::numeric_limits<size_type>::max() / sizeof(T); }
+
+        void construct(pointer p, T const& val) { new (static_cast<void*>(p)) T(val); }
+        void destroy(pointer p) { p->~T(); }
+};
+
+template<class T, class U>
+inline bool operator==(PacketAllocator<T> const&, PacketAllocator<U> const&) { return true; }
+
+template<class T, class U>
+inline bool operator!=(PacketAllocator<T> const&, PacketAllocator<U> const&) { return false; }
+
+#endif
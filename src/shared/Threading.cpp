@@ -19,6 +19,7 @@
 
 #include "Threading.h"
 #include "Errors.h"
+#include "PacketBufferPool.h"
 #include <ace/OS_NS_unistd.h>
 #include <ace/Sched_Params.h>
 #include <vector>
@@ -187,6 +188,9 @@ ACE_THR_FUNC_RETURN Thread::ThreadTask(void * param)
     Runnable * _task = (Runnable*)param;
     _task->run();
 
+    // packet blocks cached by this thread go back to the shared pool
+    PacketBufferPool::ReleaseThreadCache();
+
     // task execution complete, free referecne added at
     _task->decReference();
 
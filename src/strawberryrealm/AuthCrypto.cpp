@@ -0,0 +1,183 @@
+/*
+ * Copyright (C) 2010-2012 Strawberry-Pr0jcts <http://strawberry-pr0jcts.com/>
+ * Copyright (C) 2005-2011 MaNGOS <http://getmangos.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+/** \file
+    \ingroup realmd
+*/
+
+#include "AuthCrypto.h"
+#include "AuthSocket.h"
+#include "Log.h"
+#include "Timer.h"
+#include "Policies/SingletonImp.h"
+
+INSTANTIATE_SINGLETON_1(AuthCrypto);
+
+// x is a SHA1 digest and b is 19 bytes, both fit the window table
+#define SRP6_MAX_EXPONENT_BITS 256
+
+class AuthCryptoWorker : public ACE_Based::Runnable
+{
+    public:
+        void run()
+        {
+            while (AuthProofJob* job = sAuthCrypto.WaitForJob())
+            {
+                sAuthCrypto.ComputeProof(job);
+                sAuthCrypto.ProofDone(job);
+            }
+        }
+};
+
+AuthCrypto::AuthCrypto() : m_jobSignal(0), m_stopping(false)
+{
+    m_N.SetHexStr("894B645E89E1535BBDAD5B8B290650530801B18EBFBF5E8FAB3C82872A3E9BB7");
+    m_g.SetDword(7);
+
+    m_engine = new ModExpEngine(m_g, m_N, SRP6_MAX_EXPONENT_BITS);
+}
+
+AuthCrypto::~AuthCrypto()
+{
+    StopWorkers();
+    delete m_engine;
+}
+
+void AuthCrypto::Initialize(uint32 threads)
+{
+    for (uint32 i = 0; i < threads; ++i)
+        m_workers.push_back(new ACE_Based::Thread(new AuthCryptoWorker));
+
+    sLog.outString("Using %u thread(s) for logon proofs", threads);
+}
+
+void AuthCrypto::StopWorkers()
+{
+    m_stopping = true;
+    m_jobSignal.release(m_workers.size());
+
+    for (size_t i = 0; i < m_workers.size(); ++i)
+    {
+        m_workers[i]->wait();
+        delete m_workers[i];
+    }
+    m_workers.clear();
+
+    // sockets are gone at this point, drop what is left
+    AuthProofJob* job = NULL;
+    while (m_pendingJobs.next(job))
+        delete job;
+    while (m_doneJobs.next(job))
+        delete job;
+}
+
+void AuthCrypto::QueueProof(AuthProofJob* job)
+{
+    if (m_workers.empty())
+    {
+        ComputeProof(job);
+        m_doneJobs.add(job);
+        return;
+    }
+
+    m_pendingJobs.add(job);
+    m_jobSignal.release();
+}
+
+AuthProofJob* AuthCrypto::WaitForJob()
+{
+    AuthProofJob* job = NULL;
+    while (!m_stopping)
+    {
+        m_jobSignal.acquire();
+        if (m_pendingJobs.next(job))
+            return job;
+    }
+
+    return NULL;
+}
+
+void AuthCrypto::ComputeProof(AuthProofJob* job) const
+{
+    job->S = m_engine->ModExp(job->A * m_engine->ModExp(job->v, job->u), job->b);
+}
+
+void AuthCrypto::Update()
+{
+    AuthProofJob* job = NULL;
+    while (m_doneJobs.next(job))
+    {
+        AuthSocket::LogonProofCallback(job);
+        delete job;
+    }
+}
+
+void AuthCrypto::Benchmark(uint32 iterations)
+{
+    if (!iterations)
+        return;
+
+    BigNumber x, v, b, B;
+    x.SetRand(SHA_DIGEST_LENGTH * 8);
+    v = m_g.ModExp(x, m_N);
+
+    ///- Logon challenge: B = 3v + g^b
+    uint32 start = WorldTimer::getMSTime();
+    for (uint32 i = 0; i < iterations; ++i)
+    {
+        b.SetRand(19 * 8);
+        B = ((v * 3) + m_g.ModExp(b, m_N)) % m_N;
+    }
+    uint32 genericChallenge = WorldTimer::getMSTimeDiff(start, WorldTimer::getMSTime());
+
+    start = WorldTimer::getMSTime();
+    for (uint32 i = 0; i < iterations; ++i)
+    {
+        b.SetRand(19 * 8);
+        B = ((v * 3) + PowG(b)) % m_N;
+    }
+    uint32 fixedChallenge = WorldTimer::getMSTimeDiff(start, WorldTimer::getMSTime());
+
+    ///- Logon proof: S = (A * v^u)^b
+    AuthProofJob job;
+    job.A.SetRand(32 * 8);
+    job.v = v;
+    job.b = b;
+
+    start = WorldTimer::getMSTime();
+    for (uint32 i = 0; i < iterations; ++i)
+    {
+        job.u.SetRand(SHA_DIGEST_LENGTH * 8);
+        job.S = (job.A * (job.v.ModExp(job.u, m_N))).ModExp(job.b, m_N);
+    }
+    uint32 genericProof = WorldTimer::getMSTimeDiff(start, WorldTimer::getMSTime());
+
+    start = WorldTimer::getMSTime();
+    for (uint32 i = 0; i < iterations; ++i)
+    {
+        job.u.SetRand(SHA_DIGEST_LENGTH * 8);
+        ComputeProof(&job);
+    }
+    uint32 montProof = WorldTimer::getMSTimeDiff(start, WorldTimer::getMSTime());
+
+    sLog.outString("SRP6 benchmark, %u iterations (per second, single thread):", iterations);
+    sLog.outString("  logon challenge: %.0f generic, %.0f fixed-base", iterations * 1000.0f / std::max(genericChallenge, 1u), iterations * 1000.0f / std::max(fixedChallenge, 1u));
+    sLog.outString("  logon proof:     %.0f generic, %.0f shared Montgomery context", iterations * 1000.0f / std::max(genericProof, 1u), iterations * 1000.0f / std::max(montProof, 1u));
+}
@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2010-2012 Strawberry-Pr0jcts <http://strawberry-pr0jcts.com/>
+ * Copyright (C) 2005-2011 MaNGOS <http://getmangos.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+/// \addtogroup realmd
+/// @{
+/// \file
+
+#ifndef _AUTHCRYPTO_H
+#define _AUTHCRYPTO_H
+
+#include "Common.h"
+#include "Auth/BigNumber.h"
+#include "Auth/ModExpEngine.h"
+#include "Policies/Singleton.h"
+#include "LockedQueue.h"
+#include "Threading.h"
+
+#include <ace/Thread_Mutex.h>
+#include <ace/Thread_Semaphore.h>
+
+/// SRP6 logon proof math handed from the network thread to the crypto workers and back
+struct AuthProofJob
+{
+    uint32 socketId;
+    BigNumber A, u, v, b;
+    BigNumber S;                                            ///< (A * v^u)^b % N, set by the worker
+    uint8 M1[20];                                           ///< client proof, checked once S is known
+};
+
+/// SRP6 constants, the fixed-base g^x table and the worker pool for the logon proofs
+class AuthCrypto
+{
+    public:
+        AuthCrypto();
+        ~AuthCrypto();
+
+        void Initialize(uint32 threads);
+        void StopWorkers();
+
+        BigNumber const& GetN() const { return m_N; }
+        BigNumber const& GetG() const { return m_g; }
+
+        /// g^exp % N through the precomputed window table
+        BigNumber PowG(BigNumber const& exp) const { return m_engine->ModExp(exp); }
+
+        /// compute job->S on a worker, inline at the next Update when there are none
+        void QueueProof(AuthProofJob* job);
+        /// hand finished proofs back to their sockets, network thread only
+        void Update();
+
+        /// logon challenge and proof throughput, generic ModExp against the fixed-base engine
+        void Benchmark(uint32 iterations);
+
+        /// blocks a worker until a job is queued, NULL once the pool is stopping
+        AuthProofJob* WaitForJob();
+        void ComputeProof(AuthProofJob* job) const;
+        void ProofDone(AuthProofJob* job) { m_doneJobs.add(job); }
+
+    private:
+        typedef ACE_Based::LockedQueue<AuthProofJob*, ACE_Thread_Mutex> JobQueue;
+
+        BigNumber m_N;
+        BigNumber m_g;
+        ModExpEngine* m_engine;
+
+        JobQueue m_pendingJobs;
+        JobQueue m_doneJobs;
+        ACE_Thread_Semaphore m_jobSignal;
+        std::vector<ACE_Based::Thread*> m_workers;
+        volatile bool m_stopping;
+};
+
+#define sAuthCrypto Strawberry::Singleton<AuthCrypto>::Instance()
+
+#endif
+/// @}
@@ -29,6 +29,7 @@
 #include "AuthSocket.h"
 #include "AuthCodes.h"
 #include "PatchHandler.h"
+#include "AuthCrypto.h"
 
 #include <openssl/md5.h>
 //#include "Util.h" -- for commented utf8ToUpperOnlyLatin
@@ -179,13 +180,20 @@ const AuthHandler table[] =
 
 #define AUTH_TOTAL_COMMANDS sizeof(table)/sizeof(AuthHandler)
 
+AuthSocket::SocketMap AuthSocket::s_sockets;
+uint32 AuthSocket::s_nextSocketId = 0;
+
 /// Constructor - set the N and g values for SRP6
 AuthSocket::AuthSocket()
 {
-    N.SetHexStr("894B645E89E1535BBDAD5B8B290650530801B18EBFBF5E8FAB3C82872A3E9BB7");
-    g.SetDword(7);
+    N = sAuthCrypto.GetN();
+    g = sAuthCrypto.GetG();
     _authed = false;
 
+    _socketId = ++s_nextSocketId;
+    _waitingForReply = false;
+    s_sockets[_socketId] = this;
+
     _accountSecurityLevel = SEC_PLAYER;
 
     _build = 0;
@@ -197,6 +205,24 @@ AuthSocket::~AuthSocket()
 {
     if(patch_ != ACE_INVALID_HANDLE)
         ACE_OS::close(patch_);
+
+    s_sockets.erase(_socketId);
+}
+
+/// Find a still connected socket for a login database reply
+AuthSocket* AuthSocket::FindSocket(uint32 socketId)
+{
+    SocketMap::const_iterator itr = s_sockets.find(socketId);
+    return itr != s_sockets.end() ? itr->second : NULL;
+}
+
+/// Continue with the commands received while a reply was pending
+void AuthSocket::_ResumeRead(bool handled)
+{
+    _waitingForReply = false;
+
+    if (handled)
+        OnRead();
 }
 
 /// Accept the connection and set the s random value for SRP6
@@ -211,6 +237,10 @@ void AuthSocket::OnRead()
     uint8 _cmd;
     while (1)
     {
+        ///- Keep the input buffered until the pending database or crypto reply is handled
+        if (_waitingForReply)
+            return;
+
         if(!recv_soft((char *)&_cmd, 1))
             return;
 
@@ -268,7 +298,7 @@ void AuthSocket::_SetVSFields(const std::string& rI)
     sha.Finalize();
     BigNumber x;
     x.SetBinary(sha.GetDigest(), sha.GetLength());
-    v = g.ModExp(x, N);
+    v = sAuthCrypto.PowG(x);
     // No SQL injection (username escaped)
     const char *v_hex, *s_hex;
     v_hex = v.AsHexStr();
@@ -358,8 +388,6 @@ bool AuthSocket::_HandleLogonChallenge()
     EndianConvert(ch->timezone_bias);
     EndianConvert(ch->ip);
 
-    ByteBuffer pkt;
-
     _login = (const char*)ch->I;
     _build = ch->build;
     _os = (const char*)ch->os;
@@ -375,152 +403,176 @@ bool AuthSocket::_HandleLogonChallenge()
     _safelogin = _login;
     LoginDatabase.escape_string(_safelogin);
 
-    pkt << (uint8) CMD_AUTH_LOGON_CHALLENGE;
-    pkt << (uint8) 0x00;
+    _localizationName.resize(4);
+    for(int i = 0; i < 4; ++i)
+        _localizationName[i] = ch->country[4-i-1];
 
-    ///- Verify that this IP is not in the ip_banned table
-    // No SQL injection possible (paste the IP address as passed by the socket)
+    ///- Check the ip_banned table, the account and its active ban in a single async query
+    // No SQL injection possible (escaped user name and the IP address as passed by the socket)
     std::string address = get_remote_address();
     LoginDatabase.escape_string(address);
-    QueryResult *result = LoginDatabase.PQuery("SELECT unbandate FROM ip_banned WHERE "
+    _waitingForReply = LoginDatabase.AsyncPQuery(&AuthSocket::LogonChallengeCallback, _socketId,
+        "SELECT ipb.banned, a.sha_pass_hash, a.id, a.locked, a.last_ip, a.gmlevel, a.v, a.s, ab.bandate, ab.unbandate "
+        "FROM (SELECT COUNT(*) AS banned FROM ip_banned WHERE "
     //    permanent                    still banned
-        "(unbandate = bandate OR unbandate > UNIX_TIMESTAMP()) AND ip = '%s'", address.c_str());
-    if (result)
+        "(unbandate = bandate OR unbandate > UNIX_TIMESTAMP()) AND ip = '%s') ipb "
+        "LEFT JOIN account a ON a.username = '%s' "
+        "LEFT JOIN account_banned ab ON ab.id = a.id AND ab.active = 1 AND (ab.unbandate > UNIX_TIMESTAMP() OR ab.unbandate = ab.bandate)",
+        address.c_str(), _safelogin.c_str());
+
+    if (!_waitingForReply)
+    {
+        ByteBuffer pkt;
+        pkt << (uint8) CMD_AUTH_LOGON_CHALLENGE;
+        pkt << (uint8) 0x00;
+        pkt << (uint8) WOW_FAIL_DB_BUSY;
+        send((char const*)pkt.contents(), pkt.size());
+    }
+
+    return true;
+}
+
+void AuthSocket::LogonChallengeCallback(QueryResult* result, uint32 socketId)
+{
+    AuthSocket* socket = FindSocket(socketId);
+    if (!socket)
+    {
+        delete result;
+        return;
+    }
+
+    socket->_ResumeRead(socket->_HandleLogonChallengeResult(result));
+}
+
+/// Logon Challenge reply, sent once the account details are known
+bool AuthSocket::_HandleLogonChallengeResult(QueryResult* result)
+{
+    ByteBuffer pkt;
+    pkt << (uint8) CMD_AUTH_LOGON_CHALLENGE;
+    pkt << (uint8) 0x00;
+
+    // the derived ip_banned table always yields a row, no result means the query itself failed
+    if (!result)
+        pkt << (uint8) WOW_FAIL_DB_BUSY;
+    else if ((*result)[0].GetUInt64() > 0)
     {
         pkt << (uint8)WOW_FAIL_BANNED;
         BASIC_LOG("[AuthChallenge] Banned ip %s tries to login!", get_remote_address().c_str());
-        delete result;
     }
-    else
+    else if (!(*result)[2].IsNULL())
     {
-        ///- Get the account details from the account table
-        // No SQL injection (escaped user name)
+        ///- If the IP is 'locked', check that the player comes indeed from the correct IP address
+        bool locked = false;
+        if((*result)[3].GetUInt8() == 1)                    // if ip is locked
+        {
+            DEBUG_LOG("[AuthChallenge] Account '%s' is locked to IP - '%s'", _login.c_str(), (*result)[4].GetString());
+            DEBUG_LOG("[AuthChallenge] Player address is '%s'", get_remote_address().c_str());
+            if ( strcmp((*result)[4].GetString(),get_remote_address().c_str()) )
+            {
+                DEBUG_LOG("[AuthChallenge] Account IP differs");
+                pkt << (uint8) WOW_FAIL_SUSPENDED;
+                locked=true;
+            }
+            else
+            {
+                DEBUG_LOG("[AuthChallenge] Account IP matches");
+            }
+        }
+        else
+        {
+            DEBUG_LOG("[AuthChallenge] Account '%s' is not locked to ip", _login.c_str());
+        }
 
-        result = LoginDatabase.PQuery("SELECT sha_pass_hash,id,locked,last_ip,gmlevel,v,s FROM account WHERE username = '%s'",_safelogin.c_str ());
-        if( result )
+        if (!locked)
         {
-            ///- If the IP is 'locked', check that the player comes indeed from the correct IP address
-            bool locked = false;
-            if((*result)[2].GetUInt8() == 1)                // if ip is locked
+            ///- If the account is banned, reject the logon attempt
+            if(!(*result)[8].IsNULL())
             {
-                DEBUG_LOG("[AuthChallenge] Account '%s' is locked to IP - '%s'", _login.c_str(), (*result)[3].GetString());
-                DEBUG_LOG("[AuthChallenge] Player address is '%s'", get_remote_address().c_str());
-                if ( strcmp((*result)[3].GetString(),get_remote_address().c_str()) )
+                if((*result)[8].GetUInt64() == (*result)[9].GetUInt64())
                 {
-                    DEBUG_LOG("[AuthChallenge] Account IP differs");
-                    pkt << (uint8) WOW_FAIL_SUSPENDED;
-                    locked=true;
+                    pkt << (uint8) WOW_FAIL_BANNED;
+                    BASIC_LOG("[AuthChallenge] Banned account %s tries to login!",_login.c_str ());
                 }
                 else
                 {
-                    DEBUG_LOG("[AuthChallenge] Account IP matches");
+                    pkt << (uint8) WOW_FAIL_SUSPENDED;
+                    BASIC_LOG("[AuthChallenge] Temporarily banned account %s tries to login!",_login.c_str ());
                 }
             }
             else
             {
-                DEBUG_LOG("[AuthChallenge] Account '%s' is not locked to ip", _login.c_str());
-            }
+                ///- Get the password from the account table, upper it, and make the SRP6 calculation
+                std::string rI = (*result)[1].GetCppString();
 
-            if (!locked)
-            {
-                ///- If the account is banned, reject the logon attempt
-                QueryResult *banresult = LoginDatabase.PQuery("SELECT bandate,unbandate FROM account_banned WHERE "
-                    "id = %u AND active = 1 AND (unbandate > UNIX_TIMESTAMP() OR unbandate = bandate)", (*result)[1].GetUInt32());
-                if(banresult)
-                {
-                    if((*banresult)[0].GetUInt64() == (*banresult)[1].GetUInt64())
-                    {
-                        pkt << (uint8) WOW_FAIL_BANNED;
-                        BASIC_LOG("[AuthChallenge] Banned account %s tries to login!",_login.c_str ());
-                    }
-                    else
-                    {
-                        pkt << (uint8) WOW_FAIL_SUSPENDED;
-                        BASIC_LOG("[AuthChallenge] Temporarily banned account %s tries to login!",_login.c_str ());
-                    }
-
-                    delete banresult;
-                }
+                ///- Don't calculate (v, s) if there are already some in the database
+                std::string databaseV = (*result)[6].GetCppString();
+                std::string databaseS = (*result)[7].GetCppString();
+
+                DEBUG_LOG("database authentication values: v='%s' s='%s'", databaseV.c_str(), databaseS.c_str());
+
+                // multiply with 2, bytes are stored as hexstring
+                if(databaseV.size() != s_BYTE_SIZE*2 || databaseS.size() != s_BYTE_SIZE*2)
+                    _SetVSFields(rI);
                 else
                 {
-                    ///- Get the password from the account table, upper it, and make the SRP6 calculation
-                    std::string rI = (*result)[0].GetCppString();
+                    s.SetHexStr(databaseS.c_str());
+                    v.SetHexStr(databaseV.c_str());
+                }
 
-                    ///- Don't calculate (v, s) if there are already some in the database
-                    std::string databaseV = (*result)[5].GetCppString();
-                    std::string databaseS = (*result)[6].GetCppString();
+                b.SetRand(19 * 8);
+                BigNumber gmod = sAuthCrypto.PowG(b);
+                B = ((v * 3) + gmod) % N;
 
-                    DEBUG_LOG("database authentication values: v='%s' s='%s'", databaseV.c_str(), databaseS.c_str());
+                STRAWBERRY_ASSERT(gmod.GetNumBytes() <= 32);
 
-                    // multiply with 2, bytes are stored as hexstring
-                    if(databaseV.size() != s_BYTE_SIZE*2 || databaseS.size() != s_BYTE_SIZE*2)
-                        _SetVSFields(rI);
-                    else
-                    {
-                        s.SetHexStr(databaseS.c_str());
-                        v.SetHexStr(databaseV.c_str());
-                    }
+                BigNumber unk3;
+                unk3.SetRand(16 * 8);
 
-                    b.SetRand(19 * 8);
-                    BigNumber gmod = g.ModExp(b, N);
-                    B = ((v * 3) + gmod) % N;
+                ///- Fill the response packet with the result
+                pkt << uint8(WOW_SUCCESS);
 
-                    STRAWBERRY_ASSERT(gmod.GetNumBytes() <= 32);
+                // B may be calculated < 32B so we force minimal length to 32B
+                pkt.append(B.AsByteArray(32), 32);          // 32 bytes
+                pkt << uint8(1);
+                pkt.append(g.AsByteArray(), 1);
+                pkt << uint8(32);
+                pkt.append(N.AsByteArray(32), 32);
+                pkt.append(s.AsByteArray(), s.GetNumBytes());// 32 bytes
+                pkt.append(unk3.AsByteArray(16), 16);
+                uint8 securityFlags = 0;
+                pkt << uint8(securityFlags);                // security flags (0x0...0x04)
 
-                    BigNumber unk3;
-                    unk3.SetRand(16 * 8);
+                if(securityFlags & 0x01)                    // PIN input
+                {
+                    pkt << uint32(0);
+                    pkt << uint64(0) << uint64(0);          // 16 bytes hash?
+                }
 
-                    ///- Fill the response packet with the result
-                    pkt << uint8(WOW_SUCCESS);
+                if(securityFlags & 0x02)                    // Matrix input
+                {
+                    pkt << uint8(0);
+                    pkt << uint8(0);
+                    pkt << uint8(0);
+                    pkt << uint8(0);
+                    pkt << uint64(0);
+                }
 
-                    // B may be calculated < 32B so we force minimal length to 32B
-                    pkt.append(B.AsByteArray(32), 32);      // 32 bytes
+                if(securityFlags & 0x04)                    // Security token input
+                {
                     pkt << uint8(1);
-                    pkt.append(g.AsByteArray(), 1);
-                    pkt << uint8(32);
-                    pkt.append(N.AsByteArray(32), 32);
-                    pkt.append(s.AsByteArray(), s.GetNumBytes());// 32 bytes
-                    pkt.append(unk3.AsByteArray(16), 16);
-                    uint8 securityFlags = 0;
-                    pkt << uint8(securityFlags);            // security flags (0x0...0x04)
-
-                    if(securityFlags & 0x01)                // PIN input
-                    {
-                        pkt << uint32(0);
-                        pkt << uint64(0) << uint64(0);      // 16 bytes hash?
-                    }
-
-                    if(securityFlags & 0x02)                // Matrix input
-                    {
-                        pkt << uint8(0);
-                        pkt << uint8(0);
-                        pkt << uint8(0);
-                        pkt << uint8(0);
-                        pkt << uint64(0);
-                    }
-
-                    if(securityFlags & 0x04)                // Security token input
-                    {
-                        pkt << uint8(1);
-                    }
-
-                    uint8 secLevel = (*result)[4].GetUInt8();
-                    _accountSecurityLevel = secLevel <= SEC_ADMINISTRATOR ? AccountTypes(secLevel) : SEC_ADMINISTRATOR;
-
-                    _localizationName.resize(4);
-                    for(int i = 0; i < 4; ++i)
-                        _localizationName[i] = ch->country[4-i-1];
-
-                    BASIC_LOG("[AuthChallenge] account %s is using '%c%c%c%c' locale (%u)", _login.c_str (), ch->country[3], ch->country[2], ch->country[1], ch->country[0], GetLocaleByName(_localizationName));
                 }
+
+                uint8 secLevel = (*result)[5].GetUInt8();
+                _accountSecurityLevel = secLevel <= SEC_ADMINISTRATOR ? AccountTypes(secLevel) : SEC_ADMINISTRATOR;
+
+                BASIC_LOG("[AuthChallenge] account %s is using '%s' locale (%u)", _login.c_str (), _localizationName.c_str(), GetLocaleByName(_localizationName));
             }
-            delete result;
-        }
-        else                                                // no account
-        {
-            pkt<< (uint8) WOW_FAIL_UNKNOWN_ACCOUNT;
         }
     }
+    else                                                    // no account
+        pkt << (uint8) WOW_FAIL_UNKNOWN_ACCOUNT;
+
+    delete result;
     send((char const*)pkt.contents(), pkt.size());
     return true;
 }
@@ -609,9 +661,33 @@ bool AuthSocket::_HandleLogonProof()
     Sha1Hash sha;
     sha.UpdateBigNumbers(&A, &B, NULL);
     sha.Finalize();
-    BigNumber u;
-    u.SetBinary(sha.GetDigest(), 20);
-    BigNumber S = (A * (v.ModExp(u, N))).ModExp(b, N);
+
+    ///- The two modular exponentiations run on the crypto workers, the rest continues in _HandleLogonProofResult
+    AuthProofJob* job = new AuthProofJob;
+    job->socketId = _socketId;
+    job->A = A;
+    job->u.SetBinary(sha.GetDigest(), 20);
+    job->v = v;
+    job->b = b;
+    memcpy(job->M1, lp.M1, 20);
+
+    _waitingForReply = true;
+    sAuthCrypto.QueueProof(job);
+    return true;
+}
+
+void AuthSocket::LogonProofCallback(AuthProofJob* job)
+{
+    if (AuthSocket* socket = FindSocket(job->socketId))
+        socket->_ResumeRead(socket->_HandleLogonProofResult(*job));
+}
+
+/// Logon Proof reply, sent once S = (A * v^u)^b is known
+bool AuthSocket::_HandleLogonProofResult(AuthProofJob& job)
+{
+    BigNumber& A = job.A;
+    BigNumber& S = job.S;
+    Sha1Hash sha;
 
     uint8 t[32];
     uint8 t1[16];
@@ -672,7 +748,7 @@ bool AuthSocket::_HandleLogonProof()
     M.SetBinary(sha.GetDigest(), 20);
 
     ///- Check if SRP6 results match (password is correct), else send an error
-    if (!memcmp(M.AsByteArray(), lp.M1, 20))
+    if (!memcmp(M.AsByteArray(), job.M1, 20))
     {
         BASIC_LOG("User '%s' successfully authenticated", _login.c_str());
 
@@ -713,41 +789,51 @@ bool AuthSocket::_HandleLogonProof()
             //Increment number of failed logins by one and if it reaches the limit temporarily ban that account or IP
             LoginDatabase.PExecute("UPDATE account SET failed_logins = failed_logins + 1 WHERE username = '%s'",_safelogin.c_str());
 
-            if(QueryResult *loginfail = LoginDatabase.PQuery("SELECT id, failed_logins FROM account WHERE username = '%s'", _safelogin.c_str()))
-            {
-                Field* fields = loginfail->Fetch();
-                uint32 failed_logins = fields[1].GetUInt32();
-
-                if( failed_logins >= MaxWrongPassCount )
-                {
-                    uint32 WrongPassBanTime = sConfig.GetIntDefault("WrongPass.BanTime", 600);
-                    bool WrongPassBanType = sConfig.GetBoolDefault("WrongPass.BanType", false);
-
-                    if(WrongPassBanType)
-                    {
-                        uint32 acc_id = fields[0].GetUInt32();
-                        LoginDatabase.PExecute("INSERT INTO account_banned VALUES ('%u',UNIX_TIMESTAMP(),UNIX_TIMESTAMP()+'%u','MaNGOS realmd','Failed login autoban',1)",
-                            acc_id, WrongPassBanTime);
-                        BASIC_LOG("[AuthChallenge] account %s got banned for '%u' seconds because it failed to authenticate '%u' times",
-                            _login.c_str(), WrongPassBanTime, failed_logins);
-                    }
-                    else
-                    {
-                        std::string current_ip = get_remote_address();
-                        LoginDatabase.escape_string(current_ip);
-                        LoginDatabase.PExecute("INSERT INTO ip_banned VALUES ('%s',UNIX_TIMESTAMP(),UNIX_TIMESTAMP()+'%u','MaNGOS realmd','Failed login autoban')",
-                            current_ip.c_str(), WrongPassBanTime);
-                        BASIC_LOG("[AuthChallenge] IP %s got banned for '%u' seconds because account %s failed to authenticate '%u' times",
-                            current_ip.c_str(), WrongPassBanTime, _login.c_str(), failed_logins);
-                    }
-                }
-                delete loginfail;
-            }
+            // queued behind the update above, so the reply already sees the incremented counter
+            LoginDatabase.AsyncPQuery(&AuthSocket::WrongPassCallback, _login, get_remote_address(),
+                "SELECT id, failed_logins FROM account WHERE username = '%s'", _safelogin.c_str());
         }
     }
     return true;
 }
 
+void AuthSocket::WrongPassCallback(QueryResult* result, std::string login, std::string address)
+{
+    if (!result)
+        return;
+
+    uint32 MaxWrongPassCount = sConfig.GetIntDefault("WrongPass.MaxCount", 0);
+
+    Field* fields = result->Fetch();
+    uint32 failed_logins = fields[1].GetUInt32();
+
+    if( failed_logins >= MaxWrongPassCount )
+    {
+        uint32 WrongPassBanTime = sConfig.GetIntDefault("WrongPass.BanTime", 600);
+        bool WrongPassBanType = sConfig.GetBoolDefault("WrongPass.BanType", false);
+
+        if(WrongPassBanType)
+        {
+            uint32 acc_id = fields[0].GetUInt32();
+            LoginDatabase.PExecute("INSERT INTO account_banned VALUES ('%u',UNIX_TIMESTAMP(),UNIX_TIMESTAMP()+'%u','MaNGOS realmd','Failed login autoban',1)",
+                acc_id, WrongPassBanTime);
+            BASIC_LOG("[AuthChallenge] account %s got banned for '%u' seconds because it failed to authenticate '%u' times",
+                login.c_str(), WrongPassBanTime, failed_logins);
+        }
+        else
+        {
+            std::string current_ip = address;
+            LoginDatabase.escape_string(current_ip);
+            LoginDatabase.PExecute("INSERT INTO ip_banned VALUES ('%s',UNIX_TIMESTAMP(),UNIX_TIMESTAMP()+'%u','MaNGOS realmd','Failed login autoban')",
+                current_ip.c_str(), WrongPassBanTime);
+            BASIC_LOG("[AuthChallenge] IP %s got banned for '%u' seconds because account %s failed to authenticate '%u' times",
+                current_ip.c_str(), WrongPassBanTime, login.c_str(), failed_logins);
+        }
+    }
+
+    delete result;
+}
+
 /// Reconnect Challenge command handler
 bool AuthSocket::_HandleReconnectChallenge()
 {
@@ -790,8 +876,33 @@ bool AuthSocket::_HandleReconnectChallenge()
     if(_os.size() > 4)
         return false;
 
-    QueryResult *result = LoginDatabase.PQuery ("SELECT sessionkey FROM account WHERE username = '%s'", _safelogin.c_str ());
+    _waitingForReply = LoginDatabase.AsyncPQuery(&AuthSocket::ReconnectChallengeCallback, _socketId,
+        "SELECT sessionkey FROM account WHERE username = '%s'", _safelogin.c_str ());
+
+    if (!_waitingForReply)
+    {
+        close_connection();
+        return false;
+    }
+
+    return true;
+}
+
+void AuthSocket::ReconnectChallengeCallback(QueryResult* result, uint32 socketId)
+{
+    AuthSocket* socket = FindSocket(socketId);
+    if (!socket)
+    {
+        delete result;
+        return;
+    }
+
+    socket->_ResumeRead(socket->_HandleReconnectChallengeResult(result));
+}
 
+/// Reconnect Challenge reply, sent once the session key is known
+bool AuthSocket::_HandleReconnectChallengeResult(QueryResult* result)
+{
     // Stop if the account is not found
     if (!result)
     {
@@ -867,10 +978,36 @@ bool AuthSocket::_HandleRealmList()
 
     recv_skip(5);
 
-    ///- Get the user id (else close the connection)
+    ///- Get the user id (else close the connection) together with the character count on every realm
     // No SQL injection (escaped user name)
+    _waitingForReply = LoginDatabase.AsyncPQuery(&AuthSocket::RealmListCallback, _socketId,
+        "SELECT a.id, rc.realmid, rc.numchars FROM account a LEFT JOIN realmcharacters rc ON rc.acctid = a.id WHERE a.username = '%s'",
+        _safelogin.c_str());
+
+    if (!_waitingForReply)
+    {
+        close_connection();
+        return false;
+    }
+
+    return true;
+}
+
+void AuthSocket::RealmListCallback(QueryResult* result, uint32 socketId)
+{
+    AuthSocket* socket = FindSocket(socketId);
+    if (!socket)
+    {
+        delete result;
+        return;
+    }
 
-    QueryResult *result = LoginDatabase.PQuery("SELECT id,sha_pass_hash FROM account WHERE username = '%s'",_safelogin.c_str());
+    socket->_ResumeRead(socket->_HandleRealmListResult(result));
+}
+
+/// %Realm List reply, sent once the account's character counts are known
+bool AuthSocket::_HandleRealmListResult(QueryResult* result)
+{
     if(!result)
     {
         sLog.outError("[ERROR] user %s tried to login and we cannot find him in the database.",_login.c_str());
@@ -878,8 +1015,15 @@ bool AuthSocket::_HandleRealmList()
         return false;
     }
 
-    uint32 id = (*result)[0].GetUInt32();
-    std::string rI = (*result)[1].GetCppString();
+    RealmCharacterCounts charCounts;
+    do
+    {
+        Field* fields = result->Fetch();
+        if (!fields[1].IsNULL())
+            charCounts[fields[1].GetUInt32()] = fields[2].GetUInt8();
+    }
+    while (result->NextRow());
+
     delete result;
 
     ///- Update realm list if need
@@ -887,7 +1031,7 @@ bool AuthSocket::_HandleRealmList()
 
     ///- Circle through realms in the RealmList and construct the return packet (including # of user characters in each realm)
     ByteBuffer pkt;
-    LoadRealmlist(pkt, id);
+    LoadRealmlist(pkt, charCounts);
 
     ByteBuffer hdr;
     hdr << (uint8) CMD_REALM_LIST;
@@ -899,7 +1043,7 @@ bool AuthSocket::_HandleRealmList()
     return true;
 }
 
-void AuthSocket::LoadRealmlist(ByteBuffer &pkt, uint32 acctid)
+void AuthSocket::LoadRealmlist(ByteBuffer &pkt, RealmCharacterCounts const& charCounts)
 {
     switch(_build)
     {
@@ -911,18 +1055,8 @@ void AuthSocket::LoadRealmlist(ByteBuffer &pkt, uint32 acctid)
 
             for(RealmList::RealmMap::const_iterator  i = sRealmList.begin(); i != sRealmList.end(); ++i)
             {
-                uint8 AmountOfCharacters;
-
-                // No SQL injection. id of realm is controlled by the database.
-                QueryResult *result = LoginDatabase.PQuery( "SELECT numchars FROM realmcharacters WHERE realmid = '%d' AND acctid='%u'", i->second.m_ID, acctid);
-                if( result )
-                {
-                    Field *fields = result->Fetch();
-                    AmountOfCharacters = fields[0].GetUInt8();
-                    delete result;
-                }
-                else
-                    AmountOfCharacters = 0;
+                RealmCharacterCounts::const_iterator count = charCounts.find(i->second.m_ID);
+                uint8 AmountOfCharacters = count != charCounts.end() ? count->second : 0;
 
                 bool ok_build = std::find(i->second.realmbuilds.begin(), i->second.realmbuilds.end(), _build) != i->second.realmbuilds.end();
 
@@ -974,18 +1108,8 @@ void AuthSocket::LoadRealmlist(ByteBuffer &pkt, uint32 acctid)
 
             for(RealmList::RealmMap::const_iterator  i = sRealmList.begin(); i != sRealmList.end(); ++i)
             {
-                uint8 AmountOfCharacters;
-
-                // No SQL injection. id of realm is controlled by the database.
-                QueryResult *result = LoginDatabase.PQuery( "SELECT numchars FROM realmcharacters WHERE realmid = '%d' AND acctid='%u'", i->second.m_ID, acctid);
-                if( result )
-                {
-                    Field *fields = result->Fetch();
-                    AmountOfCharacters = fields[0].GetUInt8();
-                    delete result;
-                }
-                else
-                    AmountOfCharacters = 0;
+                RealmCharacterCounts::const_iterator count = charCounts.find(i->second.m_ID);
+                uint8 AmountOfCharacters = count != charCounts.end() ? count->second : 0;
 
                 bool ok_build = std::find(i->second.realmbuilds.begin(), i->second.realmbuilds.end(), _build) != i->second.realmbuilds.end();
 
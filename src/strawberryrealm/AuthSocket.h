@@ -31,6 +31,9 @@
 
 #include "BufferedSocket.h"
 
+class QueryResult;
+struct AuthProofJob;
+
 /// Handle login commands
 class AuthSocket: public BufferedSocket
 {
@@ -43,7 +46,10 @@ class AuthSocket: public BufferedSocket
         void OnAccept();
         void OnRead();
         void SendProof(Sha1Hash sha);
-        void LoadRealmlist(ByteBuffer &pkt, uint32 acctid);
+
+        // realm id -> number of characters of the account on that realm
+        typedef std::map<uint32, uint8> RealmCharacterCounts;
+        void LoadRealmlist(ByteBuffer &pkt, RealmCharacterCounts const& charCounts);
 
         bool _HandleLogonChallenge();
         bool _HandleLogonProof();
@@ -58,7 +64,31 @@ class AuthSocket: public BufferedSocket
 
         void _SetVSFields(const std::string& rI);
 
+        static void LogonProofCallback(AuthProofJob* job);
+
     private:
+        // login database and crypto replies are handled in the reactor loop, the socket may be gone by then
+        typedef std::map<uint32, AuthSocket*> SocketMap;
+        static SocketMap s_sockets;
+        static uint32 s_nextSocketId;
+
+        static AuthSocket* FindSocket(uint32 socketId);
+
+        static void LogonChallengeCallback(QueryResult* result, uint32 socketId);
+        static void ReconnectChallengeCallback(QueryResult* result, uint32 socketId);
+        static void RealmListCallback(QueryResult* result, uint32 socketId);
+        static void WrongPassCallback(QueryResult* result, std::string login, std::string address);
+
+        bool _HandleLogonChallengeResult(QueryResult* result);
+        bool _HandleLogonProofResult(AuthProofJob& job);
+        bool _HandleReconnectChallengeResult(QueryResult* result);
+        bool _HandleRealmListResult(QueryResult* result);
+
+        // continue with the input buffered while a query was pending
+        void _ResumeRead(bool handled);
+
+        uint32 _socketId;
+        bool _waitingForReply;
 
         BigNumber N, s, g, v;
         BigNumber b, B;
@@ -28,6 +28,7 @@
 #include "Config/Config.h"
 #include "Log.h"
 #include "AuthSocket.h"
+#include "AuthCrypto.h"
 #include "SystemConfig.h"
 #include "revision.h"
 #include "revision_nr.h"
@@ -72,6 +73,7 @@ void usage(const char *prog)
     sLog.outString("Usage: \n %s [<options>]\n"
         "    -v, --version            print version and exist\n\r"
         "    -c config_file           use config_file as configuration file\n\r"
+        "    -b iterations            benchmark the SRP6 logon math and exit\n\r"
         #ifdef WIN32
         "    Running as service functions:\n\r"
         "    -s run                   run as service\n\r"
@@ -91,12 +93,13 @@ extern int main(int argc, char **argv)
     ///- Command line parsing
     char const* cfg_file = _STRAWBERRYREALM_CONFIG;
 
-    char const *options = ":c:s:";
+    char const *options = ":c:s:b:";
 
     ACE_Get_Opt cmd_opts(argc, argv, options);
     cmd_opts.long_option("version", 'v');
 
     char serviceDaemonMode = '\0';
+    uint32 benchmarkIterations = 0;
 
     int option;
     while ((option = cmd_opts()) != EOF)
@@ -109,6 +112,9 @@ extern int main(int argc, char **argv)
             case 'v':
                 printf("%s\n", _FULLVERSION(REVISION_DATE,REVISION_TIME,REVISION_NR,REVISION_ID));
                 return 0;
+            case 'b':
+                benchmarkIterations = atoi(cmd_opts.opt_arg());
+                break;
 
             case 's':
             {
@@ -147,6 +153,12 @@ extern int main(int argc, char **argv)
         }
     }
 
+    if (benchmarkIterations)
+    {
+        sAuthCrypto.Benchmark(benchmarkIterations);
+        return 0;
+    }
+
 #ifdef WIN32                                                // windows service command need execute before config read
     switch (serviceDaemonMode)
     {
@@ -256,6 +268,9 @@ extern int main(int argc, char **argv)
     LoginDatabase.Execute("DELETE FROM ip_banned WHERE unbandate<=UNIX_TIMESTAMP() AND unbandate<>bandate");
     LoginDatabase.CommitTransaction();
 
+    ///- Start the logon proof workers before the first connection
+    sAuthCrypto.Initialize(sConfig.GetIntDefault("CryptoThreads", 2));
+
     ///- Launch the listening network socket
     ACE_Acceptor<AuthSocket, ACE_SOCK_Acceptor> acceptor;
 
@@ -321,7 +336,7 @@ extern int main(int argc, char **argv)
     LoginDatabase.AllowAsyncTransactions();
 
     // maximum counter for next ping
-    uint32 numLoops = (sConfig.GetIntDefault( "MaxPingTime", 30 ) * (MINUTE * 1000000 / 100000));
+    uint32 numLoops = (sConfig.GetIntDefault( "MaxPingTime", 30 ) * (MINUTE * 1000000 / 10000));
     uint32 loopCounter = 0;
 
     #ifndef WIN32
@@ -331,11 +346,15 @@ extern int main(int argc, char **argv)
     while (!stopEvent)
     {
         // dont move this outside the loop, the reactor will modify it
-        ACE_Time_Value interval(0, 100000);
+        // kept short, database and crypto replies are only handed back to the sockets between reactor runs
+        ACE_Time_Value interval(0, 10000);
 
         if (ACE_Reactor::instance()->run_reactor_event_loop(interval) == -1)
             break;
 
+        LoginDatabase.ProcessResultQueue();
+        sAuthCrypto.Update();
+
         if( (++loopCounter) == numLoops )
         {
             loopCounter = 0;
@@ -348,8 +367,9 @@ extern int main(int argc, char **argv)
 #endif
     }
 
-    ///- Wait for the delay thread to exit
+    ///- Wait for the delay thread and the crypto workers to exit
     LoginDatabase.HaltDelayThread();
+    sAuthCrypto.StopWorkers();
 
     ///- Remove signal handling before leaving
     UnhookSignals();
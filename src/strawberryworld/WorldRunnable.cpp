@@ -27,12 +27,13 @@
 #include "WorldRunnable.h"
 #include "Timer.h"
 #include "MapManager.h"
+#include "MapPersistentStateMgr.h"
 #include "BattleGroundMgr.h"
+#include "LFGMgr.h"
+#include "AuctionHouseBot/AuctionHouseBot.h"
 
 #include "Database/DatabaseEnv.h"
 
-#define WORLD_SLEEP_CONST 50
-
 #ifdef WIN32
 #include "ServiceWin32.h"
 extern int m_ServiceStatus;
@@ -48,7 +49,7 @@ void WorldRunnable::run()
     uint32 realCurrTime = 0;
     uint32 realPrevTime = WorldTimer::tick();
 
-    uint32 prevSleepTime = 0;                               // used for balanced full tick time length near WORLD_SLEEP_CONST
+    uint32 prevSleepTime = 0;                               // used for balanced full tick time length near WorldTickTime
 
     ///- While we have not World::m_stopEvent, update the world
     while (!World::IsStopped())
@@ -61,13 +62,17 @@ void WorldRunnable::run()
         sWorld.Update( diff );
         realPrevTime = realCurrTime;
 
+        // read every tick, WorldTickTime can be changed by config reload
+        uint32 tickTime = sWorld.getConfig(CONFIG_UINT32_WORLD_TICK_TIME);
+
         // diff (D0) include time of previous sleep (d0) + tick time (t0)
-        // we want that next d1 + t1 == WORLD_SLEEP_CONST
-        // we can't know next t1 and then can use (t0 + d1) == WORLD_SLEEP_CONST requirement
-        // d1 = WORLD_SLEEP_CONST - t0 = WORLD_SLEEP_CONST - (D0 - d0) = WORLD_SLEEP_CONST + d0 - D0
-        if (diff <= WORLD_SLEEP_CONST+prevSleepTime)
+        // we want that next d1 + t1 == tickTime
+        // we can't know next t1 and then can use (t0 + d1) == tickTime requirement
+        // d1 = tickTime - t0 = tickTime - (D0 - d0) = tickTime + d0 - D0
+        // an overrun tick gets no sleep, the next one starts at once to catch up
+        if (diff <= tickTime+prevSleepTime)
         {
-            prevSleepTime = WORLD_SLEEP_CONST+prevSleepTime-diff;
+            prevSleepTime = tickTime+prevSleepTime-diff;
             ACE_Based::Thread::Sleep(prevSleepTime);
         }
         else
@@ -85,8 +90,14 @@ void WorldRunnable::run()
     // unload battleground templates before different singletons destroyed
     sBattleGroundMgr.DeleteAllBattleGrounds();
 
+    // matching thread must not outlive the world thread
+    sLFGMgr.StopQueueThread();
+    sAuctionBot.StopPlanningThread();
+
     sWorldSocketMgr->StopNetwork();
 
+    sMapPersistentStateMgr.FinishGlobalResets();            // delete rows of global instance resets still in progress
+
     MapManager::Instance().UnloadAll();                     // unload all grids (including locked in memory)
 
     ///- End the database thread
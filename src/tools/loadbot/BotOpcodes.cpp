@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2010-2012 Strawberry-Pr0jcts <http://strawberry-pr0jcts.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/// \addtogroup loadbot
+/// @{
+/// \file
+
+#include "BotOpcodes.h"
+#include "Database/DatabaseEnv.h"
+#include "Log.h"
+
+uint16 BotOpcodes::m_values[MAX_BOT_OPCODES];
+
+static char const* const botOpcodeNames[MAX_BOT_OPCODES] =
+{
+    "MSG_WOW_CONNECTION",
+    "SMSG_AUTH_CHALLENGE",
+    "CMSG_AUTH_SESSION",
+    "SMSG_AUTH_RESPONSE",
+    "CMSG_PING",
+    "SMSG_PONG",
+    "CMSG_REQUEST_CHARACTER_ENUM",
+    "SMSG_RESPONSE_CHARACTER_ENUM",
+    "CMSG_REQUEST_CHARACTER_CREATE",
+    "SMSG_RESPONSE_CHARACTER_CREATE",
+    "CMSG_PLAYER_LOGIN",
+    "SMSG_LOGIN_VERIFY_WORLD",
+    "CMSG_LOADING_SCREEN_NOTIFY",
+    "SMSG_TIME_SYNC_REQ",
+    "CMSG_TIME_SYNC_RESPONSE",
+    "MSG_MOVE_HEARTBEAT",
+    "CMSG_CAST_SPELL",
+    "CMSG_CHAT_MESSAGE_SAY",
+    "CMSG_WHO",
+    "SMSG_WHO",
+    "CMSG_LOGOUT_REQUEST"
+};
+
+bool BotOpcodes::Load()
+{
+    for (uint32 i = 0; i < MAX_BOT_OPCODES; ++i)
+        m_values[i] = BOT_OPCODE_NONE;
+
+    QueryResult* result = WorldDatabase.Query("SELECT OpcodeName, OpcodeValue FROM opcodes WHERE ClientBuild = 15595");
+    if (!result)
+    {
+        sLog.outError("Table `opcodes` is empty or missing.");
+        return false;
+    }
+
+    do
+    {
+        Field* fields = result->Fetch();
+        std::string name = fields[0].GetCppString();
+
+        for (uint32 i = 0; i < MAX_BOT_OPCODES; ++i)
+        {
+            if (name == botOpcodeNames[i])
+            {
+                m_values[i] = uint16(fields[1].GetUInt32());
+                break;
+            }
+        }
+    }
+    while (result->NextRow());
+
+    delete result;
+
+    bool complete = true;
+    for (uint32 i = 0; i < MAX_BOT_OPCODES; ++i)
+    {
+        if (m_values[i] == BOT_OPCODE_NONE)
+        {
+            sLog.outError("Opcode %s has no value in table `opcodes`.", botOpcodeNames[i]);
+            complete = false;
+        }
+    }
+
+    return complete;
+}
+
+char const* BotOpcodes::GetName(BotOpcode opcode)
+{
+    return opcode < MAX_BOT_OPCODES ? botOpcodeNames[opcode] : "UNKNOWN";
+}
+
+BotOpcode BotOpcodes::Lookup(uint16 value)
+{
+    for (uint32 i = 0; i < MAX_BOT_OPCODES; ++i)
+        if (m_values[i] == value)
+            return BotOpcode(i);
+
+    return MAX_BOT_OPCODES;
+}
+
+/// @}
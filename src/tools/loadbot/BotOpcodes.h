@@ -0,0 +1,75 @@
+/*
+ * Copyright (C) 2010-2012 Strawberry-Pr0jcts <http://strawberry-pr0jcts.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/// \addtogroup loadbot
+/// @{
+/// \file
+
+#ifndef _BOTOPCODES_H
+#define _BOTOPCODES_H
+
+#include "Common.h"
+
+/// The opcodes a load bot sends or reacts to; wire values come from the world database like in the server
+enum BotOpcode
+{
+    BOT_MSG_WOW_CONNECTION = 0,
+    BOT_SMSG_AUTH_CHALLENGE,
+    BOT_CMSG_AUTH_SESSION,
+    BOT_SMSG_AUTH_RESPONSE,
+    BOT_CMSG_PING,
+    BOT_SMSG_PONG,
+    BOT_CMSG_REQUEST_CHARACTER_ENUM,
+    BOT_SMSG_RESPONSE_CHARACTER_ENUM,
+    BOT_CMSG_REQUEST_CHARACTER_CREATE,
+    BOT_SMSG_RESPONSE_CHARACTER_CREATE,
+    BOT_CMSG_PLAYER_LOGIN,
+    BOT_SMSG_LOGIN_VERIFY_WORLD,
+    BOT_CMSG_LOADING_SCREEN_NOTIFY,
+    BOT_SMSG_TIME_SYNC_REQ,
+    BOT_CMSG_TIME_SYNC_RESPONSE,
+    BOT_MSG_MOVE_HEARTBEAT,
+    BOT_CMSG_CAST_SPELL,
+    BOT_CMSG_CHAT_MESSAGE_SAY,
+    BOT_CMSG_WHO,
+    BOT_SMSG_WHO,
+    BOT_CMSG_LOGOUT_REQUEST,
+    MAX_BOT_OPCODES
+};
+
+/// Unknown wire value, also the value of opcodes missing in the database
+#define BOT_OPCODE_NONE 0
+
+class BotOpcodes
+{
+    public:
+        /// Fills the table from the opcodes table of the world database, false if a required opcode is missing
+        static bool Load();
+
+        static uint16 GetValue(BotOpcode opcode) { return m_values[opcode]; }
+        static char const* GetName(BotOpcode opcode);
+
+        /// Reverse lookup of a received wire value, MAX_BOT_OPCODES for opcodes the bot does not handle
+        static BotOpcode Lookup(uint16 value);
+
+    private:
+        static uint16 m_values[MAX_BOT_OPCODES];
+};
+
+#endif
+/// @}
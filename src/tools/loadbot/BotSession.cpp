@@ -0,0 +1,1075 @@
+/*
+ * Copyright (C) 2010-2012 Strawberry-Pr0jcts <http://strawberry-pr0jcts.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/// \addtogroup loadbot
+/// @{
+/// \file
+
+#include "BotSession.h"
+#include "BotStats.h"
+#include "Auth/Sha1.h"
+#include "Auth/HMACSHA1.h"
+#include "Timer.h"
+#include "Util.h"
+#include "Log.h"
+
+#include <ace/SOCK_Connector.h>
+#include <ace/INET_Addr.h>
+#include <ace/ACE.h>
+
+#define BOT_CLIENT_BUILD        15595
+#define BOT_CONNECT_TIMEOUT     5                           // seconds
+
+// realm commands, see eAuthCmd
+#define BOT_CMD_AUTH_LOGON_CHALLENGE    0x00
+#define BOT_CMD_AUTH_LOGON_PROOF        0x01
+#define BOT_CMD_REALM_LIST              0x10
+
+// single byte results the bot checks
+#define BOT_AUTH_OK                     0x0C
+#define BOT_AUTH_WAIT_QUEUE             0x1B
+#define BOT_CHAR_CREATE_SUCCESS         0x2F
+#define BOT_CHAR_CREATE_NAME_IN_USE     0x32
+
+// equipment and bag entries of one character in SMSG_RESPONSE_CHARACTER_ENUM, 9 bytes each
+#define BOT_ENUM_EQUIPMENT_ENTRIES      23
+
+// movement heartbeat circle
+#define BOT_MOVE_RADIUS                 10.0f
+#define BOT_MOVE_STEP                   0.2f
+
+static char const* const botChatLines[] =
+{
+    "anyone up for a dungeon?",
+    "selling stuff, whisper me",
+    "how do I get to the capital from here?",
+    "lag again...",
+    "looking for group"
+};
+
+#define BOT_CHAT_LINES (sizeof(botChatLines) / sizeof(botChatLines[0]))
+
+static bool IsDue(uint32 now, uint32 at)
+{
+    return int32(now - at) >= 0;
+}
+
+static uint32 GetElapsedUs(ACE_Time_Value const& start)
+{
+    ACE_Time_Value elapsed = ACE_OS::gettimeofday() - start;
+    return elapsed > ACE_Time_Value::zero ? uint32(elapsed.sec() * 1000000 + elapsed.usec()) : 0;
+}
+
+BotSession::BotSession(BotConfig const& config, std::string const& account, std::string const& charName, uint32 startTime) :
+    m_config(config), m_account(account), m_charName(charName), m_state(BOT_STATE_WAITING), m_nextStart(startTime),
+    m_connected(false), m_connecting(false), m_connectDeadline(0), m_worldPort(0), m_encrypt(SHA_DIGEST_LENGTH), m_decrypt(SHA_DIGEST_LENGTH),
+    m_cryptInitialized(false), m_decryptedHeader(0), m_guid(0), m_homeX(0.0f), m_homeY(0.0f), m_homeZ(0.0f),
+    m_angle(0.0f), m_nextMove(0), m_nextCast(0), m_nextChat(0), m_nextWho(0), m_nextPing(0), m_castCount(0),
+    m_pingSequence(0), m_whoPending(false)
+{
+    std::transform(m_account.begin(), m_account.end(), m_account.begin(), ::toupper);
+}
+
+BotSession::~BotSession()
+{
+    Close();
+}
+
+void BotSession::Close()
+{
+    if (m_state == BOT_STATE_IN_WORLD)
+        sBotStats.RemoveInWorld();
+
+    if (m_connected || m_connecting)
+    {
+        m_socket.close();
+        m_connected = false;
+        m_connecting = false;
+    }
+
+    m_recvBuf.clear();
+}
+
+void BotSession::Fail(char const* reason)
+{
+    DETAIL_LOG("Bot %s: %s", m_account.c_str(), reason);
+    sBotStats.AddFailure();
+
+    Close();
+
+    if (m_config.retryDelay)
+    {
+        m_state = BOT_STATE_WAITING;
+        m_nextStart = WorldTimer::getMSTime() + m_config.retryDelay;
+    }
+    else
+        m_state = BOT_STATE_FAILED;
+}
+
+/// Starts a non blocking connect, false if it failed at once; UpdateConnect() polls for the result
+bool BotSession::Connect(std::string const& host, uint16 port)
+{
+    ACE_INET_Addr addr(port, host.c_str());
+    ACE_SOCK_Connector connector;
+
+    m_recvBuf.clear();
+
+    // a zero timeout returns at once, EWOULDBLOCK while the connect is in progress
+    if (connector.connect(m_socket, addr, &ACE_Time_Value::zero) == -1)
+    {
+        if (errno != EWOULDBLOCK)
+            return false;
+
+        m_connecting = true;
+        m_connectDeadline = WorldTimer::getMSTime() + BOT_CONNECT_TIMEOUT * IN_MILLISECONDS;
+        return true;
+    }
+
+    m_socket.enable(ACE_NONBLOCK);
+    m_connected = true;
+    return true;
+}
+
+/// Polls a pending connect, true once the socket is usable; fails the bot on error or timeout
+bool BotSession::UpdateConnect(uint32 now)
+{
+    if (!m_connecting)
+        return true;
+
+    if (ACE::handle_timed_complete(m_socket.get_handle(), &ACE_Time_Value::zero) == ACE_INVALID_HANDLE)
+    {
+        if (errno == ETIME && !IsDue(now, m_connectDeadline))
+            return false;
+
+        Fail(m_state == BOT_STATE_WORLD_AUTH ? "can't connect to the world server" : "can't connect to the realm server");
+        return false;
+    }
+
+    m_socket.enable(ACE_NONBLOCK);
+    m_connecting = false;
+    m_connected = true;
+
+    if (m_state == BOT_STATE_LOGON_CHALLENGE)
+        SendLogonChallenge();
+    else
+        m_worldStart = ACE_OS::gettimeofday();
+    return true;
+}
+
+/// Drains the socket into m_recvBuf, false once the server closed the connection
+bool BotSession::ReadSocket()
+{
+    char buf[4096];
+
+    for (;;)
+    {
+        ssize_t n = m_socket.recv(buf, sizeof(buf));
+        if (n > 0)
+        {
+            m_recvBuf.insert(m_recvBuf.end(), buf, buf + n);
+            continue;
+        }
+
+        if (n < 0 && (errno == EWOULDBLOCK || errno == EAGAIN))
+            return true;
+
+        return false;
+    }
+}
+
+void BotSession::Update(uint32 now)
+{
+    switch (m_state)
+    {
+        case BOT_STATE_FAILED:
+            return;
+        case BOT_STATE_WAITING:
+            if (IsDue(now, m_nextStart))
+                StartLogon(now);
+            return;
+        default:
+            break;
+    }
+
+    if (!UpdateConnect(now))
+        return;
+
+    switch (m_state)
+    {
+        case BOT_STATE_LOGON_CHALLENGE:
+        case BOT_STATE_LOGON_PROOF:
+        case BOT_STATE_REALM_LIST:
+            if (!ReadSocket())
+            {
+                Fail("realm server closed the connection");
+                return;
+            }
+
+            if (!HandleRealmInput())
+                return;
+
+            // realm list received, move over to the world server
+            if (m_state == BOT_STATE_WORLD_AUTH && !ConnectWorld())
+                Fail("can't connect to the world server");
+            return;
+        default:
+            break;
+    }
+
+    if (!ReadSocket())
+    {
+        Fail("world server closed the connection");
+        return;
+    }
+
+    if (!HandleWorldInput())
+        return;
+
+    if (m_state == BOT_STATE_IN_WORLD)
+        UpdateInWorld(now);
+}
+
+// ---------------------------------------------------------------------------------------------------
+// Realm server: SRP6 logon and realm list
+// ---------------------------------------------------------------------------------------------------
+
+void BotSession::StartLogon(uint32 /*now*/)
+{
+    if (!Connect(m_config.realmHost, m_config.realmPort))
+    {
+        Fail("can't connect to the realm server");
+        return;
+    }
+
+    // the challenge goes out once the connect completed
+    m_state = BOT_STATE_LOGON_CHALLENGE;
+    if (m_connected)
+        SendLogonChallenge();
+}
+
+void BotSession::SendLogonChallenge()
+{
+    ByteBuffer pkt;
+    pkt << uint8(BOT_CMD_AUTH_LOGON_CHALLENGE);
+    pkt << uint8(8);                                        // error, the client sends 8 for 3.x and later
+    pkt << uint16(30 + m_account.size());                   // rest of the packet
+    pkt.append("WoW", 4);
+    pkt << uint8(4) << uint8(3) << uint8(4);                // 4.3.4
+    pkt << uint16(BOT_CLIENT_BUILD);
+    pkt.append("68x", 4);                                   // platform and os are sent reversed
+    pkt.append("niW", 4);
+    pkt.append("SUne", 4);
+    pkt << uint32(60);                                      // timezone bias
+    pkt << uint32(0x0100007F);                              // local ip
+    pkt << uint8(m_account.size());
+    pkt.append(m_account.c_str(), m_account.size());
+
+    m_logonStart = ACE_OS::gettimeofday();
+    m_socket.send_n(pkt.contents(), pkt.size());
+}
+
+/// Parses as many realm replies as are complete, false if the bot failed
+bool BotSession::HandleRealmInput()
+{
+    switch (m_state)
+    {
+        case BOT_STATE_LOGON_CHALLENGE:
+            return HandleLogonChallenge();
+        case BOT_STATE_LOGON_PROOF:
+            return HandleLogonProof();
+        case BOT_STATE_REALM_LIST:
+            return HandleRealmList();
+        default:
+            return true;
+    }
+}
+
+bool BotSession::HandleLogonChallenge()
+{
+    // cmd, 0, result, B[32], g_len, g, N_len, N[32], s[32], unk[16], security flags
+    if (m_recvBuf.size() < 3)
+        return true;
+
+    if (m_recvBuf[2] != 0)
+    {
+        Fail("logon challenge refused, unknown account or banned");
+        return false;
+    }
+
+    if (m_recvBuf.size() < 119)
+        return true;
+
+    uint8 const* p = &m_recvBuf[3];
+
+    BigNumber N, g, B, s;
+    B.SetBinary(p, 32);
+    g.SetBinary(p + 33, 1);
+    N.SetBinary(p + 35, 32);
+    s.SetBinary(p + 67, 32);
+
+    m_recvBuf.clear();
+
+    ///- x = H(s, H(I:P)) as the realm derives v from sha_pass_hash
+    std::string password = m_config.password;
+    std::transform(password.begin(), password.end(), password.begin(), ::toupper);
+
+    Sha1Hash sha;
+    sha.UpdateData(m_account);
+    sha.UpdateData(":");
+    sha.UpdateData(password);
+    sha.Finalize();
+
+    uint8 passHash[SHA_DIGEST_LENGTH];
+    memcpy(passHash, sha.GetDigest(), SHA_DIGEST_LENGTH);
+
+    sha.Initialize();
+    sha.UpdateBigNumbers(&s, NULL);
+    sha.UpdateData(passHash, SHA_DIGEST_LENGTH);
+    sha.Finalize();
+
+    BigNumber x;
+    x.SetBinary(sha.GetDigest(), sha.GetLength());
+
+    ///- A = g^a, u = H(A, B), S = (B - 3 g^x)^(a + u x)
+    BigNumber a;
+    a.SetRand(19 * 8);
+    BigNumber A = g.ModExp(a, N);
+
+    sha.Initialize();
+    sha.UpdateBigNumbers(&A, &B, NULL);
+    sha.Finalize();
+
+    BigNumber u;
+    u.SetBinary(sha.GetDigest(), 20);
+
+    BigNumber kgx = (g.ModExp(x, N) * 3) % N;
+    BigNumber base = ((B + N) - kgx) % N;
+    BigNumber S = base.ModExp(a + u * x, N);
+
+    ///- Session key, interleaved hash of the even and odd bytes of S
+    uint8 t[32];
+    uint8 t1[16];
+    uint8 vK[40];
+    memcpy(t, S.AsByteArray(32), 32);
+
+    for (int i = 0; i < 16; ++i)
+        t1[i] = t[i * 2];
+    sha.Initialize();
+    sha.UpdateData(t1, 16);
+    sha.Finalize();
+    for (int i = 0; i < 20; ++i)
+        vK[i * 2] = sha.GetDigest()[i];
+
+    for (int i = 0; i < 16; ++i)
+        t1[i] = t[i * 2 + 1];
+    sha.Initialize();
+    sha.UpdateData(t1, 16);
+    sha.Finalize();
+    for (int i = 0; i < 20; ++i)
+        vK[i * 2 + 1] = sha.GetDigest()[i];
+
+    m_K.SetBinary(vK, 40);
+
+    ///- M1 = H(H(N) xor H(g), H(I), s, A, B, K)
+    uint8 hash[20];
+    sha.Initialize();
+    sha.UpdateBigNumbers(&N, NULL);
+    sha.Finalize();
+    memcpy(hash, sha.GetDigest(), 20);
+    sha.Initialize();
+    sha.UpdateBigNumbers(&g, NULL);
+    sha.Finalize();
+    for (int i = 0; i < 20; ++i)
+        hash[i] ^= sha.GetDigest()[i];
+
+    BigNumber t3;
+    t3.SetBinary(hash, 20);
+
+    sha.Initialize();
+    sha.UpdateData(m_account);
+    sha.Finalize();
+    uint8 t4[SHA_DIGEST_LENGTH];
+    memcpy(t4, sha.GetDigest(), SHA_DIGEST_LENGTH);
+
+    sha.Initialize();
+    sha.UpdateBigNumbers(&t3, NULL);
+    sha.UpdateData(t4, SHA_DIGEST_LENGTH);
+    sha.UpdateBigNumbers(&s, &A, &B, &m_K, NULL);
+    sha.Finalize();
+
+    ByteBuffer pkt;
+    pkt << uint8(BOT_CMD_AUTH_LOGON_PROOF);
+    pkt.append(A.AsByteArray(32), 32);
+    pkt.append(sha.GetDigest(), 20);
+    uint8 crc[20];
+    memset(crc, 0, sizeof(crc));
+    pkt.append(crc, 20);
+    pkt << uint8(0);                                        // number of keys
+    pkt << uint8(0);                                        // security flags
+
+    m_socket.send_n(pkt.contents(), pkt.size());
+    m_state = BOT_STATE_LOGON_PROOF;
+    return true;
+}
+
+bool BotSession::HandleLogonProof()
+{
+    // cmd, error, M2[20], account flags, survey id, unk flags
+    if (m_recvBuf.size() < 2)
+        return true;
+
+    if (m_recvBuf[1] != 0)
+    {
+        Fail("logon proof refused, wrong password");
+        return false;
+    }
+
+    if (m_recvBuf.size() < 32)
+        return true;
+
+    m_recvBuf.erase(m_recvBuf.begin(), m_recvBuf.begin() + 32);
+    sBotStats.AddSample(BOT_PROBE_LOGON, GetElapsedUs(m_logonStart));
+
+    // the realm stores the session key with an async query queued before the realm list one,
+    // so waiting for the realm list also guarantees the world server can read the key
+    ByteBuffer pkt;
+    pkt << uint8(BOT_CMD_REALM_LIST);
+    pkt << uint32(0);
+
+    m_socket.send_n(pkt.contents(), pkt.size());
+    m_state = BOT_STATE_REALM_LIST;
+    return true;
+}
+
+bool BotSession::HandleRealmList()
+{
+    // cmd, uint16 size, then size bytes
+    if (m_recvBuf.size() < 3)
+        return true;
+
+    uint16 size = uint16(m_recvBuf[1] | (m_recvBuf[2] << 8));
+    if (m_recvBuf.size() < size_t(3 + size))
+        return true;
+
+    ByteBuffer list;
+    list.append(&m_recvBuf[3], size);
+    m_recvBuf.clear();
+
+    m_worldHost = m_config.worldHost;
+    m_worldPort = m_config.worldPort;
+
+    if (m_worldHost.empty())
+    {
+        try
+        {
+            list.read_skip<uint32>();
+            if (!list.read<uint16>())
+            {
+                Fail("realm list is empty");
+                return false;
+            }
+
+            list.read_skip<uint8>();                        // icon
+            list.read_skip<uint8>();                        // lock
+            list.read_skip<uint8>();                        // flags
+            std::string name, address;
+            list >> name >> address;
+
+            std::string::size_type colon = address.find(':');
+            if (colon == std::string::npos)
+            {
+                Fail("malformed realm address");
+                return false;
+            }
+
+            m_worldHost = address.substr(0, colon);
+            m_worldPort = uint16(atoi(address.c_str() + colon + 1));
+        }
+        catch (ByteBufferException&)
+        {
+            Fail("malformed realm list");
+            return false;
+        }
+    }
+
+    m_socket.close();
+    m_connected = false;
+    m_state = BOT_STATE_WORLD_AUTH;
+    return true;
+}
+
+// ---------------------------------------------------------------------------------------------------
+// World server
+// ---------------------------------------------------------------------------------------------------
+
+bool BotSession::ConnectWorld()
+{
+    m_cryptInitialized = false;
+    m_decryptedHeader = 0;
+
+    if (!Connect(m_worldHost, m_worldPort))
+        return false;
+
+    // otherwise set when the pending connect completes
+    if (m_connected)
+        m_worldStart = ACE_OS::gettimeofday();
+    return true;
+}
+
+void BotSession::InitCrypt()
+{
+    // the server encrypts with the first key and decrypts with the second one, the bot the other way around
+    uint8 serverEncryptionKey[SEED_KEY_SIZE] = { 0xCC, 0x98, 0xAE, 0x04, 0xE8, 0x97, 0xEA, 0xCA, 0x12, 0xDD, 0xC0, 0x93, 0x42, 0x91, 0x53, 0x57 };
+    uint8 serverDecryptionKey[SEED_KEY_SIZE] = { 0xC2, 0xB3, 0x72, 0x3C, 0xC6, 0xAE, 0xD9, 0xB5, 0x34, 0x3C, 0x53, 0xEE, 0x2F, 0x43, 0x67, 0xCE };
+
+    HMACSHA1 decryptHmac(SEED_KEY_SIZE, serverEncryptionKey);
+    m_decrypt.Init(decryptHmac.ComputeHash(&m_K));
+
+    HMACSHA1 encryptHmac(SEED_KEY_SIZE, serverDecryptionKey);
+    m_encrypt.Init(encryptHmac.ComputeHash(&m_K));
+
+    uint8 syncBuf[1024];
+    memset(syncBuf, 0, sizeof(syncBuf));
+    m_encrypt.UpdateData(sizeof(syncBuf), syncBuf);
+
+    memset(syncBuf, 0, sizeof(syncBuf));
+    m_decrypt.UpdateData(sizeof(syncBuf), syncBuf);
+
+    m_cryptInitialized = true;
+}
+
+void BotSession::SendPacket(BotOpcode opcode, ByteBuffer const& data)
+{
+    // uint16 size (big endian, includes the opcode), uint32 opcode
+    uint8 header[6];
+    uint16 size = uint16(data.size() + 4);
+    uint32 cmd = BotOpcodes::GetValue(opcode);
+
+    header[0] = uint8(size >> 8);
+    header[1] = uint8(size);
+    header[2] = uint8(cmd);
+    header[3] = uint8(cmd >> 8);
+    header[4] = uint8(cmd >> 16);
+    header[5] = uint8(cmd >> 24);
+
+    if (m_cryptInitialized)
+        m_encrypt.UpdateData(sizeof(header), header);
+
+    ByteBuffer pkt(sizeof(header) + data.size());
+    pkt.append(header, sizeof(header));
+    if (!data.empty())
+        pkt.append(data.contents(), data.size());
+
+    m_socket.send_n(pkt.contents(), pkt.size());
+    sBotStats.AddSentPacket(pkt.size());
+}
+
+/// Splits m_recvBuf into packets, false if the bot failed
+bool BotSession::HandleWorldInput()
+{
+    size_t pos = 0;
+
+    while (m_recvBuf.size() > pos)
+    {
+        uint8* p = &m_recvBuf[pos];
+        size_t available = m_recvBuf.size() - pos;
+
+        // the header is decrypted exactly once, even if the payload is still incomplete
+        if (!m_decryptedHeader)
+        {
+            if (m_cryptInitialized)
+                m_decrypt.UpdateData(1, p);
+            m_decryptedHeader = 1;
+        }
+
+        // 0x80 in the first byte flags a three byte size
+        uint32 headerSize = (p[0] & 0x80) ? 5 : 4;
+        if (available < headerSize)
+            break;
+
+        if (m_decryptedHeader < headerSize)
+        {
+            if (m_cryptInitialized)
+                m_decrypt.UpdateData(headerSize - m_decryptedHeader, p + m_decryptedHeader);
+            m_decryptedHeader = headerSize;
+        }
+
+        uint32 size = headerSize == 5 ? ((p[0] & 0x7F) << 16) | (p[1] << 8) | p[2] : (p[0] << 8) | p[1];
+        uint16 opcode = uint16(p[headerSize - 2] | (p[headerSize - 1] << 8));
+
+        if (size < 2)
+        {
+            Fail("malformed world packet header");
+            return false;
+        }
+
+        size_t payload = size - 2;
+        if (available < headerSize + payload)
+            break;
+
+        ByteBuffer data(payload);
+        if (payload)
+            data.append(p + headerSize, payload);
+
+        pos += headerSize + payload;
+        m_decryptedHeader = 0;
+
+        sBotStats.AddReceivedPacket(headerSize + payload);
+
+        BotOpcode botOpcode = BotOpcodes::Lookup(opcode);
+        if (botOpcode == MAX_BOT_OPCODES)
+            continue;
+
+        try
+        {
+            if (!HandlePacket(botOpcode, data))
+                return false;
+        }
+        catch (ByteBufferException&)
+        {
+            Fail("malformed world packet");
+            return false;
+        }
+    }
+
+    m_recvBuf.erase(m_recvBuf.begin(), m_recvBuf.begin() + pos);
+    return true;
+}
+
+bool BotSession::HandlePacket(BotOpcode opcode, ByteBuffer& data)
+{
+    switch (opcode)
+    {
+        case BOT_MSG_WOW_CONNECTION:
+        {
+            ByteBuffer pkt;
+            pkt << std::string("D OF WARCRAFT CONNECTION - CLIENT TO SERVER");
+            SendPacket(BOT_MSG_WOW_CONNECTION, pkt);
+            return true;
+        }
+        case BOT_SMSG_AUTH_CHALLENGE:
+            return HandleAuthChallenge(data);
+        case BOT_SMSG_AUTH_RESPONSE:
+            return HandleAuthResponse(data);
+        case BOT_SMSG_RESPONSE_CHARACTER_ENUM:
+            return HandleCharEnum(data);
+        case BOT_SMSG_RESPONSE_CHARACTER_CREATE:
+            return HandleCharCreate(data);
+        case BOT_SMSG_LOGIN_VERIFY_WORLD:
+            HandleLoginVerifyWorld(data);
+            return true;
+        case BOT_SMSG_TIME_SYNC_REQ:
+        {
+            ByteBuffer pkt;
+            pkt << data.read<uint32>();                     // counter
+            pkt << WorldTimer::getMSTime();                 // client ticks
+            SendPacket(BOT_CMSG_TIME_SYNC_RESPONSE, pkt);
+            return true;
+        }
+        case BOT_SMSG_PONG:
+            sBotStats.AddSample(BOT_PROBE_PING, GetElapsedUs(m_pingSent));
+            return true;
+        case BOT_SMSG_WHO:
+            if (m_whoPending)
+            {
+                sBotStats.AddSample(BOT_PROBE_WHO, GetElapsedUs(m_whoSent));
+                m_whoPending = false;
+            }
+            return true;
+        default:
+            return true;
+    }
+}
+
+bool BotSession::HandleAuthChallenge(ByteBuffer& data)
+{
+    data.read_skip(32);
+    data.read_skip<uint32>();                               // server seed, only needed for the digest
+    uint32 clientSeed = urand(1, 0xFFFFFFFE);
+
+    // same field order as WorldSocket::HandleAuthSession reads it; the digest is not verified there, send it zeroed
+    uint8 zero[8];
+    memset(zero, 0, sizeof(zero));
+
+    ByteBuffer pkt;
+    pkt << uint32(0);
+    pkt << uint32(0);
+    pkt << uint8(0);
+    pkt.append(zero, 4);
+    pkt << uint64(0);
+    pkt.append(zero, 7);
+    pkt << uint16(BOT_CLIENT_BUILD);
+    pkt.append(zero, 1);
+    pkt << uint32(0);
+    pkt << uint8(0);
+    pkt.append(zero, 5);
+    pkt << uint32(0);
+    pkt.append(zero, 1);
+    pkt << uint32(clientSeed);
+    pkt.append(zero, 2);
+    pkt << uint32(4);                                       // addon block size
+    pkt << uint32(0);                                       // uncompressed addon size, no addons
+    pkt << uint8(0);
+    pkt << uint8(0);
+    pkt << m_account;
+
+    SendPacket(BOT_CMSG_AUTH_SESSION, pkt);
+
+    // the server switches to the crypted header right after reading the auth session
+    InitCrypt();
+    return true;
+}
+
+bool BotSession::HandleAuthResponse(ByteBuffer& data)
+{
+    // the first response is bit packed with the account info, queue updates and errors are plain
+    if (data.size() == 1)
+    {
+        if (data.read<uint8>() != BOT_AUTH_OK)
+        {
+            Fail("world server refused the session");
+            return false;
+        }
+    }
+    else if (data[0] == BOT_AUTH_WAIT_QUEUE)
+        return true;                                        // queue position update
+    else
+    {
+        bool queued = data.ReadBit();
+        if (queued)
+            return true;                                    // wait for the AUTH_OK at the end of the queue
+
+        if (data[data.size() - 1] != BOT_AUTH_OK)
+        {
+            Fail("world server refused the session");
+            return false;
+        }
+    }
+
+    SendPacket(BOT_CMSG_REQUEST_CHARACTER_ENUM, ByteBuffer(0));
+    m_state = BOT_STATE_CHAR_ENUM;
+    return true;
+}
+
+bool BotSession::HandleCharEnum(ByteBuffer& data)
+{
+    ///- Bit block: 23 unknown bits, 1 set bit, 17 bit count, then 18 bits per character
+    for (int i = 0; i < 24; ++i)
+        data.ReadBit();
+
+    uint32 count = 0;
+    for (int i = 0; i < 17; ++i)
+        count = (count << 1) | (data.ReadBit() ? 1 : 0);
+
+    std::vector<uint8> guidMask(count * 4, 0);
+    std::vector<uint8> nameLength(count, 0);
+
+    for (uint32 c = 0; c < count; ++c)
+    {
+        for (int i = 0; i < 18; ++i)
+        {
+            switch (i)
+            {
+                case 0:  guidMask[c * 4 + 3] = data.ReadBit(); break;
+                case 10: guidMask[c * 4 + 1] = data.ReadBit(); break;
+                case 14: guidMask[c * 4 + 0] = data.ReadBit(); break;
+                case 15: guidMask[c * 4 + 2] = data.ReadBit(); break;
+                case 4:
+                {
+                    uint8 len = 0;
+                    for (int b = 0; b < 7; ++b)
+                        len = (len << 1) | (data.ReadBit() ? 1 : 0);
+                    nameLength[c] = len;
+                    break;
+                }
+                default:
+                    data.ReadBit();
+                    break;
+            }
+        }
+    }
+
+    ///- Byte block, see Player::BuildEnumData
+    for (uint32 c = 0; c < count; ++c)
+    {
+        uint8 guid[4] = { 0, 0, 0, 0 };
+
+        data.read_skip<uint8>();                            // class
+        data.read_skip(BOT_ENUM_EQUIPMENT_ENTRIES * 9);
+        data.read_skip(4 + 1 + 1 + 4 + 4 + 1);              // pet display, order, hair style, pet display, flags, hair color
+        data.read_skip<uint32>();                           // map
+        data.read_skip<float>();                            // z
+        data.read_skip<uint32>();                           // pet level
+        if (guidMask[c * 4 + 3])
+            guid[3] = data.read<uint8>() ^ 1;
+        data.read_skip<float>();                            // y
+        data.read_skip(4 + 1 + 1);                          // customize flags, facial hair, gender
+
+        std::string name(nameLength[c], '\0');
+        if (nameLength[c])
+            data.read((uint8*)&name[0], nameLength[c]);
+
+        data.read_skip<uint8>();                            // face
+        if (guidMask[c * 4 + 0])
+            guid[0] = data.read<uint8>() ^ 1;
+        if (guidMask[c * 4 + 2])
+            guid[2] = data.read<uint8>() ^ 1;
+        data.read_skip<float>();                            // x
+        data.read_skip(1 + 1 + 1);                          // skin, race, level
+        if (guidMask[c * 4 + 1])
+            guid[1] = data.read<uint8>() ^ 1;
+        data.read_skip<uint32>();                           // zone
+
+        if (name == m_charName)
+            m_guid = guid[0] | (guid[1] << 8) | (guid[2] << 16) | (guid[3] << 24);
+    }
+
+    if (!m_guid)
+    {
+        if (m_state == BOT_STATE_CHAR_CREATE)
+        {
+            Fail("created character missing in the character list");
+            return false;
+        }
+
+        ByteBuffer pkt;
+        pkt << m_charName;
+        pkt << uint8(m_config.race);
+        pkt << uint8(m_config.playerClass);
+        pkt << uint8(urand(0, 1));                          // gender
+        pkt << uint8(0) << uint8(0);                        // skin, face
+        pkt << uint8(0) << uint8(0) << uint8(0);            // hair style, hair color, facial hair
+        pkt << uint8(0);                                    // outfit
+
+        SendPacket(BOT_CMSG_REQUEST_CHARACTER_CREATE, pkt);
+        m_state = BOT_STATE_CHAR_CREATE;
+        return true;
+    }
+
+    ///- Player login: guid byte mask in the order 2 3 0 6 4 5 1 7, then the set bytes xor 1 in the order 2 7 0 3 5 6 1 4
+    uint8 guidBytes[8];
+    memset(guidBytes, 0, sizeof(guidBytes));
+    guidBytes[0] = uint8(m_guid);
+    guidBytes[1] = uint8(m_guid >> 8);
+    guidBytes[2] = uint8(m_guid >> 16);
+    guidBytes[3] = uint8(m_guid >> 24);
+
+    uint8 maskOrder[8] = { 2, 3, 0, 6, 4, 5, 1, 7 };
+    uint8 byteOrder[8] = { 2, 7, 0, 3, 5, 6, 1, 4 };
+
+    ByteBuffer pkt;
+    for (int i = 0; i < 8; ++i)
+        pkt.WriteBit(guidBytes[maskOrder[i]] ? 1 : 0);
+    pkt.FlushBits();
+    for (int i = 0; i < 8; ++i)
+        if (guidBytes[byteOrder[i]])
+            pkt << uint8(guidBytes[byteOrder[i]] ^ 1);
+
+    SendPacket(BOT_CMSG_PLAYER_LOGIN, pkt);
+    m_state = BOT_STATE_PLAYER_LOGIN;
+    return true;
+}
+
+bool BotSession::HandleCharCreate(ByteBuffer& data)
+{
+    uint8 result = data.read<uint8>();
+    if (result != BOT_CHAR_CREATE_SUCCESS && result != BOT_CHAR_CREATE_NAME_IN_USE)
+    {
+        Fail("character creation failed");
+        return false;
+    }
+
+    // name in use: created by an earlier run of this bot, the new enum finds it
+    SendPacket(BOT_CMSG_REQUEST_CHARACTER_ENUM, ByteBuffer(0));
+    return true;
+}
+
+void BotSession::HandleLoginVerifyWorld(ByteBuffer& data)
+{
+    uint32 mapId;
+    float orientation;
+    data >> mapId >> m_homeX >> m_homeY >> m_homeZ >> orientation;
+
+    ByteBuffer pkt;
+    pkt << uint32(mapId);
+    pkt << uint8(0x80);                                     // loading screen hidden
+    SendPacket(BOT_CMSG_LOADING_SCREEN_NOTIFY, pkt);
+
+    sBotStats.AddSample(BOT_PROBE_ENTER_WORLD, GetElapsedUs(m_worldStart));
+    sBotStats.AddInWorld();
+    m_state = BOT_STATE_IN_WORLD;
+
+    // spread the first actions so the bots of one login wave don't act in lockstep
+    uint32 now = WorldTimer::getMSTime();
+    m_angle = frand(0.0f, 2 * M_PI_F);
+    m_nextMove = now + urand(0, m_config.moveInterval);
+    m_nextCast = now + urand(0, m_config.castInterval);
+    m_nextChat = now + urand(0, m_config.chatInterval);
+    m_nextWho = now + urand(0, m_config.whoInterval);
+    m_nextPing = now + urand(0, m_config.pingInterval);
+}
+
+// ---------------------------------------------------------------------------------------------------
+// In world actions
+// ---------------------------------------------------------------------------------------------------
+
+void BotSession::UpdateInWorld(uint32 now)
+{
+    if (m_config.moveInterval && IsDue(now, m_nextMove))
+    {
+        SendHeartbeat();
+        m_nextMove = now + m_config.moveInterval;
+    }
+
+    if (m_config.castInterval && IsDue(now, m_nextCast))
+    {
+        SendCast();
+        m_nextCast = now + m_config.castInterval;
+    }
+
+    if (m_config.chatInterval && IsDue(now, m_nextChat))
+    {
+        SendChat();
+        m_nextChat = now + m_config.chatInterval;
+    }
+
+    if (m_config.whoInterval && IsDue(now, m_nextWho))
+    {
+        SendWho();
+        m_nextWho = now + m_config.whoInterval;
+    }
+
+    if (m_config.pingInterval && IsDue(now, m_nextPing))
+    {
+        SendPing();
+        m_nextPing = now + m_config.pingInterval;
+    }
+}
+
+/// Walks a circle around the login position, written in the MSG_MOVE_HEARTBEAT element order of MovementStructures.h
+void BotSession::SendHeartbeat()
+{
+    m_angle += BOT_MOVE_STEP;
+    if (m_angle > 2 * M_PI_F)
+        m_angle -= 2 * M_PI_F;
+
+    float x = m_homeX + BOT_MOVE_RADIUS * cos(m_angle);
+    float y = m_homeY + BOT_MOVE_RADIUS * sin(m_angle);
+    float o = m_angle + M_PI_F / 2;
+    if (o > 2 * M_PI_F)
+        o -= 2 * M_PI_F;
+
+    uint8 guid[8];
+    memset(guid, 0, sizeof(guid));
+    guid[0] = uint8(m_guid);
+    guid[1] = uint8(m_guid >> 8);
+    guid[2] = uint8(m_guid >> 16);
+    guid[3] = uint8(m_guid >> 24);
+
+    ByteBuffer pkt;
+    pkt << m_homeZ << x << y;
+    pkt.WriteBit(1);                                        // no pitch
+    pkt.WriteBit(0);                                        // has timestamp
+    pkt.WriteBit(0);                                        // no fall data
+    pkt.WriteBit(0);                                        // has movement flags2
+    pkt.WriteBit(0);                                        // no transport
+    pkt.WriteBit(guid[7] != 0);
+    pkt.WriteBit(guid[1] != 0);
+    pkt.WriteBit(guid[0] != 0);
+    pkt.WriteBit(guid[4] != 0);
+    pkt.WriteBit(guid[2] != 0);
+    pkt.WriteBit(0);                                        // has orientation
+    pkt.WriteBit(guid[5] != 0);
+    pkt.WriteBit(guid[3] != 0);
+    pkt.WriteBit(1);                                        // no spline elevation
+    pkt.WriteBit(0);                                        // unknown bit
+    pkt.WriteBit(0);                                        // no spline
+    pkt.WriteBit(guid[6] != 0);
+    pkt.WriteBit(0);                                        // has movement flags
+    pkt.WriteBits(0, 30);                                   // movement flags, none: a heartbeat at a new position
+    pkt.WriteBits(0, 12);                                   // movement flags2
+
+    uint8 byteOrder[8] = { 3, 6, 1, 7, 2, 5, 0, 4 };
+    for (int i = 0; i < 8; ++i)
+        if (guid[byteOrder[i]])
+            pkt << uint8(guid[byteOrder[i]] ^ 1);
+
+    pkt << o;
+    pkt << WorldTimer::getMSTime();
+
+    SendPacket(BOT_MSG_MOVE_HEARTBEAT, pkt);
+    sBotStats.AddAction(BOT_ACTION_MOVE);
+}
+
+void BotSession::SendCast()
+{
+    ByteBuffer pkt;
+    pkt << uint8(++m_castCount);
+    pkt << uint32(m_config.spellId);
+    pkt << uint32(0);                                       // glyph index
+    pkt << uint8(0);                                        // cast flags
+    pkt << uint32(0);                                       // target mask, TARGET_FLAG_SELF
+
+    SendPacket(BOT_CMSG_CAST_SPELL, pkt);
+    sBotStats.AddAction(BOT_ACTION_CAST);
+}
+
+void BotSession::SendChat()
+{
+    ByteBuffer pkt;
+    pkt << uint32(0);                                       // LANG_UNIVERSAL
+    pkt << uint8(0) << uint8(0);
+    pkt << std::string(botChatLines[urand(0, BOT_CHAT_LINES - 1)]);
+
+    SendPacket(BOT_CMSG_CHAT_MESSAGE_SAY, pkt);
+    sBotStats.AddAction(BOT_ACTION_CHAT);
+}
+
+/// Browses the online player list, the listing request the opcode table of this core offers
+void BotSession::SendWho()
+{
+    ByteBuffer pkt;
+    pkt << uint32(0) << uint32(100);                        // level range
+    pkt << std::string() << std::string();                  // player and guild name
+    pkt << uint32(0xFFFFFFFF) << uint32(0xFFFFFFFF);        // race and class mask
+    pkt << uint32(0);                                       // zones
+    pkt << uint32(0);                                       // search strings
+
+    // one in flight at a time, a lost reply would otherwise be matched with the next request
+    if (!m_whoPending)
+    {
+        m_whoSent = ACE_OS::gettimeofday();
+        m_whoPending = true;
+    }
+
+    SendPacket(BOT_CMSG_WHO, pkt);
+    sBotStats.AddAction(BOT_ACTION_WHO);
+}
+
+void BotSession::SendPing()
+{
+    // the server echoes the first field
+    ByteBuffer pkt;
+    pkt << uint32(++m_pingSequence);
+    pkt << uint32(0);                                       // latency
+
+    m_pingSent = ACE_OS::gettimeofday();
+    SendPacket(BOT_CMSG_PING, pkt);
+}
+
+/// @}
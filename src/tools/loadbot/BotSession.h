@@ -0,0 +1,163 @@
+/*
+ * Copyright (C) 2010-2012 Strawberry-Pr0jcts <http://strawberry-pr0jcts.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/// \addtogroup loadbot
+/// @{
+/// \file
+
+#ifndef _BOTSESSION_H
+#define _BOTSESSION_H
+
+#include "Common.h"
+#include "ByteBuffer.h"
+#include "Auth/BigNumber.h"
+#include "Auth/SARC4.h"
+#include "BotOpcodes.h"
+
+#include <ace/SOCK_Stream.h>
+
+/// Settings shared by all bots, read once from the config file
+struct BotConfig
+{
+    std::string realmHost;
+    uint16 realmPort;
+    std::string worldHost;                                  ///< empty: use the address of the first realm in the realm list
+    uint16 worldPort;
+    std::string password;
+
+    uint8 race;
+    uint8 playerClass;
+    uint32 spellId;                                         ///< self cast spell, must be known by race/class at level 1
+
+    // intervals between in world actions in ms, 0 disables the action
+    uint32 moveInterval;
+    uint32 castInterval;
+    uint32 chatInterval;
+    uint32 whoInterval;
+    uint32 pingInterval;
+
+    uint32 retryDelay;                                      ///< ms before a failed bot logs in again, 0 = never
+};
+
+enum BotState
+{
+    BOT_STATE_WAITING           = 0,                        // not started yet or waiting for a retry
+    BOT_STATE_LOGON_CHALLENGE   = 1,
+    BOT_STATE_LOGON_PROOF       = 2,
+    BOT_STATE_REALM_LIST        = 3,
+    BOT_STATE_WORLD_AUTH        = 4,                        // until SMSG_AUTH_RESPONSE
+    BOT_STATE_CHAR_ENUM         = 5,
+    BOT_STATE_CHAR_CREATE       = 6,
+    BOT_STATE_PLAYER_LOGIN      = 7,
+    BOT_STATE_IN_WORLD          = 8,
+    BOT_STATE_FAILED            = 9                         // gave up, retryDelay is 0
+};
+
+/**
+ * One simulated client. Speaks the realm SRP6 logon, then the world protocol (header crypt, auth session,
+ * character enum/create, player login) and plays a fixed loop of movement heartbeats, self casts, say
+ * chat and who queries. All sockets are non blocking, the owning worker thread calls Update() in a loop.
+ */
+class BotSession
+{
+    public:
+        BotSession(BotConfig const& config, std::string const& account, std::string const& charName, uint32 startTime);
+        ~BotSession();
+
+        /// Advances the bot, now is WorldTimer::getMSTime()
+        void Update(uint32 now);
+        void Close();
+
+        BotState GetState() const { return m_state; }
+
+    private:
+        // realm connection
+        void StartLogon(uint32 now);
+        void SendLogonChallenge();
+        bool HandleRealmInput();
+        bool HandleLogonChallenge();
+        bool HandleLogonProof();
+        bool HandleRealmList();
+
+        // world connection
+        bool ConnectWorld();
+        bool HandleWorldInput();
+        bool HandlePacket(BotOpcode opcode, ByteBuffer& data);
+        void SendPacket(BotOpcode opcode, ByteBuffer const& data);
+        void InitCrypt();
+
+        bool HandleAuthChallenge(ByteBuffer& data);
+        bool HandleAuthResponse(ByteBuffer& data);
+        bool HandleCharEnum(ByteBuffer& data);
+        bool HandleCharCreate(ByteBuffer& data);
+        void HandleLoginVerifyWorld(ByteBuffer& data);
+
+        // in world actions
+        void UpdateInWorld(uint32 now);
+        void SendHeartbeat();
+        void SendCast();
+        void SendChat();
+        void SendWho();
+        void SendPing();
+
+        bool Connect(std::string const& host, uint16 port);
+        bool UpdateConnect(uint32 now);
+        bool ReadSocket();
+        void Fail(char const* reason);
+
+        BotConfig const& m_config;
+        std::string m_account;                              ///< upper case, as the realm expects it
+        std::string m_charName;
+        BotState m_state;
+        uint32 m_nextStart;
+
+        ACE_SOCK_Stream m_socket;
+        bool m_connected;
+        bool m_connecting;                                  ///< non blocking connect in progress
+        uint32 m_connectDeadline;
+        std::vector<uint8> m_recvBuf;
+
+        // logon
+        BigNumber m_K;
+        ACE_Time_Value m_logonStart;
+        std::string m_worldHost;
+        uint16 m_worldPort;
+
+        // world header crypt, the client sides of the two streams in AuthCrypt
+        SARC4 m_encrypt;
+        SARC4 m_decrypt;
+        bool m_cryptInitialized;
+        uint32 m_decryptedHeader;                           ///< bytes of the pending server header already decrypted
+        ACE_Time_Value m_worldStart;
+
+        // character
+        uint32 m_guid;
+        float m_homeX, m_homeY, m_homeZ;
+        float m_angle;
+
+        // action timers, absolute getMSTime() values
+        uint32 m_nextMove, m_nextCast, m_nextChat, m_nextWho, m_nextPing;
+        uint8 m_castCount;
+        uint32 m_pingSequence;
+        ACE_Time_Value m_pingSent;
+        ACE_Time_Value m_whoSent;
+        bool m_whoPending;
+};
+
+#endif
+/// @}
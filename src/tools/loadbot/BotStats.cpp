@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) 2010-2012 Strawberry-Pr0jcts <http://strawberry-pr0jcts.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/// \addtogroup loadbot
+/// @{
+/// \file
+
+#include "BotStats.h"
+#include "Log.h"
+#include "Policies/SingletonImp.h"
+
+INSTANTIATE_SINGLETON_1(BotStats);
+
+void BotHistogram::Add(uint32 usec)
+{
+    uint32 bucket = 0;
+    for (uint32 v = usec; v && bucket < MAX_BOT_HISTOGRAM_BUCKETS - 1; v >>= 1)
+        ++bucket;
+
+    ++m_buckets[bucket];
+    ++m_count;
+    m_total += long(usec);
+
+    if (long(usec) > m_max.value())
+        m_max = long(usec);
+}
+
+uint32 BotHistogram::GetAverage() const
+{
+    uint32 count = GetCount();
+    return count ? uint32(uint64(m_total.value()) / count) : 0;
+}
+
+uint32 BotHistogram::GetPercentile(uint32 percent) const
+{
+    uint64 count = GetCount();
+    if (!count)
+        return 0;
+
+    uint64 rank = (count * percent + 99) / 100;
+    uint64 seen = 0;
+    for (uint32 i = 0; i < MAX_BOT_HISTOGRAM_BUCKETS - 1; ++i)
+    {
+        seen += uint64(m_buckets[i].value());
+        if (seen >= rank)
+            return std::min(uint32(1) << i, GetMax());
+    }
+
+    return GetMax();
+}
+
+BotStats::BotStats() : m_lastSentPackets(0), m_lastSentBytes(0), m_lastRecvPackets(0), m_lastRecvBytes(0), m_lastElapsed(0)
+{
+}
+
+void BotStats::PrintProgress(uint32 totalBots, uint32 elapsedSec)
+{
+    uint32 period = elapsedSec > m_lastElapsed ? elapsedSec - m_lastElapsed : 1;
+
+    long sentPackets = m_sentPackets.value();
+    long sentBytes = m_sentBytes.value();
+    long recvPackets = m_recvPackets.value();
+    long recvBytes = m_recvBytes.value();
+
+    BotHistogram const& who = m_probes[BOT_PROBE_WHO];
+
+    sLog.outString("[%5us] in world %u/%u, failed %u | out %lu pkt/s %lu KB/s | in %lu pkt/s %lu KB/s | who p50 %u us p99 %u us",
+        elapsedSec, uint32(m_inWorld.value()), totalBots, uint32(m_failures.value()),
+        (sentPackets - m_lastSentPackets) / period, (sentBytes - m_lastSentBytes) / period / 1024,
+        (recvPackets - m_lastRecvPackets) / period, (recvBytes - m_lastRecvBytes) / period / 1024,
+        who.GetPercentile(50), who.GetPercentile(99));
+
+    m_lastSentPackets = sentPackets;
+    m_lastSentBytes = sentBytes;
+    m_lastRecvPackets = recvPackets;
+    m_lastRecvBytes = recvBytes;
+    m_lastElapsed = elapsedSec;
+}
+
+void BotStats::PrintSummary(uint32 elapsedSec)
+{
+    uint32 seconds = elapsedSec ? elapsedSec : 1;
+
+    sLog.outString();
+    sLog.outString("Round trips over %u s:", elapsedSec);
+    sLog.outString("%-14s %8s %9s %9s %9s %9s %9s", "probe", "count", "avg us", "p50 us", "p95 us", "p99 us", "max us");
+    for (uint32 i = 0; i < MAX_BOT_PROBES; ++i)
+    {
+        BotHistogram const& hist = m_probes[i];
+        sLog.outString("%-14s %8u %9u %9u %9u %9u %9u", GetProbeName(BotProbe(i)), hist.GetCount(), hist.GetAverage(),
+            hist.GetPercentile(50), hist.GetPercentile(95), hist.GetPercentile(99), hist.GetMax());
+    }
+
+    sLog.outString();
+    for (uint32 i = 0; i < MAX_BOT_ACTIONS; ++i)
+        sLog.outString("%-14s %8lu (%lu/s)", GetActionName(BotAction(i)), m_actions[i].value(), m_actions[i].value() / seconds);
+
+    sLog.outString("Sent %lu packets (%lu KB), received %lu packets (%lu KB), %u bot failures.",
+        m_sentPackets.value(), m_sentBytes.value() / 1024, m_recvPackets.value(), m_recvBytes.value() / 1024,
+        uint32(m_failures.value()));
+}
+
+char const* BotStats::GetProbeName(BotProbe probe)
+{
+    switch (probe)
+    {
+        case BOT_PROBE_LOGON:       return "logon";
+        case BOT_PROBE_ENTER_WORLD: return "enter world";
+        case BOT_PROBE_PING:        return "ping";
+        case BOT_PROBE_WHO:         return "who";
+    }
+
+    return "unknown";
+}
+
+char const* BotStats::GetActionName(BotAction action)
+{
+    switch (action)
+    {
+        case BOT_ACTION_MOVE:       return "moves";
+        case BOT_ACTION_CAST:       return "casts";
+        case BOT_ACTION_CHAT:       return "chat lines";
+        case BOT_ACTION_WHO:        return "who queries";
+    }
+
+    return "unknown";
+}
+
+/// @}
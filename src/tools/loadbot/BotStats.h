@@ -0,0 +1,123 @@
+/*
+ * Copyright (C) 2010-2012 Strawberry-Pr0jcts <http://strawberry-pr0jcts.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/// \addtogroup loadbot
+/// @{
+/// \file
+
+#ifndef _BOTSTATS_H
+#define _BOTSTATS_H
+
+#include "Common.h"
+#include "Policies/Singleton.h"
+
+#include <ace/Atomic_Op.h>
+#include <ace/Thread_Mutex.h>
+
+typedef ACE_Atomic_Op<ACE_Thread_Mutex, long> BotCounter;
+
+/// Round trips measured by the bots, each one answered by a different part of the server
+enum BotProbe
+{
+    BOT_PROBE_LOGON             = 0,                        // realm challenge sent -> proof accepted, SRP6 and login database
+    BOT_PROBE_ENTER_WORLD       = 1,                        // world socket connected -> SMSG_LOGIN_VERIFY_WORLD
+    BOT_PROBE_PING              = 2,                        // CMSG_PING -> SMSG_PONG, answered by the network thread
+    BOT_PROBE_WHO               = 3                         // CMSG_WHO -> SMSG_WHO, answered from the world tick
+};
+
+#define MAX_BOT_PROBES 4
+
+enum BotAction
+{
+    BOT_ACTION_MOVE             = 0,
+    BOT_ACTION_CAST             = 1,
+    BOT_ACTION_CHAT             = 2,
+    BOT_ACTION_WHO              = 3
+};
+
+#define MAX_BOT_ACTIONS 4
+
+// bucket N holds round trips in [2^(N-1), 2^N) us, the last one everything above
+#define MAX_BOT_HISTOGRAM_BUCKETS 28
+
+/// Latency histogram filled by all worker threads at once
+class BotHistogram
+{
+    public:
+        BotHistogram() {}
+
+        void Add(uint32 usec);
+
+        uint32 GetCount() const { return uint32(m_count.value()); }
+        uint32 GetMax() const { return uint32(m_max.value()); }
+        uint32 GetAverage() const;
+        // upper bound of the bucket holding the given percentile, in us
+        uint32 GetPercentile(uint32 percent) const;
+
+    private:
+        BotCounter m_buckets[MAX_BOT_HISTOGRAM_BUCKETS];
+        BotCounter m_count;
+        BotCounter m_total;
+        BotCounter m_max;
+};
+
+class BotStats
+{
+    public:
+        BotStats();
+
+        void AddSample(BotProbe probe, uint32 usec) { m_probes[probe].Add(usec); }
+        void AddAction(BotAction action) { ++m_actions[action]; }
+
+        void AddSentPacket(size_t size) { ++m_sentPackets; m_sentBytes += long(size); }
+        void AddReceivedPacket(size_t size) { ++m_recvPackets; m_recvBytes += long(size); }
+
+        void AddInWorld() { ++m_inWorld; }
+        void RemoveInWorld() { --m_inWorld; }
+        void AddFailure() { ++m_failures; }
+
+        /// One line with the traffic since the previous call, called from the main thread only
+        void PrintProgress(uint32 totalBots, uint32 elapsedSec);
+        /// Latency table and totals of the whole run
+        void PrintSummary(uint32 elapsedSec);
+
+        static char const* GetProbeName(BotProbe probe);
+        static char const* GetActionName(BotAction action);
+
+    private:
+        BotHistogram m_probes[MAX_BOT_PROBES];
+        BotCounter m_actions[MAX_BOT_ACTIONS];
+        BotCounter m_sentPackets;
+        BotCounter m_sentBytes;
+        BotCounter m_recvPackets;
+        BotCounter m_recvBytes;
+        BotCounter m_inWorld;
+        BotCounter m_failures;
+
+        // counters at the previous progress line
+        long m_lastSentPackets;
+        long m_lastSentBytes;
+        long m_lastRecvPackets;
+        long m_lastRecvBytes;
+        uint32 m_lastElapsed;
+};
+
+#define sBotStats Strawberry::Singleton<BotStats>::Instance()
+
+#endif
+/// @}
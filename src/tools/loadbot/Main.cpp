@@ -0,0 +1,341 @@
+/*
+ * Copyright (C) 2010-2012 Strawberry-Pr0jcts <http://strawberry-pr0jcts.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/// \addtogroup loadbot
+/// @{
+/// \file
+
+#include "Common.h"
+#include "Database/DatabaseEnv.h"
+#include "Config/Config.h"
+#include "Log.h"
+#include "SystemConfig.h"
+#include "Threading.h"
+#include "Timer.h"
+#include "Util.h"
+#include "Auth/Sha1.h"
+#include "BotOpcodes.h"
+#include "BotSession.h"
+#include "BotStats.h"
+#include "RemoteAdmin.h"
+
+#include <ace/Get_Opt.h>
+
+DatabaseType LoginDatabase;                                 ///< Accessor to the realm database, bot account creation only
+DatabaseType WorldDatabase;                                 ///< Accessor to the world database, opcode values only
+
+volatile bool stopEvent = false;                            ///< Setting it to true stops the bots
+
+typedef std::vector<BotSession*> BotList;
+
+/// Drives a slice of the bots, all sockets are non blocking so one thread serves hundreds of them
+class BotWorker : public ACE_Based::Runnable
+{
+    public:
+        explicit BotWorker(BotList const& bots) : m_bots(bots) {}
+
+        void run()
+        {
+            while (!stopEvent)
+            {
+                uint32 now = WorldTimer::getMSTime();
+                for (BotList::const_iterator itr = m_bots.begin(); itr != m_bots.end(); ++itr)
+                    (*itr)->Update(now);
+
+                ACE_Based::Thread::Sleep(5);
+            }
+
+            for (BotList::const_iterator itr = m_bots.begin(); itr != m_bots.end(); ++itr)
+                (*itr)->Close();
+        }
+
+    private:
+        BotList m_bots;
+};
+
+/// Print out the usage string for this program on the console.
+void usage(const char* prog)
+{
+    sLog.outString("Usage: \n %s [<options>]\n"
+        "    -c config_file           use config_file as configuration file\n\r"
+        "    -n count                 number of bots, overrides Bots.Count\n\r"
+        "    -d seconds               run time, overrides Bots.Duration\n\r"
+        ,prog);
+}
+
+/// Handle termination signals
+void OnSignal(int s)
+{
+    switch (s)
+    {
+        case SIGINT:
+        case SIGTERM:
+            stopEvent = true;
+            break;
+    }
+
+    signal(s, OnSignal);
+}
+
+/// Character name of a bot: the number spelled in letters, no two neighbours alike so the name passes the name checks
+static std::string MakeCharacterName(std::string const& prefix, uint32 number)
+{
+    std::string digits;
+    std::ostringstream ss;
+    ss << number;
+    digits = ss.str();
+
+    std::string name = prefix;
+    for (size_t i = 0; i < digits.size(); ++i)
+        name += char('a' + (digits[i] - '0' + i * 11) % 26);
+
+    return name;
+}
+
+/// Inserts the accounts of all bots that don't exist yet
+static bool CreateAccounts(std::string const& prefix, uint32 first, uint32 count, std::string const& password)
+{
+    std::string upperPassword = password;
+    std::transform(upperPassword.begin(), upperPassword.end(), upperPassword.begin(), ::toupper);
+
+    for (uint32 i = first; i < first + count; ++i)
+    {
+        std::ostringstream ss;
+        ss << prefix << i;
+        std::string username = ss.str();
+        std::transform(username.begin(), username.end(), username.begin(), ::toupper);
+
+        Sha1Hash sha;
+        sha.UpdateData(username);
+        sha.UpdateData(":");
+        sha.UpdateData(upperPassword);
+        sha.Finalize();
+
+        std::string passHash;
+        hexEncodeByteArray(sha.GetDigest(), sha.GetLength(), passHash);
+
+        LoginDatabase.escape_string(username);
+        if (!LoginDatabase.DirectPExecute("INSERT IGNORE INTO account (username, sha_pass_hash, expansion) VALUES ('%s', '%s', 3)",
+            username.c_str(), passHash.c_str()))
+            return false;
+    }
+
+    return true;
+}
+
+static void PrintRemoteCommand(RemoteAdmin& remote, char const* command)
+{
+    std::string output;
+    if (!remote.Execute(command, output))
+    {
+        sLog.outError("Remote console command '%s' failed.", command);
+        return;
+    }
+
+    sLog.outString("Server: %s", command);
+    sLog.outString("%s", output.c_str());
+}
+
+/// Launch the load bots
+extern int main(int argc, char** argv)
+{
+    ///- Command line parsing
+    char const* cfg_file = _LOADBOT_CONFIG;
+    int botCountArg = -1;
+    int durationArg = -1;
+
+    ACE_Get_Opt cmd_opts(argc, argv, ":c:n:d:");
+
+    int option;
+    while ((option = cmd_opts()) != EOF)
+    {
+        switch (option)
+        {
+            case 'c':
+                cfg_file = cmd_opts.opt_arg();
+                break;
+            case 'n':
+                botCountArg = atoi(cmd_opts.opt_arg());
+                break;
+            case 'd':
+                durationArg = atoi(cmd_opts.opt_arg());
+                break;
+            case ':':
+                sLog.outError("Runtime-Error: -%c option requires an input argument", cmd_opts.opt_opt());
+                usage(argv[0]);
+                return 1;
+            default:
+                sLog.outError("Runtime-Error: bad format of commandline arguments");
+                usage(argv[0]);
+                return 1;
+        }
+    }
+
+    if (!sConfig.SetSource(cfg_file))
+    {
+        sLog.outError("Could not find configuration file %s.", cfg_file);
+        return 1;
+    }
+
+    sLog.Initialize();
+    sLog.outString("Using configuration file %s.", cfg_file);
+
+    if (uint32(sConfig.GetIntDefault("ConfVersion", 0)) < _LOADBOTCONFVERSION)
+        sLog.outError("Your loadbot.conf version indicates your conf file is out of date!");
+
+    ///- Bot settings
+    BotConfig config;
+    config.realmHost = sConfig.GetStringDefault("RealmServerHost", "127.0.0.1");
+    config.realmPort = uint16(sConfig.GetIntDefault("RealmServerPort", DEFAULT_REALMSERVER_PORT));
+    config.worldHost = sConfig.GetStringDefault("WorldServerHost", "");
+    config.worldPort = uint16(sConfig.GetIntDefault("WorldServerPort", DEFAULT_WORLDSERVER_PORT));
+    config.password = sConfig.GetStringDefault("Bots.Password", "loadbot");
+    config.race = uint8(sConfig.GetIntDefault("Bots.Race", 1));
+    config.playerClass = uint8(sConfig.GetIntDefault("Bots.Class", 1));
+    config.spellId = sConfig.GetIntDefault("Behaviour.SpellId", 2457);
+    config.moveInterval = sConfig.GetIntDefault("Behaviour.MoveInterval", 500);
+    config.castInterval = sConfig.GetIntDefault("Behaviour.CastInterval", 10000);
+    config.chatInterval = sConfig.GetIntDefault("Behaviour.ChatInterval", 30000);
+    config.whoInterval = sConfig.GetIntDefault("Behaviour.WhoInterval", 15000);
+    config.pingInterval = sConfig.GetIntDefault("Behaviour.PingInterval", 30000);
+    config.retryDelay = sConfig.GetIntDefault("Bots.RetryDelay", 10000);
+
+    uint32 botCount = botCountArg >= 0 ? uint32(botCountArg) : sConfig.GetIntDefault("Bots.Count", 100);
+    uint32 firstBot = sConfig.GetIntDefault("Bots.First", 1);
+    uint32 loginRate = std::max(1, sConfig.GetIntDefault("Bots.LoginRate", 50));
+    uint32 threadCount = std::max(1, sConfig.GetIntDefault("Bots.Threads", 4));
+    uint32 duration = durationArg >= 0 ? uint32(durationArg) : sConfig.GetIntDefault("Bots.Duration", 300);
+    uint32 reportInterval = std::max(1, sConfig.GetIntDefault("Bots.ReportInterval", 10));
+    std::string accountPrefix = sConfig.GetStringDefault("Bots.AccountPrefix", "LOADBOT");
+    std::string namePrefix = sConfig.GetStringDefault("Bots.NamePrefix", "Bot");
+
+    ///- Opcode values, and the bot accounts if requested
+    std::string dbstring = sConfig.GetStringDefault("WorldDatabaseInfo", "");
+    if (dbstring.empty() || !WorldDatabase.Initialize(dbstring.c_str()))
+    {
+        sLog.outError("Cannot connect to world database %s", dbstring.c_str());
+        return 1;
+    }
+
+    if (!BotOpcodes::Load())
+        return 1;
+
+    if (sConfig.GetBoolDefault("Bots.CreateAccounts", true))
+    {
+        dbstring = sConfig.GetStringDefault("LoginDatabaseInfo", "");
+        if (dbstring.empty() || !LoginDatabase.Initialize(dbstring.c_str()))
+        {
+            sLog.outError("Cannot connect to login database %s", dbstring.c_str());
+            return 1;
+        }
+
+        if (!CreateAccounts(accountPrefix, firstBot, botCount, config.password))
+        {
+            sLog.outError("Cannot create the bot accounts.");
+            return 1;
+        }
+
+        LoginDatabase.HaltDelayThread();
+    }
+
+    WorldDatabase.HaltDelayThread();
+
+    ///- Server side statistics through the remote console
+    RemoteAdmin remote;
+    bool remoteEnabled = false;
+    if (sConfig.GetBoolDefault("RemoteAdmin.Enable", false))
+    {
+        remoteEnabled = remote.Connect(sConfig.GetStringDefault("RemoteAdmin.Host", "127.0.0.1"),
+            uint16(sConfig.GetIntDefault("RemoteAdmin.Port", 3443)),
+            sConfig.GetStringDefault("RemoteAdmin.Username", ""), sConfig.GetStringDefault("RemoteAdmin.Password", ""));
+
+        std::string output;
+        if (remoteEnabled && !remote.Execute("perf reset", output))
+            sLog.outError("Remote console command 'perf reset' failed.");
+    }
+
+    ///- Bots, started at Bots.LoginRate per second and dealt round robin to the workers
+    uint32 startTime = WorldTimer::getMSTime();
+
+    BotList bots;
+    std::vector<BotList> slices(threadCount);
+    for (uint32 i = 0; i < botCount; ++i)
+    {
+        std::ostringstream account;
+        account << accountPrefix << (firstBot + i);
+
+        BotSession* bot = new BotSession(config, account.str(), MakeCharacterName(namePrefix, firstBot + i),
+            startTime + uint32(uint64(i) * 1000 / loginRate));
+        bots.push_back(bot);
+        slices[i % threadCount].push_back(bot);
+    }
+
+    signal(SIGINT, OnSignal);
+    signal(SIGTERM, OnSignal);
+
+    sLog.outString("Starting %u bots on %u threads, %u logins/s, %s:%u. <Ctrl-C> to stop.", botCount, threadCount, loginRate,
+        config.realmHost.c_str(), config.realmPort);
+
+    std::vector<ACE_Based::Thread*> threads;
+    for (uint32 i = 0; i < threadCount; ++i)
+        threads.push_back(new ACE_Based::Thread(new BotWorker(slices[i])));
+
+    ///- Wait for the end of the run, printing a progress line every Bots.ReportInterval seconds
+    uint32 nextReport = reportInterval;
+    uint32 elapsed = 0;
+    while (!stopEvent)
+    {
+        ACE_Based::Thread::Sleep(100);
+
+        elapsed = WorldTimer::getMSTimeDiff(startTime, WorldTimer::getMSTime()) / 1000;
+        if (elapsed >= nextReport)
+        {
+            sBotStats.PrintProgress(botCount, elapsed);
+            nextReport += reportInterval;
+        }
+
+        if (duration && elapsed >= duration)
+            stopEvent = true;
+    }
+
+    for (size_t i = 0; i < threads.size(); ++i)
+    {
+        threads[i]->wait();
+        delete threads[i];
+    }
+
+    for (BotList::const_iterator itr = bots.begin(); itr != bots.end(); ++itr)
+        delete *itr;
+
+    signal(SIGINT, 0);
+    signal(SIGTERM, 0);
+
+    sBotStats.PrintSummary(elapsed);
+
+    if (remoteEnabled)
+    {
+        sLog.outString();
+        PrintRemoteCommand(remote, "perf stats");
+        PrintRemoteCommand(remote, "perf opcodes time 10");
+        remote.Close();
+    }
+
+    return 0;
+}
+
+/// @}
@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2010-2012 Strawberry-Pr0jcts <http://strawberry-pr0jcts.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/// \addtogroup loadbot
+/// @{
+/// \file
+
+#include "RemoteAdmin.h"
+#include "Log.h"
+
+#include <ace/SOCK_Connector.h>
+#include <ace/INET_Addr.h>
+
+#define RA_PROMPT               "mangos>"
+#define RA_REPLY_TIMEOUT        10                          // seconds
+#define RA_QUIET_TIMEOUT        300                         // ms without data ending a prompt
+
+bool RemoteAdmin::Connect(std::string const& host, uint16 port, std::string const& user, std::string const& password)
+{
+    ACE_INET_Addr addr(port, host.c_str());
+    ACE_SOCK_Connector connector;
+    ACE_Time_Value timeout(RA_REPLY_TIMEOUT);
+
+    if (connector.connect(m_socket, addr, &timeout) == -1)
+    {
+        sLog.outError("Can't connect to the remote console at %s:%u.", host.c_str(), port);
+        return false;
+    }
+
+    m_connected = true;
+
+    // motd and username prompt, then the password prompt; the console reads one line per packet
+    std::string output;
+    if (!ReadUntil(NULL, output) || !SendLine(user) || !ReadUntil(NULL, output) || !SendLine(password))
+    {
+        Close();
+        return false;
+    }
+
+    output.clear();
+    if (!ReadUntil(RA_PROMPT, output) || output.find("+Logged in.") == std::string::npos)
+    {
+        sLog.outError("Remote console login as %s failed: %s", user.c_str(), output.c_str());
+        Close();
+        return false;
+    }
+
+    return true;
+}
+
+bool RemoteAdmin::Execute(std::string const& command, std::string& output)
+{
+    output.clear();
+    if (!m_connected || !SendLine(command) || !ReadUntil(RA_PROMPT, output))
+        return false;
+
+    output.erase(output.size() - strlen(RA_PROMPT));
+    return true;
+}
+
+void RemoteAdmin::Close()
+{
+    if (m_connected)
+    {
+        m_socket.close();
+        m_connected = false;
+    }
+}
+
+bool RemoteAdmin::SendLine(std::string const& line)
+{
+    std::string data = line + "\r\n";
+    return m_socket.send_n(data.c_str(), data.size()) == ssize_t(data.size());
+}
+
+bool RemoteAdmin::ReadUntil(char const* marker, std::string& output)
+{
+    char buf[4096];
+    bool received = false;
+
+    for (;;)
+    {
+        ACE_Time_Value timeout = (marker || !received) ? ACE_Time_Value(RA_REPLY_TIMEOUT) : ACE_Time_Value(0, RA_QUIET_TIMEOUT * 1000);
+
+        ssize_t n = m_socket.recv(buf, sizeof(buf), &timeout);
+        if (n <= 0)
+            return !marker && received;                     // quiet after some data is the end of a prompt
+
+        output.append(buf, n);
+        received = true;
+
+        if (marker && output.size() >= strlen(marker) && output.compare(output.size() - strlen(marker), strlen(marker), marker) == 0)
+            return true;
+    }
+}
+
+/// @}
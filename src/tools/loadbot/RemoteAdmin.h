@@ -0,0 +1,53 @@
+/*
+ * Copyright (C) 2010-2012 Strawberry-Pr0jcts <http://strawberry-pr0jcts.com/>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/// \addtogroup loadbot
+/// @{
+/// \file
+
+#ifndef _REMOTEADMIN_H
+#define _REMOTEADMIN_H
+
+#include "Common.h"
+
+#include <ace/SOCK_Stream.h>
+
+/// Blocking client for the world server remote administration console, used to read the server side
+/// tick and opcode statistics (.perf) around a bot run
+class RemoteAdmin
+{
+    public:
+        RemoteAdmin() : m_connected(false) {}
+        ~RemoteAdmin() { Close(); }
+
+        bool Connect(std::string const& host, uint16 port, std::string const& user, std::string const& password);
+        /// Runs one console command, output holds everything printed before the next prompt
+        bool Execute(std::string const& command, std::string& output);
+        void Close();
+
+    private:
+        bool SendLine(std::string const& line);
+        /// Reads until marker shows up, or until the server goes quiet if marker is NULL
+        bool ReadUntil(char const* marker, std::string& output);
+
+        ACE_SOCK_Stream m_socket;
+        bool m_connected;
+};
+
+#endif
+/// @}